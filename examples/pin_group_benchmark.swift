@@ -0,0 +1,54 @@
+// main.swift
+// PinGroup benchmark:
+// Counts 8-bit bus updates per second on pins 2..9, first with PinGroup
+// (port registers), then with one PIN.write per bit (digitalWrite path).
+
+@_silgen_name("arduino_swift_main")
+public func arduino_swift_main() {
+    Serial.begin(115200)
+    print("PinGroup benchmark\n")
+
+    let bus = PinGroup([2, 3, 4, 5, 6, 7, 8, 9])
+    bus.output()
+
+    var f = FormatBuffer()
+    f.append("fast path: ")
+    if bus.hasFastIO { f.append("yes") } else { f.append("no") }
+    Serial.print(&f)
+    Serial.println()
+
+    let group = measure { v in bus.write(v) }
+    report("PinGroup.write   ", group)
+
+    let bits = bus.pins
+    let sequential = measure { v in
+        var x = v
+        for p in bits {
+            arduino_digitalWrite(p, (x & 1) != 0 ? arduino_high() : arduino_low())
+            x >>= 1
+        }
+    }
+    report("digitalWrite x8  ", sequential)
+
+    ArduinoRuntime.keepAlive()
+}
+
+// Updates completed in one second (counter pattern 0..255).
+private func measure(_ update: (U32) -> Void) -> U32 {
+    var n: U32 = 0
+    let start = arduino_millis()
+    while arduino_millis() &- start < 1000 {
+        update(n & 0xFF)
+        n &+= 1
+    }
+    return n
+}
+
+private func report(_ label: StaticString, _ updates: U32) {
+    var f = FormatBuffer()
+    f.append(label)
+    f.append(updates)
+    f.append(" updates/s")
+    Serial.print(&f)
+    Serial.println()
+}
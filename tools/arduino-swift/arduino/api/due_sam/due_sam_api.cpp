@@ -10,6 +10,10 @@
 
 #include <Arduino.h>
 #include "due_sam_api.h"
+#include "FastIO.h"
+#include "AdcStream.h"
+#include "HwTimer.h"
+#include "I2CQueue.h"
 
 // ----------------------------------------------
 // Analog resolution helpers
@@ -33,18 +37,26 @@ struct SwiftIrqSlot {
   uint8_t  used;
   uint8_t  irqNumber;
   volatile uint8_t fired;
+  volatile uint16_t edges;     // since last consume_edges (saturating)
+  volatile uint32_t lastUs;    // micros() of the latest edge
 };
 
 static SwiftIrqSlot gSlots[ARDUINO_SWIFT_IRQ_SLOTS] = {};
 
-static void irq0() { gSlots[0].fired = 1; }
-static void irq1() { gSlots[1].fired = 1; }
-static void irq2() { gSlots[2].fired = 1; }
-static void irq3() { gSlots[3].fired = 1; }
-static void irq4() { gSlots[4].fired = 1; }
-static void irq5() { gSlots[5].fired = 1; }
-static void irq6() { gSlots[6].fired = 1; }
-static void irq7() { gSlots[7].fired = 1; }
+static inline void irqFire(SwiftIrqSlot& s) {
+  s.lastUs = (uint32_t)micros();
+  if (s.edges != 0xFFFFu) s.edges++;
+  s.fired = 1;
+}
+
+static void irq0() { irqFire(gSlots[0]); }
+static void irq1() { irqFire(gSlots[1]); }
+static void irq2() { irqFire(gSlots[2]); }
+static void irq3() { irqFire(gSlots[3]); }
+static void irq4() { irqFire(gSlots[4]); }
+static void irq5() { irqFire(gSlots[5]); }
+static void irq6() { irqFire(gSlots[6]); }
+static void irq7() { irqFire(gSlots[7]); }
 
 static void (*const gHandlers[ARDUINO_SWIFT_IRQ_SLOTS])() = {
   irq0, irq1, irq2, irq3, irq4, irq5, irq6, irq7
@@ -103,6 +115,8 @@ int32_t arduino_irq_attach(uint32_t pin, uint32_t mode) {
       gSlots[i].used = 1;
       gSlots[i].irqNumber = (uint8_t)irq;
       gSlots[i].fired = 0;
+      gSlots[i].edges = 0;
+      gSlots[i].lastUs = 0;
 
       attachInterrupt((uint8_t)irq, gHandlers[i], (int)mode);
       return (int32_t)i;
@@ -133,6 +147,21 @@ uint32_t arduino_irq_consume(int32_t slot) {
   return (uint32_t)(v ? 1u : 0u);
 }
 
+uint32_t arduino_irq_consume_edges(int32_t slot, uint32_t* last_us) {
+  if (slot < 0 || slot >= (int32_t)ARDUINO_SWIFT_IRQ_SLOTS) return 0;
+  if (!gSlots[slot].used) return 0;
+
+  noInterrupts();
+  const uint16_t n = gSlots[slot].edges;
+  const uint32_t t = gSlots[slot].lastUs;
+  gSlots[slot].edges = 0;
+  gSlots[slot].fired = 0;
+  interrupts();
+
+  if (last_us) *last_us = t;
+  return (uint32_t)n;
+}
+
 // ----------------------
 // Serial
 // ----------------------
@@ -154,7 +183,362 @@ void arduino_serial_print_u32(uint32_t v) {
 }
 
 void arduino_serial_print_f64(double v) {
-  Serial.print(v);
+  Serial.print(v, (int)arduino_serial_float_digits());
+}
+
+uint32_t arduino_serial_float_digits(void) {
+  return 2;
+}
+
+// ----------------------
+// Memory
+// ----------------------
+// SAM3X linker script: the main stack is its own section [_sstack, _estack);
+// the heap (sbrk) grows from _end up to the end of RAM.
+
+extern char _sstack;
+extern char _estack;
+extern char _ram_end_;
+extern char* sbrk(int incr);
+
+int arduino_stack_region(uintptr_t* lo, uintptr_t* hi) {
+  if (!lo || !hi) return 0;
+  *lo = (uintptr_t)&_sstack;
+  *hi = (uintptr_t)&_estack;
+  return 1;
+}
+
+uint32_t arduino_heap_headroom(void) {
+  uintptr_t top = (uintptr_t)sbrk(0);
+  uintptr_t end = (uintptr_t)&_ram_end_ + 1u;
+  return (end > top) ? (uint32_t)(end - top) : 0u;
+}
+
+// ----------------------
+// Fast IO
+// ----------------------
+// SAM3X PIO: SODR/CODR set/clear, PDSR input level, ODSR output latch; one mask for all.
+
+uint32_t arduino_fastio_resolve(uint32_t pin, uintptr_t* out) {
+  if (!out || pin >= PINS_COUNT) return 0;
+
+  const PinDescription& d = g_APinDescription[pin];
+  Pio* port = d.pPort;
+  if (!port || d.ulPin == 0) return 0;
+
+  out[ARDUINO_FASTIO_SET_REG]  = (uintptr_t)&port->PIO_SODR;
+  out[ARDUINO_FASTIO_SET_MASK] = d.ulPin;
+  out[ARDUINO_FASTIO_CLR_REG]  = (uintptr_t)&port->PIO_CODR;
+  out[ARDUINO_FASTIO_CLR_MASK] = d.ulPin;
+  out[ARDUINO_FASTIO_IN_REG]   = (uintptr_t)&port->PIO_PDSR;
+  out[ARDUINO_FASTIO_IN_MASK]  = d.ulPin;
+  out[ARDUINO_FASTIO_OUT_REG]  = (uintptr_t)&port->PIO_ODSR;
+  out[ARDUINO_FASTIO_OUT_MASK] = d.ulPin;
+  return 1;
+}
+
+// ----------------------
+// ADC stream
+// ----------------------
+// TC0 channel 0 toggles TIOA0 (= ADC_TRIG1) at rate_hz; every edge converts the
+// user sequence (ADC_SEQR1, so frames follow the caller's pin order). The PDC
+// moves each result from ADC_LCDR straight into ring slots: RPR/RCR is the block
+// being filled, RNPR/RNCR the next one. ENDRX fires once per block.
+//
+// Owns TC0 ch0 and the ADC while running; analogRead() is unavailable until stop().
+
+static uint16_t* gAdcCur = nullptr;
+static uint16_t* gAdcNext = nullptr;
+static uint32_t  gAdcMode = ARDUINO_ADC_STREAM_OFF;
+static uint32_t  gAdcSavedMr = 0;
+
+static void adcArm(void) {
+  gAdcCur = arduino_adc_ring_reserve(&g_adc_stream);
+  gAdcNext = arduino_adc_ring_reserve(&g_adc_stream);
+  ADC->ADC_RPR = (uint32_t)gAdcCur;
+  ADC->ADC_RCR = g_adc_stream.block_len;
+  ADC->ADC_RNPR = (uint32_t)gAdcNext;
+  ADC->ADC_RNCR = g_adc_stream.block_len;
+}
+
+void ADC_Handler(void) {
+  const uint32_t isr = ADC->ADC_ISR & ADC->ADC_IMR;
+  const uint32_t now = micros();
+
+  if (isr & ADC_ISR_RXBUFF) {
+    // Both buffers ran out before we got here: the PDC stopped. Count the
+    // finished pair and re-arm from scratch.
+    arduino_adc_ring_commit(&g_adc_stream, gAdcCur, now);
+    arduino_adc_ring_commit(&g_adc_stream, gAdcNext, now);
+    adcArm();
+    return;
+  }
+
+  if (isr & ADC_ISR_ENDRX) {
+    arduino_adc_ring_commit(&g_adc_stream, gAdcCur, now);
+    gAdcCur = gAdcNext;
+    gAdcNext = arduino_adc_ring_reserve(&g_adc_stream);
+    ADC->ADC_RNPR = (uint32_t)gAdcNext;
+    ADC->ADC_RNCR = g_adc_stream.block_len;   // also clears ENDRX
+  }
+}
+
+uint32_t arduino_adc_stream_start(const uint32_t* pins, uint32_t channels, uint32_t rate_hz,
+                                  uint32_t frames, uint32_t blocks, void* storage) {
+  arduino_adc_stream_stop();
+  if (!pins || rate_hz == 0) return ARDUINO_ADC_STREAM_OFF;
+
+  uint32_t seq = 0;
+  for (uint32_t i = 0; i < channels && i < ARDUINO_ADC_STREAM_MAX_CHANNELS; i++) {
+    uint32_t pin = pins[i];
+    if (pin < A0) pin += A0;   // same convention as analogRead(0..11)
+    if (pin >= PINS_COUNT) return ARDUINO_ADC_STREAM_OFF;
+
+    const EAnalogChannel ch = g_APinDescription[pin].ulADCChannelNumber;
+    if (ch == NO_ADC || (uint32_t)ch > 15u) return ARDUINO_ADC_STREAM_OFF;
+    seq |= ((uint32_t)ch & 0xFu) << (4u * i);
+  }
+
+  const uint32_t rc = (VARIANT_MCK / 2u) / rate_hz;   // TIMER_CLOCK1 = MCK/2
+  if (rc < 2u) return ARDUINO_ADC_STREAM_OFF;
+
+  if (!arduino_adc_stream_prepare(storage, channels, frames, blocks)) return ARDUINO_ADC_STREAM_OFF;
+
+  pmc_enable_periph_clk(ID_ADC);
+  pmc_enable_periph_clk(ID_TC0);
+
+  // ADC: user sequence, hardware trigger, PDC.
+  ADC->ADC_PTCR = ADC_PTCR_RXTDIS;
+  ADC->ADC_IDR = 0xFFFFFFFFu;
+  ADC->ADC_CHDR = 0xFFFFu;
+
+  gAdcSavedMr = ADC->ADC_MR;
+  uint32_t mr = gAdcSavedMr & ~(ADC_MR_TRGEN | ADC_MR_TRGSEL_Msk | ADC_MR_FREERUN | ADC_MR_LOWRES | ADC_MR_USEQ);
+  mr |= ADC_MR_TRGEN_EN | ADC_MR_TRGSEL_ADC_TRIG1 | ADC_MR_USEQ;
+  if (gAnalogBits <= 10) mr |= ADC_MR_LOWRES_BITS_10;
+  ADC->ADC_MR = mr;
+  ADC->ADC_SEQR1 = seq;
+  ADC->ADC_CHER = (1u << channels) - 1u;   // USEQ: CHx enables sequence slot x
+
+  adcArm();
+  ADC->ADC_PTCR = ADC_PTCR_RXTEN;
+  ADC->ADC_IER = ADC_IER_ENDRX | ADC_IER_RXBUFF;
+
+  NVIC_ClearPendingIRQ(ADC_IRQn);
+  NVIC_EnableIRQ(ADC_IRQn);
+
+  // TC0 ch0: up to RC, TIOA0 low at RA, high at RC -> one rising edge per frame.
+  TcChannel* tc = &TC0->TC_CHANNEL[0];
+  tc->TC_CCR = TC_CCR_CLKDIS;
+  tc->TC_IDR = 0xFFFFFFFFu;
+  tc->TC_CMR = TC_CMR_TCCLKS_TIMER_CLOCK1 | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC |
+               TC_CMR_ACPA_CLEAR | TC_CMR_ACPC_SET;
+  tc->TC_RC = rc;
+  tc->TC_RA = rc / 2u;
+  tc->TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
+
+  gAdcMode = ARDUINO_ADC_STREAM_DMA;
+  return gAdcMode;
+}
+
+void arduino_adc_stream_stop(void) {
+  if (gAdcMode == ARDUINO_ADC_STREAM_OFF) return;
+
+  TC0->TC_CHANNEL[0].TC_CCR = TC_CCR_CLKDIS;
+  NVIC_DisableIRQ(ADC_IRQn);
+  ADC->ADC_IDR = 0xFFFFFFFFu;
+  ADC->ADC_PTCR = ADC_PTCR_RXTDIS;
+  ADC->ADC_CHDR = 0xFFFFu;
+  ADC->ADC_MR = gAdcSavedMr;
+
+  gAdcCur = nullptr;
+  gAdcNext = nullptr;
+  gAdcMode = ARDUINO_ADC_STREAM_OFF;
+}
+
+uint32_t arduino_adc_stream_mode(void) {
+  return gAdcMode;
+}
+
+// ----------------------
+// Hardware timers
+// ----------------------
+// TC1 ch0..2 and TC2 ch2 (TC3/TC4/TC5/TC8), MCK/2 = 42 MHz, up-to-RC with the RC
+// compare interrupt. TC0 ch0 belongs to the ADC stream; Servo also uses TC1.
+// All four IRQs share the top priority, so one timer ISR never preempts another.
+
+struct DueHwTimer {
+  Tc*       tc;
+  uint32_t  channel;
+  uint32_t  id;
+  IRQn_Type irq;
+};
+
+static const DueHwTimer kHwTimers[] = {
+  { TC1, 0, ID_TC3, TC3_IRQn },
+  { TC1, 1, ID_TC4, TC4_IRQn },
+  { TC1, 2, ID_TC5, TC5_IRQn },
+  { TC2, 2, ID_TC8, TC8_IRQn },
+};
+
+static const uint32_t kHwTimerCount = sizeof(kHwTimers) / sizeof(kHwTimers[0]);
+
+static inline void hwTimerIrq(uint32_t slot) {
+  (void)kHwTimers[slot].tc->TC_CHANNEL[kHwTimers[slot].channel].TC_SR;   // ack CPCS
+  arduino_hwtimer_isr(slot);
+}
+
+void TC3_Handler(void) { hwTimerIrq(0); }
+void TC4_Handler(void) { hwTimerIrq(1); }
+void TC5_Handler(void) { hwTimerIrq(2); }
+void TC8_Handler(void) { hwTimerIrq(3); }
+
+uint32_t arduino_hwtimer_hw_slots(void) {
+  return kHwTimerCount;
+}
+
+uint32_t arduino_hwtimer_hw_open(uint32_t slot, uint32_t period_us) {
+  if (slot >= kHwTimerCount) return 0;
+  const DueHwTimer& t = kHwTimers[slot];
+
+  const uint64_t rc = (uint64_t)(VARIANT_MCK / 2u / 1000000u) * period_us;
+  if (rc < 2u || rc > 0xFFFFFFFFull) return 0;
+
+  pmc_enable_periph_clk(t.id);
+
+  TcChannel* c = &t.tc->TC_CHANNEL[t.channel];
+  c->TC_CCR = TC_CCR_CLKDIS;
+  c->TC_IDR = 0xFFFFFFFFu;
+  c->TC_CMR = TC_CMR_TCCLKS_TIMER_CLOCK1 | TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC;
+  c->TC_RC = (uint32_t)rc;
+  (void)c->TC_SR;
+  c->TC_IER = TC_IER_CPCS;
+
+  NVIC_SetPriority(t.irq, 0);
+  NVIC_ClearPendingIRQ(t.irq);
+  NVIC_EnableIRQ(t.irq);
+
+  c->TC_CCR = TC_CCR_CLKEN | TC_CCR_SWTRG;
+  return 1;
+}
+
+void arduino_hwtimer_hw_close(uint32_t slot) {
+  if (slot >= kHwTimerCount) return;
+  const DueHwTimer& t = kHwTimers[slot];
+
+  TcChannel* c = &t.tc->TC_CHANNEL[t.channel];
+  c->TC_CCR = TC_CCR_CLKDIS;
+  c->TC_IDR = 0xFFFFFFFFu;
+  NVIC_DisableIRQ(t.irq);
+  pmc_disable_periph_clk(t.id);
+}
+
+uint32_t arduino_hwtimer_now_us(void) {
+  return (uint32_t)micros();
+}
+
+// ----------------------
+// I2C master queue (I2CQueue.h: TWI1 + PDC backend)
+// ----------------------
+// Wire's bus (TWI1, SDA 20 / SCL 21), clocked and in master mode after Wire.begin().
+// Writes go out through the PDC and are polled from arduino_i2cq_pump() (the Wire
+// library owns TWI1_Handler): the master transmitter holds SCL low while THR is
+// empty, so a late poll only stretches the bus. Reads need the STOP written
+// before the last byte arrives, which a loop poll cannot guarantee; they and
+// bare probes / STOP_BETWEEN / NO_STOP run on the blocking Wire fallback.
+
+#ifndef DUE_I2CQ_TIMEOUT_MS
+#define DUE_I2CQ_TIMEOUT_MS 50u
+#endif
+
+enum DueI2CQState : uint8_t {
+  kI2CQIdle,
+  kI2CQWrite,       // PDC feeding THR
+  kI2CQWriteStop,   // last byte in THR: STOP once it has gone
+  kI2CQWaitComp,    // STOP sent: wait TXCOMP
+};
+
+static DueI2CQState gI2CQState = kI2CQIdle;
+static uint32_t     gI2CQTxLen = 0;
+static uint32_t     gI2CQStartMs = 0;
+
+static void dueI2cqFinish(int32_t result) {
+  TWI1->TWI_PTCR = TWI_PTCR_TXTDIS | TWI_PTCR_RXTDIS;
+  gI2CQState = kI2CQIdle;
+  arduino_i2cq_complete(result);
+}
+
+uint32_t arduino_i2cq_hw_async(void) {
+  return 1;
+}
+
+uint32_t arduino_i2cq_hw_start(uint8_t address,
+                               const uint8_t* tx, uint32_t txLen,
+                               uint8_t* rx, uint32_t rxLen,
+                               uint32_t flags) {
+  (void)rx;
+  if (gI2CQState != kI2CQIdle) return 0;
+  if (rxLen != 0 || txLen == 0 || !tx) return 0;
+  if (flags & (ARDUINO_I2CQ_STOP_BETWEEN | ARDUINO_I2CQ_NO_STOP)) return 0;
+
+  Twi* t = TWI1;
+  t->TWI_PTCR = TWI_PTCR_TXTDIS | TWI_PTCR_RXTDIS;
+  (void)t->TWI_SR;   // drop a stale NACK
+
+  t->TWI_MMR = TWI_MMR_DADR(address);
+  t->TWI_IADR = 0;
+
+  gI2CQTxLen = txLen;
+  gI2CQStartMs = millis();
+  gI2CQState = kI2CQWrite;
+
+  // The PDC's first store to THR sends START + address.
+  t->TWI_TPR = (uint32_t)tx;
+  t->TWI_TCR = txLen;
+  t->TWI_PTCR = TWI_PTCR_TXTEN;
+  return 1;
+}
+
+void arduino_i2cq_hw_poll(void) {
+  if (gI2CQState == kI2CQIdle) return;
+
+  Twi* t = TWI1;
+  const uint32_t sr = t->TWI_SR;
+
+  if (sr & TWI_SR_NACK) {
+    // The PDC preloads one byte: nothing beyond it means the address was refused.
+    const uint32_t moved = gI2CQTxLen - t->TWI_TCR;
+    dueI2cqFinish(moved <= 1u ? -2 : -3);
+    return;
+  }
+
+  switch (gI2CQState) {
+  case kI2CQWrite:
+    if (sr & TWI_SR_ENDTX) {
+      t->TWI_PTCR = TWI_PTCR_TXTDIS;
+      gI2CQState = kI2CQWriteStop;
+    }
+    break;
+  case kI2CQWriteStop:
+    if (sr & TWI_SR_TXRDY) {
+      t->TWI_CR = TWI_CR_STOP;
+      gI2CQState = kI2CQWaitComp;
+    }
+    break;
+  case kI2CQWaitComp:
+    if (sr & TWI_SR_TXCOMP) {
+      dueI2cqFinish(0);
+      return;
+    }
+    break;
+  default:
+    break;
+  }
+
+  if ((uint32_t)(millis() - gI2CQStartMs) > DUE_I2CQ_TIMEOUT_MS) {
+    t->TWI_CR = TWI_CR_STOP;
+    dueI2cqFinish(-4);
+  }
 }
 
 } // extern "C"
\ No newline at end of file
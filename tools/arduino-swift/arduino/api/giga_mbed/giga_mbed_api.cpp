@@ -6,6 +6,20 @@
 
 #include <Arduino.h>
 #include "giga_mbed_api.h"
+#include "FastIO.h"
+#include "AdcStream.h"
+#include "HwTimer.h"
+#include "CoreLink.h"
+#include "I2CQueue.h"
+#include "drivers/I2C.h"
+#include "pinmap.h"
+#include "PeripheralPins.h"
+
+// RTX thread info (main thread stack bounds for Memory.stats()).
+#if __has_include("rtx_os.h")
+#include "rtx_os.h"
+#define GIGA_HAS_RTX_INFO 1
+#endif
 
 // ----------------------------------------------
 // Analog resolution helpers
@@ -29,18 +43,26 @@ struct SwiftIrqSlot {
   uint8_t  used;
   uint8_t  irqNumber;
   volatile uint8_t fired;
+  volatile uint16_t edges;     // since last consume_edges (saturating)
+  volatile uint32_t lastUs;    // micros() of the latest edge
 };
 
 static SwiftIrqSlot gSlots[ARDUINO_SWIFT_IRQ_SLOTS] = {};
 
-static void irq0() { gSlots[0].fired = 1; }
-static void irq1() { gSlots[1].fired = 1; }
-static void irq2() { gSlots[2].fired = 1; }
-static void irq3() { gSlots[3].fired = 1; }
-static void irq4() { gSlots[4].fired = 1; }
-static void irq5() { gSlots[5].fired = 1; }
-static void irq6() { gSlots[6].fired = 1; }
-static void irq7() { gSlots[7].fired = 1; }
+static inline void irqFire(SwiftIrqSlot& s) {
+  s.lastUs = (uint32_t)micros();
+  if (s.edges != 0xFFFFu) s.edges++;
+  s.fired = 1;
+}
+
+static void irq0() { irqFire(gSlots[0]); }
+static void irq1() { irqFire(gSlots[1]); }
+static void irq2() { irqFire(gSlots[2]); }
+static void irq3() { irqFire(gSlots[3]); }
+static void irq4() { irqFire(gSlots[4]); }
+static void irq5() { irqFire(gSlots[5]); }
+static void irq6() { irqFire(gSlots[6]); }
+static void irq7() { irqFire(gSlots[7]); }
 
 static void (*const gHandlers[ARDUINO_SWIFT_IRQ_SLOTS])() = {
   irq0, irq1, irq2, irq3, irq4, irq5, irq6, irq7
@@ -100,6 +122,8 @@ int32_t arduino_irq_attach(uint32_t pin, uint32_t mode) {
       gSlots[i].used = 1;
       gSlots[i].irqNumber = (uint8_t)irq;
       gSlots[i].fired = 0;
+      gSlots[i].edges = 0;
+      gSlots[i].lastUs = 0;
 
       attachInterrupt((uint8_t)irq, gHandlers[i], (int)mode);
       return (int32_t)i;
@@ -130,6 +154,21 @@ uint32_t arduino_irq_consume(int32_t slot) {
   return (uint32_t)(v ? 1u : 0u);
 }
 
+uint32_t arduino_irq_consume_edges(int32_t slot, uint32_t* last_us) {
+  if (slot < 0 || slot >= (int32_t)ARDUINO_SWIFT_IRQ_SLOTS) return 0;
+  if (!gSlots[slot].used) return 0;
+
+  noInterrupts();
+  const uint16_t n = gSlots[slot].edges;
+  const uint32_t t = gSlots[slot].lastUs;
+  gSlots[slot].edges = 0;
+  gSlots[slot].fired = 0;
+  interrupts();
+
+  if (last_us) *last_us = t;
+  return (uint32_t)n;
+}
+
 // ----------------------
 // Serial
 // ----------------------
@@ -151,7 +190,562 @@ void arduino_serial_print_u32(uint32_t v) {
 }
 
 void arduino_serial_print_f64(double v) {
-  Serial.print(v);
+  Serial.print(v, (int)arduino_serial_float_digits());
+}
+
+uint32_t arduino_serial_float_digits(void) {
+  return 6;
+}
+
+// ----------------------
+// Memory
+// ----------------------
+// Mbed OS: Swift runs on the RTX main thread, whose stack is a static block
+// (the first word is RTX's overflow magic, so it is never painted).
+// The heap (sbrk) lives in [mbed_heap_start, mbed_heap_start + mbed_heap_size).
+
+extern unsigned char* mbed_heap_start;
+extern uint32_t mbed_heap_size;
+extern char* sbrk(int incr);
+
+int arduino_stack_region(uintptr_t* lo, uintptr_t* hi) {
+  if (!lo || !hi) return 0;
+#if defined(GIGA_HAS_RTX_INFO)
+  const osRtxThread_t* t = osRtxInfo.thread.run.curr;
+  if (!t || !t->stack_mem || t->stack_size == 0) return 0;
+  *lo = (uintptr_t)t->stack_mem + 8u;
+  *hi = (uintptr_t)t->stack_mem + t->stack_size;
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+uint32_t arduino_heap_headroom(void) {
+  uintptr_t top = (uintptr_t)sbrk(0);
+  uintptr_t end = (uintptr_t)mbed_heap_start + mbed_heap_size;
+  return (end > top) ? (uint32_t)(end - top) : 0u;
+}
+
+// ----------------------
+// Fast IO
+// ----------------------
+// STM32H7 GPIOx (stride 0x400 from GPIOA): BSRR low half sets, high half resets,
+// IDR input level, ODR output latch.
+
+uint32_t arduino_fastio_resolve(uint32_t pin, uintptr_t* out) {
+  if (!out) return 0;
+
+  PinName pn = digitalPinToPinName((pin_size_t)pin);
+  if (pn == NC) return 0;
+
+  const uint32_t portIndex = STM_PORT(pn);
+  const uint32_t bit = 1u << STM_PIN(pn);
+
+  GPIO_TypeDef* gpio = (GPIO_TypeDef*)(GPIOA_BASE + 0x400u * portIndex);
+
+  out[ARDUINO_FASTIO_SET_REG]  = (uintptr_t)&gpio->BSRR;
+  out[ARDUINO_FASTIO_SET_MASK] = bit;
+  out[ARDUINO_FASTIO_CLR_REG]  = (uintptr_t)&gpio->BSRR;
+  out[ARDUINO_FASTIO_CLR_MASK] = bit << 16;
+  out[ARDUINO_FASTIO_IN_REG]   = (uintptr_t)&gpio->IDR;
+  out[ARDUINO_FASTIO_IN_MASK]  = bit;
+  out[ARDUINO_FASTIO_OUT_REG]  = (uintptr_t)&gpio->ODR;
+  out[ARDUINO_FASTIO_OUT_MASK] = bit;
+  return 1;
+}
+
+// ----------------------
+// ADC stream
+// ----------------------
+// TIM6 TRGO starts one ADC1 regular sequence per frame (pins in caller order).
+// DMA1 stream 1 runs in double-buffer mode (M0AR / M1AR) and writes straight into
+// ring slots: on every transfer-complete the idle address register is pointed at
+// the next reserved block. Only pins whose first PinMap_ADC entry is ADC1 are accepted.
+//
+// Ring storage must live in AXI SRAM (heap / .bss), not DTCM: DMA1 cannot reach it.
+// Blocks are invalidated from the D-cache before they are published.
+// Owns ADC1 + TIM6 while running; analogRead() on ADC1 pins needs a reset afterwards.
+
+static ADC_HandleTypeDef gAdcHandle;
+static uint16_t* gAdcCur = nullptr;
+static uint16_t* gAdcNext = nullptr;
+static uint32_t  gAdcMode = ARDUINO_ADC_STREAM_OFF;
+
+static const uint32_t kAdcRanks[ARDUINO_ADC_STREAM_MAX_CHANNELS] = {
+  ADC_REGULAR_RANK_1, ADC_REGULAR_RANK_2, ADC_REGULAR_RANK_3, ADC_REGULAR_RANK_4,
+  ADC_REGULAR_RANK_5, ADC_REGULAR_RANK_6, ADC_REGULAR_RANK_7, ADC_REGULAR_RANK_8
+};
+
+static uint32_t adcResolution(uint32_t bits) {
+  if (bits <= 8)  return ADC_RESOLUTION_8B;
+  if (bits <= 10) return ADC_RESOLUTION_10B;
+  if (bits <= 12) return ADC_RESOLUTION_12B;
+  if (bits <= 14) return ADC_RESOLUTION_14B;
+  return ADC_RESOLUTION_16B;
+}
+
+static inline void adcCacheInvalidate(void* p, uint32_t bytes) {
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+  if (SCB->CCR & SCB_CCR_DC_Msk) SCB_InvalidateDCache_by_Addr((uint32_t*)p, (int32_t)bytes);
+#else
+  (void)p;
+  (void)bytes;
+#endif
+}
+
+static void adcDmaIsr(void) {
+  const uint32_t flags = DMA1->LISR;
+  DMA1->LIFCR = DMA_LIFCR_CTCIF1 | DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTEIF1 |
+                DMA_LIFCR_CDMEIF1 | DMA_LIFCR_CFEIF1;
+  if (!(flags & DMA_LISR_TCIF1)) return;
+
+  const uint32_t now = micros();
+  adcCacheInvalidate(gAdcCur, g_adc_stream.stride * sizeof(uint16_t));
+  arduino_adc_ring_commit(&g_adc_stream, gAdcCur, now);
+
+  gAdcCur = gAdcNext;
+  gAdcNext = arduino_adc_ring_reserve(&g_adc_stream);
+
+  // CT names the buffer now being filled; the other register is idle.
+  if (DMA1_Stream1->CR & DMA_SxCR_CT) {
+    DMA1_Stream1->M0AR = (uint32_t)gAdcNext;
+  } else {
+    DMA1_Stream1->M1AR = (uint32_t)gAdcNext;
+  }
+}
+
+static uint32_t apbTimerClock(bool apb2) {
+  // APBx timers run at 2x PCLKx whenever the APBx prescaler is not 1.
+  if (apb2) {
+    uint32_t clk = HAL_RCC_GetPCLK2Freq();
+    if ((RCC->D2CFGR & RCC_D2CFGR_D2PPRE2) != 0) clk *= 2u;
+    return clk;
+  }
+  uint32_t clk = HAL_RCC_GetPCLK1Freq();
+  if ((RCC->D2CFGR & RCC_D2CFGR_D2PPRE1) != 0) clk *= 2u;
+  return clk;
+}
+
+uint32_t arduino_adc_stream_start(const uint32_t* pins, uint32_t channels, uint32_t rate_hz,
+                                  uint32_t frames, uint32_t blocks, void* storage) {
+  arduino_adc_stream_stop();
+  if (!pins || rate_hz == 0 || channels == 0 || channels > ARDUINO_ADC_STREAM_MAX_CHANNELS) {
+    return ARDUINO_ADC_STREAM_OFF;
+  }
+
+  uint32_t adcChannel[ARDUINO_ADC_STREAM_MAX_CHANNELS];
+  for (uint32_t i = 0; i < channels; i++) {
+    const PinName pn = digitalPinToPinName((pin_size_t)pins[i]);
+    if (pn == NC) return ARDUINO_ADC_STREAM_OFF;
+    if (pinmap_find_peripheral(pn, PinMap_ADC) != (uint32_t)ADC_1) return ARDUINO_ADC_STREAM_OFF;
+
+    // First analogRead lets mbed set the ADC kernel clock and the pin's analog mode.
+    (void)analogRead(pins[i]);
+    const uint32_t fn = pinmap_find_function(pn, PinMap_ADC);
+    adcChannel[i] = __LL_ADC_DECIMAL_NB_TO_CHANNEL(STM_PIN_CHANNEL(fn));
+  }
+
+  if (!arduino_adc_stream_prepare(storage, channels, frames, blocks)) return ARDUINO_ADC_STREAM_OFF;
+
+  // Whatever the heap left in the cache must not be written back over DMA data.
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+  if (SCB->CCR & SCB_CCR_DC_Msk) {
+    SCB_CleanInvalidateDCache_by_Addr((uint32_t*)storage,
+                                      (int32_t)arduino_adc_stream_bytes(channels, frames, blocks));
+  }
+#endif
+
+  // ADC1: regular sequence on TIM6 TRGO, results to DMA (circular management).
+  __HAL_RCC_ADC12_CLK_ENABLE();
+  gAdcHandle = ADC_HandleTypeDef();
+  gAdcHandle.Instance = ADC1;
+  gAdcHandle.Init.ClockPrescaler = ADC_CLOCK_ASYNC_DIV4;
+  gAdcHandle.Init.Resolution = adcResolution(gAnalogBits);
+  gAdcHandle.Init.ScanConvMode = ADC_SCAN_ENABLE;
+  gAdcHandle.Init.EOCSelection = ADC_EOC_SEQ_CONV;
+  gAdcHandle.Init.LowPowerAutoWait = DISABLE;
+  gAdcHandle.Init.ContinuousConvMode = DISABLE;
+  gAdcHandle.Init.NbrOfConversion = channels;
+  gAdcHandle.Init.DiscontinuousConvMode = DISABLE;
+  gAdcHandle.Init.ExternalTrigConv = ADC_EXTERNALTRIG_T6_TRGO;
+  gAdcHandle.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_RISING;
+  gAdcHandle.Init.ConversionDataManagement = ADC_CONVERSIONDATA_DMA_CIRCULAR;
+  gAdcHandle.Init.Overrun = ADC_OVR_DATA_OVERWRITTEN;
+  gAdcHandle.Init.LeftBitShift = ADC_LEFTBITSHIFT_NONE;
+  gAdcHandle.Init.OversamplingMode = DISABLE;
+  if (HAL_ADC_Init(&gAdcHandle) != HAL_OK) return ARDUINO_ADC_STREAM_OFF;
+  HAL_ADCEx_Calibration_Start(&gAdcHandle, ADC_CALIB_OFFSET, ADC_SINGLE_ENDED);
+
+  for (uint32_t i = 0; i < channels; i++) {
+    ADC_ChannelConfTypeDef c = {};
+    c.Channel = adcChannel[i];
+    c.Rank = kAdcRanks[i];
+    c.SamplingTime = ADC_SAMPLETIME_16CYCLES_5;
+    c.SingleDiff = ADC_SINGLE_ENDED;
+    c.OffsetNumber = ADC_OFFSET_NONE;
+    if (HAL_ADC_ConfigChannel(&gAdcHandle, &c) != HAL_OK) {
+      // Nothing else is armed yet: just release the ADC so analogRead() works again.
+      HAL_ADC_DeInit(&gAdcHandle);
+      return ARDUINO_ADC_STREAM_OFF;
+    }
+  }
+
+  // DMA1 stream 1 <- DMAMUX1 channel 1 <- ADC1, double buffer into ring slots.
+  __HAL_RCC_DMA1_CLK_ENABLE();
+  DMA_Stream_TypeDef* st = DMA1_Stream1;
+  st->CR = 0;
+  while (st->CR & DMA_SxCR_EN) {}
+  DMA1->LIFCR = DMA_LIFCR_CTCIF1 | DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTEIF1 |
+                DMA_LIFCR_CDMEIF1 | DMA_LIFCR_CFEIF1;
+  DMAMUX1_Channel1->CCR = DMA_REQUEST_ADC1;
+
+  gAdcCur = arduino_adc_ring_reserve(&g_adc_stream);
+  gAdcNext = arduino_adc_ring_reserve(&g_adc_stream);
+  st->PAR = (uint32_t)&ADC1->DR;
+  st->M0AR = (uint32_t)gAdcCur;
+  st->M1AR = (uint32_t)gAdcNext;
+  st->NDTR = g_adc_stream.block_len;
+  st->FCR = 0;   // direct mode
+  st->CR = DMA_SxCR_DBM | DMA_SxCR_CIRC | DMA_SxCR_MINC | DMA_SxCR_PSIZE_0 |
+           DMA_SxCR_MSIZE_0 | DMA_SxCR_PL_1 | DMA_SxCR_TCIE;
+
+  NVIC_SetVector(DMA1_Stream1_IRQn, (uint32_t)&adcDmaIsr);
+  NVIC_ClearPendingIRQ(DMA1_Stream1_IRQn);
+  NVIC_EnableIRQ(DMA1_Stream1_IRQn);
+  st->CR |= DMA_SxCR_EN;
+
+  if (HAL_ADC_Start(&gAdcHandle) != HAL_OK) {
+    arduino_adc_stream_stop();
+    return ARDUINO_ADC_STREAM_OFF;
+  }
+
+  // TIM6: update event -> TRGO at rate_hz.
+  __HAL_RCC_TIM6_CLK_ENABLE();
+  const uint32_t clk = apbTimerClock(false);
+  uint32_t psc = 0;
+  uint32_t ticks = clk / rate_hz;
+  while (ticks > 0x10000u) {
+    psc++;
+    ticks = clk / (rate_hz * (psc + 1u));
+  }
+  TIM6->CR1 = 0;
+  TIM6->PSC = psc;
+  TIM6->ARR = (ticks > 1u ? ticks : 2u) - 1u;
+  TIM6->CR2 = TIM_TRGO_UPDATE;
+  TIM6->EGR = TIM_EGR_UG;
+  TIM6->CR1 = TIM_CR1_CEN;
+
+  gAdcMode = ARDUINO_ADC_STREAM_DMA;
+  return gAdcMode;
+}
+
+void arduino_adc_stream_stop(void) {
+  if (gAdcMode == ARDUINO_ADC_STREAM_OFF && gAdcCur == nullptr) return;
+
+  TIM6->CR1 = 0;
+  HAL_ADC_Stop(&gAdcHandle);
+  NVIC_DisableIRQ(DMA1_Stream1_IRQn);
+  DMA1_Stream1->CR = 0;
+  while (DMA1_Stream1->CR & DMA_SxCR_EN) {}
+  HAL_ADC_DeInit(&gAdcHandle);
+
+  gAdcCur = nullptr;
+  gAdcNext = nullptr;
+  gAdcMode = ARDUINO_ADC_STREAM_OFF;
+}
+
+uint32_t arduino_adc_stream_mode(void) {
+  return gAdcMode;
+}
+
+// ----------------------
+// Hardware timers
+// ----------------------
+// 16-bit TIM13 / TIM14 (APB1) and TIM16 / TIM17 (APB2) on update interrupts,
+// handlers installed with NVIC_SetVector. TIM6 belongs to the ADC stream.
+// All four IRQs share one priority, so one timer ISR never preempts another.
+
+struct GigaHwTimer {
+  TIM_TypeDef* tim;
+  IRQn_Type    irq;
+  bool         apb2;
+};
+
+static const GigaHwTimer kHwTimers[] = {
+  { TIM13, TIM8_UP_TIM13_IRQn,      false },
+  { TIM14, TIM8_TRG_COM_TIM14_IRQn, false },
+  { TIM16, TIM16_IRQn,              true  },
+  { TIM17, TIM17_IRQn,              true  },
+};
+
+static const uint32_t kHwTimerCount = sizeof(kHwTimers) / sizeof(kHwTimers[0]);
+
+static inline void hwTimerIrq(uint32_t slot) {
+  TIM_TypeDef* tim = kHwTimers[slot].tim;
+  if (!(tim->SR & TIM_SR_UIF)) return;
+  tim->SR = ~TIM_SR_UIF;
+  arduino_hwtimer_isr(slot);
+}
+
+static void hwTimerIsr0(void) { hwTimerIrq(0); }
+static void hwTimerIsr1(void) { hwTimerIrq(1); }
+static void hwTimerIsr2(void) { hwTimerIrq(2); }
+static void hwTimerIsr3(void) { hwTimerIrq(3); }
+
+static void (*const kHwTimerIsrs[])(void) = {
+  hwTimerIsr0, hwTimerIsr1, hwTimerIsr2, hwTimerIsr3
+};
+
+static void hwTimerClock(uint32_t slot, bool on) {
+  switch (slot) {
+    case 0: if (on) __HAL_RCC_TIM13_CLK_ENABLE(); else __HAL_RCC_TIM13_CLK_DISABLE(); break;
+    case 1: if (on) __HAL_RCC_TIM14_CLK_ENABLE(); else __HAL_RCC_TIM14_CLK_DISABLE(); break;
+    case 2: if (on) __HAL_RCC_TIM16_CLK_ENABLE(); else __HAL_RCC_TIM16_CLK_DISABLE(); break;
+    case 3: if (on) __HAL_RCC_TIM17_CLK_ENABLE(); else __HAL_RCC_TIM17_CLK_DISABLE(); break;
+    default: break;
+  }
+}
+
+uint32_t arduino_hwtimer_hw_slots(void) {
+  return kHwTimerCount;
+}
+
+uint32_t arduino_hwtimer_hw_open(uint32_t slot, uint32_t period_us) {
+  if (slot >= kHwTimerCount) return 0;
+  const GigaHwTimer& t = kHwTimers[slot];
+
+  // Total timer ticks per period, split into PSC x ARR (both 16-bit).
+  const uint64_t total = (uint64_t)apbTimerClock(t.apb2) * period_us / 1000000u;
+  if (total < 2u) return 0;
+  const uint64_t psc = (total - 1u) >> 16;
+  if (psc > 0xFFFFu) return 0;
+  const uint64_t arr = total / (psc + 1u);
+
+  hwTimerClock(slot, true);
+  TIM_TypeDef* tim = t.tim;
+  tim->CR1 = 0;
+  tim->DIER = 0;
+  tim->PSC = (uint32_t)psc;
+  tim->ARR = (uint32_t)(arr - 1u);
+  tim->EGR = TIM_EGR_UG;
+  tim->SR = 0;
+  tim->DIER = TIM_DIER_UIE;
+
+  NVIC_SetVector(t.irq, (uint32_t)kHwTimerIsrs[slot]);
+  NVIC_SetPriority(t.irq, 0);
+  NVIC_ClearPendingIRQ(t.irq);
+  NVIC_EnableIRQ(t.irq);
+
+  tim->CR1 = TIM_CR1_URS | TIM_CR1_CEN;
+  return 1;
+}
+
+void arduino_hwtimer_hw_close(uint32_t slot) {
+  if (slot >= kHwTimerCount) return;
+  const GigaHwTimer& t = kHwTimers[slot];
+
+  t.tim->CR1 = 0;
+  t.tim->DIER = 0;
+  NVIC_DisableIRQ(t.irq);
+  hwTimerClock(slot, false);
+}
+
+uint32_t arduino_hwtimer_now_us(void) {
+  return (uint32_t)micros();
+}
+
+// ----------------------
+// Core link (CoreLink.h: M7 <-> M4 message rings)
+// ----------------------
+// Window: top 16 KB of SRAM4 (D3 domain, reachable from both cores; the mbed
+// RPC / OpenAMP buffers sit at the start of SRAM4). The M7 maps it Normal,
+// non-cacheable, shareable through MPU region 15, so neither core does cache
+// maintenance. The M4 has no D-cache.
+// Notification: hardware semaphores. A 1-step take + release of semaphore 28
+// interrupts the M4 (HSEM2_IRQn), of semaphore 29 the M7 (HSEM1_IRQn).
+// Not for use together with the RPC library, which owns the HSEM IRQ handlers.
+
+#ifndef GIGA_CORELINK_BASE
+#define GIGA_CORELINK_BASE 0x3800C000u   // aligned to GIGA_CORELINK_BYTES
+#endif
+#ifndef GIGA_CORELINK_BYTES
+#define GIGA_CORELINK_BYTES 0x4000u      // power of two
+#endif
+
+#define GIGA_CORELINK_SEM_TO_AUX  28u
+#define GIGA_CORELINK_SEM_TO_MAIN 29u
+
+#if defined(CORE_CM4)
+#define GIGA_CORELINK_SEM_RX GIGA_CORELINK_SEM_TO_AUX
+#define GIGA_CORELINK_SEM_TX GIGA_CORELINK_SEM_TO_MAIN
+#define GIGA_CORELINK_IRQ    HSEM2_IRQn
+#else
+#define GIGA_CORELINK_SEM_RX GIGA_CORELINK_SEM_TO_MAIN
+#define GIGA_CORELINK_SEM_TX GIGA_CORELINK_SEM_TO_AUX
+#define GIGA_CORELINK_IRQ    HSEM1_IRQn
+#endif
+
+static bool gCoreLinkMapped = false;
+
+static void coreLinkIsr(void) {
+#if defined(CORE_CM4)
+  const uint32_t pending = HSEM->C2MISR;
+  HSEM->C2ICR = pending;
+#else
+  const uint32_t pending = HSEM->C1MISR;
+  HSEM->C1ICR = pending;
+#endif
+  if (pending & (1u << GIGA_CORELINK_SEM_RX)) arduino_corelink_isr();
+}
+
+static void coreLinkMapWindow(void) {
+  if (gCoreLinkMapped) return;
+  gCoreLinkMapped = true;
+
+#if !defined(CORE_CM4)
+  // Write back anything the cache still holds for the window before it turns uncached.
+  if (SCB->CCR & SCB_CCR_DC_Msk) {
+    SCB_CleanInvalidateDCache_by_Addr((uint32_t*)GIGA_CORELINK_BASE, (int32_t)GIGA_CORELINK_BYTES);
+  }
+
+  MPU_Region_InitTypeDef r = {};
+  r.Enable           = MPU_REGION_ENABLE;
+  r.Number           = MPU_REGION_NUMBER15;
+  r.BaseAddress      = GIGA_CORELINK_BASE;
+  r.Size             = (uint8_t)(30 - __builtin_clz(GIGA_CORELINK_BYTES));   // 2^(Size+1) bytes
+  r.SubRegionDisable = 0;
+  r.TypeExtField     = MPU_TEX_LEVEL1;
+  r.AccessPermission = MPU_REGION_FULL_ACCESS;
+  r.DisableExec      = MPU_INSTRUCTION_ACCESS_DISABLE;
+  r.IsShareable      = MPU_ACCESS_SHAREABLE;
+  r.IsCacheable      = MPU_ACCESS_NOT_CACHEABLE;
+  r.IsBufferable     = MPU_ACCESS_NOT_BUFFERABLE;
+
+  HAL_MPU_Disable();
+  HAL_MPU_ConfigRegion(&r);
+  HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+#endif
+}
+
+void* arduino_corelink_hw_window(uint32_t* bytes) {
+  coreLinkMapWindow();
+  if (bytes) *bytes = GIGA_CORELINK_BYTES;
+  return (void*)GIGA_CORELINK_BASE;
+}
+
+uint32_t arduino_corelink_hw_core(void) {
+#if defined(CORE_CM4)
+  return ARDUINO_CORELINK_CORE_AUX;
+#else
+  return ARDUINO_CORELINK_CORE_MAIN;
+#endif
+}
+
+void arduino_corelink_hw_listen(void) {
+  __HAL_RCC_HSEM_CLK_ENABLE();
+
+  NVIC_SetVector(GIGA_CORELINK_IRQ, (uint32_t)&coreLinkIsr);
+  NVIC_SetPriority(GIGA_CORELINK_IRQ, 2);
+  NVIC_ClearPendingIRQ(GIGA_CORELINK_IRQ);
+
+  // Sets C1IER on the M7, C2IER on the M4.
+  HAL_HSEM_ActivateNotification(1u << GIGA_CORELINK_SEM_RX);
+  NVIC_EnableIRQ(GIGA_CORELINK_IRQ);
+}
+
+void arduino_corelink_hw_notify(void) {
+  __HAL_RCC_HSEM_CLK_ENABLE();
+  // The release is what raises the listener's interrupt.
+  if (HAL_HSEM_FastTake(GIGA_CORELINK_SEM_TX) == HAL_OK) {
+    HAL_HSEM_Release(GIGA_CORELINK_SEM_TX, 0);
+  }
+}
+
+uint32_t arduino_corelink_hw_boot_aux(void) {
+#if defined(CORE_CM4)
+  return 0;
+#else
+  // The core passes the M4 flash start for the selected split.
+#if defined(CM4_BINARY_START)
+  HAL_SYSCFG_CM4BootAddConfig(SYSCFG_BOOT_ADDR0, CM4_BINARY_START);
+#endif
+  HAL_RCCEx_EnableBootCore(RCC_BOOT_C2);
+  return 1;
+#endif
+}
+
+// ----------------------
+// I2C master queue (I2CQueue.h: mbed asynchronous I2C backend)
+// ----------------------
+// mbed::I2C::transfer() on Wire's pins: interrupt-driven (STM32 HAL IT mode), one
+// call for write + repeated start + read. Started from the loop (mbed takes its
+// bus mutex there); the completion event runs in the I2C IRQ and only records
+// the result. STOP_BETWEEN write+read and bare probes run on the Wire fallback.
+
+#if DEVICE_I2C_ASYNCH
+static mbed::I2C* gI2CQBus = nullptr;
+static uint32_t   gI2CQHz = 0;
+static uint32_t   gI2CQRxLen = 0;
+
+static void i2cqEvent(int event) {
+  if (event & I2C_EVENT_TRANSFER_COMPLETE) {
+    arduino_i2cq_complete((int32_t)gI2CQRxLen);
+  } else if (event & I2C_EVENT_ERROR_NO_SLAVE) {
+    arduino_i2cq_complete(-2);
+  } else if (event & I2C_EVENT_TRANSFER_EARLY_NACK) {
+    arduino_i2cq_complete(-3);
+  } else {
+    arduino_i2cq_complete(-4);
+  }
+}
+#endif
+
+uint32_t arduino_i2cq_hw_async(void) {
+#if DEVICE_I2C_ASYNCH
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+uint32_t arduino_i2cq_hw_start(uint8_t address,
+                               const uint8_t* tx, uint32_t txLen,
+                               uint8_t* rx, uint32_t rxLen,
+                               uint32_t flags) {
+#if DEVICE_I2C_ASYNCH
+  if (txLen == 0 && rxLen == 0) return 0;
+  if (txLen != 0 && rxLen != 0 && (flags & ARDUINO_I2CQ_STOP_BETWEEN)) return 0;
+
+  if (!gI2CQBus) {
+    gI2CQBus = new mbed::I2C(digitalPinToPinName(PIN_WIRE_SDA), digitalPinToPinName(PIN_WIRE_SCL));
+  }
+  const uint32_t hz = arduino_i2cq_clock();
+  if (hz != gI2CQHz) {
+    gI2CQBus->frequency((int)hz);
+    gI2CQHz = hz;
+  }
+
+  gI2CQRxLen = rxLen;
+  const int rc = gI2CQBus->transfer(
+    (int)address << 1,                         // mbed takes 8-bit addresses
+    (const char*)tx, (int)txLen,
+    (char*)rx, (int)rxLen,
+    mbed::callback(i2cqEvent), I2C_EVENT_ALL,
+    (flags & ARDUINO_I2CQ_NO_STOP) != 0);      // repeated: no STOP at the end
+  return rc == 0 ? 1u : 0u;
+#else
+  (void)address;
+  (void)tx;
+  (void)txLen;
+  (void)rx;
+  (void)rxLen;
+  (void)flags;
+  return 0;
+#endif
+}
+
+void arduino_i2cq_hw_poll(void) {
 }
 
 } // extern "C"
\ No newline at end of file
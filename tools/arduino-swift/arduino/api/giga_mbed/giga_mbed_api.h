@@ -8,6 +8,12 @@
 // - Analog
 // - External Interrupts (flag-based polling)
 // - Serial (basic printing)
+// - Memory bounds (stack region, heap headroom)
+// - Fast IO pin handles (direct port registers)
+// - ADC stream (TIM6-triggered ADC1, double-buffered DMA into the block ring)
+// - Hardware timers (TIM13/14/16/17 periodic interrupts)
+// - Core link (SRAM4 message rings between the M7 and M4 images, HSEM notification)
+// - I2C master queue backend (mbed asynchronous I2C, interrupt-driven)
 //
 // Note: On Giga, Serial is typically USB CDC via mbed core; Serial works.
 
@@ -40,6 +46,10 @@ int32_t  arduino_irq_attach(uint32_t pin, uint32_t mode);
 void     arduino_irq_detach(int32_t slot);
 uint32_t arduino_irq_consume(int32_t slot);
 
+// Edges since the last consume (saturates at 65535) + micros() of the latest one.
+// Clears the flag read by arduino_irq_consume() too.
+uint32_t arduino_irq_consume_edges(int32_t slot, uint32_t* last_us);
+
 // ----------------------
 // Serial
 // ----------------------
@@ -48,6 +58,51 @@ void arduino_serial_print_cstr(const char* s);
 void arduino_serial_print_i32(int32_t v);
 void arduino_serial_print_u32(uint32_t v);
 void arduino_serial_print_f64(double v);
+uint32_t arduino_serial_float_digits(void);
+
+// ----------------------
+// Memory (board bounds for SwiftMemory.c / Memory.stats())
+// ----------------------
+int      arduino_stack_region(uintptr_t* lo, uintptr_t* hi);
+uint32_t arduino_heap_headroom(void);
+
+// ----------------------
+// Fast IO (direct port registers, see FastIO.h for the handle layout)
+// ----------------------
+uint32_t arduino_fastio_resolve(uint32_t pin, uintptr_t* out);
+
+// ----------------------
+// ADC stream (continuous sampling into the AdcStream.h block ring)
+// ----------------------
+uint32_t arduino_adc_stream_start(const uint32_t* pins, uint32_t channels, uint32_t rate_hz,
+                                  uint32_t frames, uint32_t blocks, void* storage);
+void     arduino_adc_stream_stop(void);
+uint32_t arduino_adc_stream_mode(void);
+
+// ----------------------
+// Hardware timers (HwTimer.h: board side of the periodic timer slots)
+// ----------------------
+uint32_t arduino_hwtimer_hw_slots(void);
+uint32_t arduino_hwtimer_hw_open(uint32_t slot, uint32_t period_us);
+void     arduino_hwtimer_hw_close(uint32_t slot);
+uint32_t arduino_hwtimer_now_us(void);
+
+// ----------------------
+// Core link (CoreLink.h: board side of the M7 <-> M4 rings)
+// ----------------------
+void*    arduino_corelink_hw_window(uint32_t* bytes);
+uint32_t arduino_corelink_hw_core(void);
+void     arduino_corelink_hw_listen(void);
+void     arduino_corelink_hw_notify(void);
+uint32_t arduino_corelink_hw_boot_aux(void);
+
+// ----------------------
+// I2C master queue (I2CQueue.h: board side, mbed async I2C)
+// ----------------------
+uint32_t arduino_i2cq_hw_async(void);
+uint32_t arduino_i2cq_hw_start(uint8_t address, const uint8_t* tx, uint32_t txLen,
+                               uint8_t* rx, uint32_t rxLen, uint32_t flags);
+void     arduino_i2cq_hw_poll(void);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -8,25 +8,37 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "SwiftHeap.h"
+#include "SwiftMemory.h"
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
 
+int posix_memalign(void **memptr, size_t alignment, size_t size);
+
 void *swift_slowAlloc(size_t size, size_t alignMask) {
-    (void)alignMask;
-    return malloc(size);
+    void *p = NULL;
+    size_t align = alignMask + 1;
+    if (align < sizeof(void *)) align = sizeof(void *);
+    return (posix_memalign(&p, align, size) == 0) ? p : NULL;
 }
 
 void swift_slowDealloc(void *ptr, size_t size, size_t alignMask) {
     (void)size;
     (void)alignMask;
-    free(ptr);
+    free(ptr); // link-wrapped: counted and routed to the TLSF arena when it owns ptr
 }
 
 int posix_memalign(void **memptr, size_t alignment, size_t size) {
-    (void)alignment;
     if (!memptr) return 22; // EINVAL
-    void *p = malloc(size);
+#if defined(ARDUINO_SWIFT_HEAP_TLSF) && ARDUINO_SWIFT_HEAP_TLSF
+    void *h = swift_heap_runtime_alloc(size, alignment);
+    if (h) { swift_mem_note_alloc(h, size); *memptr = h; return 0; }
+#else
+    (void)alignment;
+#endif
+    void *p = malloc(size); // link-wrapped: counted in SwiftMemory.c
     if (!p) return 12; // ENOMEM
     *memptr = p;
     return 0;
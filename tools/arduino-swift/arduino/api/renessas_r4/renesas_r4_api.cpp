@@ -10,6 +10,10 @@
 
 #include <Arduino.h>
 #include "renesas_r4_api.h"
+#include "FastIO.h"
+#include "AdcStream.h"
+#include "HwTimer.h"
+#include "FspTimer.h"
 
 // ----------------------------------------------
 // Analog resolution helpers
@@ -33,18 +37,26 @@ struct SwiftIrqSlot {
   uint8_t  used;
   uint8_t  irqNumber;
   volatile uint8_t fired;
+  volatile uint16_t edges;     // since last consume_edges (saturating)
+  volatile uint32_t lastUs;    // micros() of the latest edge
 };
 
 static SwiftIrqSlot gSlots[ARDUINO_SWIFT_IRQ_SLOTS] = {};
 
-static void irq0() { gSlots[0].fired = 1; }
-static void irq1() { gSlots[1].fired = 1; }
-static void irq2() { gSlots[2].fired = 1; }
-static void irq3() { gSlots[3].fired = 1; }
-static void irq4() { gSlots[4].fired = 1; }
-static void irq5() { gSlots[5].fired = 1; }
-static void irq6() { gSlots[6].fired = 1; }
-static void irq7() { gSlots[7].fired = 1; }
+static inline void irqFire(SwiftIrqSlot& s) {
+  s.lastUs = (uint32_t)micros();
+  if (s.edges != 0xFFFFu) s.edges++;
+  s.fired = 1;
+}
+
+static void irq0() { irqFire(gSlots[0]); }
+static void irq1() { irqFire(gSlots[1]); }
+static void irq2() { irqFire(gSlots[2]); }
+static void irq3() { irqFire(gSlots[3]); }
+static void irq4() { irqFire(gSlots[4]); }
+static void irq5() { irqFire(gSlots[5]); }
+static void irq6() { irqFire(gSlots[6]); }
+static void irq7() { irqFire(gSlots[7]); }
 
 static void (*const gHandlers[ARDUINO_SWIFT_IRQ_SLOTS])() = {
   irq0, irq1, irq2, irq3, irq4, irq5, irq6, irq7
@@ -104,6 +116,8 @@ int32_t arduino_irq_attach(uint32_t pin, uint32_t mode) {
       gSlots[i].used = 1;
       gSlots[i].irqNumber = (uint8_t)irq;
       gSlots[i].fired = 0;
+      gSlots[i].edges = 0;
+      gSlots[i].lastUs = 0;
 
       attachInterrupt((uint8_t)irq, gHandlers[i], (int)mode);
       return (int32_t)i;
@@ -134,6 +148,21 @@ uint32_t arduino_irq_consume(int32_t slot) {
   return (uint32_t)(v ? 1u : 0u);
 }
 
+uint32_t arduino_irq_consume_edges(int32_t slot, uint32_t* last_us) {
+  if (slot < 0 || slot >= (int32_t)ARDUINO_SWIFT_IRQ_SLOTS) return 0;
+  if (!gSlots[slot].used) return 0;
+
+  noInterrupts();
+  const uint16_t n = gSlots[slot].edges;
+  const uint32_t t = gSlots[slot].lastUs;
+  gSlots[slot].edges = 0;
+  gSlots[slot].fired = 0;
+  interrupts();
+
+  if (last_us) *last_us = t;
+  return (uint32_t)n;
+}
+
 // ----------------------
 // Serial
 // ----------------------
@@ -155,7 +184,178 @@ void arduino_serial_print_u32(uint32_t v) {
 }
 
 void arduino_serial_print_f64(double v) {
-  Serial.print(v);
+  Serial.print(v, (int)arduino_serial_float_digits());
+}
+
+uint32_t arduino_serial_float_digits(void) {
+  return 6;
+}
+
+// ----------------------
+// Memory
+// ----------------------
+// RA4M1 (FSP linker script): the main stack is [__StackLimit, __StackTop),
+// the heap (sbrk) is bounded by __HeapLimit.
+
+extern char __StackLimit;
+extern char __StackTop;
+extern char __HeapLimit;
+extern char* sbrk(int incr);
+
+int arduino_stack_region(uintptr_t* lo, uintptr_t* hi) {
+  if (!lo || !hi) return 0;
+  *lo = (uintptr_t)&__StackLimit;
+  *hi = (uintptr_t)&__StackTop;
+  return 1;
+}
+
+uint32_t arduino_heap_headroom(void) {
+  uintptr_t top = (uintptr_t)sbrk(0);
+  uintptr_t end = (uintptr_t)&__HeapLimit;
+  return (end > top) ? (uint32_t)(end - top) : 0u;
+}
+
+// ----------------------
+// Fast IO
+// ----------------------
+// RA4M1 PORTn (stride 0x20): PCNTR3 = POSR (low half) / PORR (high half),
+// PCNTR2 low half = PIDR, PCNTR1 high half = PODR. All accessed as 32-bit words.
+
+uint32_t arduino_fastio_resolve(uint32_t pin, uintptr_t* out) {
+  if (!out || pin >= (uint32_t)(g_pin_cfg_size / sizeof(g_pin_cfg[0]))) return 0;
+
+  const uint32_t pp = (uint32_t)g_pin_cfg[pin].pin;   // bsp_io_port_pin_t: port << 8 | bit
+  const uint32_t portIndex = (pp >> 8) & 0xFFu;
+  const uint32_t bit = 1u << (pp & 0xFFu);
+  if (portIndex > 9u || bit > 0x8000u) return 0;
+
+  R_PORT0_Type* port = (R_PORT0_Type*)((uintptr_t)R_PORT0 + 0x20u * portIndex);
+
+  out[ARDUINO_FASTIO_SET_REG]  = (uintptr_t)&port->PCNTR3;
+  out[ARDUINO_FASTIO_SET_MASK] = bit;
+  out[ARDUINO_FASTIO_CLR_REG]  = (uintptr_t)&port->PCNTR3;
+  out[ARDUINO_FASTIO_CLR_MASK] = bit << 16;
+  out[ARDUINO_FASTIO_IN_REG]   = (uintptr_t)&port->PCNTR2;
+  out[ARDUINO_FASTIO_IN_MASK]  = bit;
+  out[ARDUINO_FASTIO_OUT_REG]  = (uintptr_t)&port->PCNTR1;
+  out[ARDUINO_FASTIO_OUT_MASK] = bit << 16;
+  return 1;
+}
+
+// ----------------------
+// ADC stream
+// ----------------------
+// Timer-ISR fallback: a free GPT/AGT channel (FspTimer) fires at rate_hz and the
+// ISR converts every channel with analogRead() into the block ring. The core
+// keeps the ADC scan-end / DTC vectors behind its own IRQ manager, so there is
+// no DMA path here yet; budget ~20 us of ISR time per channel per frame.
+
+static FspTimer gAdcTimer;
+static uint32_t gAdcPins[ARDUINO_ADC_STREAM_MAX_CHANNELS];
+static uint32_t gAdcChannels = 0;
+static uint32_t gAdcMode = ARDUINO_ADC_STREAM_OFF;
+
+static void adcTimerIsr(timer_callback_args_t* args) {
+  (void)args;
+  const uint32_t now = micros();
+  for (uint32_t i = 0; i < gAdcChannels; i++) {
+    arduino_adc_ring_push(&g_adc_stream, (uint16_t)analogRead(gAdcPins[i]), now);
+  }
+}
+
+uint32_t arduino_adc_stream_start(const uint32_t* pins, uint32_t channels, uint32_t rate_hz,
+                                  uint32_t frames, uint32_t blocks, void* storage) {
+  arduino_adc_stream_stop();
+  if (!pins || rate_hz == 0) return ARDUINO_ADC_STREAM_OFF;
+  if (!arduino_adc_stream_prepare(storage, channels, frames, blocks)) return ARDUINO_ADC_STREAM_OFF;
+
+  for (uint32_t i = 0; i < channels; i++) {
+    gAdcPins[i] = pins[i];
+    (void)analogRead(pins[i]);   // pin mux + ADC open happen outside the ISR
+  }
+  gAdcChannels = channels;
+
+  uint8_t type = 0;
+  const int8_t ch = FspTimer::get_available_timer(type);
+  if (ch < 0) return ARDUINO_ADC_STREAM_OFF;
+
+  if (!gAdcTimer.begin(TIMER_MODE_PERIODIC, type, (uint8_t)ch, (float)rate_hz, 0.0f, adcTimerIsr)) {
+    return ARDUINO_ADC_STREAM_OFF;
+  }
+  if (!gAdcTimer.setup_overflow_irq() || !gAdcTimer.open() || !gAdcTimer.start()) {
+    gAdcTimer.end();
+    return ARDUINO_ADC_STREAM_OFF;
+  }
+
+  gAdcMode = ARDUINO_ADC_STREAM_TIMER;
+  return gAdcMode;
+}
+
+void arduino_adc_stream_stop(void) {
+  if (gAdcMode == ARDUINO_ADC_STREAM_OFF) return;
+
+  gAdcTimer.stop();
+  gAdcTimer.end();
+  gAdcChannels = 0;
+  gAdcMode = ARDUINO_ADC_STREAM_OFF;
+}
+
+uint32_t arduino_adc_stream_mode(void) {
+  return gAdcMode;
+}
+
+// ----------------------
+// Hardware timers
+// ----------------------
+// Each slot takes whichever GPT/AGT channel FspTimer reports free (the ADC stream
+// and PWM compete for the same pool). The FSP callback runs in the timer ISR.
+
+static FspTimer gHwTimers[ARDUINO_HWTIMER_SLOTS];
+static uint8_t  gHwTimerOpen[ARDUINO_HWTIMER_SLOTS] = {};
+
+static void hwTimerCb0(timer_callback_args_t*) { arduino_hwtimer_isr(0); }
+static void hwTimerCb1(timer_callback_args_t*) { arduino_hwtimer_isr(1); }
+static void hwTimerCb2(timer_callback_args_t*) { arduino_hwtimer_isr(2); }
+static void hwTimerCb3(timer_callback_args_t*) { arduino_hwtimer_isr(3); }
+
+static void (*const kHwTimerCbs[])(timer_callback_args_t*) = {
+  hwTimerCb0, hwTimerCb1, hwTimerCb2, hwTimerCb3
+};
+
+static const uint32_t kHwTimerCount = sizeof(kHwTimerCbs) / sizeof(kHwTimerCbs[0]);
+
+uint32_t arduino_hwtimer_hw_slots(void) {
+  return kHwTimerCount;
+}
+
+uint32_t arduino_hwtimer_hw_open(uint32_t slot, uint32_t period_us) {
+  if (slot >= kHwTimerCount || gHwTimerOpen[slot]) return 0;
+
+  uint8_t type = 0;
+  const int8_t ch = FspTimer::get_available_timer(type);
+  if (ch < 0) return 0;
+
+  FspTimer& t = gHwTimers[slot];
+  const float hz = 1000000.0f / (float)period_us;
+  if (!t.begin(TIMER_MODE_PERIODIC, type, (uint8_t)ch, hz, 0.0f, kHwTimerCbs[slot])) return 0;
+  if (!t.setup_overflow_irq(0) || !t.open() || !t.start()) {
+    t.end();
+    return 0;
+  }
+
+  gHwTimerOpen[slot] = 1;
+  return 1;
+}
+
+void arduino_hwtimer_hw_close(uint32_t slot) {
+  if (slot >= kHwTimerCount || !gHwTimerOpen[slot]) return;
+  gHwTimers[slot].stop();
+  gHwTimers[slot].end();
+  gHwTimerOpen[slot] = 0;
+}
+
+uint32_t arduino_hwtimer_now_us(void) {
+  return (uint32_t)micros();
 }
 
 } // extern "C"
\ No newline at end of file
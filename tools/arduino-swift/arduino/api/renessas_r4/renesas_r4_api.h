@@ -7,6 +7,10 @@
 // - Analog
 // - External Interrupts (flag-based polling)
 // - Serial (basic printing)
+// - Memory bounds (stack region, heap headroom)
+// - Fast IO pin handles (direct port registers)
+// - ADC stream (timer ISR analogRead into the block ring)
+// - Hardware timers (FspTimer GPT/AGT periodic interrupts)
 //
 // NOT included here (for now):
 // - SPI (moves to libs/spi later)
@@ -40,6 +44,10 @@ int32_t  arduino_irq_attach(uint32_t pin, uint32_t mode);
 void     arduino_irq_detach(int32_t slot);
 uint32_t arduino_irq_consume(int32_t slot);
 
+// Edges since the last consume (saturates at 65535) + micros() of the latest one.
+// Clears the flag read by arduino_irq_consume() too.
+uint32_t arduino_irq_consume_edges(int32_t slot, uint32_t* last_us);
+
 // ----------------------
 // Serial
 // ----------------------
@@ -48,6 +56,34 @@ void arduino_serial_print_cstr(const char* s);
 void arduino_serial_print_i32(int32_t v);
 void arduino_serial_print_u32(uint32_t v);
 void arduino_serial_print_f64(double v);
+uint32_t arduino_serial_float_digits(void);
+
+// ----------------------
+// Memory (board bounds for SwiftMemory.c / Memory.stats())
+// ----------------------
+int      arduino_stack_region(uintptr_t* lo, uintptr_t* hi);
+uint32_t arduino_heap_headroom(void);
+
+// ----------------------
+// Fast IO (direct port registers, see FastIO.h for the handle layout)
+// ----------------------
+uint32_t arduino_fastio_resolve(uint32_t pin, uintptr_t* out);
+
+// ----------------------
+// ADC stream (continuous sampling into the AdcStream.h block ring)
+// ----------------------
+uint32_t arduino_adc_stream_start(const uint32_t* pins, uint32_t channels, uint32_t rate_hz,
+                                  uint32_t frames, uint32_t blocks, void* storage);
+void     arduino_adc_stream_stop(void);
+uint32_t arduino_adc_stream_mode(void);
+
+// ----------------------
+// Hardware timers (HwTimer.h: board side of the periodic timer slots)
+// ----------------------
+uint32_t arduino_hwtimer_hw_slots(void);
+uint32_t arduino_hwtimer_hw_open(uint32_t slot, uint32_t period_us);
+void     arduino_hwtimer_hw_close(uint32_t slot);
+uint32_t arduino_hwtimer_now_us(void);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -0,0 +1,161 @@
+// AdcStream.c
+// Block ring + board-independent stream ABI (see AdcStream.h).
+//
+// Ordering: the producer writes samples and the stamp, then publishes head;
+// the consumer reads head before touching the block, then publishes tail.
+// __sync_synchronize() is a DMB on Cortex-M (and a full fence on the host).
+
+#include "AdcStream.h"
+
+#include <string.h>
+
+#define ADC_ALIGN        32u
+#define ADC_STRIDE_MASK  (ADC_ALIGN / sizeof(uint16_t) - 1u)
+
+static inline uint32_t round_up(uint32_t v, uint32_t a) {
+  return (v + a - 1u) & ~(a - 1u);
+}
+
+static inline uint16_t* scratch_of(const arduino_adc_ring_t* r) {
+  return r->samples + (r->mask + 1u) * r->stride;
+}
+
+// ----------------------
+// Block ring
+// ----------------------
+
+uint32_t arduino_adc_ring_bytes(uint32_t block_len, uint32_t blocks) {
+  const uint32_t stride = (block_len + ADC_STRIDE_MASK) & ~ADC_STRIDE_MASK;
+  return round_up(blocks * (uint32_t)sizeof(uint32_t), ADC_ALIGN)
+       + (blocks + 1u) * stride * (uint32_t)sizeof(uint16_t);
+}
+
+uint32_t arduino_adc_ring_init(arduino_adc_ring_t* r, void* storage, uint32_t block_len, uint32_t blocks) {
+  if (!r || !storage || block_len == 0) return 0;
+  if (blocks < 2u || (blocks & (blocks - 1u)) != 0) return 0;
+
+  uint8_t* base = (uint8_t*)storage;
+  memset(r, 0, sizeof(*r));
+  r->stamps = (uint32_t*)base;
+  r->samples = (uint16_t*)(base + round_up(blocks * (uint32_t)sizeof(uint32_t), ADC_ALIGN));
+  r->block_len = block_len;
+  r->stride = (block_len + ADC_STRIDE_MASK) & ~ADC_STRIDE_MASK;
+  r->mask = blocks - 1u;
+  return 1;
+}
+
+uint16_t* arduino_adc_ring_reserve(arduino_adc_ring_t* r) {
+  // A stale tail only makes the ring look fuller than it is.
+  const uint32_t next = r->head + r->reserved;
+  if (next - r->tail > r->mask) return scratch_of(r);
+
+  r->reserved++;
+  return r->samples + (next & r->mask) * r->stride;
+}
+
+void arduino_adc_ring_commit(arduino_adc_ring_t* r, uint16_t* block, uint32_t stamp_us) {
+  r->total++;
+  if (block == scratch_of(r)) {
+    r->overruns++;
+    return;
+  }
+
+  // Reservations complete in order: this is always slot `head`.
+  const uint32_t h = r->head;
+  r->stamps[h & r->mask] = stamp_us;
+  r->reserved--;
+  __sync_synchronize();
+  r->head = h + 1u;
+}
+
+void arduino_adc_ring_push(arduino_adc_ring_t* r, uint16_t sample, uint32_t stamp_us) {
+  if (!r->fill_block) {
+    r->fill_block = arduino_adc_ring_reserve(r);
+    r->fill = 0;
+  }
+
+  r->fill_block[r->fill++] = sample;
+  if (r->fill == r->block_len) {
+    arduino_adc_ring_commit(r, r->fill_block, stamp_us);
+    r->fill_block = 0;
+  }
+}
+
+uint32_t arduino_adc_ring_available(const arduino_adc_ring_t* r) {
+  return r->head - r->tail;
+}
+
+const uint16_t* arduino_adc_ring_peek(const arduino_adc_ring_t* r, uint32_t* stamp_us) {
+  const uint32_t t = r->tail;
+  if (r->head == t) return 0;
+  __sync_synchronize();
+
+  if (stamp_us) *stamp_us = r->stamps[t & r->mask];
+  return r->samples + (t & r->mask) * r->stride;
+}
+
+void arduino_adc_ring_release(arduino_adc_ring_t* r) {
+  if (r->head == r->tail) return;
+  __sync_synchronize();
+  r->tail = r->tail + 1u;
+}
+
+// ----------------------
+// Board engine
+// ----------------------
+
+arduino_adc_ring_t g_adc_stream;
+
+uint32_t arduino_adc_stream_prepare(void* storage, uint32_t channels, uint32_t frames, uint32_t blocks) {
+  if (channels == 0 || channels > ARDUINO_ADC_STREAM_MAX_CHANNELS || frames == 0) return 0;
+  if (((uintptr_t)storage & (ADC_ALIGN - 1u)) != 0) return 0;
+  return arduino_adc_ring_init(&g_adc_stream, storage, channels * frames, blocks);
+}
+
+// ----------------------
+// Board hooks (weak defaults: unsupported)
+// ----------------------
+
+__attribute__((weak))
+uint32_t arduino_adc_stream_start(const uint32_t* pins, uint32_t channels, uint32_t rate_hz,
+                                  uint32_t frames, uint32_t blocks, void* storage) {
+  (void)pins;
+  (void)channels;
+  (void)rate_hz;
+  (void)frames;
+  (void)blocks;
+  (void)storage;
+  return ARDUINO_ADC_STREAM_OFF;
+}
+
+__attribute__((weak))
+void arduino_adc_stream_stop(void) {
+}
+
+__attribute__((weak))
+uint32_t arduino_adc_stream_mode(void) {
+  return ARDUINO_ADC_STREAM_OFF;
+}
+
+// ----------------------
+// C ABI
+// ----------------------
+
+uint32_t arduino_adc_stream_bytes(uint32_t channels, uint32_t frames, uint32_t blocks) {
+  return arduino_adc_ring_bytes(channels * frames, blocks);
+}
+
+uint32_t arduino_adc_stream_available(void) {
+  return arduino_adc_ring_available(&g_adc_stream);
+}
+
+const uint16_t* arduino_adc_stream_peek(uint32_t* stamp_us) {
+  return arduino_adc_ring_peek(&g_adc_stream, stamp_us);
+}
+
+void arduino_adc_stream_release(void) {
+  arduino_adc_ring_release(&g_adc_stream);
+}
+
+uint32_t arduino_adc_stream_overruns(void) { return g_adc_stream.overruns; }
+uint32_t arduino_adc_stream_total(void)    { return g_adc_stream.total; }
@@ -0,0 +1,101 @@
+// AdcStream.h
+// Continuous ADC sampling into a block ring (C ABI consumed by AnalogStream.swift).
+//
+// Rules:
+// - Pure C, no Arduino.h: the ring logic builds and runs on the host.
+// - One producer (DMA-complete ISR or timer ISR), one consumer (Swift loop).
+// - Samples are uint16_t, frames interleaved in pin order: c0 c1 .. cN-1 c0 c1 ..
+// - A block = frames_per_block frames + the micros() stamp of its LAST frame.
+// - Ring full: the producer is handed a scratch block and the finished block is
+//   dropped (overrun counted). Queued blocks are never overwritten.
+// - DMA engines write straight into ring slots (reserve / commit). Blocks are
+//   padded to 32 bytes so STM32H7 D-cache maintenance never touches a neighbour.
+// - Not built on SpscRing.h: DMA holds two reservations at once and a full ring
+//   hands out the scratch block, neither of which an element ring expresses.
+// - Storage is caller-owned: arduino_adc_stream_bytes() bytes, 32-byte aligned.
+// - Hardware setup is board-specific (api/<api_name>/): arduino_adc_stream_start()
+//   and arduino_adc_stream_stop(). The weak defaults in AdcStream.c report OFF.
+
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ARDUINO_ADC_STREAM_MAX_CHANNELS 8u
+
+// arduino_adc_stream_start() / arduino_adc_stream_mode() results.
+enum {
+  ARDUINO_ADC_STREAM_OFF = 0,
+  ARDUINO_ADC_STREAM_DMA,     // hardware-triggered conversions moved by DMA / PDC
+  ARDUINO_ADC_STREAM_TIMER    // analogRead() per channel from a periodic timer ISR
+};
+
+// ----------------------
+// Block ring
+// ----------------------
+typedef struct {
+  uint16_t* samples;          // (blocks + 1) * stride; the last block is scratch
+  uint32_t* stamps;           // blocks
+  uint32_t  block_len;        // samples per block
+  uint32_t  stride;           // block_len rounded up to 16 samples (32 bytes)
+  uint32_t  mask;             // blocks - 1 (blocks is a power of two)
+
+  volatile uint32_t head;     // blocks committed (producer)
+  volatile uint32_t tail;     // blocks released (consumer)
+  uint32_t  reserved;         // slots handed to the producer, not yet committed
+  volatile uint32_t overruns; // blocks dropped because the ring was full
+  volatile uint32_t total;    // blocks produced (committed + dropped)
+
+  uint16_t* fill_block;       // push(): block being filled
+  uint32_t  fill;             // push(): samples already in fill_block
+} arduino_adc_ring_t;
+
+uint32_t arduino_adc_ring_bytes(uint32_t block_len, uint32_t blocks);
+
+// Returns 0 on bad arguments (blocks must be a power of two >= 2).
+uint32_t arduino_adc_ring_init(arduino_adc_ring_t* r, void* storage, uint32_t block_len, uint32_t blocks);
+
+// Producer, zero copy: DMA fills reserved blocks in order, commit() in the same order.
+uint16_t* arduino_adc_ring_reserve(arduino_adc_ring_t* r);
+void      arduino_adc_ring_commit(arduino_adc_ring_t* r, uint16_t* block, uint32_t stamp_us);
+
+// Producer, one sample at a time (timer ISR fallback). The block is committed
+// with the stamp of its last sample.
+void      arduino_adc_ring_push(arduino_adc_ring_t* r, uint16_t sample, uint32_t stamp_us);
+
+// Consumer.
+uint32_t        arduino_adc_ring_available(const arduino_adc_ring_t* r);
+const uint16_t* arduino_adc_ring_peek(const arduino_adc_ring_t* r, uint32_t* stamp_us);
+void            arduino_adc_ring_release(arduino_adc_ring_t* r);
+
+// ----------------------
+// Board engine (one stream per board)
+// ----------------------
+extern arduino_adc_ring_t g_adc_stream;
+
+// Called by the board start() before arming the hardware: validates the shape
+// and formats `storage` as the ring. Returns 0 on bad arguments.
+uint32_t arduino_adc_stream_prepare(void* storage, uint32_t channels, uint32_t frames, uint32_t blocks);
+
+// Board hooks (api/<api_name>/, weak defaults in AdcStream.c).
+// rate_hz is the frame rate (every channel is converted once per frame).
+uint32_t arduino_adc_stream_start(const uint32_t* pins, uint32_t channels, uint32_t rate_hz,
+                                  uint32_t frames, uint32_t blocks, void* storage);
+void     arduino_adc_stream_stop(void);
+uint32_t arduino_adc_stream_mode(void);
+
+// ----------------------
+// C ABI (Swift)
+// ----------------------
+uint32_t        arduino_adc_stream_bytes(uint32_t channels, uint32_t frames, uint32_t blocks);
+uint32_t        arduino_adc_stream_available(void);
+const uint16_t* arduino_adc_stream_peek(uint32_t* stamp_us);
+void            arduino_adc_stream_release(void);
+uint32_t        arduino_adc_stream_overruns(void);
+uint32_t        arduino_adc_stream_total(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -3,7 +3,7 @@
 //
 // Notes:
 // - Only uses <Arduino.h>.
-// - No Serial / Analog / IRQ / SPI here.
+// - No Serial printing / Analog / IRQ / SPI here.
 
 #include <Arduino.h>
 #include "ArduinoSwiftShim.h"
@@ -36,6 +36,50 @@ uint32_t arduino_millis(void) {
   return (uint32_t)millis();
 }
 
+static uint32_t gMicrosLast = 0;
+static uint32_t gMicrosHigh = 0;
+
+uint64_t arduino_micros(void) {
+  // PRIMASK save/restore: safe from ISRs and from code that already masked IRQs.
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  const uint32_t now = (uint32_t)micros();
+  if (now < gMicrosLast) gMicrosHigh++;
+  gMicrosLast = now;
+  const uint64_t t = ((uint64_t)gMicrosHigh << 32) | now;
+
+  __set_PRIMASK(primask);
+  return t;
+}
+
+void arduino_delay_us(uint32_t us) {
+  // Cores take an unsigned int and some misbehave on large values: chunk per ms.
+  while (us > 1000u) {
+    delayMicroseconds(1000u);
+    us -= 1000u;
+  }
+  if (us) delayMicroseconds((unsigned int)us);
+}
+
+// ----------------------
+// Serial RX
+// ----------------------
+int32_t arduino_serial_available(void) {
+  return (int32_t)Serial.available();
+}
+
+uint32_t arduino_serial_read_buf(uint8_t* out, uint32_t cap) {
+  if (!out || cap == 0) return 0;
+
+  int avail = Serial.available();
+  if (avail <= 0) return 0;
+  if ((uint32_t)avail < cap) cap = (uint32_t)avail;
+
+  // Capped to available(), so readBytes() never waits on its Stream timeout.
+  return (uint32_t)Serial.readBytes((char*)out, (size_t)cap);
+}
+
 // ----------------------
 // Constants
 // ----------------------
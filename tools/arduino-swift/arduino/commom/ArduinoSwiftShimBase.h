@@ -3,7 +3,8 @@
 //
 // Rules:
 // - ONLY truly universal Arduino APIs live here.
-// - No Serial / Analog / IRQ / SPI here.
+// - No Serial printing / Analog / IRQ / SPI here (Serial RX only uses the
+//   Stream API every core has).
 // - No board assumptions.
 // - No logic in headers.
 //
@@ -29,6 +30,19 @@ uint32_t arduino_digitalRead(uint32_t pin);
 void     arduino_delay_ms(uint32_t ms);
 uint32_t arduino_millis(void);
 
+// 64-bit monotonic micros(): extends the core's 32-bit counter across its
+// ~71.6 min wrap. Must be called at least once per wrap period (any caller).
+uint64_t arduino_micros(void);
+void     arduino_delay_us(uint32_t us);
+
+// ----------------------
+// Serial RX (universal, non-blocking)
+// ----------------------
+int32_t  arduino_serial_available(void);
+
+// Reads at most min(cap, available()) bytes; never waits.
+uint32_t arduino_serial_read_buf(uint8_t* out, uint32_t cap);
+
 // ----------------------
 // Constants (universal)
 // ----------------------
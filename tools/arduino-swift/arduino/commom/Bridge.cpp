@@ -8,6 +8,7 @@
 
 #include <Arduino.h>
 #include "ArduinoSwiftShim.h"
+#include "SwiftMemory.h"
 
 extern "C" {
 
@@ -26,6 +27,9 @@ void setup() {
   if (gSwiftDidStart) return;
   gSwiftDidStart = true;
 
+  // Paint the unused stack first so Memory.stats() can report the high-water mark.
+  arduino_mem_paint_stack();
+
   if (arduino_swift_setup) {
     arduino_swift_setup();
   }
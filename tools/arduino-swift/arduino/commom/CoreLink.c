@@ -0,0 +1,255 @@
+// CoreLink.c
+// Shared window layout + SPSC message rings (see CoreLink.h).
+
+#include "CoreLink.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define SLOT_MASK (ARDUINO_CORELINK_SLOTS - 1u)
+#define LINK_MAGIC 0x4B4E4C43u   // "CLNK"
+
+#if (ARDUINO_CORELINK_SLOTS & SLOT_MASK) != 0
+#error "ARDUINO_CORELINK_SLOTS must be a power of two"
+#endif
+
+#if (ARDUINO_CORELINK_SLOT_BYTES % 4u) != 0 || ARDUINO_CORELINK_SLOT_BYTES < 8u
+#error "ARDUINO_CORELINK_SLOT_BYTES must be a multiple of 4 (>= 8)"
+#endif
+
+// One 32-byte line per writer.
+typedef struct {
+  volatile uint32_t head;       // producer
+  volatile uint32_t dropped;    // producer
+  uint32_t pad0[6];
+  volatile uint32_t tail;       // consumer
+  uint32_t pad1[7];
+  uint8_t  slots[ARDUINO_CORELINK_SLOTS][ARDUINO_CORELINK_SLOT_BYTES];
+} corelink_ring_t;
+
+typedef struct {
+  volatile uint32_t magic;
+  uint32_t slot_bytes;
+  uint32_t slots;
+  uint32_t pad[5];
+  corelink_ring_t ring[2];      // [0] main -> aux, [1] aux -> main
+} corelink_window_t;
+
+static corelink_window_t* g_link;
+static corelink_ring_t*   g_tx;
+static corelink_ring_t*   g_rx;
+static uint8_t            g_formatted;
+static volatile uint32_t  g_signals;       // ISR only
+static uint32_t           g_signals_seen;  // loop only
+
+// ----------------------
+// Board hooks (weak defaults: single core, loopback)
+// ----------------------
+
+static corelink_window_t g_local_window __attribute__((aligned(32)));
+
+__attribute__((weak))
+void* arduino_corelink_hw_window(uint32_t* bytes) {
+  if (bytes) *bytes = 0;
+  return NULL;
+}
+
+__attribute__((weak))
+uint32_t arduino_corelink_hw_core(void) {
+  return ARDUINO_CORELINK_CORE_MAIN;
+}
+
+__attribute__((weak))
+void arduino_corelink_hw_listen(void) {
+}
+
+__attribute__((weak))
+void arduino_corelink_hw_notify(void) {
+  // Loopback: the "other core" is this one.
+  g_signals++;
+}
+
+__attribute__((weak))
+uint32_t arduino_corelink_hw_boot_aux(void) {
+  return 0;
+}
+
+void arduino_corelink_isr(void) {
+  g_signals++;
+}
+
+uint32_t arduino_corelink_window_bytes(void) {
+  return (uint32_t)sizeof(corelink_window_t);
+}
+
+// ----------------------
+// Internals
+// ----------------------
+
+static corelink_window_t* resolve_window(void) {
+  uint32_t bytes = 0;
+  void* w = arduino_corelink_hw_window(&bytes);
+  if (w && bytes >= sizeof(corelink_window_t) && ((uintptr_t)w & 31u) == 0) {
+    return (corelink_window_t*)w;
+  }
+  return NULL;
+}
+
+static uint32_t bind_rings(corelink_window_t* w, uint32_t shared) {
+  if (!shared) {
+    g_tx = &w->ring[0];
+    g_rx = &w->ring[0];
+  } else if (arduino_corelink_hw_core() == ARDUINO_CORELINK_CORE_MAIN) {
+    g_tx = &w->ring[0];
+    g_rx = &w->ring[1];
+  } else {
+    g_tx = &w->ring[1];
+    g_rx = &w->ring[0];
+  }
+  g_link = w;
+  arduino_corelink_hw_listen();
+  return 1;
+}
+
+static inline uint8_t* slot_at(corelink_ring_t* r, uint32_t index) {
+  return r->slots[index & SLOT_MASK];
+}
+
+// ----------------------
+// C ABI
+// ----------------------
+
+uint32_t arduino_corelink_open(void) {
+  if (g_link) return 1;
+
+  corelink_window_t* w = resolve_window();
+  const uint32_t shared = (w != NULL);
+  if (!w) w = &g_local_window;
+
+  if (!shared || arduino_corelink_hw_core() == ARDUINO_CORELINK_CORE_MAIN) {
+    // The window survives a main-core reset: always reformat once per boot,
+    // header last so the aux core never sees a half-initialised ring.
+    if (!g_formatted) {
+      w->magic = 0;
+      __sync_synchronize();
+      memset(w->ring, 0, sizeof(w->ring));
+      w->slot_bytes = ARDUINO_CORELINK_SLOT_BYTES;
+      w->slots = ARDUINO_CORELINK_SLOTS;
+      __sync_synchronize();
+      w->magic = LINK_MAGIC;
+      g_formatted = 1;
+    }
+    return bind_rings(w, shared);
+  }
+
+  // Aux: wait for the main core's header (and matching build settings).
+  if (w->magic != LINK_MAGIC) return 0;
+  __sync_synchronize();
+  if (w->slot_bytes != ARDUINO_CORELINK_SLOT_BYTES || w->slots != ARDUINO_CORELINK_SLOTS) return 0;
+  return bind_rings(w, shared);
+}
+
+uint32_t arduino_corelink_core(void) {
+  return resolve_window() ? arduino_corelink_hw_core() : ARDUINO_CORELINK_CORE_MAIN;
+}
+
+uint32_t arduino_corelink_is_dual(void) {
+  return resolve_window() != NULL;
+}
+
+uint32_t arduino_corelink_boot_aux(void) {
+  if (!resolve_window() || arduino_corelink_hw_core() != ARDUINO_CORELINK_CORE_MAIN) return 0;
+  // The aux core looks for the header as soon as it runs.
+  if (!arduino_corelink_open()) return 0;
+  return arduino_corelink_hw_boot_aux();
+}
+
+uint32_t arduino_corelink_payload_max(void) {
+  return ARDUINO_CORELINK_PAYLOAD_MAX;
+}
+
+uint8_t* arduino_corelink_reserve(void) {
+  corelink_ring_t* r = g_tx;
+  if (!r) return NULL;
+
+  const uint32_t h = r->head;
+  if (h - r->tail > SLOT_MASK) {
+    r->dropped++;
+    return NULL;
+  }
+  return slot_at(r, h) + 4u;
+}
+
+void arduino_corelink_commit(uint32_t len) {
+  corelink_ring_t* r = g_tx;
+  if (!r) return;
+  if (len > ARDUINO_CORELINK_PAYLOAD_MAX) len = ARDUINO_CORELINK_PAYLOAD_MAX;
+
+  const uint32_t h = r->head;
+  if (h - r->tail > SLOT_MASK) return;   // no reserve() before this commit
+
+  uint8_t* s = slot_at(r, h);
+  memcpy(s, &len, 4u);
+
+  // Empty before this message: the consumer may be idle, wake it.
+  const uint32_t was_empty = (r->tail == h);
+  __sync_synchronize();
+  r->head = h + 1u;
+  __sync_synchronize();
+
+  if (was_empty) arduino_corelink_hw_notify();
+}
+
+uint32_t arduino_corelink_send(const uint8_t* data, uint32_t len) {
+  if (len > ARDUINO_CORELINK_PAYLOAD_MAX) return 0;
+
+  uint8_t* p = arduino_corelink_reserve();
+  if (!p) return 0;
+
+  if (len && data) memcpy(p, data, len);
+  arduino_corelink_commit(len);
+  return 1;
+}
+
+const uint8_t* arduino_corelink_peek(uint32_t* len) {
+  corelink_ring_t* r = g_rx;
+  if (!r) return NULL;
+
+  const uint32_t t = r->tail;
+  if (r->head == t) return NULL;
+  __sync_synchronize();
+
+  const uint8_t* s = slot_at(r, t);
+  uint32_t n;
+  memcpy(&n, s, 4u);
+  if (n > ARDUINO_CORELINK_PAYLOAD_MAX) n = ARDUINO_CORELINK_PAYLOAD_MAX;
+  if (len) *len = n;
+  return s + 4u;
+}
+
+void arduino_corelink_release(void) {
+  corelink_ring_t* r = g_rx;
+  if (!r) return;
+
+  const uint32_t t = r->tail;
+  if (r->head == t) return;
+  __sync_synchronize();
+  r->tail = t + 1u;
+}
+
+uint32_t arduino_corelink_available(void) {
+  corelink_ring_t* r = g_rx;
+  return r ? (r->head - r->tail) : 0u;
+}
+
+uint32_t arduino_corelink_signals(void) {
+  const uint32_t now = g_signals;
+  const uint32_t n = now - g_signals_seen;
+  g_signals_seen = now;
+  return n;
+}
+
+uint32_t arduino_corelink_dropped(void) {
+  corelink_ring_t* r = g_tx;
+  return r ? r->dropped : 0u;
+}
@@ -0,0 +1,107 @@
+// CoreLink.h
+// Inter-core message rings in shared memory (C ABI consumed by CoreLink.swift).
+//
+// Rules:
+// - Pure C, no Arduino.h (the ring logic also builds on the host).
+// - Two lock-free single-producer / single-consumer rings of fixed slots:
+//   ring 0 main -> aux, ring 1 aux -> main. Each core only ever writes the head
+//   of the ring it produces into and the tail of the ring it consumes.
+// - Head / tail live on their own 32-byte lines (Cortex-M7 cache line), so the
+//   two cores never write the same line. This is why the rings do not use
+//   SpscRing.h: its control block packs head, tail and a buffer pointer together,
+//   and the window layout is shared between two separately built images.
+// - A slot is [u32 length][payload]; reserve() / commit() let the producer fill
+//   the payload in place, peek() / release() let the consumer read it in place.
+// - The main core formats the window in open(); the aux core's open() returns 1
+//   once it sees the formatted header.
+// - Notification is a wake-up hint: commit() signals the other core only when
+//   the ring was empty, the consumer always polls until it is empty again.
+// - Hardware is board-specific (api/<api_name>/): arduino_corelink_hw_*().
+//   The weak defaults in CoreLink.c use a private RAM window and map both
+//   directions onto ring 0, so single-core boards get a loopback.
+
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bytes per slot, including the 4-byte length (multiple of 4).
+#ifndef ARDUINO_CORELINK_SLOT_BYTES
+#define ARDUINO_CORELINK_SLOT_BYTES 64u
+#endif
+
+// Slots per direction (power of two).
+#ifndef ARDUINO_CORELINK_SLOTS
+#define ARDUINO_CORELINK_SLOTS 64u
+#endif
+
+#define ARDUINO_CORELINK_PAYLOAD_MAX (ARDUINO_CORELINK_SLOT_BYTES - 4u)
+
+#define ARDUINO_CORELINK_CORE_MAIN 0u   // Giga: Cortex-M7 (single-core boards: the only core)
+#define ARDUINO_CORELINK_CORE_AUX  1u   // Giga: Cortex-M4
+
+// ----------------------
+// Board hooks (api/<api_name>/, weak defaults in CoreLink.c)
+// ----------------------
+
+// Shared window both cores can address (uncached on cores with a D-cache).
+// Returns NULL when the board has a single core.
+void*    arduino_corelink_hw_window(uint32_t* bytes);
+
+// ARDUINO_CORELINK_CORE_MAIN / _AUX for the core running this image.
+uint32_t arduino_corelink_hw_core(void);
+
+// Enable this core's notification interrupt (its handler calls arduino_corelink_isr()).
+void     arduino_corelink_hw_listen(void);
+
+// Raise the other core's notification interrupt.
+void     arduino_corelink_hw_notify(void);
+
+// Main core only: release the aux core from reset. Returns 0 when unsupported.
+uint32_t arduino_corelink_hw_boot_aux(void);
+
+// Called by the board notification IRQ handler after acknowledging it.
+void     arduino_corelink_isr(void);
+
+// Bytes the window must hold for the current slot configuration.
+uint32_t arduino_corelink_window_bytes(void);
+
+// ----------------------
+// C ABI (Swift)
+// ----------------------
+
+// Main: formats the window (once per boot) and returns 1.
+// Aux: returns 1 once the main core has formatted it, 0 until then.
+uint32_t arduino_corelink_open(void);
+
+uint32_t arduino_corelink_core(void);
+uint32_t arduino_corelink_is_dual(void);
+uint32_t arduino_corelink_boot_aux(void);
+uint32_t arduino_corelink_payload_max(void);
+
+// Copy-in send. Returns 0 when the ring is full (counted in dropped) or len is too big.
+uint32_t arduino_corelink_send(const uint8_t* data, uint32_t len);
+
+// Zero-copy send: fill up to payload_max bytes at the returned pointer, then commit(len).
+// Returns NULL when the ring is full (counted in dropped).
+uint8_t* arduino_corelink_reserve(void);
+void     arduino_corelink_commit(uint32_t len);
+
+// Oldest message from the other core (NULL when empty); valid until release().
+const uint8_t* arduino_corelink_peek(uint32_t* len);
+void     arduino_corelink_release(void);
+
+// Messages waiting from the other core.
+uint32_t arduino_corelink_available(void);
+
+// Notifications received since the previous call.
+uint32_t arduino_corelink_signals(void);
+
+// Messages this core could not send because its outgoing ring was full.
+uint32_t arduino_corelink_dropped(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
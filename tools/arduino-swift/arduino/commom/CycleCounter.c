@@ -0,0 +1,52 @@
+// CycleCounter.c
+// DWT CYCCNT access (see CycleCounter.h).
+
+#include "CycleCounter.h"
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+
+#define DEMCR          (*(volatile uint32_t*)0xE000EDFCu)
+#define DEMCR_TRCENA   (1u << 24)
+#define DWT_CTRL       (*(volatile uint32_t*)0xE0001000u)
+#define DWT_CYCCNTENA  (1u << 0)
+#define DWT_NOCYCCNT   (1u << 25)
+#define DWT_CYCCNT     (*(volatile uint32_t*)0xE0001004u)
+#define DWT_LAR        (*(volatile uint32_t*)0xE0001FB0u)
+#define DWT_LAR_KEY    0xC5ACCE55u
+
+// CMSIS system file of every supported core.
+extern uint32_t SystemCoreClock;
+
+uint32_t arduino_cycles_enable(void) {
+  if (DWT_CTRL & DWT_CYCCNTENA) return 1;
+
+  DEMCR |= DEMCR_TRCENA;
+  if (DWT_CTRL & DWT_NOCYCCNT) return 0;
+
+  DWT_LAR = DWT_LAR_KEY;   // Cortex-M7 software lock; ignored elsewhere
+  DWT_CYCCNT = 0;
+  DWT_CTRL |= DWT_CYCCNTENA;
+  return (DWT_CTRL & DWT_CYCCNTENA) ? 1u : 0u;
+}
+
+uint32_t arduino_cycles_read(void) {
+  return DWT_CYCCNT;
+}
+
+uint32_t arduino_cycles_hz(void) {
+  return SystemCoreClock;
+}
+
+#else
+
+uint32_t arduino_cycles_enable(void) { return 0; }
+uint32_t arduino_cycles_read(void)   { return 0; }
+uint32_t arduino_cycles_hz(void)     { return 0; }
+
+#endif
+
+uint64_t arduino_cycles_to_ns(uint32_t cycles) {
+  const uint32_t hz = arduino_cycles_hz();
+  if (hz == 0) return 0;
+  return ((uint64_t)cycles * 1000000000ull) / hz;
+}
@@ -0,0 +1,31 @@
+// CycleCounter.h
+// DWT CYCCNT cycle counter (C ABI consumed by Clock.swift).
+//
+// Rules:
+// - Pure C, no Arduino.h: raw ARMv7-M debug registers (DEMCR / DWT), so the same
+//   code serves the Due (M3), UNO R4 (M4) and Giga (M7, needs the DWT lock opened).
+// - Other targets (host builds, cores without DWT) compile to stubs that report
+//   "not available": enable() returns 0 and read() returns 0.
+// - CYCCNT is 32-bit: it wraps every 2^32 / f_cpu (51 s at 84 MHz, 8.9 s at 480 MHz).
+//   Differences of two reads (end - start) are wrap-safe below that.
+
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Starts CYCCNT (idempotent). Returns 1 when the counter is running.
+uint32_t arduino_cycles_enable(void);
+
+uint32_t arduino_cycles_read(void);
+
+// Core clock (SystemCoreClock), 0 when unknown.
+uint32_t arduino_cycles_hz(void);
+
+uint64_t arduino_cycles_to_ns(uint32_t cycles);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
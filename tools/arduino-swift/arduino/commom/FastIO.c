@@ -0,0 +1,143 @@
+// FastIO.c
+// Board-independent fast pin accessors (see FastIO.h).
+
+#include "FastIO.h"
+
+#define REG(h, i) (*(volatile uint32_t*)(h)[i])
+
+// ----------------------
+// Board hook (weak default: unsupported)
+// ----------------------
+
+__attribute__((weak))
+uint32_t arduino_fastio_resolve(uint32_t pin, uintptr_t* out) {
+  (void)pin;
+  (void)out;
+  return 0;
+}
+
+// ----------------------
+// Accessors
+// ----------------------
+
+void arduino_fastio_set(const uintptr_t* h) {
+  REG(h, ARDUINO_FASTIO_SET_REG) = (uint32_t)h[ARDUINO_FASTIO_SET_MASK];
+}
+
+void arduino_fastio_clear(const uintptr_t* h) {
+  REG(h, ARDUINO_FASTIO_CLR_REG) = (uint32_t)h[ARDUINO_FASTIO_CLR_MASK];
+}
+
+void arduino_fastio_write(const uintptr_t* h, uint32_t value) {
+  if (value) {
+    REG(h, ARDUINO_FASTIO_SET_REG) = (uint32_t)h[ARDUINO_FASTIO_SET_MASK];
+  } else {
+    REG(h, ARDUINO_FASTIO_CLR_REG) = (uint32_t)h[ARDUINO_FASTIO_CLR_MASK];
+  }
+}
+
+// None of the supported ports has a toggle register: read the output latch,
+// then one set/clear store (no digitalRead, no pin-table lookup).
+void arduino_fastio_toggle(const uintptr_t* h) {
+  if (REG(h, ARDUINO_FASTIO_OUT_REG) & (uint32_t)h[ARDUINO_FASTIO_OUT_MASK]) {
+    REG(h, ARDUINO_FASTIO_CLR_REG) = (uint32_t)h[ARDUINO_FASTIO_CLR_MASK];
+  } else {
+    REG(h, ARDUINO_FASTIO_SET_REG) = (uint32_t)h[ARDUINO_FASTIO_SET_MASK];
+  }
+}
+
+uint32_t arduino_fastio_read(const uintptr_t* h) {
+  return (REG(h, ARDUINO_FASTIO_IN_REG) & (uint32_t)h[ARDUINO_FASTIO_IN_MASK]) ? 1u : 0u;
+}
+
+// ----------------------
+// Pin groups
+// ----------------------
+// Layout (uintptr_t words):
+//   [0] pin count  [1] port count
+//   ports: { set reg, clear reg, input reg } x ARDUINO_PINGROUP_MAX_PORTS
+//   pins:  { port index, set mask, clear mask, input mask } x count
+
+enum { PG_HDR = 2, PG_PORT_WORDS = 3, PG_PIN_WORDS = 4 };
+
+#define PG_PORT(g, p) ((g) + PG_HDR + (p) * PG_PORT_WORDS)
+#define PG_PIN(g, i)  ((g) + PG_HDR + ARDUINO_PINGROUP_MAX_PORTS * PG_PORT_WORDS + (i) * PG_PIN_WORDS)
+
+uint32_t arduino_pingroup_words(uint32_t count) {
+  if (count > ARDUINO_PINGROUP_MAX_PINS) count = ARDUINO_PINGROUP_MAX_PINS;
+  return PG_HDR + ARDUINO_PINGROUP_MAX_PORTS * PG_PORT_WORDS + count * PG_PIN_WORDS;
+}
+
+uint32_t arduino_pingroup_init(uintptr_t* g, const uint32_t* pins, uint32_t count) {
+  if (!g) return 0;
+  g[0] = 0;
+  g[1] = 0;
+  if (!pins || count == 0 || count > ARDUINO_PINGROUP_MAX_PINS) return 0;
+
+  uint32_t ports = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    uintptr_t h[ARDUINO_FASTIO_WORDS];
+    if (!arduino_fastio_resolve(pins[i], h)) return 0;
+
+    // Same port <=> same set register.
+    uint32_t p = 0;
+    while (p < ports && PG_PORT(g, p)[0] != h[ARDUINO_FASTIO_SET_REG]) p++;
+    if (p == ports) {
+      if (ports == ARDUINO_PINGROUP_MAX_PORTS) return 0;
+      PG_PORT(g, p)[0] = h[ARDUINO_FASTIO_SET_REG];
+      PG_PORT(g, p)[1] = h[ARDUINO_FASTIO_CLR_REG];
+      PG_PORT(g, p)[2] = h[ARDUINO_FASTIO_IN_REG];
+      ports++;
+    }
+
+    uintptr_t* e = PG_PIN(g, i);
+    e[0] = p;
+    e[1] = h[ARDUINO_FASTIO_SET_MASK];
+    e[2] = h[ARDUINO_FASTIO_CLR_MASK];
+    e[3] = h[ARDUINO_FASTIO_IN_MASK];
+  }
+
+  g[0] = count;
+  g[1] = ports;
+  return 1;
+}
+
+void arduino_pingroup_write(const uintptr_t* g, uint32_t value) {
+  uint32_t set[ARDUINO_PINGROUP_MAX_PORTS] = {0};
+  uint32_t clr[ARDUINO_PINGROUP_MAX_PORTS] = {0};
+
+  const uint32_t count = (uint32_t)g[0];
+  for (uint32_t i = 0; i < count; i++, value >>= 1) {
+    const uintptr_t* e = PG_PIN(g, i);
+    if (value & 1u) set[e[0]] |= (uint32_t)e[1];
+    else            clr[e[0]] |= (uint32_t)e[2];
+  }
+
+  const uint32_t ports = (uint32_t)g[1];
+  for (uint32_t p = 0; p < ports; p++) {
+    const uintptr_t* r = PG_PORT(g, p);
+    if (r[0] == r[1]) {
+      *(volatile uint32_t*)r[0] = set[p] | clr[p];
+    } else {
+      if (set[p]) *(volatile uint32_t*)r[0] = set[p];
+      if (clr[p]) *(volatile uint32_t*)r[1] = clr[p];
+    }
+  }
+}
+
+uint32_t arduino_pingroup_read(const uintptr_t* g) {
+  uint32_t in[ARDUINO_PINGROUP_MAX_PORTS];
+
+  const uint32_t ports = (uint32_t)g[1];
+  for (uint32_t p = 0; p < ports; p++) {
+    in[p] = *(volatile uint32_t*)PG_PORT(g, p)[2];
+  }
+
+  uint32_t value = 0;
+  const uint32_t count = (uint32_t)g[0];
+  for (uint32_t i = 0; i < count; i++) {
+    const uintptr_t* e = PG_PIN(g, i);
+    if (in[e[0]] & (uint32_t)e[3]) value |= (1u << i);
+  }
+  return value;
+}
@@ -0,0 +1,71 @@
+// FastIO.h
+// Direct port-register pin access (C ABI consumed by PIN.swift / PinGroup.swift).
+//
+// Rules:
+// - Pure C, no Arduino.h (the accessors also build on the host).
+// - A pin is resolved ONCE into a handle of register addresses + masks;
+//   every later edge is a single volatile store (no pin-table lookup).
+// - Resolution is board-specific (api/<api_name>/). The weak default in
+//   FastIO.c returns 0 so Swift falls back to digitalWrite/digitalRead.
+// - Host tests can fill a handle by hand with addresses of plain RAM words.
+
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Handle layout: ARDUINO_FASTIO_WORDS uintptr_t words.
+enum {
+  ARDUINO_FASTIO_SET_REG = 0,  // write mask -> pin high   (SAM3X SODR, RA4M1 PCNTR3.POSR, STM32 BSRR)
+  ARDUINO_FASTIO_SET_MASK,
+  ARDUINO_FASTIO_CLR_REG,      // write mask -> pin low    (SAM3X CODR, RA4M1 PCNTR3.PORR, STM32 BSRR hi)
+  ARDUINO_FASTIO_CLR_MASK,
+  ARDUINO_FASTIO_IN_REG,       // input level              (SAM3X PDSR, RA4M1 PCNTR2.PIDR, STM32 IDR)
+  ARDUINO_FASTIO_IN_MASK,
+  ARDUINO_FASTIO_OUT_REG,      // output latch (toggle)    (SAM3X ODSR, RA4M1 PCNTR1.PODR, STM32 ODR)
+  ARDUINO_FASTIO_OUT_MASK,
+  ARDUINO_FASTIO_WORDS
+};
+
+// ----------------------
+// Board hook (api/<api_name>/)
+// ----------------------
+
+// Fills out[ARDUINO_FASTIO_WORDS]. Returns 0 when the pin has no direct-register path.
+uint32_t arduino_fastio_resolve(uint32_t pin, uintptr_t* out);
+
+// ----------------------
+// Accessors (one volatile access each)
+// ----------------------
+void     arduino_fastio_set(const uintptr_t* h);
+void     arduino_fastio_clear(const uintptr_t* h);
+void     arduino_fastio_write(const uintptr_t* h, uint32_t value);
+void     arduino_fastio_toggle(const uintptr_t* h);
+uint32_t arduino_fastio_read(const uintptr_t* h);
+
+// ----------------------
+// Pin groups (PinGroup.swift)
+// ----------------------
+// Pins are merged by port at init. write() then costs one store per port when
+// set/clear share a register (RA4M1 PCNTR3, STM32 BSRR: atomic across the port)
+// or two stores (SAM3X SODR then CODR). read() is one load per port.
+//
+// Storage is caller-owned: arduino_pingroup_words(count) uintptr_t words.
+
+#define ARDUINO_PINGROUP_MAX_PINS  32u
+#define ARDUINO_PINGROUP_MAX_PORTS 8u
+
+uint32_t arduino_pingroup_words(uint32_t count);
+
+// Returns 1 when every pin resolved to a fast handle, 0 otherwise (caller falls back).
+uint32_t arduino_pingroup_init(uintptr_t* g, const uint32_t* pins, uint32_t count);
+
+// Bit i of value drives pins[i].
+void     arduino_pingroup_write(const uintptr_t* g, uint32_t value);
+uint32_t arduino_pingroup_read(const uintptr_t* g);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
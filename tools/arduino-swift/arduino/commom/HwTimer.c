@@ -0,0 +1,154 @@
+// HwTimer.c
+// Slot table + per-slot event queues (see HwTimer.h).
+
+#include "HwTimer.h"
+#include "FastIO.h"
+#include "SpscRing.h"
+
+#include <string.h>
+
+#if (ARDUINO_HWTIMER_QUEUE & (ARDUINO_HWTIMER_QUEUE - 1u)) != 0
+#error "ARDUINO_HWTIMER_QUEUE must be a power of two"
+#endif
+
+typedef struct {
+  uintptr_t toggle[ARDUINO_FASTIO_WORDS];
+  volatile uint8_t has_toggle;
+  uint8_t  used;
+
+  volatile uint32_t ticks;
+  arduino_spsc_t   queue;     // ISR pushes, Swift pops; full -> overflows
+  uint32_t         stamps[ARDUINO_HWTIMER_QUEUE];
+} hwtimer_slot_t;
+
+static hwtimer_slot_t g_timers[ARDUINO_HWTIMER_SLOTS];
+
+static inline hwtimer_slot_t* slot_at(uint32_t slot) {
+  return slot < ARDUINO_HWTIMER_SLOTS ? &g_timers[slot] : 0;
+}
+
+// ----------------------
+// Board hooks (weak defaults: no timers)
+// ----------------------
+
+__attribute__((weak))
+uint32_t arduino_hwtimer_hw_slots(void) {
+  return 0;
+}
+
+__attribute__((weak))
+uint32_t arduino_hwtimer_hw_open(uint32_t slot, uint32_t period_us) {
+  (void)slot;
+  (void)period_us;
+  return 0;
+}
+
+__attribute__((weak))
+void arduino_hwtimer_hw_close(uint32_t slot) {
+  (void)slot;
+}
+
+__attribute__((weak))
+uint32_t arduino_hwtimer_now_us(void) {
+  return 0;
+}
+
+// ----------------------
+// ISR
+// ----------------------
+
+void arduino_hwtimer_isr(uint32_t slot) {
+  hwtimer_slot_t* t = slot_at(slot);
+  if (!t) return;
+
+  // Pin edge first: it is the jitter-critical part.
+  if (t->has_toggle) arduino_fastio_toggle(t->toggle);
+
+  const uint32_t stamp = arduino_hwtimer_now_us();
+
+  t->ticks++;
+  (void)arduino_spsc_push(&t->queue, &stamp);
+}
+
+// ----------------------
+// C ABI
+// ----------------------
+
+int32_t arduino_hwtimer_open(uint32_t period_us) {
+  if (period_us < ARDUINO_HWTIMER_MIN_PERIOD_US) return -1;
+
+  uint32_t n = arduino_hwtimer_hw_slots();
+  if (n > ARDUINO_HWTIMER_SLOTS) n = ARDUINO_HWTIMER_SLOTS;
+
+  for (uint32_t i = 0; i < n; i++) {
+    hwtimer_slot_t* t = &g_timers[i];
+    if (t->used) continue;
+
+    // Fresh counters + queue; actions are attached after open().
+    t->ticks = 0;
+    arduino_spsc_init(&t->queue, t->stamps, sizeof(uint32_t), ARDUINO_HWTIMER_QUEUE);
+    t->used = 1;
+
+    if (!arduino_hwtimer_hw_open(i, period_us)) {
+      t->used = 0;
+      return -1;
+    }
+    return (int32_t)i;
+  }
+  return -1;
+}
+
+void arduino_hwtimer_close(uint32_t slot) {
+  hwtimer_slot_t* t = slot_at(slot);
+  if (!t || !t->used) return;
+
+  arduino_hwtimer_hw_close(slot);
+  t->used = 0;
+  t->has_toggle = 0;
+}
+
+uint32_t arduino_hwtimer_set_toggle(uint32_t slot, uint32_t pin) {
+  hwtimer_slot_t* t = slot_at(slot);
+  if (!t) return 0;
+
+  uintptr_t h[ARDUINO_FASTIO_WORDS];
+  if (!arduino_fastio_resolve(pin, h)) return 0;
+
+  t->has_toggle = 0;
+  __sync_synchronize();
+  memcpy(t->toggle, h, sizeof(h));
+  __sync_synchronize();
+  t->has_toggle = 1;
+  return 1;
+}
+
+uint32_t arduino_hwtimer_can_toggle(uint32_t pin) {
+  uintptr_t h[ARDUINO_FASTIO_WORDS];
+  return arduino_fastio_resolve(pin, h);
+}
+
+void arduino_hwtimer_clear_actions(uint32_t slot) {
+  hwtimer_slot_t* t = slot_at(slot);
+  if (!t) return;
+  t->has_toggle = 0;
+}
+
+uint32_t arduino_hwtimer_ticks(uint32_t slot) {
+  hwtimer_slot_t* t = slot_at(slot);
+  return t ? t->ticks : 0u;
+}
+
+uint32_t arduino_hwtimer_pop(uint32_t slot, uint32_t* stamp_us) {
+  hwtimer_slot_t* t = slot_at(slot);
+  if (!t) return 0;
+
+  uint32_t stamp;
+  if (!arduino_spsc_pop(&t->queue, &stamp)) return 0;
+  if (stamp_us) *stamp_us = stamp;
+  return 1;
+}
+
+uint32_t arduino_hwtimer_dropped(uint32_t slot) {
+  hwtimer_slot_t* t = slot_at(slot);
+  return t ? arduino_spsc_overflows(&t->queue) : 0u;
+}
@@ -0,0 +1,80 @@
+// HwTimer.h
+// Hardware periodic timers with ISR -> Swift tick queues (C ABI consumed by PeriodicTimer.swift).
+//
+// Rules:
+// - Pure C, no Arduino.h (the slot/queue logic also builds on the host).
+// - The ISR does the minimum, in this order: optional pin toggle (one register
+//   store through a FastIO handle), one micros() stamp, one queue push.
+// - No ADC action: a blocking analogRead() would stretch every period by a
+//   conversion (and on Giga takes a mutex), and it would fight AdcStream.h for
+//   the ADC. Timed sampling is AdcStream.h (AnalogStream.swift), which owns the
+//   ADC while it runs (hardware trigger + DMA / PDC on Due and Giga).
+// - One single-producer / single-consumer queue per slot (SpscRing.h): the timer
+//   ISR pushes, the Swift loop pops. Full queue: the event is dropped and counted,
+//   the tick counter still advances, so Swift can always tell how many periods elapsed.
+// - Hardware is board-specific (api/<api_name>/): arduino_hwtimer_hw_*(); the
+//   board IRQ handler acknowledges the peripheral and calls arduino_hwtimer_isr().
+//   The weak defaults in HwTimer.c report no timers.
+
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef ARDUINO_HWTIMER_SLOTS
+#define ARDUINO_HWTIMER_SLOTS 4u
+#endif
+
+// Events buffered per slot (power of two).
+#ifndef ARDUINO_HWTIMER_QUEUE
+#define ARDUINO_HWTIMER_QUEUE 16u
+#endif
+
+#define ARDUINO_HWTIMER_MIN_PERIOD_US 10u
+
+// ----------------------
+// Board hooks (api/<api_name>/, weak defaults in HwTimer.c)
+// ----------------------
+
+// Timers this board can hand out (<= ARDUINO_HWTIMER_SLOTS).
+uint32_t arduino_hwtimer_hw_slots(void);
+
+// Program slot's timer for period_us and enable its interrupt. Returns 0 on failure.
+uint32_t arduino_hwtimer_hw_open(uint32_t slot, uint32_t period_us);
+void     arduino_hwtimer_hw_close(uint32_t slot);
+
+// Event timestamp source (micros()).
+uint32_t arduino_hwtimer_now_us(void);
+
+// Called by the board IRQ handler after acknowledging the peripheral.
+void     arduino_hwtimer_isr(uint32_t slot);
+
+// ----------------------
+// C ABI (Swift)
+// ----------------------
+
+// Returns the slot index, or -1 when no timer is free / the period is out of range.
+int32_t  arduino_hwtimer_open(uint32_t period_us);
+void     arduino_hwtimer_close(uint32_t slot);
+
+// ISR action (0 = pin has no fast path / bad slot).
+uint32_t arduino_hwtimer_set_toggle(uint32_t slot, uint32_t pin);
+
+// Same check without a slot (PeriodicTimer validates the pin before start()).
+uint32_t arduino_hwtimer_can_toggle(uint32_t pin);
+void     arduino_hwtimer_clear_actions(uint32_t slot);
+
+// Periods elapsed since open (wraps).
+uint32_t arduino_hwtimer_ticks(uint32_t slot);
+
+// Oldest queued event: its micros() stamp. Returns 0 when the queue is empty.
+uint32_t arduino_hwtimer_pop(uint32_t slot, uint32_t* stamp_us);
+
+// Events dropped because the queue was full.
+uint32_t arduino_hwtimer_dropped(uint32_t slot);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
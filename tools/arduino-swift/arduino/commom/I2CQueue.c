@@ -0,0 +1,194 @@
+// I2CQueue.c
+// Transaction ring + engine (see I2CQueue.h).
+
+#include "I2CQueue.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define SLOT_MASK (ARDUINO_I2CQ_SLOTS - 1u)
+#define ID_MASK   0x7FFFFFFFu   // ids are free-running 31-bit counters (fit int32)
+
+#if (ARDUINO_I2CQ_SLOTS & SLOT_MASK) != 0
+#error "ARDUINO_I2CQ_SLOTS must be a power of two"
+#endif
+
+typedef struct {
+  uint8_t  address;
+  uint32_t flags;
+  const uint8_t* tx;
+  uint32_t tx_len;
+  uint8_t* rx;
+  uint32_t rx_len;
+  volatile int32_t result;
+  uint8_t  tx_inline[ARDUINO_I2CQ_INLINE];
+  uint8_t  rx_inline[ARDUINO_I2CQ_INLINE];
+} i2cq_slot_t;
+
+static i2cq_slot_t g_slots[ARDUINO_I2CQ_SLOTS];
+
+// tail <= done <= started <= head (mod 2^31); at most one running (done..started).
+static volatile uint32_t g_head;      // loop: submitted
+static volatile uint32_t g_started;   // loop: handed to the engine
+static volatile uint32_t g_done;      // engine (IRQ or loop): finished
+static volatile uint32_t g_tail;      // loop: reaped
+
+static uint32_t g_clock_hz = 100000u;
+
+static inline uint32_t dist(uint32_t a, uint32_t b) {
+  return (a - b) & ID_MASK;
+}
+
+static inline i2cq_slot_t* slot_at(uint32_t id) {
+  return &g_slots[id & SLOT_MASK];
+}
+
+// ----------------------
+// Board hooks (weak defaults: no backend)
+// ----------------------
+
+__attribute__((weak))
+uint32_t arduino_i2cq_hw_async(void) {
+  return 0;
+}
+
+__attribute__((weak))
+uint32_t arduino_i2cq_hw_start(uint8_t address,
+                               const uint8_t* tx, uint32_t txLen,
+                               uint8_t* rx, uint32_t rxLen,
+                               uint32_t flags) {
+  (void)address;
+  (void)tx;
+  (void)txLen;
+  (void)rx;
+  (void)rxLen;
+  (void)flags;
+  return 0;
+}
+
+__attribute__((weak))
+void arduino_i2cq_hw_poll(void) {
+}
+
+__attribute__((weak))
+int32_t arduino_i2cq_blocking_transfer(uint8_t address,
+                                       const uint8_t* tx, uint32_t txLen,
+                                       uint8_t* rx, uint32_t rxLen,
+                                       uint32_t flags) {
+  (void)address;
+  (void)tx;
+  (void)txLen;
+  (void)rx;
+  (void)rxLen;
+  (void)flags;
+  return -4;   // "other error": no I2C lib linked
+}
+
+void arduino_i2cq_complete(int32_t result) {
+  const uint32_t d = g_done;
+  if (d == g_started) return;   // nothing running
+
+  slot_at(d)->result = result;
+  __sync_synchronize();
+  g_done = (d + 1u) & ID_MASK;
+}
+
+void arduino_i2cq_set_clock(uint32_t hz) {
+  if (hz) g_clock_hz = hz;
+}
+
+uint32_t arduino_i2cq_clock(void) {
+  return g_clock_hz;
+}
+
+// ----------------------
+// C ABI
+// ----------------------
+
+int32_t arduino_i2cq_submit(uint8_t address,
+                            const uint8_t* tx, uint32_t txLen,
+                            uint8_t* rx, uint32_t rxLen,
+                            uint32_t flags) {
+  if (!tx) txLen = 0;
+  if (rxLen > 0 && !rx && rxLen > ARDUINO_I2CQ_INLINE) return -1;
+
+  const uint32_t h = g_head;
+  if (dist(h, g_tail) >= ARDUINO_I2CQ_SLOTS) return -1;
+
+  i2cq_slot_t* s = slot_at(h);
+  s->address = address;
+  s->flags = flags;
+  s->tx_len = txLen;
+  s->rx_len = rxLen;
+  s->result = 0;
+
+  if (txLen <= ARDUINO_I2CQ_INLINE) {
+    if (txLen) memcpy(s->tx_inline, tx, txLen);
+    s->tx = s->tx_inline;
+  } else {
+    s->tx = tx;
+  }
+  s->rx = rx ? rx : s->rx_inline;
+
+  __sync_synchronize();
+  g_head = (h + 1u) & ID_MASK;
+  return (int32_t)h;
+}
+
+uint32_t arduino_i2cq_pump(void) {
+  arduino_i2cq_hw_poll();
+
+  const uint32_t st = g_started;
+  if (st != g_done || st == g_head) return dist(g_head, g_done);
+
+  // Running before the backend sees it: its IRQ may complete at once.
+  i2cq_slot_t* s = slot_at(st);
+  g_started = (st + 1u) & ID_MASK;
+  __sync_synchronize();
+
+  if (!arduino_i2cq_hw_async() ||
+      !arduino_i2cq_hw_start(s->address, s->tx, s->tx_len, s->rx, s->rx_len, s->flags)) {
+    arduino_i2cq_complete(
+      arduino_i2cq_blocking_transfer(s->address, s->tx, s->tx_len, s->rx, s->rx_len, s->flags));
+  }
+  return dist(g_head, g_done);
+}
+
+uint32_t arduino_i2cq_peek_done(uint32_t* id, int32_t* result, const uint8_t** rx) {
+  const uint32_t t = g_tail;
+  if (t == g_done) return 0;
+  __sync_synchronize();
+
+  const i2cq_slot_t* s = slot_at(t);
+  if (id) *id = t;
+  if (result) *result = s->result;
+  if (rx) *rx = s->rx;
+  return 1;
+}
+
+void arduino_i2cq_release_done(void) {
+  const uint32_t t = g_tail;
+  if (t == g_done) return;
+  g_tail = (t + 1u) & ID_MASK;
+}
+
+uint32_t arduino_i2cq_slots(void) {
+  return ARDUINO_I2CQ_SLOTS;
+}
+
+uint32_t arduino_i2cq_state(uint32_t id) {
+  const uint32_t t = g_tail;
+  const uint32_t k = dist(id, t);
+  if (k >= dist(g_head, t)) return ARDUINO_I2CQ_STATE_UNKNOWN;
+  if (k < dist(g_done, t)) return ARDUINO_I2CQ_STATE_DONE;
+  if (k < dist(g_started, t)) return ARDUINO_I2CQ_STATE_RUNNING;
+  return ARDUINO_I2CQ_STATE_QUEUED;
+}
+
+uint32_t arduino_i2cq_pending(void) {
+  return dist(g_head, g_done);
+}
+
+uint32_t arduino_i2cq_is_async(void) {
+  return arduino_i2cq_hw_async();
+}
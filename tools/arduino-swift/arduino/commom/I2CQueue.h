@@ -0,0 +1,104 @@
+// I2CQueue.h
+// Non-blocking I2C master transaction queue (C ABI consumed by I2C.Queue in I2C.swift).
+//
+// Rules:
+// - Pure C, no Arduino.h (the queue logic also builds on the host).
+// - Fixed ring of transaction slots, FIFO on one bus: the loop submits and
+//   reaps, the engine runs one transaction at a time in submission order.
+// - Short buffers (<= ARDUINO_I2CQ_INLINE bytes) are copied into the slot;
+//   longer ones are borrowed and must stay valid until the slot is reaped.
+// - arduino_i2cq_pump() (loop only) advances the engine: it polls the board
+//   backend, starts the next transaction when the bus is idle, and on boards
+//   without a backend runs it with the blocking fallback (Wire).
+// - Hardware is board-specific (api/<api_name>/): arduino_i2cq_hw_*(); the
+//   backend reports the end of a transaction with arduino_i2cq_complete(),
+//   from its IRQ or from hw_poll(). The weak defaults in I2CQueue.c have no backend.
+// - Do not mix blocking I2C.Master calls with a non-empty queue: both drive
+//   the same peripheral.
+
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Transaction slots (power of two).
+#ifndef ARDUINO_I2CQ_SLOTS
+#define ARDUINO_I2CQ_SLOTS 8u
+#endif
+
+// Bytes copied into a slot per direction.
+#ifndef ARDUINO_I2CQ_INLINE
+#define ARDUINO_I2CQ_INLINE 32u
+#endif
+
+// Same flags and result encoding as arduino_i2c_transfer (I2C.h).
+#define ARDUINO_I2CQ_STOP_BETWEEN 0x01u   // STOP + START between write and read
+#define ARDUINO_I2CQ_NO_STOP      0x02u   // keep the bus after the last phase
+
+// State of a transaction id.
+#define ARDUINO_I2CQ_STATE_UNKNOWN 0u     // never submitted, or already reaped
+#define ARDUINO_I2CQ_STATE_QUEUED  1u
+#define ARDUINO_I2CQ_STATE_RUNNING 2u
+#define ARDUINO_I2CQ_STATE_DONE    3u
+
+// ----------------------
+// Board hooks (api/<api_name>/, weak defaults in I2CQueue.c)
+// ----------------------
+
+// 1 when the board has a non-blocking backend.
+uint32_t arduino_i2cq_hw_async(void);
+
+// Start one transaction (called from the loop). Returns 1 when started; the
+// backend calls arduino_i2cq_complete() later. Returns 0 when this transaction
+// is not supported by the backend: it then runs on the blocking fallback.
+uint32_t arduino_i2cq_hw_start(uint8_t address,
+                               const uint8_t* tx, uint32_t txLen,
+                               uint8_t* rx, uint32_t rxLen,
+                               uint32_t flags);
+
+// Loop-side progress for polled backends (no-op for IRQ backends).
+void     arduino_i2cq_hw_poll(void);
+
+// Blocking transfer used when there is no backend (I2C.cpp: Wire).
+int32_t  arduino_i2cq_blocking_transfer(uint8_t address,
+                                        const uint8_t* tx, uint32_t txLen,
+                                        uint8_t* rx, uint32_t rxLen,
+                                        uint32_t flags);
+
+// Backend: the running transaction ended. result = bytes read, or -status.
+void     arduino_i2cq_complete(int32_t result);
+
+// Bus clock for backends that own their peripheral setup (set by arduino_i2c_setClock).
+void     arduino_i2cq_set_clock(uint32_t hz);
+uint32_t arduino_i2cq_clock(void);
+
+// ----------------------
+// C ABI (Swift)
+// ----------------------
+
+// Queue a write-then-read (either side may be empty). rx may be NULL when
+// rxLen <= ARDUINO_I2CQ_INLINE: the bytes land in the slot (see peek_done).
+// Returns the transaction id, or -1 when the queue is full / rx is missing.
+int32_t  arduino_i2cq_submit(uint8_t address,
+                             const uint8_t* tx, uint32_t txLen,
+                             uint8_t* rx, uint32_t rxLen,
+                             uint32_t flags);
+
+// Advance the engine (loop only). Returns transactions not yet done.
+uint32_t arduino_i2cq_pump(void);
+
+// Oldest finished transaction: id, result and where its rx bytes are.
+// Returns 0 when none is finished. Valid until release_done().
+uint32_t arduino_i2cq_peek_done(uint32_t* id, int32_t* result, const uint8_t** rx);
+void     arduino_i2cq_release_done(void);
+
+uint32_t arduino_i2cq_slots(void);
+uint32_t arduino_i2cq_state(uint32_t id);
+uint32_t arduino_i2cq_pending(void);
+uint32_t arduino_i2cq_is_async(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,199 @@
+// SpscRing.h
+// Header-only lock-free single-producer / single-consumer ring (C and C++).
+//
+// Rules:
+// - Pure C, no Arduino.h; everything is static inline (no .c to stage).
+// - Exactly one producer (e.g. an ISR) and one consumer (e.g. the Swift loop).
+//   Neither side ever disables interrupts.
+// - Capacity is a power of two: indices are free-running uint32_t and
+//   `index & mask` picks the slot (no division in the ISR).
+// - The producer only writes `head` and `overflows`, the consumer only writes `tail`.
+//   DMB orders slot data against the index that publishes it (Cortex-M: `dmb`;
+//   host builds: a full fence, so the same header can be stress-tested).
+// - Elements are `elem_size` bytes; bulk push / pop copy across the wrap, and
+//   write_span / read_span expose the contiguous part for zero-copy access.
+// - Elements that do not fit are dropped and counted in `overflows`.
+//
+// Usage (byte ring filled from an ISR):
+//   static uint8_t storage[128];
+//   static arduino_spsc_t rx;
+//   arduino_spsc_init(&rx, storage, 1, 128);
+//   ISR:  arduino_spsc_push(&rx, &b);
+//   loop: n = arduino_spsc_pop_bulk(&rx, out, sizeof(out));
+
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__arm__) || defined(__thumb__)
+#define ARDUINO_SPSC_DMB() __asm__ volatile ("dmb" ::: "memory")
+#else
+#define ARDUINO_SPSC_DMB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+typedef struct {
+  uint8_t* buf;
+  uint32_t elem_size;
+  uint32_t mask;                  // capacity - 1
+  volatile uint32_t head;         // producer
+  volatile uint32_t overflows;    // producer: elements dropped
+  volatile uint32_t tail;         // consumer
+} arduino_spsc_t;
+
+// ----------------------
+// Setup / query
+// ----------------------
+
+// storage must hold capacity * elem_size bytes. Returns 0 unless capacity is a power of two.
+static inline uint32_t arduino_spsc_init(arduino_spsc_t* r, void* storage, uint32_t elem_size, uint32_t capacity) {
+  if (!r || !storage || elem_size == 0 || capacity == 0 || (capacity & (capacity - 1u)) != 0) return 0;
+  r->buf = (uint8_t*)storage;
+  r->elem_size = elem_size;
+  r->mask = capacity - 1u;
+  r->head = 0;
+  r->tail = 0;
+  r->overflows = 0;
+  return 1;
+}
+
+static inline uint32_t arduino_spsc_capacity(const arduino_spsc_t* r) {
+  return r->mask + 1u;
+}
+
+// Either side: a snapshot (exact for the caller's own end).
+static inline uint32_t arduino_spsc_count(const arduino_spsc_t* r) {
+  return r->head - r->tail;
+}
+
+static inline uint32_t arduino_spsc_free(const arduino_spsc_t* r) {
+  return r->mask + 1u - (r->head - r->tail);
+}
+
+static inline uint32_t arduino_spsc_overflows(const arduino_spsc_t* r) {
+  return r->overflows;
+}
+
+static inline uint8_t* arduino_spsc_slot(const arduino_spsc_t* r, uint32_t index) {
+  return r->buf + (index & r->mask) * r->elem_size;
+}
+
+// ----------------------
+// Producer
+// ----------------------
+
+// Producer: count `n` elements that could not be queued.
+static inline void arduino_spsc_note_overflow(arduino_spsc_t* r, uint32_t n) {
+  r->overflows += n;
+}
+
+// Contiguous free slots at head (up to the wrap); *n = how many. NULL when full.
+static inline uint8_t* arduino_spsc_write_span(arduino_spsc_t* r, uint32_t* n) {
+  const uint32_t h = r->head;
+  const uint32_t free_slots = r->mask + 1u - (h - r->tail);
+  const uint32_t to_end = r->mask + 1u - (h & r->mask);
+  const uint32_t k = free_slots < to_end ? free_slots : to_end;
+  if (n) *n = k;
+  return k ? arduino_spsc_slot(r, h) : (uint8_t*)0;
+}
+
+// Publish n elements written through write_span().
+static inline void arduino_spsc_write_commit(arduino_spsc_t* r, uint32_t n) {
+  ARDUINO_SPSC_DMB();
+  r->head = r->head + n;
+}
+
+static inline uint32_t arduino_spsc_push(arduino_spsc_t* r, const void* elem) {
+  const uint32_t h = r->head;
+  if (h - r->tail > r->mask) {
+    r->overflows++;
+    return 0;
+  }
+  memcpy(arduino_spsc_slot(r, h), elem, r->elem_size);
+  ARDUINO_SPSC_DMB();
+  r->head = h + 1u;
+  return 1;
+}
+
+// Pushes as many of `n` elements as fit (at most two copies); the rest count as overflows.
+static inline uint32_t arduino_spsc_push_bulk(arduino_spsc_t* r, const void* src, uint32_t n) {
+  const uint8_t* s = (const uint8_t*)src;
+  const uint32_t h = r->head;
+  const uint32_t free_slots = r->mask + 1u - (h - r->tail);
+  const uint32_t k = n < free_slots ? n : free_slots;
+
+  const uint32_t off = h & r->mask;
+  const uint32_t first = (r->mask + 1u - off) < k ? (r->mask + 1u - off) : k;
+  memcpy(r->buf + off * r->elem_size, s, first * r->elem_size);
+  if (k > first) memcpy(r->buf, s + first * r->elem_size, (k - first) * r->elem_size);
+
+  if (k < n) r->overflows += n - k;
+  if (k == 0) return 0;
+
+  ARDUINO_SPSC_DMB();
+  r->head = h + k;
+  return k;
+}
+
+// ----------------------
+// Consumer
+// ----------------------
+
+// Contiguous queued elements at tail (up to the wrap); *n = how many. NULL when empty.
+static inline const uint8_t* arduino_spsc_read_span(const arduino_spsc_t* r, uint32_t* n) {
+  const uint32_t t = r->tail;
+  const uint32_t avail = r->head - t;
+  ARDUINO_SPSC_DMB();
+  const uint32_t to_end = r->mask + 1u - (t & r->mask);
+  const uint32_t k = avail < to_end ? avail : to_end;
+  if (n) *n = k;
+  return k ? arduino_spsc_slot(r, t) : (const uint8_t*)0;
+}
+
+// Hand n elements read through read_span() back to the producer.
+static inline void arduino_spsc_read_release(arduino_spsc_t* r, uint32_t n) {
+  ARDUINO_SPSC_DMB();
+  r->tail = r->tail + n;
+}
+
+static inline uint32_t arduino_spsc_pop(arduino_spsc_t* r, void* elem) {
+  const uint32_t t = r->tail;
+  if (r->head == t) return 0;
+  ARDUINO_SPSC_DMB();
+  memcpy(elem, arduino_spsc_slot(r, t), r->elem_size);
+  ARDUINO_SPSC_DMB();
+  r->tail = t + 1u;
+  return 1;
+}
+
+// Pops up to `max` elements (at most two copies). Returns how many.
+static inline uint32_t arduino_spsc_pop_bulk(arduino_spsc_t* r, void* dst, uint32_t max) {
+  uint8_t* d = (uint8_t*)dst;
+  const uint32_t t = r->tail;
+  const uint32_t avail = r->head - t;
+  const uint32_t k = max < avail ? max : avail;
+  if (k == 0) return 0;
+  ARDUINO_SPSC_DMB();
+
+  const uint32_t off = t & r->mask;
+  const uint32_t first = (r->mask + 1u - off) < k ? (r->mask + 1u - off) : k;
+  memcpy(d, r->buf + off * r->elem_size, first * r->elem_size);
+  if (k > first) memcpy(d + first * r->elem_size, r->buf, (k - first) * r->elem_size);
+
+  ARDUINO_SPSC_DMB();
+  r->tail = t + k;
+  return k;
+}
+
+// Consumer: drop everything queued so far.
+static inline void arduino_spsc_clear(arduino_spsc_t* r) {
+  ARDUINO_SPSC_DMB();
+  r->tail = r->head;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -0,0 +1,388 @@
+// SwiftHeap.c
+// Two-Level Segregated Fit allocator for Embedded Swift (see SwiftHeap.h).
+//
+// Layout:
+// - Every block is [header | payload]. The header keeps the physical
+//   predecessor and the payload size (low bit = FREE).
+// - Free blocks reuse the first payload words as free-list links.
+// - A zero-sized USED sentinel closes the region so coalescing never runs off the end.
+//
+// Size classes:
+// - first level  = power of two of the size
+// - second level = 2^SL_LOG2 linear slices inside that power of two
+// - one bitmap per level -> find a fitting list with two ffs() calls (O(1)).
+//
+// Not interrupt-safe: allocate/free from loop context only (as Swift does).
+
+#include "SwiftHeap.h"
+
+#include <string.h>
+
+// ----------------------
+// Configuration
+// ----------------------
+
+#ifndef ARDUINO_SWIFT_HEAP_SL_LOG2
+#define ARDUINO_SWIFT_HEAP_SL_LOG2 4
+#endif
+
+#ifndef ARDUINO_SWIFT_HEAP_FL_MAX
+#define ARDUINO_SWIFT_HEAP_FL_MAX 20
+#endif
+
+#define HEAP_ALIGN_LOG2  3
+#define HEAP_ALIGN       ((size_t)1 << HEAP_ALIGN_LOG2)
+
+#define SL_LOG2          ARDUINO_SWIFT_HEAP_SL_LOG2
+#define SL_COUNT         (1u << SL_LOG2)
+#define FL_SHIFT         (SL_LOG2 + HEAP_ALIGN_LOG2)
+#define FL_COUNT         (ARDUINO_SWIFT_HEAP_FL_MAX - FL_SHIFT + 1)
+#define SMALL_BLOCK      ((size_t)1 << FL_SHIFT)
+#define BLOCK_MAX        ((size_t)1 << ARDUINO_SWIFT_HEAP_FL_MAX)
+
+#define ALIGN_UP(x, a)   (((x) + ((a) - 1)) & ~((size_t)(a) - 1))
+
+#define FLAG_FREE        ((size_t)1)
+#define FLAG_MASK        ((size_t)(HEAP_ALIGN - 1))
+
+// ----------------------
+// Blocks
+// ----------------------
+
+typedef struct swift_heap_block {
+    struct swift_heap_block* prev_phys;
+    size_t size; // payload bytes | flags
+} swift_heap_block_t;
+
+typedef struct {
+    swift_heap_block_t* next;
+    swift_heap_block_t* prev;
+} swift_heap_links_t;
+
+#define HDR_SIZE     ALIGN_UP(sizeof(swift_heap_block_t), HEAP_ALIGN)
+#define MIN_PAYLOAD  ALIGN_UP(sizeof(swift_heap_links_t), HEAP_ALIGN)
+#define MIN_BLOCK    (HDR_SIZE + MIN_PAYLOAD)
+
+typedef struct {
+    uint8_t* begin;
+    uint8_t* end;
+    size_t capacity;
+    size_t free_bytes;
+    int ready;
+
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[FL_COUNT];
+    swift_heap_block_t* lists[FL_COUNT][SL_COUNT];
+} swift_heap_t;
+
+static swift_heap_t g_heap;
+
+static inline uint8_t* payload_of(swift_heap_block_t* b) { return (uint8_t*)b + HDR_SIZE; }
+static inline swift_heap_block_t* block_of(const void* p) { return (swift_heap_block_t*)((uint8_t*)p - HDR_SIZE); }
+static inline swift_heap_links_t* links_of(swift_heap_block_t* b) { return (swift_heap_links_t*)payload_of(b); }
+
+static inline size_t block_size(const swift_heap_block_t* b) { return b->size & ~FLAG_MASK; }
+static inline int    block_is_free(const swift_heap_block_t* b) { return (b->size & FLAG_FREE) != 0; }
+
+static inline void block_set_size(swift_heap_block_t* b, size_t size) {
+    b->size = size | (b->size & FLAG_MASK);
+}
+
+static inline swift_heap_block_t* block_next(swift_heap_block_t* b) {
+    return (swift_heap_block_t*)(payload_of(b) + block_size(b));
+}
+
+static inline int fls_u32(uint32_t x) { return x ? 31 - __builtin_clz(x) : -1; }
+static inline int ffs_u32(uint32_t x) { return x ? __builtin_ctz(x) : -1; }
+
+static inline int fls_size(size_t x) {
+#if SIZE_MAX > 0xFFFFFFFFu
+    if (x >> 32) return 32 + fls_u32((uint32_t)(x >> 32));
+#endif
+    return fls_u32((uint32_t)x);
+}
+
+// ----------------------
+// Size class mapping
+// ----------------------
+
+static void mapping_insert(size_t size, int* fl, int* sl) {
+    if (size < SMALL_BLOCK) {
+        *fl = 0;
+        *sl = (int)(size / (SMALL_BLOCK / SL_COUNT));
+        return;
+    }
+    int f = fls_size(size);
+    *sl = (int)((size >> (f - SL_LOG2)) ^ SL_COUNT);
+    *fl = f - (FL_SHIFT - 1);
+}
+
+// Rounds up so any block in the resulting list is large enough.
+static void mapping_search(size_t size, int* fl, int* sl) {
+    if (size >= SMALL_BLOCK) {
+        size += ((size_t)1 << (fls_size(size) - SL_LOG2)) - 1;
+    }
+    mapping_insert(size, fl, sl);
+}
+
+// ----------------------
+// Free lists
+// ----------------------
+
+static void list_remove(swift_heap_block_t* b, int fl, int sl) {
+    swift_heap_links_t* l = links_of(b);
+    if (l->prev) links_of(l->prev)->next = l->next;
+    if (l->next) links_of(l->next)->prev = l->prev;
+
+    if (g_heap.lists[fl][sl] == b) {
+        g_heap.lists[fl][sl] = l->next;
+        if (!l->next) {
+            g_heap.sl_bitmap[fl] &= ~(1u << sl);
+            if (!g_heap.sl_bitmap[fl]) g_heap.fl_bitmap &= ~(1u << fl);
+        }
+    }
+}
+
+static void list_insert(swift_heap_block_t* b, int fl, int sl) {
+    swift_heap_block_t* head = g_heap.lists[fl][sl];
+    swift_heap_links_t* l = links_of(b);
+    l->prev = NULL;
+    l->next = head;
+    if (head) links_of(head)->prev = b;
+
+    g_heap.lists[fl][sl] = b;
+    g_heap.fl_bitmap |= (1u << fl);
+    g_heap.sl_bitmap[fl] |= (1u << sl);
+}
+
+static void block_insert(swift_heap_block_t* b) {
+    int fl, sl;
+    mapping_insert(block_size(b), &fl, &sl);
+    b->size |= FLAG_FREE;
+    list_insert(b, fl, sl);
+    g_heap.free_bytes += block_size(b);
+}
+
+static void block_remove(swift_heap_block_t* b) {
+    int fl, sl;
+    mapping_insert(block_size(b), &fl, &sl);
+    list_remove(b, fl, sl);
+    b->size &= ~FLAG_FREE;
+    g_heap.free_bytes -= block_size(b);
+}
+
+static swift_heap_block_t* find_suitable(size_t size) {
+    int fl, sl;
+    mapping_search(size, &fl, &sl);
+    if (fl >= (int)FL_COUNT) return NULL;
+
+    uint32_t sl_map = g_heap.sl_bitmap[fl] & (~0u << sl);
+    if (!sl_map) {
+        uint32_t fl_map = (fl + 1 < 32) ? (g_heap.fl_bitmap & (~0u << (fl + 1))) : 0;
+        if (!fl_map) return NULL;
+        fl = ffs_u32(fl_map);
+        sl_map = g_heap.sl_bitmap[fl];
+    }
+    sl = ffs_u32(sl_map);
+    return g_heap.lists[fl][sl];
+}
+
+// ----------------------
+// Split / merge
+// ----------------------
+
+// Carves the tail of a USED block back into the free lists when it is big enough.
+static void block_trim(swift_heap_block_t* b, size_t size) {
+    size_t have = block_size(b);
+    if (have < size + MIN_BLOCK) return;
+
+    swift_heap_block_t* rest = (swift_heap_block_t*)(payload_of(b) + size);
+    rest->prev_phys = b;
+    rest->size = have - size - HDR_SIZE;
+    block_set_size(b, size);
+
+    // b came off a free list, so its neighbours are USED (or too big to merge with).
+    block_next(rest)->prev_phys = rest;
+    block_insert(rest);
+}
+
+// Splits `gap` bytes off the front of a USED block; the front becomes free.
+static swift_heap_block_t* block_trim_leading(swift_heap_block_t* b, size_t gap) {
+    swift_heap_block_t* aligned = (swift_heap_block_t*)((uint8_t*)b + gap);
+    aligned->prev_phys = b;
+    aligned->size = block_size(b) - gap;
+    block_next(aligned)->prev_phys = aligned;
+
+    b->size = gap - HDR_SIZE;
+    block_insert(b);
+    return aligned;
+}
+
+// Merged blocks must still map to a first-level class (regions > BLOCK_MAX stay split).
+static inline int can_merge(const swift_heap_block_t* a, const swift_heap_block_t* b) {
+    return block_size(a) + HDR_SIZE + block_size(b) <= BLOCK_MAX - HEAP_ALIGN;
+}
+
+// ----------------------
+// Public API
+// ----------------------
+
+int swift_heap_init(void* mem, size_t bytes) {
+    memset(&g_heap, 0, sizeof(g_heap));
+    if (!mem) return 0;
+
+    uint8_t* begin = (uint8_t*)ALIGN_UP((uintptr_t)mem, HEAP_ALIGN);
+    uint8_t* end = (uint8_t*)((uintptr_t)((uint8_t*)mem + bytes) & ~(uintptr_t)(HEAP_ALIGN - 1));
+    if (end <= begin || (size_t)(end - begin) < MIN_BLOCK + HDR_SIZE) return 0;
+
+    g_heap.begin = begin;
+    g_heap.end = end;
+
+    // Carve the region into blocks no larger than BLOCK_MAX, then close it with a sentinel.
+    swift_heap_block_t* prev = NULL;
+    uint8_t* at = begin;
+    for (;;) {
+        size_t left = (size_t)(end - at) - HDR_SIZE; // keep room for the sentinel
+        if (left < MIN_BLOCK) break;
+
+        size_t payload = left - HDR_SIZE;
+        if (payload > BLOCK_MAX - HEAP_ALIGN) payload = BLOCK_MAX - HEAP_ALIGN;
+
+        swift_heap_block_t* b = (swift_heap_block_t*)at;
+        b->prev_phys = prev;
+        b->size = payload;
+        block_insert(b);
+
+        prev = b;
+        at = payload_of(b) + payload;
+    }
+
+    swift_heap_block_t* sentinel = (swift_heap_block_t*)at;
+    sentinel->prev_phys = prev;
+    sentinel->size = 0;
+
+    g_heap.capacity = g_heap.free_bytes;
+    g_heap.ready = 1;
+    return 1;
+}
+
+int swift_heap_ready(void) {
+    return g_heap.ready;
+}
+
+void* swift_heap_alloc(size_t size, size_t align) {
+    if (!g_heap.ready) return NULL;
+    if (align < HEAP_ALIGN) align = HEAP_ALIGN;
+    if ((align & (align - 1)) != 0) return NULL;
+    if (size > BLOCK_MAX / 2) return NULL;
+
+    size = ALIGN_UP(size < MIN_PAYLOAD ? MIN_PAYLOAD : size, HEAP_ALIGN);
+
+    // Over-aligned requests search for enough slack to split off a leading free block.
+    size_t search = size;
+    if (align > HEAP_ALIGN) search += align + MIN_BLOCK;
+
+    swift_heap_block_t* b = find_suitable(search);
+    if (!b) return NULL;
+    block_remove(b);
+
+    if (align > HEAP_ALIGN) {
+        uintptr_t p = (uintptr_t)payload_of(b);
+        uintptr_t aligned = ALIGN_UP(p, align);
+        size_t gap = (size_t)(aligned - p);
+
+        // The leading remainder must itself be a valid free block.
+        while (gap != 0 && gap < MIN_BLOCK) {
+            aligned += align;
+            gap += align;
+        }
+        if (gap) b = block_trim_leading(b, gap);
+    }
+
+    block_trim(b, size);
+    return payload_of(b);
+}
+
+void swift_heap_free(void* p) {
+    if (!p || !swift_heap_owns(p)) return;
+
+    swift_heap_block_t* b = block_of(p);
+    if (block_is_free(b)) return; // double free: ignore rather than corrupt the lists
+
+    swift_heap_block_t* prev = b->prev_phys;
+    if (prev && block_is_free(prev) && can_merge(prev, b)) {
+        block_remove(prev);
+        prev->size += HDR_SIZE + block_size(b);
+        b = prev;
+        block_next(b)->prev_phys = b;
+    }
+
+    swift_heap_block_t* next = block_next(b);
+    if (block_is_free(next) && can_merge(b, next)) {
+        block_remove(next);
+        b->size += HDR_SIZE + block_size(next);
+        block_next(b)->prev_phys = b;
+    }
+
+    block_insert(b);
+}
+
+int swift_heap_owns(const void* p) {
+    const uint8_t* u = (const uint8_t*)p;
+    return g_heap.ready && u >= g_heap.begin + HDR_SIZE && u < g_heap.end;
+}
+
+size_t swift_heap_block_size(const void* p) {
+    if (!p || !swift_heap_owns(p)) return 0;
+    return block_size(block_of(p));
+}
+
+size_t swift_heap_capacity(void) {
+    return g_heap.capacity;
+}
+
+size_t swift_heap_free_bytes(void) {
+    return g_heap.free_bytes;
+}
+
+size_t swift_heap_largest_free(void) {
+    if (!g_heap.fl_bitmap) return 0;
+
+    int fl = fls_u32(g_heap.fl_bitmap);
+    int sl = fls_u32(g_heap.sl_bitmap[fl]);
+
+    // Only the top list can hold the largest block; its members differ by < one slice.
+    size_t best = 0;
+    for (swift_heap_block_t* b = g_heap.lists[fl][sl]; b; b = links_of(b)->next) {
+        if (block_size(b) > best) best = block_size(b);
+    }
+    return best;
+}
+
+// ----------------------
+// Runtime hookup (ARDUINO_SWIFT_HEAP_TLSF=1)
+// ----------------------
+// posix_memalign (SwiftRuntimeSupport) allocates from the arena via
+// swift_heap_runtime_alloc(). free() is link-wrapped in SwiftMemory.c, which
+// hands arena pointers back here so they never reach newlib.
+
+#if defined(ARDUINO_SWIFT_HEAP_TLSF) && ARDUINO_SWIFT_HEAP_TLSF
+
+#ifndef ARDUINO_SWIFT_HEAP_SIZE
+#define ARDUINO_SWIFT_HEAP_SIZE 16384
+#endif
+
+#if defined(ARDUINO_SWIFT_HEAP_SECTION)
+#define SWIFT_HEAP_ARENA_ATTR __attribute__((aligned(8), section(ARDUINO_SWIFT_HEAP_SECTION)))
+#else
+#define SWIFT_HEAP_ARENA_ATTR __attribute__((aligned(8)))
+#endif
+
+static uint8_t g_heap_arena[ARDUINO_SWIFT_HEAP_SIZE] SWIFT_HEAP_ARENA_ATTR;
+
+void* swift_heap_runtime_alloc(size_t size, size_t align) {
+    if (!g_heap.ready) (void)swift_heap_init(g_heap_arena, sizeof(g_heap_arena));
+    return swift_heap_alloc(size, align);
+}
+
+#endif
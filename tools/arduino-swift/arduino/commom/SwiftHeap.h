@@ -0,0 +1,64 @@
+// SwiftHeap.h
+// Optional O(1) allocator (TLSF) for Embedded Swift allocations.
+//
+// Rules:
+// - Pure C, no Arduino.h (also compiles on the host).
+// - One heap per program, over a caller-provided region.
+// - Enabled for Swift only when ARDUINO_SWIFT_HEAP_TLSF=1 (set by the build
+//   from config.json "heap"); otherwise the runtime keeps using newlib malloc.
+//
+// Build flags (all optional):
+//   ARDUINO_SWIFT_HEAP_TLSF      1 = route posix_memalign/free through this heap
+//   ARDUINO_SWIFT_HEAP_SIZE      static arena size in bytes (default 16384)
+//   ARDUINO_SWIFT_HEAP_SECTION   linker section for the arena (e.g. ".sdram")
+//   ARDUINO_SWIFT_HEAP_SL_LOG2   second-level classes per power of two (log2, default 4)
+//   ARDUINO_SWIFT_HEAP_FL_MAX    log2 of the largest block (default 20 = 1 MiB)
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------
+// Region setup
+// ----------------------
+
+// Takes ownership of [mem, mem + bytes). Returns 0 if the region is too small.
+// Calling it again discards every previous allocation.
+int    swift_heap_init(void* mem, size_t bytes);
+int    swift_heap_ready(void);
+
+// ----------------------
+// Allocation
+// ----------------------
+
+// `align` must be a power of two (0 = default 8-byte alignment).
+void*  swift_heap_alloc(size_t size, size_t align);
+void   swift_heap_free(void* p);
+
+// True when p was returned by swift_heap_alloc (cheap range check).
+int    swift_heap_owns(const void* p);
+
+// Usable payload size of an allocated block.
+size_t swift_heap_block_size(const void* p);
+
+// ----------------------
+// Introspection
+// ----------------------
+size_t swift_heap_capacity(void);
+size_t swift_heap_free_bytes(void);
+size_t swift_heap_largest_free(void);
+
+// ----------------------
+// Runtime hookup (ARDUINO_SWIFT_HEAP_TLSF=1 only)
+// ----------------------
+
+// Lazily initializes the static arena, then allocates. NULL -> caller falls back to malloc.
+void*  swift_heap_runtime_alloc(size_t size, size_t align);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
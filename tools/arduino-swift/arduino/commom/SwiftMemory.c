@@ -0,0 +1,298 @@
+// SwiftMemory.c
+// Heap counters, malloc/free link wraps and stack painting (see SwiftMemory.h).
+//
+// Counting is on by default (config.json "heap": { "stats": "on" } ->
+// ARDUINO_SWIFT_MEM_STATS=1 plus the malloc/calloc/free/realloc link wraps).
+// Counters are updated with relaxed 32-bit atomics: Giga RTX threads (and ISRs)
+// can allocate concurrently, and every supported core has LDREX/STREX.
+//
+// The free/realloc wraps are also linked for the TLSF heap without stats: they
+// route arena pointers back to SwiftHeap.c.
+
+#include "SwiftMemory.h"
+#include "SwiftHeap.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+size_t malloc_usable_size(void* p);
+
+// ----------------------
+// Counters
+// ----------------------
+
+typedef struct {
+    uint32_t live;
+    uint32_t peak;
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t failed;
+    uint32_t buckets[ARDUINO_MEM_BUCKETS];
+} swift_mem_counters_t;
+
+static swift_mem_counters_t g_mem;
+
+static inline uint32_t bucket_of(size_t n) {
+    if (n <= 16) return 0;
+    uint32_t b = (uint32_t)(31 - __builtin_clz((uint32_t)(n - 1))) - 3u; // 17..32 -> 1, ...
+    return b < ARDUINO_MEM_BUCKETS ? b : ARDUINO_MEM_BUCKETS - 1u;
+}
+
+static inline size_t usable_size(void* p) {
+    if (swift_heap_owns(p)) return swift_heap_block_size(p);
+    return malloc_usable_size(p);
+}
+
+static inline void counter_inc(uint32_t* c) {
+    (void)__atomic_fetch_add(c, 1u, __ATOMIC_RELAXED);
+}
+
+static inline void live_add(size_t n) {
+    uint32_t live = __atomic_add_fetch(&g_mem.live, (uint32_t)n, __ATOMIC_RELAXED);
+    uint32_t peak = __atomic_load_n(&g_mem.peak, __ATOMIC_RELAXED);
+    while (live > peak &&
+           !__atomic_compare_exchange_n(&g_mem.peak, &peak, live, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static inline void live_sub(size_t n) {
+    // Blocks allocated before counting started (or by newlib internals) can be freed here.
+    uint32_t live = __atomic_load_n(&g_mem.live, __ATOMIC_RELAXED);
+    uint32_t next;
+    do {
+        next = (live > (uint32_t)n) ? live - (uint32_t)n : 0u;
+    } while (!__atomic_compare_exchange_n(&g_mem.live, &live, next, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+#if defined(ARDUINO_SWIFT_MEM_STATS) && ARDUINO_SWIFT_MEM_STATS
+
+void swift_mem_note_alloc(void* p, size_t requested) {
+    if (!p) {
+        if (requested) counter_inc(&g_mem.failed);
+        return;
+    }
+    counter_inc(&g_mem.allocs);
+    counter_inc(&g_mem.buckets[bucket_of(requested)]);
+    live_add(usable_size(p));
+}
+
+void swift_mem_note_free(void* p) {
+    if (!p) return;
+    counter_inc(&g_mem.frees);
+    live_sub(usable_size(p));
+}
+
+#else
+
+void swift_mem_note_alloc(void* p, size_t requested) {
+    (void)p;
+    (void)requested;
+}
+
+void swift_mem_note_free(void* p) {
+    (void)p;
+}
+
+#endif
+
+// ----------------------
+// Link wraps
+// ----------------------
+// stats:       -Wl,--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=realloc
+// TLSF only:   -Wl,--wrap=free,--wrap=realloc
+
+#if defined(ARDUINO_SWIFT_MEM_STATS) && ARDUINO_SWIFT_MEM_STATS
+
+void* __real_malloc(size_t n);
+void* __real_calloc(size_t count, size_t n);
+
+void* __wrap_malloc(size_t n) {
+    void* p = __real_malloc(n);
+    swift_mem_note_alloc(p, n);
+    return p;
+}
+
+void* __wrap_calloc(size_t count, size_t n) {
+    void* p = __real_calloc(count, n);
+    swift_mem_note_alloc(p, count * n);
+    return p;
+}
+
+#endif
+
+#if (defined(ARDUINO_SWIFT_MEM_STATS) && ARDUINO_SWIFT_MEM_STATS) || \
+    (defined(ARDUINO_SWIFT_HEAP_TLSF) && ARDUINO_SWIFT_HEAP_TLSF)
+
+void  __real_free(void* p);
+void* __real_realloc(void* p, size_t n);
+
+// malloc is only wrapped (and counted) with stats; TLSF-only builds call newlib directly.
+#if defined(ARDUINO_SWIFT_MEM_STATS) && ARDUINO_SWIFT_MEM_STATS
+#define newlib_malloc __real_malloc
+#define counted_malloc __wrap_malloc
+#else
+#define newlib_malloc malloc
+#define counted_malloc malloc
+#endif
+
+void __wrap_free(void* p) {
+    if (!p) return;
+    swift_mem_note_free(p);
+
+    // TLSF arena pointers (ARDUINO_SWIFT_HEAP_TLSF) must never reach newlib.
+    if (swift_heap_owns(p)) {
+        swift_heap_free(p);
+        return;
+    }
+    __real_free(p);
+}
+
+// Arena blocks stay in the arena: newlib only sees them as the overflow path,
+// exactly like posix_memalign when the arena is full.
+static void* realloc_arena(void* p, size_t n) {
+    size_t have = swift_heap_block_size(p);
+    if (n <= have) return p;
+
+    void* q = swift_heap_alloc(n, 0);
+    if (!q) q = newlib_malloc(n);
+    swift_mem_note_alloc(q, n);
+    if (!q) return NULL;
+
+    memcpy(q, p, have);
+    __wrap_free(p);
+    return q;
+}
+
+void* __wrap_realloc(void* p, size_t n) {
+    if (!p) return counted_malloc(n);
+    if (n == 0) {
+        __wrap_free(p);
+        return NULL;
+    }
+
+    if (swift_heap_owns(p)) return realloc_arena(p, n);
+
+#if defined(ARDUINO_SWIFT_MEM_STATS) && ARDUINO_SWIFT_MEM_STATS
+    size_t before = malloc_usable_size(p);
+    void* q = __real_realloc(p, n);
+    if (!q) {
+        counter_inc(&g_mem.failed);
+        return NULL;
+    }
+    live_sub(before);
+    live_add(malloc_usable_size(q));
+    return q;
+#else
+    return __real_realloc(p, n);
+#endif
+}
+
+#endif
+
+// ----------------------
+// Board hooks (weak defaults: unknown)
+// ----------------------
+
+__attribute__((weak))
+int arduino_stack_region(uintptr_t* lo, uintptr_t* hi) {
+    (void)lo;
+    (void)hi;
+    return 0;
+}
+
+__attribute__((weak))
+uint32_t arduino_heap_headroom(void) {
+    return 0;
+}
+
+// ----------------------
+// Stack painting
+// ----------------------
+
+#ifndef ARDUINO_SWIFT_STACK_PAINT_MARGIN
+#define ARDUINO_SWIFT_STACK_PAINT_MARGIN 128u
+#endif
+
+#define STACK_PAINT 0xA5A5A5A5u
+
+static uintptr_t g_paint_lo;
+static uintptr_t g_paint_hi;  // top of the painted words
+static uintptr_t g_stack_hi;
+
+// noinline: keeps our own frame (and everything above it) out of the painted range.
+__attribute__((noinline))
+void arduino_mem_paint_stack(void) {
+    uintptr_t lo = 0, hi = 0;
+    if (!arduino_stack_region(&lo, &hi) || hi <= lo) return;
+
+    uintptr_t sp = (uintptr_t)__builtin_frame_address(0);
+    if (sp <= lo || sp > hi) return;
+
+    uintptr_t top = (sp - ARDUINO_SWIFT_STACK_PAINT_MARGIN) & ~(uintptr_t)3u;
+    lo = (lo + 3u) & ~(uintptr_t)3u;
+    if (top <= lo) return;
+
+    // Plain loop (no memset call): nothing below sp may be live while we paint.
+    for (volatile uint32_t* w = (volatile uint32_t*)lo; (uintptr_t)w < top; w++) {
+        *w = STACK_PAINT;
+    }
+
+    g_paint_lo = lo;
+    g_paint_hi = top;
+    g_stack_hi = hi;
+}
+
+uint32_t arduino_mem_stack_used(void) {
+    if (!g_stack_hi) return 0;
+
+    // Boards whose heap grows into the stack gap report a moving low bound.
+    uintptr_t start = g_paint_lo;
+    uintptr_t lo = 0, hi = 0;
+    if (arduino_stack_region(&lo, &hi) && lo > start) start = (lo + 3u) & ~(uintptr_t)3u;
+
+    const volatile uint32_t* w = (const volatile uint32_t*)start;
+    while ((uintptr_t)w < g_paint_hi && *w == STACK_PAINT) w++;
+
+    return (uint32_t)(g_stack_hi - (uintptr_t)w);
+}
+
+uint32_t arduino_mem_stack_size(void) {
+    return g_stack_hi ? (uint32_t)(g_stack_hi - g_paint_lo) : 0u;
+}
+
+// ----------------------
+// C ABI
+// ----------------------
+
+uint32_t arduino_mem_stats_enabled(void) {
+#if defined(ARDUINO_SWIFT_MEM_STATS) && ARDUINO_SWIFT_MEM_STATS
+    return 1u;
+#else
+    return 0u;
+#endif
+}
+
+uint32_t arduino_mem_live_bytes(void)   { return g_mem.live; }
+uint32_t arduino_mem_peak_bytes(void)   { return g_mem.peak; }
+uint32_t arduino_mem_alloc_count(void)  { return g_mem.allocs; }
+uint32_t arduino_mem_free_count(void)   { return g_mem.frees; }
+uint32_t arduino_mem_failed_count(void) { return g_mem.failed; }
+
+uint32_t arduino_mem_largest_free(void) {
+    // TLSF: exact. newlib: what sbrk can still hand out (holes in the free lists are not counted).
+    if (swift_heap_ready()) return (uint32_t)swift_heap_largest_free();
+    return arduino_heap_headroom();
+}
+
+uint32_t arduino_mem_bucket_count(uint32_t i) {
+    return (i < ARDUINO_MEM_BUCKETS) ? g_mem.buckets[i] : 0u;
+}
+
+uint32_t arduino_mem_bucket_limit(uint32_t i) {
+    if (i + 1u >= ARDUINO_MEM_BUCKETS) return 0xFFFFFFFFu;
+    return 16u << i;
+}
+
+void arduino_mem_reset_peak(void) {
+    g_mem.peak = g_mem.live;
+}
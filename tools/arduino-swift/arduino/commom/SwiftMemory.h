@@ -0,0 +1,73 @@
+// SwiftMemory.h
+// Heap counters + stack high-water mark (C ABI consumed by Memory.swift).
+//
+// Rules:
+// - Pure C, no Arduino.h.
+// - On by default (ARDUINO_SWIFT_MEM_STATS=1; config.json "heap": { "stats": "off" }
+//   drops it): a handful of atomic adds per allocation, no locks, no tables.
+//   Without it the heap counters read 0, arduino_mem_stats_enabled() returns 0
+//   and malloc/free are not wrapped.
+// - Heap traffic is observed through the linker wraps added by the build
+//   (-Wl,--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=realloc) plus
+//   posix_memalign, which is where Embedded Swift allocates.
+// - Sizes are usable block sizes, so alloc/free always balance.
+// - Stack bounds are board-specific: each API provides arduino_stack_region()
+//   and arduino_heap_headroom(); the weak defaults report "unknown" (0).
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ARDUINO_MEM_BUCKETS 8u
+
+// ----------------------
+// Runtime hooks (called by the allocator shims)
+// ----------------------
+void swift_mem_note_alloc(void* p, size_t requested);
+void swift_mem_note_free(void* p);
+
+// ----------------------
+// Board hooks (api/<api_name>/, weak defaults in SwiftMemory.c)
+// ----------------------
+
+// Current thread's stack [lo, hi). Returns 0 when unknown.
+int      arduino_stack_region(uintptr_t* lo, uintptr_t* hi);
+
+// Bytes the heap can still grow by (sbrk room). 0 when unknown.
+uint32_t arduino_heap_headroom(void);
+
+// ----------------------
+// Stack painting (Bridge.cpp setup())
+// ----------------------
+void     arduino_mem_paint_stack(void);
+
+// ----------------------
+// C ABI (Swift)
+// ----------------------
+// 1 when the heap counters below are kept (ARDUINO_SWIFT_MEM_STATS), else 0.
+uint32_t arduino_mem_stats_enabled(void);
+
+uint32_t arduino_mem_live_bytes(void);
+uint32_t arduino_mem_peak_bytes(void);
+uint32_t arduino_mem_alloc_count(void);
+uint32_t arduino_mem_free_count(void);
+uint32_t arduino_mem_failed_count(void);
+uint32_t arduino_mem_largest_free(void);
+
+// Bucket i counts allocations <= arduino_mem_bucket_limit(i) (last bucket: everything larger).
+uint32_t arduino_mem_bucket_count(uint32_t i);
+uint32_t arduino_mem_bucket_limit(uint32_t i);
+
+// Deepest stack use since painting (bytes) and the painted region size. 0 when unknown.
+uint32_t arduino_mem_stack_used(void);
+uint32_t arduino_mem_stack_size(void);
+
+void     arduino_mem_reset_peak(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
@@ -7,6 +7,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "SwiftHeap.h"
+#include "SwiftMemory.h"
+
 extern "C" {
 
 // -----------------------------
@@ -37,9 +40,18 @@ void arduino_serial_print_u32(uint32_t v) {
   Serial.print(v);
 }
 
+// Digits after the point for a plain print(Double): what the board's shim
+// has always printed (Due: the core's default of 2).
+uint32_t arduino_serial_float_digits(void) {
+  #if defined(ARDUINO_ARCH_SAM) || defined(ARDUINO_SAM_DUE)
+    return 2;
+  #else
+    return 6;
+  #endif
+}
+
 void arduino_serial_print_f64(double v) {
-  // Ajuste a precisão se quiser menos custo
-  Serial.print(v, 6);
+  Serial.print(v, (int)arduino_serial_float_digits());
 }
 
 // -----------------------------
@@ -102,6 +114,10 @@ void arc4random_buf(void* buf, size_t n) {
 // -----------------------------
 // O ideal é usar um allocator alinhado real; aqui tentamos memalign/aligned_alloc,
 // e se não existir, caímos para malloc (geralmente já é 8/16-aligned no ARM).
+//
+// With ARDUINO_SWIFT_HEAP_TLSF=1 (config.json "heap"), Swift allocations come from
+// the TLSF arena in SwiftHeap.c first; newlib is only the overflow path.
+// Every successful path is recorded in SwiftMemory.c (Memory.stats()).
 
 int posix_memalign(void** memptr, size_t alignment, size_t size) {
   if (!memptr) return 22; // EINVAL
@@ -113,6 +129,15 @@ int posix_memalign(void** memptr, size_t alignment, size_t size) {
 
   void* p = nullptr;
 
+  #if defined(ARDUINO_SWIFT_HEAP_TLSF) && ARDUINO_SWIFT_HEAP_TLSF
+    p = swift_heap_runtime_alloc(size, alignment);
+    if (p) {
+      swift_mem_note_alloc(p, size);
+      *memptr = p;
+      return 0;
+    }
+  #endif
+
   // newlib costuma ter memalign()
   #if defined(__NEWLIB__)
     // NOLINTNEXTLINE
@@ -128,7 +153,10 @@ int posix_memalign(void** memptr, size_t alignment, size_t size) {
     }
   #endif
 
-  // Fallback (pode ser suficiente na prática)
+  // memalign/aligned_alloc bypass the malloc wrap, so count them here.
+  if (p) swift_mem_note_alloc(p, size);
+
+  // Fallback (pode ser suficiente na prática). Counted by __wrap_malloc.
   if (!p) {
     p = malloc(size);
   }
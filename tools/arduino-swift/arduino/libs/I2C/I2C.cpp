@@ -15,19 +15,46 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include "I2C.h"
+#include "SpscRing.h"
+#include "I2CQueue.h"
 
 // --------------------------------------------------
 // Configurable capacities
 // --------------------------------------------------
 
+// RX slab bytes, power of two (SpscRing masks indices).
 #ifndef ARDUINO_SWIFT_I2C_SLAVE_RX_CAP
-#define ARDUINO_SWIFT_I2C_SLAVE_RX_CAP 128
+#define ARDUINO_SWIFT_I2C_SLAVE_RX_CAP 256
+#endif
+
+// RX frames (one per master write transaction) queued at once, power of two.
+#ifndef ARDUINO_SWIFT_I2C_SLAVE_RX_FRAMES
+#define ARDUINO_SWIFT_I2C_SLAVE_RX_FRAMES 16
 #endif
 
 #ifndef ARDUINO_SWIFT_I2C_SLAVE_TX_CAP
 #define ARDUINO_SWIFT_I2C_SLAVE_TX_CAP 128
 #endif
 
+// Register response templates answered directly by the onRequest ISR.
+#ifndef ARDUINO_SWIFT_I2C_SLAVE_REG_TX_SLOTS
+#define ARDUINO_SWIFT_I2C_SLAVE_REG_TX_SLOTS 8
+#endif
+
+#ifndef ARDUINO_SWIFT_I2C_SLAVE_REG_TX_CAP
+#define ARDUINO_SWIFT_I2C_SLAVE_REG_TX_CAP 16
+#endif
+
+// TCA9548A-style muxes whose selected channel is cached.
+#ifndef ARDUINO_SWIFT_I2C_MUX_MAX
+#define ARDUINO_SWIFT_I2C_MUX_MAX 4
+#endif
+
+static_assert((ARDUINO_SWIFT_I2C_SLAVE_RX_CAP & (ARDUINO_SWIFT_I2C_SLAVE_RX_CAP - 1)) == 0,
+              "ARDUINO_SWIFT_I2C_SLAVE_RX_CAP must be a power of two");
+static_assert((ARDUINO_SWIFT_I2C_SLAVE_RX_FRAMES & (ARDUINO_SWIFT_I2C_SLAVE_RX_FRAMES - 1)) == 0,
+              "ARDUINO_SWIFT_I2C_SLAVE_RX_FRAMES must be a power of two");
+
 // --------------------------------------------------
 // Slave state (ISR-shared)
 // --------------------------------------------------
@@ -35,36 +62,87 @@
 static volatile uint8_t  gI2CSlaveOnReceive = 0;
 static volatile uint8_t  gI2CSlaveOnRequest = 0;
 
-static volatile uint8_t  gI2CRxBuf[ARDUINO_SWIFT_I2C_SLAVE_RX_CAP];
-static volatile uint32_t gI2CRxHead = 0;
-static volatile uint32_t gI2CRxTail = 0;
-
-static volatile uint8_t  gI2CTxBuf[ARDUINO_SWIFT_I2C_SLAVE_TX_CAP];
-static volatile uint32_t gI2CTxLen = 0;
+// RX: onReceive ISR produces, Swift consumes. Lock-free, no interrupt masking.
+// Each master write becomes one frame: its bytes sit contiguously in the slab
+// (a frame that would straddle the wrap starts at slab[0], the tail end is
+// padding) and a descriptor in gI2CRxFrames records where it ends.
+typedef struct {
+  uint32_t end;   // slab index just past the frame (free-running)
+  uint32_t len;
+} i2c_rx_frame_t;
+
+static uint8_t        gI2CRxStorage[ARDUINO_SWIFT_I2C_SLAVE_RX_CAP];
+static arduino_spsc_t gI2CRx = { gI2CRxStorage, 1, ARDUINO_SWIFT_I2C_SLAVE_RX_CAP - 1, 0, 0, 0 };
+
+static i2c_rx_frame_t gI2CRxFrameStorage[ARDUINO_SWIFT_I2C_SLAVE_RX_FRAMES];
+static arduino_spsc_t gI2CRxFrames = {
+  (uint8_t*)gI2CRxFrameStorage, sizeof(i2c_rx_frame_t), ARDUINO_SWIFT_I2C_SLAVE_RX_FRAMES - 1, 0, 0, 0
+};
+
+static volatile uint32_t gI2CRxBytesIn = 0;   // ISR: payload bytes queued
+static uint32_t          gI2CRxBytesOut = 0;  // loop: payload bytes consumed
+static uint32_t          gI2CRxFrameOff = 0;  // loop: bytes already read from the oldest frame
+
+// TX: double buffer. Swift fills the back one, then publish() flips gI2CTxFront;
+// the ISR hands the front one straight to Wire.write. The ISR never runs
+// interleaved with a loop-side write to the same buffer, so no masking and no copy.
+static uint8_t           gI2CTxBuf[2][ARDUINO_SWIFT_I2C_SLAVE_TX_CAP];
+static uint32_t          gI2CTxLen[2] = { 0, 0 };
+static volatile uint8_t  gI2CTxFront = 0;
+
+// Register templates: a request following a write whose first byte is `reg` is
+// answered from `data`. len == 0 marks a slot as off (also while it is rewritten).
+typedef struct {
+  volatile uint32_t len;
+  uint8_t used;
+  uint8_t reg;
+  uint8_t data[ARDUINO_SWIFT_I2C_SLAVE_REG_TX_CAP];
+} i2c_reg_tx_t;
+
+static i2c_reg_tx_t     gI2CRegTx[ARDUINO_SWIFT_I2C_SLAVE_REG_TX_SLOTS];
+static volatile int16_t gI2CLastReg = -1;   // ISR: first byte of the last master write
 
 // --------------------------------------------------
-// RX ring buffer helpers (ISR-safe by design)
+// Mux channel cache (main context only)
 // --------------------------------------------------
 
-static inline uint32_t i2c_rx_count_unsafe(void) {
-  uint32_t h = gI2CRxHead;
-  uint32_t t = gI2CRxTail;
-  if (h >= t) return h - t;
-  return ARDUINO_SWIFT_I2C_SLAVE_RX_CAP - (t - h);
-}
+struct I2CMux {
+  uint8_t address;
+  uint8_t used;
+  uint8_t known;    // mask matches the mux (cleared on a failed write / invalidate)
+  uint8_t mask;     // control register: bit n = channel n enabled
+};
+
+static I2CMux   gI2CMux[ARDUINO_SWIFT_I2C_MUX_MAX];
+static uint32_t gI2CMuxWrites = 0;
+static uint32_t gI2CMuxSkips = 0;
 
-static inline void i2c_rx_push_unsafe(uint8_t b) {
-  uint32_t next = (gI2CRxHead + 1u) % ARDUINO_SWIFT_I2C_SLAVE_RX_CAP;
-  if (next == gI2CRxTail) return; // overflow -> drop
-  gI2CRxBuf[gI2CRxHead] = b;
-  gI2CRxHead = next;
+static uint8_t i2c_mux_write(I2CMux* m, uint8_t address, uint8_t mask) {
+  Wire.beginTransmission((int)address);
+  Wire.write(mask);
+  const uint8_t st = (uint8_t)Wire.endTransmission(true);
+  gI2CMuxWrites++;
+  if (m) {
+    m->known = (st == 0);
+    m->mask = mask;
+  }
+  return st;
 }
 
-static inline int32_t i2c_rx_pop_unsafe(void) {
-  if (gI2CRxTail == gI2CRxHead) return -1;
-  uint8_t v = gI2CRxBuf[gI2CRxTail];
-  gI2CRxTail = (gI2CRxTail + 1u) % ARDUINO_SWIFT_I2C_SLAVE_RX_CAP;
-  return (int32_t)v;
+static I2CMux* i2c_mux_entry(uint8_t address) {
+  I2CMux* free_slot = NULL;
+  for (uint32_t i = 0; i < ARDUINO_SWIFT_I2C_MUX_MAX; i++) {
+    I2CMux* m = &gI2CMux[i];
+    if (m->used && m->address == address) return m;
+    if (!m->used && !free_slot) free_slot = m;
+  }
+  if (free_slot) {
+    free_slot->address = address;
+    free_slot->used = 1;
+    free_slot->known = 0;
+    free_slot->mask = 0;
+  }
+  return free_slot;   // NULL: table full, no caching for this mux
 }
 
 // --------------------------------------------------
@@ -73,33 +151,68 @@ static inline int32_t i2c_rx_pop_unsafe(void) {
 
 static void i2c_onReceive_isr(int count) {
   gI2CSlaveOnReceive = 1;
+  if (count < 0) count = 0;
+
+  const uint32_t n = (uint32_t)count;
+  uint32_t span = 0;
+  uint8_t* dst = arduino_spsc_write_span(&gI2CRx, &span);
+  const uint32_t haveDesc = arduino_spsc_free(&gI2CRxFrames) != 0;
+
+  // Frame would straddle the wrap: pad to the end and start at slab[0].
+  if (haveDesc && dst && span < n && arduino_spsc_free(&gI2CRx) - span >= n) {
+    arduino_spsc_write_commit(&gI2CRx, span);
+    dst = arduino_spsc_write_span(&gI2CRx, &span);
+  }
+
+  // No room for the whole frame (or its descriptor): drain Wire, count the bytes.
+  if (!haveDesc || (n > 0 && (!dst || span < n))) {
+    for (uint32_t i = 0; i < n; i++) {
+      if (Wire.read() < 0) break;
+    }
+    arduino_spsc_note_overflow(&gI2CRx, n);
+    return;
+  }
 
-  while (count-- > 0) {
+  uint32_t got = 0;
+  while (got < n) {
     int v = Wire.read();
     if (v < 0) break;
-    i2c_rx_push_unsafe((uint8_t)v);
+    dst[got++] = (uint8_t)v;
   }
+  arduino_spsc_write_commit(&gI2CRx, got);
+  if (got > 0) gI2CLastReg = (int16_t)dst[0];
+
+  i2c_rx_frame_t f;
+  f.end = gI2CRx.head;
+  f.len = got;
+  gI2CRxBytesIn = gI2CRxBytesIn + got;
+  arduino_spsc_push(&gI2CRxFrames, &f);
 }
 
 static void i2c_onRequest_isr(void) {
   gI2CSlaveOnRequest = 1;
 
-  // In ISR context already. Main context updates TX under noInterrupts().
-  uint32_t copyLen = gI2CTxLen;
-  if (copyLen > ARDUINO_SWIFT_I2C_SLAVE_TX_CAP)
-    copyLen = ARDUINO_SWIFT_I2C_SLAVE_TX_CAP;
+  const int16_t reg = gI2CLastReg;
+  if (reg >= 0) {
+    for (uint32_t i = 0; i < ARDUINO_SWIFT_I2C_SLAVE_REG_TX_SLOTS; i++) {
+      i2c_reg_tx_t* t = &gI2CRegTx[i];
+      const uint32_t len = t->len;
+      if (len != 0 && t->reg == (uint8_t)reg) {
+        ARDUINO_SPSC_DMB();
+        Wire.write(t->data, (size_t)len);
+        return;
+      }
+    }
+  }
 
-  if (copyLen == 0) {
+  const uint8_t f = gI2CTxFront;
+  ARDUINO_SPSC_DMB();
+  const uint32_t len = gI2CTxLen[f];
+  if (len == 0) {
     Wire.write((uint8_t)0);
     return;
   }
-
-  // Copy to a non-volatile temp (Wire.write wants a normal pointer)
-  uint8_t tmp[ARDUINO_SWIFT_I2C_SLAVE_TX_CAP];
-  for (uint32_t i = 0; i < copyLen; i++)
-    tmp[i] = gI2CTxBuf[i];
-
-  Wire.write(tmp, (size_t)copyLen);
+  Wire.write(gI2CTxBuf[f], (size_t)len);
 }
 
 // --------------------------------------------------
@@ -118,6 +231,7 @@ void arduino_i2c_begin(void) {
 
 void arduino_i2c_setClock(uint32_t hz) {
   Wire.setClock((unsigned long)hz);
+  arduino_i2cq_set_clock(hz);
 }
 
 void arduino_i2c_beginTransmission(uint8_t address) {
@@ -153,15 +267,116 @@ int32_t arduino_i2c_read(void) {
   return (int32_t)Wire.read();
 }
 
+uint32_t arduino_i2c_read_buf(uint8_t* out, uint32_t cap) {
+  if (!out) return 0;
+
+  uint32_t n = 0;
+  while (n < cap && Wire.available() > 0) {
+    int v = Wire.read();
+    if (v < 0) break;
+    out[n++] = (uint8_t)v;
+  }
+  return n;
+}
+
+int32_t arduino_i2c_transfer(uint8_t address,
+                             const uint8_t* tx, uint32_t txLen,
+                             uint8_t* rx, uint32_t rxLen,
+                             uint32_t flags) {
+  if (!tx) txLen = 0;
+  if (!rx) rxLen = 0;
+
+  const bool holdBus = (flags & ARDUINO_I2C_XFER_NO_STOP) != 0;
+
+  // Write phase (also a bare address probe when there is nothing to read).
+  if (txLen > 0 || rxLen == 0) {
+    const bool stop = (rxLen > 0) ? (flags & ARDUINO_I2C_XFER_STOP_BETWEEN) != 0 : !holdBus;
+
+    Wire.beginTransmission((int)address);
+    if (txLen > 0) Wire.write(tx, (size_t)txLen);
+    const uint8_t st = (uint8_t)Wire.endTransmission(stop);
+    if (st != 0) return -(int32_t)st;
+  }
+
+  if (rxLen == 0) return 0;
+
+  // Read phase (repeated start unless STOP_BETWEEN).
+  const uint32_t got = (uint32_t)Wire.requestFrom((int)address, (int)rxLen, (int)(holdBus ? 0 : 1));
+  return (int32_t)arduino_i2c_read_buf(rx, got < rxLen ? got : rxLen);
+}
+
+// ============================================================
+// I2C (Wire) - Mux
+// ============================================================
+
+uint8_t arduino_i2c_mux_select(uint8_t mux, uint8_t channel) {
+  const uint8_t want = (channel < 8) ? (uint8_t)(1u << channel) : 0u;
+  I2CMux* m = i2c_mux_entry(mux);
+
+  // Close the other muxes first, so identical devices behind them stay off the bus.
+  if (want != 0) {
+    for (uint32_t i = 0; i < ARDUINO_SWIFT_I2C_MUX_MAX; i++) {
+      I2CMux* o = &gI2CMux[i];
+      if (!o->used || o == m) continue;
+      if (o->known && o->mask == 0) continue;
+      (void)i2c_mux_write(o, o->address, 0);
+    }
+  }
+
+  if (m && m->known && m->mask == want) {
+    gI2CMuxSkips++;
+    return 0;
+  }
+  return i2c_mux_write(m, mux, want);
+}
+
+void arduino_i2c_mux_invalidate(void) {
+  for (uint32_t i = 0; i < ARDUINO_SWIFT_I2C_MUX_MAX; i++) {
+    gI2CMux[i].known = 0;
+  }
+}
+
+uint32_t arduino_i2c_mux_stats(uint32_t* skipped) {
+  if (skipped) *skipped = gI2CMuxSkips;
+  return gI2CMuxWrites;
+}
+
+int32_t arduino_i2c_mux_transfer(uint8_t mux, uint8_t channel, uint8_t address,
+                                 const uint8_t* tx, uint32_t txLen,
+                                 uint8_t* rx, uint32_t rxLen,
+                                 uint32_t flags) {
+  const uint8_t st = arduino_i2c_mux_select(mux, channel);
+  if (st != 0) return -(int32_t)st;
+  return arduino_i2c_transfer(address, tx, txLen, rx, rxLen, flags);
+}
+
+// I2CQueue.h blocking fallback (boards without an async backend).
+int32_t arduino_i2cq_blocking_transfer(uint8_t address,
+                                       const uint8_t* tx, uint32_t txLen,
+                                       uint8_t* rx, uint32_t rxLen,
+                                       uint32_t flags) {
+  return arduino_i2c_transfer(address, tx, txLen, rx, rxLen, flags);
+}
+
 // ============================================================
 // I2C (Wire) - Slave
 // ============================================================
 
 void arduino_i2c_slave_begin(uint8_t address) {
   noInterrupts();
-  gI2CRxHead = 0;
-  gI2CRxTail = 0;
-  gI2CTxLen = 0;
+  arduino_spsc_init(&gI2CRx, gI2CRxStorage, 1, ARDUINO_SWIFT_I2C_SLAVE_RX_CAP);
+  arduino_spsc_init(&gI2CRxFrames, gI2CRxFrameStorage, sizeof(i2c_rx_frame_t), ARDUINO_SWIFT_I2C_SLAVE_RX_FRAMES);
+  gI2CRxBytesIn = 0;
+  gI2CRxBytesOut = 0;
+  gI2CRxFrameOff = 0;
+  gI2CTxLen[0] = 0;
+  gI2CTxLen[1] = 0;
+  gI2CTxFront = 0;
+  gI2CLastReg = -1;
+  for (uint32_t i = 0; i < ARDUINO_SWIFT_I2C_SLAVE_REG_TX_SLOTS; i++) {
+    gI2CRegTx[i].len = 0;
+    gI2CRegTx[i].used = 0;
+  }
   gI2CSlaveOnReceive = 0;
   gI2CSlaveOnRequest = 0;
   interrupts();
@@ -171,58 +386,137 @@ void arduino_i2c_slave_begin(uint8_t address) {
   Wire.onRequest(i2c_onRequest_isr);
 }
 
-uint32_t arduino_i2c_slave_rx_available(void) {
-  noInterrupts();
-  uint32_t c = i2c_rx_count_unsafe();
-  interrupts();
-  return c;
+// Frames: borrowed views into the slab, oldest first.
+
+uint32_t arduino_i2c_slave_rx_frames(void) {
+  return arduino_spsc_count(&gI2CRxFrames);
 }
 
-int32_t arduino_i2c_slave_rx_read(void) {
-  noInterrupts();
-  int32_t v = i2c_rx_pop_unsafe();
-  interrupts();
-  return v;
+const uint8_t* arduino_i2c_slave_rx_frame_peek(uint32_t* len) {
+  uint32_t n = 0;
+  const i2c_rx_frame_t* f = (const i2c_rx_frame_t*)arduino_spsc_read_span(&gI2CRxFrames, &n);
+  if (!f) {
+    if (len) *len = 0;
+    return NULL;
+  }
+  if (len) *len = f->len - gI2CRxFrameOff;
+  return arduino_spsc_slot(&gI2CRx, f->end - f->len + gI2CRxFrameOff);
+}
+
+void arduino_i2c_slave_rx_frame_release(void) {
+  uint32_t n = 0;
+  const i2c_rx_frame_t* f = (const i2c_rx_frame_t*)arduino_spsc_read_span(&gI2CRxFrames, &n);
+  if (!f) return;
+
+  // Frees the frame and any padding in front of it.
+  gI2CRxBytesOut += f->len - gI2CRxFrameOff;
+  gI2CRxFrameOff = 0;
+  arduino_spsc_read_release(&gI2CRx, f->end - gI2CRx.tail);
+  arduino_spsc_read_release(&gI2CRxFrames, 1);
+}
+
+// Byte stream: reads straight through frame boundaries.
+
+uint32_t arduino_i2c_slave_rx_available(void) {
+  return gI2CRxBytesIn - gI2CRxBytesOut;
 }
 
 uint32_t arduino_i2c_slave_rx_read_buf(uint8_t* out, uint32_t maxLen) {
   if (!out || maxLen == 0) return 0;
 
-  noInterrupts();
-  uint32_t n = 0;
-  while (n < maxLen) {
-    int32_t v = i2c_rx_pop_unsafe();
-    if (v < 0) break;
-    out[n++] = (uint8_t)v;
+  uint32_t got = 0;
+  while (got < maxLen) {
+    uint32_t len = 0;
+    const uint8_t* p = arduino_i2c_slave_rx_frame_peek(&len);
+    if (!p) break;
+
+    const uint32_t k = (maxLen - got) < len ? (maxLen - got) : len;
+    memcpy(out + got, p, k);
+    got += k;
+
+    if (k == len) {
+      arduino_i2c_slave_rx_frame_release();
+    } else {
+      gI2CRxFrameOff += k;
+      gI2CRxBytesOut += k;
+    }
   }
-  interrupts();
-  return n;
+  return got;
+}
+
+int32_t arduino_i2c_slave_rx_read(void) {
+  uint8_t v;
+  return arduino_i2c_slave_rx_read_buf(&v, 1) ? (int32_t)v : -1;
 }
 
 void arduino_i2c_slave_rx_clear(void) {
-  noInterrupts();
-  gI2CRxHead = 0;
-  gI2CRxTail = 0;
-  interrupts();
+  while (arduino_spsc_count(&gI2CRxFrames) != 0) {
+    arduino_i2c_slave_rx_frame_release();
+  }
 }
 
-void arduino_i2c_slave_set_tx(const uint8_t* data, uint32_t len) {
-  noInterrupts();
+uint32_t arduino_i2c_slave_rx_overflows(void) {
+  return arduino_spsc_overflows(&gI2CRx);
+}
 
-  if (!data || len == 0) {
-    gI2CTxLen = 0;
-    interrupts();
-    return;
-  }
+uint8_t* arduino_i2c_slave_tx_back(uint32_t* cap) {
+  if (cap) *cap = ARDUINO_SWIFT_I2C_SLAVE_TX_CAP;
+  return gI2CTxBuf[gI2CTxFront ^ 1u];
+}
 
+void arduino_i2c_slave_tx_publish(uint32_t len) {
+  const uint8_t back = (uint8_t)(gI2CTxFront ^ 1u);
   if (len > ARDUINO_SWIFT_I2C_SLAVE_TX_CAP)
     len = ARDUINO_SWIFT_I2C_SLAVE_TX_CAP;
 
-  for (uint32_t i = 0; i < len; i++)
-    gI2CTxBuf[i] = data[i];
+  gI2CTxLen[back] = len;
+  ARDUINO_SPSC_DMB();
+  gI2CTxFront = back;
+}
 
-  gI2CTxLen = len;
-  interrupts();
+void arduino_i2c_slave_set_tx(const uint8_t* data, uint32_t len) {
+  if (!data) len = 0;
+  if (len > ARDUINO_SWIFT_I2C_SLAVE_TX_CAP)
+    len = ARDUINO_SWIFT_I2C_SLAVE_TX_CAP;
+
+  if (len) memcpy(arduino_i2c_slave_tx_back(NULL), data, len);
+  arduino_i2c_slave_tx_publish(len);
+}
+
+uint32_t arduino_i2c_slave_set_reg_tx(uint8_t reg, const uint8_t* data, uint32_t len) {
+  if (len > ARDUINO_SWIFT_I2C_SLAVE_REG_TX_CAP) return 0;
+
+  i2c_reg_tx_t* slot = NULL;
+  for (uint32_t i = 0; i < ARDUINO_SWIFT_I2C_SLAVE_REG_TX_SLOTS; i++) {
+    i2c_reg_tx_t* t = &gI2CRegTx[i];
+    if (t->used && t->reg == reg) { slot = t; break; }
+    if (!t->used && !slot) slot = t;
+  }
+  if (!slot) return 0;
+
+  // Off while rewritten: a request in between falls back to the TX buffer.
+  slot->len = 0;
+  ARDUINO_SPSC_DMB();
+
+  if (!data || len == 0) {
+    slot->used = 0;
+    return 1;
+  }
+
+  slot->reg = reg;
+  slot->used = 1;
+  memcpy(slot->data, data, len);
+  ARDUINO_SPSC_DMB();
+  slot->len = len;
+  return 1;
+}
+
+void arduino_i2c_slave_clear_reg_tx(void) {
+  for (uint32_t i = 0; i < ARDUINO_SWIFT_I2C_SLAVE_REG_TX_SLOTS; i++) {
+    gI2CRegTx[i].len = 0;
+    ARDUINO_SPSC_DMB();
+    gI2CRegTx[i].used = 0;
+  }
 }
 
 uint32_t arduino_i2c_slave_consume_onReceive(void) {
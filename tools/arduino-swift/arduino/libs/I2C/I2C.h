@@ -35,26 +35,87 @@ uint32_t arduino_i2c_requestFrom(uint8_t address, uint32_t quantity, uint8_t sen
 int32_t  arduino_i2c_available(void);
 int32_t  arduino_i2c_read(void);
 
+// Copies up to cap received bytes (after requestFrom). Returns how many.
+uint32_t arduino_i2c_read_buf(uint8_t* out, uint32_t cap);
+
+// arduino_i2c_transfer flags (0 = write, repeated start, read, stop)
+#define ARDUINO_I2C_XFER_STOP_BETWEEN 0x01u   // STOP + START between write and read
+#define ARDUINO_I2C_XFER_NO_STOP      0x02u   // keep the bus after the last phase
+
+// Whole write-then-read transaction in one call. Either phase may be empty
+// (txLen 0 and rxLen 0 = address probe).
+// Returns bytes read (may be < rxLen), or -status (endTransmission code) when the write failed.
+int32_t  arduino_i2c_transfer(uint8_t address,
+                              const uint8_t* tx, uint32_t txLen,
+                              uint8_t* rx, uint32_t rxLen,
+                              uint32_t flags);
+
+// ============================================================
+// I2C (Wire) - Mux (TCA9548A-style, main context only)
+// ============================================================
+//
+// The selected channel of each mux is cached: selecting the channel that is
+// already on costs no bus traffic. Selecting a channel closes every other known
+// mux first. channel 0..7, or 0xFF to close the mux.
+
+// Returns the endTransmission status of the select write (0 also when skipped).
+uint8_t  arduino_i2c_mux_select(uint8_t mux, uint8_t channel);
+
+// Forget the cached state (mux reset / power cycle): the next select always writes.
+void     arduino_i2c_mux_invalidate(void);
+
+// Select writes issued; *skipped = selects answered from the cache.
+uint32_t arduino_i2c_mux_stats(uint32_t* skipped);
+
+// select + arduino_i2c_transfer. Same result encoding (-status when the select failed).
+int32_t  arduino_i2c_mux_transfer(uint8_t mux, uint8_t channel, uint8_t address,
+                                  const uint8_t* tx, uint32_t txLen,
+                                  uint8_t* rx, uint32_t rxLen,
+                                  uint32_t flags);
+
 // ============================================================
 // I2C (Wire) - Slave (ISR-safe, polled by Swift)
 // ============================================================
 //
 // Design:
-// - ISR: receive bytes -> push to RX ring buffer; set "onReceive" flag.
-// - ISR: request -> write prepared TX buffer to Wire; set "onRequest" flag.
+// - ISR: receive -> one frame per master write (length + bytes, contiguous in an
+//   RX slab ring, SpscRing.h, lock-free); set "onReceive" flag.
+// - ISR: request -> if the last write started with a register byte that has a
+//   template, answer with it; else Wire.write the front TX buffer (no copy). Set "onRequest" flag.
 // - Main: Swift polls flags and RX buffer; Swift sets TX buffer ahead of requests.
 
 void     arduino_i2c_slave_begin(uint8_t address);
 
-// RX (from master -> slave)
+// RX frames (from master -> slave), oldest first.
+// peek() returns a view into the slab (NULL when none), valid until release().
+// A frame with len 0 is a master write that carried no data.
+uint32_t arduino_i2c_slave_rx_frames(void);
+const uint8_t* arduino_i2c_slave_rx_frame_peek(uint32_t* len);
+void     arduino_i2c_slave_rx_frame_release(void);
+
+// RX as a byte stream (reads across frame boundaries)
 uint32_t arduino_i2c_slave_rx_available(void);
 int32_t  arduino_i2c_slave_rx_read(void);
 uint32_t arduino_i2c_slave_rx_read_buf(uint8_t* out, uint32_t maxLen);
 void     arduino_i2c_slave_rx_clear(void);
 
-// TX (slave -> master)
+// Bytes dropped because their frame did not fit the RX slab / frame ring (since slave_begin).
+uint32_t arduino_i2c_slave_rx_overflows(void);
+
+// TX (slave -> master), double-buffered, no interrupt masking.
+// Fill the back buffer (cap bytes) in place, then publish(len) swaps it to the front.
+uint8_t* arduino_i2c_slave_tx_back(uint32_t* cap);
+void     arduino_i2c_slave_tx_publish(uint32_t len);
+
+// Copy into the back buffer + publish.
 void     arduino_i2c_slave_set_tx(const uint8_t* data, uint32_t len);
 
+// Register templates: a request right after a write starting with `reg` is
+// answered from the template in the ISR. len 0 / NULL removes it.
+// Returns 0 when the table is full or len is too big.
+uint32_t arduino_i2c_slave_set_reg_tx(uint8_t reg, const uint8_t* data, uint32_t len);
+void     arduino_i2c_slave_clear_reg_tx(void);
+
 // Flags (edge-triggered, cleared by consume)
 uint32_t arduino_i2c_slave_consume_onReceive(void);
 uint32_t arduino_i2c_slave_consume_onRequest(void);
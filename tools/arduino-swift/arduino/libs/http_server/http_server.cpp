@@ -2,13 +2,35 @@
 #include <Arduino.h>
 #include <WiFiS3.h>
 #include "http_server.h"
+#include <string.h>
+
+struct HTTPSlot {
+  WiFiClient client;
+  bool       used;
+  bool       idle;
+  uint32_t   lastMs;   // last accept / read / write
+};
 
 static WiFiServer* g_server = nullptr;
-static WiFiClient  g_client;
+static HTTPSlot    g_slots[ARDUINO_HTTP_SERVER_CLIENTS];
 static uint16_t    g_port   = 0;
 
-static inline bool clientValid() {
-  return (bool)g_client && g_client.connected();
+static inline HTTPSlot* slotAt(uint32_t slot) {
+  if (slot >= ARDUINO_HTTP_SERVER_CLIENTS) return nullptr;
+  HTTPSlot* s = &g_slots[slot];
+  return s->used ? s : nullptr;
+}
+
+static inline bool clientValid(HTTPSlot* s) {
+  return s && (bool)s->client && s->client.connected();
+}
+
+static void releaseSlot(HTTPSlot* s) {
+  if ((bool)s->client) {
+    s->client.stop();
+  }
+  s->used = false;
+  s->idle = false;
 }
 
 extern "C" int32_t arduino_http_server_begin(uint16_t port) {
@@ -20,14 +42,13 @@ extern "C" int32_t arduino_http_server_begin(uint16_t port) {
   if (!g_server) return 0;
 
   g_server->begin();
-  g_client.stop();
 
   return 1;
 }
 
 extern "C" void arduino_http_server_end(void) {
-  if ((bool)g_client) {
-    g_client.stop();
+  for (uint32_t i = 0; i < ARDUINO_HTTP_SERVER_CLIENTS; i++) {
+    if (g_slots[i].used) releaseSlot(&g_slots[i]);
   }
 
   if (g_server) {
@@ -38,48 +59,156 @@ extern "C" void arduino_http_server_end(void) {
   g_port = 0;
 }
 
-extern "C" int32_t arduino_http_server_client_available(void) {
-  if (!g_server) return 0;
+extern "C" uint32_t arduino_http_server_slots(void) {
+  return ARDUINO_HTTP_SERVER_CLIENTS;
+}
 
-  if (clientValid()) return 1;
+extern "C" int32_t arduino_http_server_accept(void) {
+  if (!g_server) return ARDUINO_HTTP_ACCEPT_NONE;
 
+  // WiFiS3 hands out any socket with data, including ones already in a slot.
   WiFiClient c = g_server->available();
-  if ((bool)c) {
-    g_client = c;
-    return clientValid() ? 1 : 0;
+  if (!(bool)c) return ARDUINO_HTTP_ACCEPT_NONE;
+
+  int32_t freeSlot = -1;
+  for (uint32_t i = 0; i < ARDUINO_HTTP_SERVER_CLIENTS; i++) {
+    if (!g_slots[i].used) {
+      if (freeSlot < 0) freeSlot = (int32_t)i;
+    } else if (g_slots[i].client == c) {
+      return ARDUINO_HTTP_ACCEPT_SKIPPED;
+    }
   }
 
-  return 0;
+  const uint32_t now = millis();
+
+  if (freeSlot < 0) {
+    uint32_t oldest = 0;
+    for (uint32_t i = 0; i < ARDUINO_HTTP_SERVER_CLIENTS; i++) {
+      HTTPSlot* s = &g_slots[i];
+      if (!s->idle || s->client.available() > 0) continue;
+      const uint32_t age = now - s->lastMs;
+      if (freeSlot < 0 || age > oldest) {
+        freeSlot = (int32_t)i;
+        oldest = age;
+      }
+    }
+    if (freeSlot < 0) {
+      c.stop();
+      return ARDUINO_HTTP_ACCEPT_SKIPPED;
+    }
+    releaseSlot(&g_slots[freeSlot]);
+  }
+
+  HTTPSlot* s = &g_slots[freeSlot];
+  s->client = c;
+  s->used = true;
+  s->idle = false;
+  s->lastMs = now;
+  return freeSlot;
 }
 
-extern "C" int32_t arduino_http_server_client_connected(void) {
-  return clientValid() ? 1 : 0;
+extern "C" int32_t arduino_http_server_slot_connected(uint32_t slot) {
+  return clientValid(slotAt(slot)) ? 1 : 0;
 }
 
-extern "C" int32_t arduino_http_server_client_available_bytes(void) {
-  if (!clientValid()) return 0;
-  return (int32_t)g_client.available();
+extern "C" int32_t arduino_http_server_slot_available_bytes(uint32_t slot) {
+  HTTPSlot* s = slotAt(slot);
+  if (!clientValid(s)) return 0;
+  return (int32_t)s->client.available();
 }
 
-extern "C" int32_t arduino_http_server_client_read(uint8_t* out, uint32_t cap) {
-  if (!clientValid()) return 0;
+extern "C" int32_t arduino_http_server_slot_read(uint32_t slot, uint8_t* out, uint32_t cap) {
+  HTTPSlot* s = slotAt(slot);
+  if (!clientValid(s)) return 0;
   if (!out || cap == 0) return 0;
 
-  int n = g_client.read(out, (size_t)cap);
-  if (n < 0) return 0;
+  int n = s->client.read(out, (size_t)cap);
+  if (n <= 0) return 0;
+
+  s->idle = false;
+  s->lastMs = millis();
   return (int32_t)n;
 }
 
-extern "C" int32_t arduino_http_server_client_write(const uint8_t* data, uint32_t len) {
-  if (!clientValid()) return 0;
+extern "C" int32_t arduino_http_server_slot_write(uint32_t slot, const uint8_t* data, uint32_t len) {
+  HTTPSlot* s = slotAt(slot);
+  if (!clientValid(s)) return 0;
   if (!data || len == 0) return 0;
 
-  size_t w = g_client.write((const uint8_t*)data, (size_t)len);
+  size_t w = s->client.write((const uint8_t*)data, (size_t)len);
+  s->lastMs = millis();
   return (int32_t)w;
 }
 
-extern "C" void arduino_http_server_client_stop(void) {
-  if ((bool)g_client) {
-    g_client.stop();
+extern "C" void arduino_http_server_slot_set_idle(uint32_t slot, uint32_t idle) {
+  HTTPSlot* s = slotAt(slot);
+  if (s) s->idle = idle != 0;
+}
+
+extern "C" void arduino_http_server_slot_stop(uint32_t slot) {
+  HTTPSlot* s = slotAt(slot);
+  if (s) releaseSlot(s);
+}
+
+// ----------------------
+// Static assets
+// ----------------------
+
+extern "C" __attribute__((weak))
+const arduino_http_asset_t* arduino_http_assets(uint32_t* count) {
+  *count = 0;
+  return nullptr;
+}
+
+static const arduino_http_asset_t* assetAt(uint32_t i) {
+  uint32_t n = 0;
+  const arduino_http_asset_t* t = arduino_http_assets(&n);
+  return (t && i < n) ? &t[i] : nullptr;
+}
+
+extern "C" uint32_t arduino_http_asset_count(void) {
+  uint32_t n = 0;
+  (void)arduino_http_assets(&n);
+  return n;
+}
+
+extern "C" int32_t arduino_http_asset_find(const uint8_t* path, uint32_t len) {
+  uint32_t n = 0;
+  const arduino_http_asset_t* t = arduino_http_assets(&n);
+  if (!t || !path) return -1;
+
+  // Same order as strcmp (unsigned bytes, shorter first on a common prefix).
+  uint32_t lo = 0;
+  uint32_t hi = n;
+  while (lo < hi) {
+    const uint32_t mid = (lo + hi) / 2;
+    const char* p = t[mid].path;
+    const size_t plen = strlen(p);
+    int c = memcmp(p, path, plen < len ? plen : len);
+    if (c == 0) c = (plen < len) ? -1 : (plen > len ? 1 : 0);
+    if (c == 0) return (int32_t)mid;
+    if (c < 0) lo = mid + 1; else hi = mid;
   }
+  return -1;
+}
+
+extern "C" const uint8_t* arduino_http_asset_data(uint32_t i, uint32_t* len) {
+  const arduino_http_asset_t* a = assetAt(i);
+  if (len) *len = a ? a->len : 0;
+  return a ? a->data : nullptr;
+}
+
+extern "C" const char* arduino_http_asset_content_type(uint32_t i) {
+  const arduino_http_asset_t* a = assetAt(i);
+  return a ? a->content_type : "";
+}
+
+extern "C" const char* arduino_http_asset_etag(uint32_t i) {
+  const arduino_http_asset_t* a = assetAt(i);
+  return a ? a->etag : "";
+}
+
+extern "C" uint32_t arduino_http_asset_gzip(uint32_t i) {
+  const arduino_http_asset_t* a = assetAt(i);
+  return a ? a->gzip : 0;
 }
\ No newline at end of file
@@ -1,24 +1,72 @@
 // http_server.h
+//
+// Client slots: up to ARDUINO_HTTP_SERVER_CLIENTS connections are held open at
+// once (keep-alive). arduino_http_server_accept() admits a new connection into
+// a free slot; when all slots are taken it evicts the slot that has been idle
+// longest (marked with slot_set_idle, nothing pending), else it refuses.
+//
+// Static assets: the build turns the project's assets/ directory into
+// __asw_assets.c, a const (flash) table that overrides the weak, empty
+// arduino_http_assets(). The asset_* calls look entries up by URL path and
+// hand out pointers into flash (HTTPServer.serveStatic).
 #pragma once
 
 #include <stdint.h>
 
+#ifndef ARDUINO_HTTP_SERVER_CLIENTS
+#define ARDUINO_HTTP_SERVER_CLIENTS 4
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+typedef struct {
+  const char*    path;          // URL path, e.g. "/app.js"; table sorted by strcmp
+  const char*    content_type;
+  const char*    etag;          // strong validator, quoted
+  const uint8_t* data;
+  uint32_t       len;
+  uint32_t       gzip;          // 1 = data is gzip (Content-Encoding: gzip)
+} arduino_http_asset_t;
+
+// Generated table (weak default: no assets).
+const arduino_http_asset_t* arduino_http_assets(uint32_t* count);
+
 int32_t  arduino_http_server_begin(uint16_t port);
 void     arduino_http_server_end(void);
 
-int32_t  arduino_http_server_client_available(void);
-int32_t  arduino_http_server_client_connected(void);
+uint32_t arduino_http_server_slots(void);
+
+// arduino_http_server_accept() results below zero.
+enum {
+  ARDUINO_HTTP_ACCEPT_NONE    = -1,  // no connection waiting: stop accepting this tick
+  ARDUINO_HTTP_ACCEPT_SKIPPED = -2   // socket already in a slot, or refused (no idle slot)
+};
+
+// Slot index of a newly admitted connection, or ARDUINO_HTTP_ACCEPT_*.
+int32_t  arduino_http_server_accept(void);
+
+int32_t  arduino_http_server_slot_connected(uint32_t slot);
+int32_t  arduino_http_server_slot_available_bytes(uint32_t slot);
+
+int32_t  arduino_http_server_slot_read(uint32_t slot, uint8_t* out, uint32_t cap);
+int32_t  arduino_http_server_slot_write(uint32_t slot, const uint8_t* data, uint32_t len);
+
+// 1 = between requests, may be evicted for a new connection. Cleared by reads.
+void     arduino_http_server_slot_set_idle(uint32_t slot, uint32_t idle);
+
+void     arduino_http_server_slot_stop(uint32_t slot);
 
-int32_t  arduino_http_server_client_available_bytes(void);
+uint32_t arduino_http_asset_count(void);
 
-int32_t  arduino_http_server_client_read(uint8_t* out, uint32_t cap);
-int32_t  arduino_http_server_client_write(const uint8_t* data, uint32_t len);
+// Index of the asset at `path` (len bytes, no query), or -1.
+int32_t  arduino_http_asset_find(const uint8_t* path, uint32_t len);
 
-void     arduino_http_server_client_stop(void);
+const uint8_t* arduino_http_asset_data(uint32_t i, uint32_t* len);
+const char*    arduino_http_asset_content_type(uint32_t i);
+const char*    arduino_http_asset_etag(uint32_t i);
+uint32_t       arduino_http_asset_gzip(uint32_t i);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -89,15 +89,11 @@ static int copy_first_existing_as(const char* src_dir,
     return 0;
 }
 
-int cmd_build_step_3_prepare_sketch_workspace(BuildContext* ctx) {
-    if (!ctx) return 0;
-
-    if (!build_ctx_prepare_dirs(ctx)) {
-        log_error("Failed to prepare build directories");
-        return 0;
-    }
-
-    log_info("Preparing Arduino sketch workspace at: %s", ctx->sketch_dir);
+// Copies the runtime (sketch.ino, shims, commom C sources, runtime support)
+// into sketch_dir. Used for the main sketch and, on a dual-core Giga, for the
+// M4 sketch, which gets only this runtime plus its own "m4_lib" (step 4).
+static int stage_runtime(BuildContext* ctx, const char* sketch_dir) {
+    log_info("Preparing Arduino sketch workspace at: %s", sketch_dir);
 
     // New runtime layout: arduino/commom/
     // But build_context may already include /commom. Don't append twice.
@@ -118,7 +114,7 @@ int cmd_build_step_3_prepare_sketch_workspace(BuildContext* ctx) {
 
     log_info("Runtime Arduino (common): %s", common_dir);
 
-    if (!require_and_copy(common_dir, "sketch.ino", ctx->sketch_dir)) return 0;
+    if (!require_and_copy(common_dir, "sketch.ino", sketch_dir)) return 0;
 
     // Runtime can rename the shim header. Always stage it as ArduinoSwiftShim.h in the sketch.
     {
@@ -129,7 +125,7 @@ int cmd_build_step_3_prepare_sketch_workspace(BuildContext* ctx) {
             "ArduinoSwiftShimBase.hpp",
         };
         if (!copy_first_existing_as(common_dir, cand, (int)(sizeof(cand)/sizeof(cand[0])),
-                                    ctx->sketch_dir, "ArduinoSwiftShim.h")) return 0;
+                                    sketch_dir, "ArduinoSwiftShim.h")) return 0;
     }
 
     // Runtime may provide ArduinoSwiftShimBase.cpp; the sketch expects ArduinoSwiftShim.cpp.
@@ -140,10 +136,46 @@ int cmd_build_step_3_prepare_sketch_workspace(BuildContext* ctx) {
             "ArduinoSwiftShimBase.cpp",
         };
         if (!copy_first_existing_as(common_dir, cand, (int)(sizeof(cand)/sizeof(cand[0])),
-                                    ctx->sketch_dir, "ArduinoSwiftShim.cpp")) return 0;
+                                    sketch_dir, "ArduinoSwiftShim.cpp")) return 0;
     }
 
-    if (!require_and_copy(common_dir, "Bridge.cpp", ctx->sketch_dir)) return 0;
+    if (!require_and_copy(common_dir, "Bridge.cpp", sketch_dir)) return 0;
+
+    // Optional TLSF heap. Always staged; it compiles to the bare allocator unless
+    // config.json selects "heap": { "allocator": "tlsf" } (see step 5).
+    if (!require_and_copy(common_dir, "SwiftHeap.h", sketch_dir)) return 0;
+    if (!require_and_copy(common_dir, "SwiftHeap.c", sketch_dir)) return 0;
+
+    // Heap counters + malloc/free wraps (linked only with heap.stats or the TLSF heap, see step 5).
+    if (!require_and_copy(common_dir, "SwiftMemory.h", sketch_dir)) return 0;
+    if (!require_and_copy(common_dir, "SwiftMemory.c", sketch_dir)) return 0;
+
+    // Header-only SPSC ring shared by ISR -> loop paths (I2C slave RX, ...).
+    if (!require_and_copy(common_dir, "SpscRing.h", sketch_dir)) return 0;
+
+    // Fast IO accessors (board APIs provide arduino_fastio_resolve()).
+    if (!require_and_copy(common_dir, "FastIO.h", sketch_dir)) return 0;
+    if (!require_and_copy(common_dir, "FastIO.c", sketch_dir)) return 0;
+
+    // ADC block ring (board APIs provide arduino_adc_stream_start/stop()).
+    if (!require_and_copy(common_dir, "AdcStream.h", sketch_dir)) return 0;
+    if (!require_and_copy(common_dir, "AdcStream.c", sketch_dir)) return 0;
+
+    // Periodic timer slots + tick queues (board APIs provide arduino_hwtimer_hw_*()).
+    if (!require_and_copy(common_dir, "HwTimer.h", sketch_dir)) return 0;
+    if (!require_and_copy(common_dir, "HwTimer.c", sketch_dir)) return 0;
+
+    // DWT cycle counter (Clock.Cycles).
+    if (!require_and_copy(common_dir, "CycleCounter.h", sketch_dir)) return 0;
+    if (!require_and_copy(common_dir, "CycleCounter.c", sketch_dir)) return 0;
+
+    // Inter-core message rings (board APIs provide arduino_corelink_hw_*()).
+    if (!require_and_copy(common_dir, "CoreLink.h", sketch_dir)) return 0;
+    if (!require_and_copy(common_dir, "CoreLink.c", sketch_dir)) return 0;
+
+    // I2C master transaction queue (board APIs provide arduino_i2cq_hw_*(), the I2C lib the Wire fallback).
+    if (!require_and_copy(common_dir, "I2CQueue.h", sketch_dir)) return 0;
+    if (!require_and_copy(common_dir, "I2CQueue.c", sketch_dir)) return 0;
 
     // Runtime support may be provided as .c or .cpp (and may be suffixed with Base).
     // Prefer the .c variant when present.
@@ -195,7 +227,7 @@ int cmd_build_step_3_prepare_sketch_workspace(BuildContext* ctx) {
             if (!sd || !sd[0] || !dir_exists(sd)) continue;
 
             if (copy_first_existing_as(sd, cand_c, (int)(sizeof(cand_c)/sizeof(cand_c[0])),
-                                       ctx->sketch_dir, "SwiftRuntimeSupport.c")) {
+                                       sketch_dir, "SwiftRuntimeSupport.c")) {
                 copied = 1;
                 break;
             }
@@ -207,7 +239,7 @@ int cmd_build_step_3_prepare_sketch_workspace(BuildContext* ctx) {
             if (!sd || !sd[0] || !dir_exists(sd)) continue;
 
             if (copy_first_existing_as(sd, cand_cpp, (int)(sizeof(cand_cpp)/sizeof(cand_cpp[0])),
-                                       ctx->sketch_dir, "SwiftRuntimeSupport.cpp")) {
+                                       sketch_dir, "SwiftRuntimeSupport.cpp")) {
                 copied = 1;
                 break;
             }
@@ -220,4 +252,17 @@ int cmd_build_step_3_prepare_sketch_workspace(BuildContext* ctx) {
     }
 
     return 1;
-}
\ No newline at end of file
+}
+
+int cmd_build_step_3_prepare_sketch_workspace(BuildContext* ctx) {
+    if (!ctx) return 0;
+
+    if (!build_ctx_prepare_dirs(ctx)) {
+        log_error("Failed to prepare build directories");
+        return 0;
+    }
+
+    if (!stage_runtime(ctx, ctx->sketch_dir)) return 0;
+    if (ctx->dual_core && !stage_runtime(ctx, ctx->m4_sketch_dir)) return 0;
+    return 1;
+}
@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <ctype.h>
 
 // ------------------------------------------------------------
@@ -355,59 +356,278 @@ static void debug_dump_sketch_tree(const char* sketch_dir) {
 }
 
 // ------------------------------------------------------------
-// Main
+// Static assets: <project>/assets/** -> sketch/__asw_assets.c
+//
+// One const (flash) byte array per file plus a table sorted by URL path
+// (arduino_http_assets(), see http_server.h). Text files are stored
+// gzip -9 when that is smaller. The ETag is strong: length + FNV-1a of
+// the stored bytes. "<dir>/index.html" is also served as "<dir>/".
 // ------------------------------------------------------------
 
-int cmd_build_step_4_stage_sources_and_libs(BuildContext* ctx) {
-    if (!ctx) return 0;
+#define ASSET_MAX 128
+
+typedef struct {
+    unsigned char* data;
+    size_t         len;
+    int            gzip;
+    const char*    type;
+    char           etag[32];
+} AssetBlob;
+
+typedef struct {
+    char url[512];
+    int  blob;
+} AssetEntry;
+
+static const char* asset_content_type(const char* path, int* text) {
+    static const struct { const char* ext; const char* type; int text; } map[] = {
+        { ".html",  "text/html; charset=utf-8",              1 },
+        { ".htm",   "text/html; charset=utf-8",              1 },
+        { ".css",   "text/css; charset=utf-8",               1 },
+        { ".js",    "text/javascript; charset=utf-8",        1 },
+        { ".mjs",   "text/javascript; charset=utf-8",        1 },
+        { ".json",  "application/json; charset=utf-8",       1 },
+        { ".svg",   "image/svg+xml",                         1 },
+        { ".txt",   "text/plain; charset=utf-8",             1 },
+        { ".xml",   "application/xml; charset=utf-8",        1 },
+        { ".webmanifest", "application/manifest+json",       1 },
+        { ".wasm",  "application/wasm",                      1 },
+        { ".png",   "image/png",                             0 },
+        { ".jpg",   "image/jpeg",                            0 },
+        { ".jpeg",  "image/jpeg",                            0 },
+        { ".gif",   "image/gif",                             0 },
+        { ".webp",  "image/webp",                            0 },
+        { ".ico",   "image/x-icon",                          0 },
+        { ".woff",  "font/woff",                             0 },
+        { ".woff2", "font/woff2",                            0 },
+    };
+    for (size_t i = 0; i < sizeof(map) / sizeof(map[0]); i++) {
+        if (str_endswith_ieq(path, map[i].ext)) {
+            *text = map[i].text;
+            return map[i].type;
+        }
+    }
+    *text = 0;
+    return "application/octet-stream";
+}
 
-    ctx->swift_args[0] = 0;
+static unsigned char* read_binary_file(const char* path, size_t* out_len) {
+    *out_len = 0;
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    size_t cap = 4096, len = 0;
+    unsigned char* buf = (unsigned char*)malloc(cap);
+    if (!buf) die("OOM");
+
+    size_t n;
+    while ((n = fread(buf + len, 1, cap - len, f)) > 0) {
+        len += n;
+        if (len == cap) {
+            cap *= 2;
+            buf = (unsigned char*)realloc(buf, cap);
+            if (!buf) die("OOM");
+        }
+    }
+    fclose(f);
+    *out_len = len;
+    return buf;
+}
 
-    // --------------------------------------------------
-    // 0) Derive Arduino runtime root for Arduino-side libs
-    //
-    // ctx->runtime_arduino is currently ".../arduino/commom"
-    // but Arduino-side libs live in ".../arduino/libs/<Lib>/*"
-    // --------------------------------------------------
-    char arduino_runtime_root[1024];
-    if (!derive_arduino_runtime_root(ctx->runtime_arduino, arduino_runtime_root, sizeof(arduino_runtime_root))) {
-        log_warn("Failed deriving Arduino runtime root from: %s (using as-is)", ctx->runtime_arduino);
-        snprintf(arduino_runtime_root, sizeof(arduino_runtime_root), "%s", ctx->runtime_arduino);
-    } else {
-        // Optional: make it visible in logs (helps debugging)
-        log_info("Arduino runtime root: %s", arduino_runtime_root);
+// gzip -9 -n (no name/mtime: same input, same bytes, same ETag). NULL when gzip fails.
+static unsigned char* gzip_file(const char* src, const char* tmp, size_t* out_len) {
+    char cmd[4096];
+    char out[256];
+    snprintf(cmd, sizeof(cmd), "gzip -9 -n -c \"%s\" > \"%s\" 2>/dev/null", src, tmp);
+    if (run_cmd_capture(cmd, out, sizeof(out)) != 0) {
+        remove(tmp);
+        *out_len = 0;
+        return NULL;
     }
+    unsigned char* data = read_binary_file(tmp, out_len);
+    remove(tmp);
+    return data;
+}
 
-    // --------------------------------------------------
-    // 1) Core Swift files
-    // --------------------------------------------------
-    char core_list[65535];
-    {
-        char root[1024];
-        snprintf(root, sizeof(root), "%s/core", ctx->runtime_swift);
-        if (!fs_find_list(root, "-type f -name \"*.swift\"", core_list, sizeof(core_list))) {
-            log_error("Failed listing Swift core sources");
-            return 0;
-        }
+static int asset_entry_cmp(const void* a, const void* b) {
+    return strcmp(((const AssetEntry*)a)->url, ((const AssetEntry*)b)->url);
+}
+
+static void fput_c_string(FILE* f, const char* s) {
+    fputc('"', f);
+    for (const unsigned char* p = (const unsigned char*)s; *p; p++) {
+        if (*p == '"' || *p == '\\') fprintf(f, "\\%c", *p);
+        else if (*p < 0x20 || *p >= 0x7F) fprintf(f, "\\%03o", *p);
+        else fputc(*p, f);
     }
-    if (!core_list[0]) {
-        log_error("No Swift core sources found in: %s/core", ctx->runtime_swift);
+    fputc('"', f);
+}
+
+static int stage_static_assets(BuildContext* ctx) {
+    char assets_dir[1024];
+    if (!path_join(assets_dir, sizeof(assets_dir), ctx->project_root, "assets") || !dir_exists(assets_dir)) return 1;
+
+    int has_server = 0;
+    for (int i = 0; i < ctx->swift_lib_count; i++) {
+        if (str_ieq(ctx->swift_libs[i], "http_server")) has_server = 1;
+    }
+    if (!has_server) {
+        log_warn("assets/ ignored: the http_server lib is not in config.json \"lib\"");
+        return 1;
+    }
+
+    char list[65535];
+    if (!fs_find_list(assets_dir, "-type f ! -name \".*\"", list, sizeof(list))) {
+        log_error("Failed listing assets in: %s", assets_dir);
         return 0;
     }
-    append_swift_list_as_args(core_list, ctx->swift_args, sizeof(ctx->swift_args));
 
-    if (ctx->swift_lib_count > 0) log_info("Including %d Swift lib(s)", ctx->swift_lib_count);
-    else                         log_info("No Swift libs specified -> core only");
+    static AssetBlob  blobs[ASSET_MAX];
+    static AssetEntry entries[ASSET_MAX * 2];
+    int blob_count = 0;
+    int entry_count = 0;
+    char probe[256];
+    int use_gzip = run_cmd_capture("command -v gzip", probe, sizeof(probe)) == 0;
+    if (!use_gzip) log_warn("gzip not found: assets are stored uncompressed");
 
-    // --------------------------------------------------
-    // 2) Swift libs + optional Arduino libs
-    //    Staging rule:
-    //      - keep libs under sketch/libraries/<Lib>/src (staged layout)
-    //      - ALSO promote bridge .c/.cpp into sketch root to guarantee compile/link
-    //      - generate shim headers in sketch root to satisfy #include "X.h"
-    // --------------------------------------------------
-    for (int i = 0; i < ctx->swift_lib_count; i++) {
-        const char* libname = ctx->swift_libs[i];
+    char tmp_gz[1024];
+    snprintf(tmp_gz, sizeof(tmp_gz), "%s/__asw_assets.gz.tmp", ctx->sketch_dir);
+
+    const size_t root_len = strlen(assets_dir);
+    size_t raw_total = 0, stored_total = 0;
+
+    char* p = list;
+    while (*p) {
+        char* e = strchr(p, '\n');
+        if (e) *e = 0;
+
+        if (p[0] && strncmp(p, assets_dir, root_len) == 0 && p[root_len] == '/') {
+            const char* rel = p + root_len; // "/css/app.css"
+
+            if (blob_count >= ASSET_MAX) {
+                log_error("Too many assets (max %d)", ASSET_MAX);
+                return 0;
+            }
+            if (strlen(rel) >= sizeof(entries[0].url)) {
+                log_error("Asset path too long: %s", rel);
+                return 0;
+            }
+
+            AssetBlob* b = &blobs[blob_count];
+            int text = 0;
+            b->type = asset_content_type(rel, &text);
+            b->gzip = 0;
+            b->data = read_binary_file(p, &b->len);
+            if (!b->data) {
+                log_error("Failed reading asset: %s", p);
+                return 0;
+            }
+            raw_total += b->len;
+
+            if (text && use_gzip && b->len > 0) {
+                size_t gz_len = 0;
+                unsigned char* gz = gzip_file(p, tmp_gz, &gz_len);
+                if (!gz) {
+                    log_warn("gzip failed for %s (stored uncompressed)", rel);
+                } else if (gz_len < b->len) {
+                    free(b->data);
+                    b->data = gz;
+                    b->len = gz_len;
+                    b->gzip = 1;
+                } else {
+                    free(gz);
+                }
+            }
+            stored_total += b->len;
+
+            uint32_t h = 2166136261u;
+            for (size_t i = 0; i < b->len; i++) h = (h ^ b->data[i]) * 16777619u;
+            snprintf(b->etag, sizeof(b->etag), "\"%zx-%08x\"", b->len, (unsigned)h);
+
+            snprintf(entries[entry_count].url, sizeof(entries[0].url), "%s", rel);
+            entries[entry_count].blob = blob_count;
+            entry_count++;
+
+            // "<dir>/index.html" also answers "<dir>/".
+            const char* base = path_basename(rel);
+            if (strcmp(base, "index.html") == 0) {
+                size_t dir_len = (size_t)(base - rel);
+                memcpy(entries[entry_count].url, rel, dir_len);
+                entries[entry_count].url[dir_len] = 0;
+                entries[entry_count].blob = blob_count;
+                entry_count++;
+            }
+
+            log_info("Asset: %s (%zu bytes%s)", rel, b->len, b->gzip ? ", gzip" : "");
+            blob_count++;
+        }
+
+        if (!e) break;
+        p = e + 1;
+    }
+
+    // find | sort follows the locale; the device binary-searches in byte order.
+    qsort(entries, (size_t)entry_count, sizeof(entries[0]), asset_entry_cmp);
+
+    char out_path[1024];
+    snprintf(out_path, sizeof(out_path), "%s/__asw_assets.c", ctx->sketch_dir);
+    FILE* f = fopen(out_path, "wb");
+    if (!f) die("Failed to write %s", out_path);
+
+    fprintf(f,
+        "// Auto-generated by ArduinoSwift from assets/ (do not edit)\n"
+        "#include <stdint.h>\n"
+        "#include \"http_server.h\"\n");
+
+    for (int i = 0; i < blob_count; i++) {
+        fprintf(f, "\nstatic const uint8_t asw_asset_%d[%zu] = {", i, blobs[i].len ? blobs[i].len : (size_t)1);
+        for (size_t k = 0; k < blobs[i].len; k++) {
+            fprintf(f, "%s0x%02x,", (k % 16) ? "" : "\n  ", blobs[i].data[k]);
+        }
+        fprintf(f, "%s\n};\n", blobs[i].len ? "" : " 0");
+    }
+
+    fprintf(f, "\nstatic const arduino_http_asset_t asw_assets[%d] = {\n", entry_count ? entry_count : 1);
+    for (int i = 0; i < entry_count; i++) {
+        const AssetBlob* b = &blobs[entries[i].blob];
+        fprintf(f, "  { ");
+        fput_c_string(f, entries[i].url);
+        fprintf(f, ", ");
+        fput_c_string(f, b->type);
+        fprintf(f, ", ");
+        fput_c_string(f, b->etag);
+        fprintf(f, ", asw_asset_%d, %zuu, %du },\n", entries[i].blob, b->len, b->gzip);
+    }
+    fprintf(f,
+        "};\n"
+        "\n"
+        "const arduino_http_asset_t* arduino_http_assets(uint32_t* count) {\n"
+        "  *count = %du;\n"
+        "  return asw_assets;\n"
+        "}\n",
+        entry_count);
+    fclose(f);
+
+    for (int i = 0; i < blob_count; i++) free(blobs[i].data);
+
+    log_info("Static assets: %d file(s), %zu bytes in flash (%zu before gzip) -> %s",
+             blob_count, stored_total, raw_total, path_basename(out_path));
+    return 1;
+}
+
+// ------------------------------------------------------------
+// Swift libs
+// ------------------------------------------------------------
+
+// Swift libs (+ their bridges and Arduino-side libs) for one image:
+// sources go to swift_args, bridges/libs into sketch_dir.
+static int stage_swift_libs(BuildContext* ctx,
+                            const char* arduino_runtime_root,
+                            char libs[][64], int lib_count,
+                            const char* sketch_dir,
+                            char* swift_args, size_t swift_args_cap) {
+    for (int i = 0; i < lib_count; i++) {
+        const char* libname = libs[i];
         if (!libname || !libname[0]) continue;
 
         char swift_libdir[1024];
@@ -445,12 +665,12 @@ int cmd_build_step_4_stage_sources_and_libs(BuildContext* ctx) {
 
         const char* leaf = (swift_leaf[0] ? swift_leaf : libname);
         log_info("Adding Swift lib: %s", leaf);
-        append_swift_list_as_args(lib_list, ctx->swift_args, sizeof(ctx->swift_args));
+        append_swift_list_as_args(lib_list, swift_args, swift_args_cap);
 
         // ---- Stage Swift C/C++ bridges (if any) into sketch/libraries/<leaf> ----
         {
             char dst_libdir[1024];
-            snprintf(dst_libdir, sizeof(dst_libdir), "%s/libraries/%s", ctx->sketch_dir, leaf);
+            snprintf(dst_libdir, sizeof(dst_libdir), "%s/libraries/%s", sketch_dir, leaf);
             mkdir_p(dst_libdir);
 
             log_info("Staging Swift bridge sources for lib: %s", leaf);
@@ -464,8 +684,8 @@ int cmd_build_step_4_stage_sources_and_libs(BuildContext* ctx) {
             ensure_arduino_library_properties(dst_libdir, leaf);
 
             // Guarantee compile/link:
-            generate_shim_headers_for_lib(ctx->sketch_dir, leaf);
-            promote_bridge_sources_to_sketch_root(ctx->sketch_dir, leaf);
+            generate_shim_headers_for_lib(sketch_dir, leaf);
+            promote_bridge_sources_to_sketch_root(sketch_dir, leaf);
         }
 
         // ---- Stage optional Arduino-side lib shipped with tool ----
@@ -478,7 +698,7 @@ int cmd_build_step_4_stage_sources_and_libs(BuildContext* ctx) {
                 const char* aleaf = (arduino_leaf[0] ? arduino_leaf : libname);
 
                 char dst_libdir[1024];
-                snprintf(dst_libdir, sizeof(dst_libdir), "%s/libraries/%s", ctx->sketch_dir, aleaf);
+                snprintf(dst_libdir, sizeof(dst_libdir), "%s/libraries/%s", sketch_dir, aleaf);
                 mkdir_p(dst_libdir);
 
                 log_info("Copying Arduino lib: %s (%s)", aleaf, arduino_libdir);
@@ -491,14 +711,82 @@ int cmd_build_step_4_stage_sources_and_libs(BuildContext* ctx) {
                 ensure_arduino_library_properties(dst_libdir, aleaf);
 
                 // same guarantee rule:
-                generate_shim_headers_for_lib(ctx->sketch_dir, aleaf);
-                promote_bridge_sources_to_sketch_root(ctx->sketch_dir, aleaf);
+                generate_shim_headers_for_lib(sketch_dir, aleaf);
+                promote_bridge_sources_to_sketch_root(sketch_dir, aleaf);
             } else {
                 log_info("Swift-only lib (no Arduino side): %s", libname);
             }
         }
     }
 
+    return 1;
+}
+
+// ------------------------------------------------------------
+// Main
+// ------------------------------------------------------------
+
+int cmd_build_step_4_stage_sources_and_libs(BuildContext* ctx) {
+    if (!ctx) return 0;
+
+    ctx->swift_args[0] = 0;
+    ctx->m4_swift_args[0] = 0;
+
+    // --------------------------------------------------
+    // 0) Derive Arduino runtime root for Arduino-side libs
+    //
+    // ctx->runtime_arduino is currently ".../arduino/commom"
+    // but Arduino-side libs live in ".../arduino/libs/<Lib>/*"
+    // --------------------------------------------------
+    char arduino_runtime_root[1024];
+    if (!derive_arduino_runtime_root(ctx->runtime_arduino, arduino_runtime_root, sizeof(arduino_runtime_root))) {
+        log_warn("Failed deriving Arduino runtime root from: %s (using as-is)", ctx->runtime_arduino);
+        snprintf(arduino_runtime_root, sizeof(arduino_runtime_root), "%s", ctx->runtime_arduino);
+    } else {
+        // Optional: make it visible in logs (helps debugging)
+        log_info("Arduino runtime root: %s", arduino_runtime_root);
+    }
+
+    // --------------------------------------------------
+    // 1) Core Swift files
+    // --------------------------------------------------
+    char core_list[65535];
+    {
+        char root[1024];
+        snprintf(root, sizeof(root), "%s/core", ctx->runtime_swift);
+        if (!fs_find_list(root, "-type f -name \"*.swift\"", core_list, sizeof(core_list))) {
+            log_error("Failed listing Swift core sources");
+            return 0;
+        }
+    }
+    if (!core_list[0]) {
+        log_error("No Swift core sources found in: %s/core", ctx->runtime_swift);
+        return 0;
+    }
+    append_swift_list_as_args(core_list, ctx->swift_args, sizeof(ctx->swift_args));
+    if (ctx->dual_core) append_swift_list_as_args(core_list, ctx->m4_swift_args, sizeof(ctx->m4_swift_args));
+
+    if (ctx->swift_lib_count > 0) log_info("Including %d Swift lib(s)", ctx->swift_lib_count);
+    else                         log_info("No Swift libs specified -> core only");
+
+    // --------------------------------------------------
+    // 2) Swift libs + optional Arduino libs
+    //    Staging rule:
+    //      - keep libs under sketch/libraries/<Lib>/src (staged layout)
+    //      - ALSO promote bridge .c/.cpp into sketch root to guarantee compile/link
+    //      - generate shim headers in sketch root to satisfy #include "X.h"
+    // --------------------------------------------------
+    if (!stage_swift_libs(ctx, arduino_runtime_root, ctx->swift_libs, ctx->swift_lib_count,
+                          ctx->sketch_dir, ctx->swift_args, sizeof(ctx->swift_args))) return 0;
+
+    // Giga M4 image: the same core, but only the libs listed in "m4_lib".
+    if (ctx->dual_core) {
+        if (ctx->m4_swift_lib_count > 0) log_info("M4 image: %d Swift lib(s)", ctx->m4_swift_lib_count);
+        else                            log_info("M4 image: no \"m4_lib\" -> core only");
+        if (!stage_swift_libs(ctx, arduino_runtime_root, ctx->m4_swift_libs, ctx->m4_swift_lib_count,
+                              ctx->m4_sketch_dir, ctx->m4_swift_args, sizeof(ctx->m4_swift_args))) return 0;
+    }
+
     // --------------------------------------------------
     // 3) User Arduino libs — do NOT stage/copy (avoid duplicate compilation)
     // --------------------------------------------------
@@ -522,6 +810,12 @@ int cmd_build_step_4_stage_sources_and_libs(BuildContext* ctx) {
         }
     }
 
+    // --------------------------------------------------
+    // 4) Static assets for http_server (flash tables)
+    // --------------------------------------------------
+    if (!stage_static_assets(ctx)) return 0;
+
     debug_dump_sketch_tree(ctx->sketch_dir);
+    if (ctx->dual_core) debug_dump_sketch_tree(ctx->m4_sketch_dir);
     return 1;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "step_5_compile_and_arduino_cli.h"
 
 #include "common/build_log.h"
+#include "common/fs_helpers.h"
 #include "common/proc_helpers.h"
 #include "util.h"
 
@@ -74,7 +75,7 @@ static const char* swift_target_for_swiftc(const BuildContext* ctx) {
   Others (Due, etc):
     - no float flags (toolchain defaults)
 */
-static void swift_xcc_float_flags(const BuildContext* ctx, char* out, size_t cap) {
+static void swift_xcc_float_flags(const BuildContext* ctx, const char* board_opts, char* out, size_t cap) {
     if (!out || cap == 0) return;
     out[0] = 0;
 
@@ -89,7 +90,7 @@ static void swift_xcc_float_flags(const BuildContext* ctx, char* out, size_t cap
 
     // GIGA: softfp, choose mfpu based on board options (target_core)
     if (is_mbed_giga_fqbn(ctx)) {
-        const char* opts = (ctx->board_opts_csv[0] ? ctx->board_opts_csv : "target_core=cm7");
+        const char* opts = (board_opts && board_opts[0] ? board_opts : "target_core=cm7");
         const int is_cm4 = str_contains_kv(opts, "target_core=cm4");
 
         snprintf(out, cap,
@@ -103,23 +104,23 @@ static void swift_xcc_float_flags(const BuildContext* ctx, char* out, size_t cap
     // Due / others: no extra float flags
 }
 
-static int append_main_swift(BuildContext* ctx) {
-    if (!ctx) return 0;
+static int append_main_swift(char* swift_args, size_t cap, const char* main_path) {
+    if (!swift_args || !main_path) return 0;
 
-    if (!file_exists(ctx->main_swift_path)) {
-        log_error("Missing main.swift at project root: %s", ctx->main_swift_path);
+    if (!file_exists(main_path)) {
+        log_error("Missing Swift entry file at project root: %s", main_path);
         return 0;
     }
 
-    size_t need = strlen(ctx->swift_args) + strlen(ctx->main_swift_path) + 8;
-    if (need >= sizeof(ctx->swift_args)) {
-        log_error("Args buffer overflow adding main.swift");
+    size_t need = strlen(swift_args) + strlen(main_path) + 8;
+    if (need >= cap) {
+        log_error("Args buffer overflow adding %s", main_path);
         return 0;
     }
 
-    strcat(ctx->swift_args, "\"");
-    strcat(ctx->swift_args, ctx->main_swift_path);
-    strcat(ctx->swift_args, "\" ");
+    strcat(swift_args, "\"");
+    strcat(swift_args, main_path);
+    strcat(swift_args, "\" ");
 
     return 1;
 }
@@ -160,6 +161,187 @@ static void sanitize_board_options_csv(const char* in, char* out, size_t cap) {
     }
 }
 
+// Heap selection -> preprocessor flags for SwiftHeap.c / SwiftMemory.c / SwiftRuntimeSupport.
+static void heap_flags(const BuildContext* ctx, char* cflags, size_t ccap) {
+    if (cflags && ccap) cflags[0] = 0;
+    if (!ctx) return;
+
+    const int tlsf  = strcmp(ctx->heap_allocator, "tlsf") == 0;
+    const int stats = strcmp(ctx->heap_stats, "on") == 0;
+
+    snprintf(cflags, ccap, "%s%s%s%s%s",
+             tlsf ? "-DARDUINO_SWIFT_HEAP_TLSF=1" : "",
+             (tlsf && ctx->heap_size[0]) ? " -DARDUINO_SWIFT_HEAP_SIZE=" : "",
+             (tlsf && ctx->heap_size[0]) ? ctx->heap_size : "",
+             (tlsf && stats) ? " " : "",
+             stats ? "-DARDUINO_SWIFT_MEM_STATS=1" : "");
+}
+
+// Link wraps for SwiftMemory.c (see SwiftMemory.h):
+// - heap.stats "on": every malloc/calloc/free/realloc is counted.
+// - tlsf without stats: free/realloc only, so arena pointers go back to the arena.
+// - otherwise: none, the core's allocator is linked untouched.
+static const char* heap_wraps(const BuildContext* ctx) {
+    if (strcmp(ctx->heap_stats, "on") == 0) {
+        return " -Wl,--wrap=malloc -Wl,--wrap=free -Wl,--wrap=calloc -Wl,--wrap=realloc";
+    }
+    if (strcmp(ctx->heap_allocator, "tlsf") == 0) {
+        return " -Wl,--wrap=free -Wl,--wrap=realloc";
+    }
+    return "";
+}
+
+// ------------------------------------------------------------
+// Compile helpers (shared by the main image and the Giga M4 image)
+// ------------------------------------------------------------
+
+// swiftc: swift_args (core + libs + entry file) -> obj_path.
+static int compile_swift(BuildContext* ctx, const char* swift_args, const char* cpu,
+                         const char* board_opts, const char* obj_path) {
+    char swiftc_cmd[260000];
+
+    const char* swift_target = swift_target_for_swiftc(ctx);
+
+    char xcc_float[512];
+    swift_xcc_float_flags(ctx, board_opts, xcc_float, sizeof(xcc_float));
+
+    snprintf(swiftc_cmd, sizeof(swiftc_cmd),
+        "%s "
+        "-target %s -O -wmo -parse-as-library "
+        "-Xfrontend -enable-experimental-feature -Xfrontend Embedded "
+        "-Xfrontend -target-cpu -Xfrontend %s "
+        "-Xfrontend -disable-stack-protector "
+        "-Xcc -mcpu=%s -Xcc -mthumb -Xcc -ffreestanding -Xcc -fno-builtin "
+        "-Xcc -fdata-sections -Xcc -ffunction-sections "
+        "%s"
+        "%s "
+        "-c -o \"%s\"",
+        ctx->swiftc,
+        swift_target,
+        cpu,
+        cpu,
+        xcc_float,
+        swift_args,
+        obj_path
+    );
+
+    log_cmd("%s", swiftc_cmd);
+    int rc = proc_run_tee(swiftc_cmd, ctx->last_log_path, log_is_verbose());
+    if (rc != 0) {
+        log_error("Swift compile failed (log: %s)", ctx->last_log_path);
+        log_sep();
+        proc_tail_file(ctx->last_log_path, 140);
+        log_sep();
+        return 0;
+    }
+    return 1;
+}
+
+// arduino-cli compile of sketch_dir into build_dir, linking obj_path.
+//
+// Goals:
+// - Same script works for Due, Minima, Giga and future boards.
+// - No fragile embedded quoting in build-property values.
+// - Inject Swift object into final ELF link step reliably.
+static int compile_sketch(BuildContext* ctx,
+                          const char* board_opts,
+                          const char* sketch_dir,
+                          const char* build_dir,
+                          const char* obj_path) {
+    const int renesas = is_renesas_uno_fqbn(ctx);
+    const int giga    = is_mbed_giga_fqbn(ctx);
+
+    char cli_cmd[32000];
+
+    // Some cores choke on -fno-short-enums or don't need it.
+    // Keep your current policy but make it data-driven later if needed.
+    const char* core_extra = (renesas || giga) ? "" : "-fno-short-enums";
+    const char* s_extra    = "";
+
+    char heap_c[256];
+    heap_flags(ctx, heap_c, sizeof(heap_c));
+
+    char c_extra[512], cpp_extra[512];
+    snprintf(c_extra, sizeof(c_extra), "%s%s%s", core_extra, (core_extra[0] && heap_c[0]) ? " " : "", heap_c);
+    snprintf(cpp_extra, sizeof(cpp_extra), "%s", c_extra);
+
+    // For some legacy cores (Due/SAM) you used this defsym. Keep it for non-renesas/non-giga.
+    char link_tail[256];
+    snprintf(link_tail, sizeof(link_tail), "%s%s",
+             (renesas || giga) ? "" : " -Wl,--defsym=end=_end", heap_wraps(ctx));
+
+    // Board options (if any) are always optional and should be safe to pass.
+    char safe_opts[512];
+    sanitize_board_options_csv(board_opts, safe_opts, sizeof(safe_opts));
+    const int has_board_opts = (safe_opts[0] != 0);
+
+    // IMPORTANT: do NOT wrap this in extra quotes inside the property value.
+    // Otherwise gcc receives "obj + linker flags" as one single file path.
+    char elf_extra[2048];
+    snprintf(elf_extra, sizeof(elf_extra), "%s%s", obj_path, link_tail);
+
+    snprintf(cli_cmd, sizeof(cli_cmd),
+        "arduino-cli compile --clean "
+        "--fqbn \"%s\" "
+        "%s%s%s "
+        "--build-path \"%s\" "
+        "--build-property \"compiler.c.extra_flags=%s\" "
+        "--build-property \"compiler.cpp.extra_flags=%s\" "
+        "--build-property \"compiler.S.extra_flags=%s\" "
+        "--build-property \"compiler.c.elf.extra_flags=%s\" "
+        "\"%s\"",
+        ctx->fqbn_final,
+        (has_board_opts ? "--board-options \"" : ""),
+        (has_board_opts ? safe_opts : ""),
+        (has_board_opts ? "\" " : ""),
+        build_dir,
+        c_extra,
+        cpp_extra,
+        s_extra,
+        elf_extra,
+        sketch_dir
+    );
+
+    if (has_board_opts) {
+        log_info("Board options: %s", safe_opts);
+    }
+    if (strcmp(ctx->heap_allocator, "tlsf") == 0) {
+        log_info("Swift heap: tlsf (%s bytes)", ctx->heap_size[0] ? ctx->heap_size : "default");
+    }
+    if (strcmp(ctx->heap_stats, "off") == 0) {
+        log_info("Heap stats: off (Memory.heapStatsEnabled is false, heap counters read 0)");
+    }
+
+    log_cmd("%s", cli_cmd);
+    int rc = proc_run_tee(cli_cmd, ctx->last_log_path, log_is_verbose());
+    if (rc != 0) {
+        log_error("arduino-cli compile failed (log: %s)", ctx->last_log_path);
+        log_sep();
+        proc_tail_file(ctx->last_log_path, 180);
+        log_sep();
+        return 0;
+    }
+    return 1;
+}
+
+// Giga dual-core: main_m4.swift + core + "m4_lib", built for the M4 from its
+// own sketch (steps 3/4: runtime + M4 libs only, no M7 libs or assets).
+static int build_m4_image(BuildContext* ctx) {
+    log_info("Dual-core: building the M4 image from %s", ctx->m4_main_swift_path);
+
+    if (!append_main_swift(ctx->m4_swift_args, sizeof(ctx->m4_swift_args), ctx->m4_main_swift_path)) return 0;
+
+    build_ctx_set_step_log(ctx, "build_swiftc_m4");
+    if (!compile_swift(ctx, ctx->m4_swift_args, "cortex-m4", ctx->m4_board_opts_csv, ctx->m4_swift_obj_path)) return 0;
+
+    build_ctx_set_step_log(ctx, "build_arduino_cli_m4");
+    if (!compile_sketch(ctx, ctx->m4_board_opts_csv, ctx->m4_sketch_dir,
+                        ctx->m4_ard_build_dir, ctx->m4_swift_obj_path)) return 0;
+
+    log_info("M4 artifacts: %s", ctx->m4_ard_build_dir);
+    return 1;
+}
+
 // ------------------------------------------------------------
 // Step 5
 // ------------------------------------------------------------
@@ -167,121 +349,25 @@ static void sanitize_board_options_csv(const char* in, char* out, size_t cap) {
 int cmd_build_step_5_compile_and_arduino_cli(BuildContext* ctx) {
     if (!ctx) return 0;
 
-    if (!append_main_swift(ctx)) return 0;
-
-    const int renesas = is_renesas_uno_fqbn(ctx);
-    const int giga    = is_mbed_giga_fqbn(ctx);
+    if (!append_main_swift(ctx->swift_args, sizeof(ctx->swift_args), ctx->main_swift_path)) return 0;
 
     // --------------------------------------------------
     // 1) swiftc compile
     // --------------------------------------------------
     build_ctx_set_step_log(ctx, "build_swiftc");
-    {
-        char swiftc_cmd[260000];
-
-        const char* swift_target = swift_target_for_swiftc(ctx);
-
-        char xcc_float[512];
-        swift_xcc_float_flags(ctx, xcc_float, sizeof(xcc_float));
-
-        snprintf(swiftc_cmd, sizeof(swiftc_cmd),
-            "%s "
-            "-target %s -O -wmo -parse-as-library "
-            "-Xfrontend -enable-experimental-feature -Xfrontend Embedded "
-            "-Xfrontend -target-cpu -Xfrontend %s "
-            "-Xfrontend -disable-stack-protector "
-            "-Xcc -mcpu=%s -Xcc -mthumb -Xcc -ffreestanding -Xcc -fno-builtin "
-            "-Xcc -fdata-sections -Xcc -ffunction-sections "
-            "%s"
-            "%s "
-            "-c -o \"%s\"",
-            ctx->swiftc,
-            swift_target,
-            ctx->cpu,
-            ctx->cpu,
-            xcc_float,
-            ctx->swift_args,
-            ctx->swift_obj_path
-        );
-
-        log_cmd("%s", swiftc_cmd);
-        int rc = proc_run_tee(swiftc_cmd, ctx->last_log_path, log_is_verbose());
-        if (rc != 0) {
-            log_error("Swift compile failed (log: %s)", ctx->last_log_path);
-            log_sep();
-            proc_tail_file(ctx->last_log_path, 140);
-            log_sep();
-            return 0;
-        }
-    }
+    if (!compile_swift(ctx, ctx->swift_args, ctx->cpu, ctx->board_opts_csv, ctx->swift_obj_path)) return 0;
 
     // --------------------------------------------------
     // 2) arduino-cli compile
-    //
-    // Goals:
-    // - Same script works for Due, Minima, Giga and future boards.
-    // - No fragile embedded quoting in build-property values.
-    // - Inject Swift object into final ELF link step reliably.
     // --------------------------------------------------
     build_ctx_set_step_log(ctx, "build_arduino_cli");
-    {
-        char cli_cmd[32000];
-
-        // Some cores choke on -fno-short-enums or don't need it.
-        // Keep your current policy but make it data-driven later if needed.
-        const char* c_extra   = (renesas || giga) ? "" : "-fno-short-enums";
-        const char* cpp_extra = (renesas || giga) ? "" : "-fno-short-enums";
-        const char* s_extra   = "";
-
-        // For some legacy cores (Due/SAM) you used this defsym. Keep it for non-renesas/non-giga.
-        const char* link_tail = (renesas || giga) ? "" : " -Wl,--defsym=end=_end";
-
-        // Board options (if any) are always optional and should be safe to pass.
-        char safe_opts[512];
-        sanitize_board_options_csv(ctx->board_opts_csv, safe_opts, sizeof(safe_opts));
-        const int has_board_opts = (safe_opts[0] != 0);
-
-        // IMPORTANT: do NOT wrap this in extra quotes inside the property value.
-        // Otherwise gcc receives "obj + linker flags" as one single file path.
-        char elf_extra[2048];
-        snprintf(elf_extra, sizeof(elf_extra), "%s%s", ctx->swift_obj_path, link_tail);
-
-        snprintf(cli_cmd, sizeof(cli_cmd),
-            "arduino-cli compile --clean "
-            "--fqbn \"%s\" "
-            "%s%s%s "
-            "--build-path \"%s\" "
-            "--build-property \"compiler.c.extra_flags=%s\" "
-            "--build-property \"compiler.cpp.extra_flags=%s\" "
-            "--build-property \"compiler.S.extra_flags=%s\" "
-            "--build-property \"compiler.c.elf.extra_flags=%s\" "
-            "\"%s\"",
-            ctx->fqbn_final,
-            (has_board_opts ? "--board-options \"" : ""),
-            (has_board_opts ? safe_opts : ""),
-            (has_board_opts ? "\" " : ""),
-            ctx->ard_build_dir,
-            c_extra,
-            cpp_extra,
-            s_extra,
-            elf_extra,
-            ctx->sketch_dir
-        );
+    if (!compile_sketch(ctx, ctx->board_opts_csv, ctx->sketch_dir,
+                        ctx->ard_build_dir, ctx->swift_obj_path)) return 0;
 
-        if (has_board_opts) {
-            log_info("Board options: %s", safe_opts);
-        }
-
-        log_cmd("%s", cli_cmd);
-        int rc = proc_run_tee(cli_cmd, ctx->last_log_path, log_is_verbose());
-        if (rc != 0) {
-            log_error("arduino-cli compile failed (log: %s)", ctx->last_log_path);
-            log_sep();
-            proc_tail_file(ctx->last_log_path, 180);
-            log_sep();
-            return 0;
-        }
-    }
+    // --------------------------------------------------
+    // 3) Giga M4 image (main_m4.swift present)
+    // --------------------------------------------------
+    if (ctx->dual_core && !build_m4_image(ctx)) return 0;
 
     log_info("Build complete");
     log_info("Artifacts: %s", ctx->ard_build_dir);
@@ -50,17 +50,19 @@ static void board_opts_append(char* csv, size_t cap, const char* k, const char*
     }
 }
 
-static void build_board_opts_csv(
-    BuildContext* ctx,
+// Merge for the known keys; forced[i] (when non-NULL) wins over config + defaults.
+static void merge_board_opts(
+    char* csv, size_t cap,
     const char* def_ob, const char* def_oe,
-    const char* cfg_ob, const char* cfg_oe
+    const char* cfg_ob, const char* cfg_oe,
+    const char* const* forced
 ) {
     // Deterministic merge for known keys.
     // Order: config overrides defaults.
     // Keys we care (Giga): target_core, split, security
     char v_def[128], v_cfg[128];
 
-    ctx->board_opts_csv[0] = 0;
+    csv[0] = 0;
 
     const char* keys[] = { "target_core", "split", "security" };
     for (int i = 0; i < 3; i++) {
@@ -72,10 +74,103 @@ static void build_board_opts_csv(
         if (cfg_ob && cfg_oe) (void)asw_json_get_string_in_span(cfg_ob, cfg_oe, k, v_cfg, sizeof(v_cfg));
 
         const char* chosen = v_cfg[0] ? v_cfg : (v_def[0] ? v_def : NULL);
-        if (chosen) board_opts_append(ctx->board_opts_csv, sizeof(ctx->board_opts_csv), k, chosen);
+        if (forced && forced[i]) chosen = forced[i];
+        if (chosen) board_opts_append(csv, cap, k, chosen);
     }
 }
 
+static void build_board_opts_csv(
+    BuildContext* ctx,
+    const char* def_ob, const char* def_oe,
+    const char* cfg_ob, const char* cfg_oe
+) {
+    merge_board_opts(ctx->board_opts_csv, sizeof(ctx->board_opts_csv),
+                     def_ob, def_oe, cfg_ob, cfg_oe, NULL);
+}
+
+// Giga with main_m4.swift next to main.swift: build a second image for the M4.
+// Both images must agree on the flash split, and 100_0 gives the M4 nothing,
+// so config.json has to name the split itself (the board default is 100_0).
+static int resolve_dual_core(
+    BuildContext* ctx,
+    const char* def_ob, const char* def_oe,
+    const char* cfg_ob, const char* cfg_oe
+) {
+    ctx->dual_core = 0;
+    ctx->m4_board_opts_csv[0] = 0;
+
+    if (strcmp(ctx->api, "giga_mbed") != 0) return 1;
+    if (!file_exists(ctx->m4_main_swift_path)) return 1;
+
+    if (strstr(ctx->board_opts_csv, "target_core=cm4") != NULL) {
+        log_warn("main_m4.swift ignored: board_options.target_core is cm4 (main.swift already targets the M4)");
+        return 1;
+    }
+
+    char split[32] = {0};
+    if (cfg_ob && cfg_oe) (void)asw_json_get_string_in_span(cfg_ob, cfg_oe, "split", split, sizeof(split));
+    if (!split[0] || strcmp(split, "100_0") == 0) {
+        log_error("main_m4.swift needs flash for the M4: set \"board_options\": { \"split\": \"75_25\" }\n"
+                  "(or 50_50) in config.json. The board default 100_0 leaves the M4 no flash.");
+        return 0;
+    }
+
+    const char* forced_m7[] = { "cm7", NULL, NULL };
+    const char* forced_m4[] = { "cm4", NULL, NULL };
+    merge_board_opts(ctx->board_opts_csv, sizeof(ctx->board_opts_csv),
+                     def_ob, def_oe, cfg_ob, cfg_oe, forced_m7);
+    merge_board_opts(ctx->m4_board_opts_csv, sizeof(ctx->m4_board_opts_csv),
+                     def_ob, def_oe, cfg_ob, cfg_oe, forced_m4);
+
+    ctx->dual_core = 1;
+    return 1;
+}
+
+static int is_decimal(const char* s) {
+    if (!s || !s[0]) return 0;
+    for (const char* p = s; *p; p++) {
+        if (*p < '0' || *p > '9') return 0;
+    }
+    return 1;
+}
+
+static int resolve_heap(
+    BuildContext* ctx,
+    const char* def_ob, const char* def_oe,
+    const char* cfg_ob, const char* cfg_oe
+) {
+    // Same merge rule as board_options: config overrides board defaults.
+    const char* keys[] = { "allocator", "size", "stats" };
+    char* outs[] = { ctx->heap_allocator, ctx->heap_size, ctx->heap_stats };
+    size_t caps[] = { sizeof(ctx->heap_allocator), sizeof(ctx->heap_size), sizeof(ctx->heap_stats) };
+
+    for (int i = 0; i < 3; i++) {
+        outs[i][0] = 0;
+        if (cfg_ob && cfg_oe) (void)asw_json_get_string_in_span(cfg_ob, cfg_oe, keys[i], outs[i], caps[i]);
+        if (!outs[i][0] && def_ob && def_oe) (void)asw_json_get_string_in_span(def_ob, def_oe, keys[i], outs[i], caps[i]);
+    }
+
+    if (!ctx->heap_allocator[0]) strncpy(ctx->heap_allocator, "newlib", sizeof(ctx->heap_allocator) - 1);
+
+    if (strcmp(ctx->heap_allocator, "newlib") != 0 && strcmp(ctx->heap_allocator, "tlsf") != 0) {
+        log_error("heap.allocator must be \"newlib\" or \"tlsf\" (got: %s)", ctx->heap_allocator);
+        return 0;
+    }
+
+    if (!ctx->heap_stats[0]) strncpy(ctx->heap_stats, "on", sizeof(ctx->heap_stats) - 1);
+
+    if (strcmp(ctx->heap_stats, "off") != 0 && strcmp(ctx->heap_stats, "on") != 0) {
+        log_error("heap.stats must be \"on\" or \"off\" (got: %s)", ctx->heap_stats);
+        return 0;
+    }
+
+    if (ctx->heap_size[0] && !is_decimal(ctx->heap_size)) {
+        log_error("heap.size must be a decimal byte count (got: %s)", ctx->heap_size);
+        return 0;
+    }
+    return 1;
+}
+
 int build_ctx_init(BuildContext* ctx) {
     if (!ctx) return 0;
     zero_ctx(ctx);
@@ -109,6 +204,12 @@ int build_ctx_init(BuildContext* ctx) {
     snprintf(ctx->swift_obj_path, sizeof(ctx->swift_obj_path), "%s/ArduinoSwiftApp.o", ctx->sketch_dir);
     snprintf(ctx->main_swift_path, sizeof(ctx->main_swift_path), "%s/main.swift", ctx->project_root);
 
+    snprintf(ctx->m4_main_swift_path, sizeof(ctx->m4_main_swift_path), "%s/main_m4.swift", ctx->project_root);
+    snprintf(ctx->m4_dir, sizeof(ctx->m4_dir), "%s/m4", ctx->build_dir);
+    snprintf(ctx->m4_sketch_dir, sizeof(ctx->m4_sketch_dir), "%s/sketch", ctx->m4_dir);
+    snprintf(ctx->m4_ard_build_dir, sizeof(ctx->m4_ard_build_dir), "%s/arduino_build", ctx->m4_dir);
+    snprintf(ctx->m4_swift_obj_path, sizeof(ctx->m4_swift_obj_path), "%s/ArduinoSwiftApp.o", ctx->m4_sketch_dir);
+
     // Resolve swiftc (override supported)
     {
         char pfile[1024];
@@ -178,6 +279,7 @@ int build_ctx_select_board_and_parse(BuildContext* ctx) {
     // libs
     ctx->swift_lib_count   = asw_parse_json_string_array(ctx->cfg_json, "lib",        ctx->swift_libs,   64);
     ctx->arduino_lib_count = asw_parse_json_string_array(ctx->cfg_json, "arduino_lib", ctx->arduino_libs, 64);
+    ctx->m4_swift_lib_count = asw_parse_json_string_array(ctx->cfg_json, "m4_lib",     ctx->m4_swift_libs, 64);
 
     // board
     if (!asw_json_get_string(ctx->cfg_json, "board", ctx->board, sizeof(ctx->board))) {
@@ -243,6 +345,18 @@ int build_ctx_select_board_and_parse(BuildContext* ctx) {
     (void)asw_json_get_object_span(ctx->cfg_json, "board_options", &cfg_ob2, &cfg_oe2);
 
     build_board_opts_csv(ctx, def_ob, def_oe, cfg_ob2, cfg_oe2);
+    if (!resolve_dual_core(ctx, def_ob, def_oe, cfg_ob2, cfg_oe2)) return 0;
+
+    // ---- Swift heap selection ----
+    const char* heap_def_ob = NULL;
+    const char* heap_def_oe = NULL;
+    (void)asw_json_get_object_span_in_span(ob, oe, "default_heap", &heap_def_ob, &heap_def_oe);
+
+    const char* heap_cfg_ob = NULL;
+    const char* heap_cfg_oe = NULL;
+    (void)asw_json_get_object_span(ctx->cfg_json, "heap", &heap_cfg_ob, &heap_cfg_oe);
+
+    if (!resolve_heap(ctx, heap_def_ob, heap_def_oe, heap_cfg_ob, heap_cfg_oe)) return 0;
 
     return 1;
 }
@@ -252,6 +366,7 @@ int build_ctx_prepare_dirs(BuildContext* ctx) {
 
     (void)fs_rm_rf(ctx->sketch_dir);
     (void)fs_rm_rf(ctx->ard_build_dir);
+    (void)fs_rm_rf(ctx->m4_dir);
 
     if (!fs_mkdir_p(ctx->build_dir)) return 0;
     if (!fs_mkdir_p(ctx->sketch_dir)) return 0;
@@ -262,6 +377,13 @@ int build_ctx_prepare_dirs(BuildContext* ctx) {
     snprintf(libs_root, sizeof(libs_root), "%s/libraries", ctx->sketch_dir);
     if (!fs_mkdir_p(libs_root)) return 0;
 
+    // Giga M4 image: its own sketch (runtime + "m4_lib" only), see step 3/4.
+    if (ctx->dual_core) {
+        snprintf(libs_root, sizeof(libs_root), "%s/libraries", ctx->m4_sketch_dir);
+        if (!fs_mkdir_p(libs_root)) return 0;
+        if (!fs_mkdir_p(ctx->m4_ard_build_dir)) return 0;
+    }
+
     return 1;
 }
 
@@ -58,6 +58,11 @@ typedef struct BuildContext {
     char fpu[64];            // e.g. "fpv5-d16"
     char swiftc[512];
 
+    // ---- Swift heap (boards.json "default_heap", overridden by config.json "heap") ----
+    char heap_allocator[32]; // "newlib" (default) | "tlsf"
+    char heap_size[32];      // arena bytes for tlsf (decimal string)
+    char heap_stats[8];      // "on" (default): SwiftMemory.c counters + malloc wraps | "off"
+
     // ---- Arduino sketchbook user libs ----
     char user_arduino_lib_dir[1024];
 
@@ -76,8 +81,20 @@ typedef struct BuildContext {
     char swift_obj_path[1024];
     char main_swift_path[1024];
 
-    // Big args buffer (compile command assembly)
+    // ---- Dual-core (Giga): second image for the M4 from main_m4.swift ----
+    int  dual_core;               // 1 when main_m4.swift exists and the board has an M4
+    char m4_main_swift_path[1024];
+    char m4_dir[1024];            // build/m4
+    char m4_sketch_dir[1024];
+    char m4_ard_build_dir[1024];
+    char m4_swift_obj_path[1024];
+    char m4_board_opts_csv[256];  // board_opts_csv with target_core=cm4
+    char m4_swift_libs[64][64];   // config.json "m4_lib" (default: core only)
+    int  m4_swift_lib_count;
+
+    // Big args buffers (compile command assembly): main image, Giga M4 image
     char swift_args[200000];
+    char m4_swift_args[200000];
 } BuildContext;
 
 int  build_ctx_init(BuildContext* ctx);
@@ -200,6 +200,26 @@ static int choose_port(BuildContext* ctx, char* out, size_t cap) {
     return 1;
 }
 
+// After a reset the port disappears and re-enumerates. Poll instead of guessing
+// a delay: a /dev path from PORT must exist again, otherwise detection must
+// find the board. Non-path PORT values (DFU "1-1") cannot be probed and are
+// taken as is.
+#define PORT_WAIT_MS      15000
+#define PORT_POLL_MS      250
+
+static int wait_for_port(BuildContext* ctx, char* out, size_t cap) {
+    for (int waited = 0; waited <= PORT_WAIT_MS; waited += PORT_POLL_MS) {
+        sleep_ms(PORT_POLL_MS);
+        const char* env = getenv("PORT");
+        if (env && env[0]) {
+            if (env[0] != '/' || path_exists(env)) return choose_port(ctx, out, cap);
+            continue;
+        }
+        if (choose_port(ctx, out, cap)) return 1;
+    }
+    return 0;
+}
+
 // ------------------------------------------------------------
 // Artifact checks
 // ------------------------------------------------------------
@@ -234,6 +254,54 @@ static void debug_list_artifacts(const char* dir) {
     run_cmd(cmd);
 }
 
+// ------------------------------------------------------------
+// Upload one image
+// ------------------------------------------------------------
+
+static int upload_image(const char* port,
+                        const char* fqbn,
+                        const char* board_opts,
+                        const char* input_dir,
+                        const char* sketch_dir) {
+    char cmd[8192];
+    if (board_opts && board_opts[0]) {
+        snprintf(cmd, sizeof(cmd),
+                 "arduino-cli upload "
+                 "-p \"%s\" "
+                 "--fqbn \"%s\" "
+                 "--board-options \"%s\" "
+                 "--input-dir \"%s\" "
+                 "\"%s\"",
+                 port,
+                 fqbn,
+                 board_opts,
+                 input_dir,
+                 sketch_dir);
+    } else {
+        snprintf(cmd, sizeof(cmd),
+                 "arduino-cli upload "
+                 "-p \"%s\" "
+                 "--fqbn \"%s\" "
+                 "--input-dir \"%s\" "
+                 "\"%s\"",
+                 port,
+                 fqbn,
+                 input_dir,
+                 sketch_dir);
+    }
+
+    log_cmd("%s", cmd);
+
+    int rc = run_cmd(cmd);
+    if (rc != 0) {
+        log_error("arduino-cli upload failed");
+        log_info("Tip: on DFU boards (like UNO R4), try double-tap RESET to re-enter DFU, then re-run upload.");
+        log_info("Tip: or set PORT explicitly (example DFU port can be like '1-1').");
+        return 0;
+    }
+    return 1;
+}
+
 // ------------------------------------------------------------
 // Step 3: detect port + upload
 // ------------------------------------------------------------
@@ -269,46 +337,34 @@ int upload_step_3_detect_port_and_upload(BuildContext* ctx) {
         return 0;
     }
 
+    // Dual-core Giga: the M4 image must exist too, or the M7 would boot an empty core.
+    if (ctx->dual_core && !has_build_artifacts(ctx->m4_ard_build_dir)) {
+        log_error("main_m4.swift present but no M4 build artifacts under: %s", ctx->m4_ard_build_dir);
+        log_error("Fix: run `arduino-swift build` first (it builds both images).");
+        return 0;
+    }
+
     log_info("Uploading...");
     log_info("FQBN: %s", fqbn);
     log_info("PORT: %s", port);
     log_info("Input dir: %s", ctx->ard_build_dir);
 
-    char cmd[8192];
-    if (ctx->board_opts_csv[0]) {
-        snprintf(cmd, sizeof(cmd),
-                 "arduino-cli upload "
-                 "-p \"%s\" "
-                 "--fqbn \"%s\" "
-                 "--board-options \"%s\" "
-                 "--input-dir \"%s\" "
-                 "\"%s\"",
-                 port,
-                 fqbn,
-                 ctx->board_opts_csv,
-                 ctx->ard_build_dir,
-                 ctx->sketch_dir);
-    } else {
-        snprintf(cmd, sizeof(cmd),
-                 "arduino-cli upload "
-                 "-p \"%s\" "
-                 "--fqbn \"%s\" "
-                 "--input-dir \"%s\" "
-                 "\"%s\"",
-                 port,
-                 fqbn,
-                 ctx->ard_build_dir,
-                 ctx->sketch_dir);
-    }
+    if (!upload_image(port, fqbn, ctx->board_opts_csv, ctx->ard_build_dir, ctx->sketch_dir)) return 0;
 
-    log_cmd("%s", cmd);
+    if (ctx->dual_core) {
+        // The board resets after the first image; wait for it to enumerate again.
+        if (!wait_for_port(ctx, port, sizeof(port))) {
+            log_error("PORT did not come back within %d ms for the M4 image.\n"
+                      "Fix: set PORT explicitly and re-run upload.", PORT_WAIT_MS);
+            debug_dump_port_diagnostics();
+            return 0;
+        }
 
-    int rc = run_cmd(cmd);
-    if (rc != 0) {
-        log_error("arduino-cli upload failed");
-        log_info("Tip: on DFU boards (like UNO R4), try double-tap RESET to re-enter DFU, then re-run upload.");
-        log_info("Tip: or set PORT explicitly (example DFU port can be like '1-1').");
-        return 0;
+        log_info("Uploading M4 image...");
+        log_info("PORT: %s", port);
+        log_info("Input dir: %s", ctx->m4_ard_build_dir);
+
+        if (!upload_image(port, fqbn, ctx->m4_board_opts_csv, ctx->m4_ard_build_dir, ctx->m4_sketch_dir)) return 0;
     }
 
     log_info("Upload complete");
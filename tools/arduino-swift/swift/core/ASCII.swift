@@ -21,3 +21,17 @@ public func asciiEquals(_ a: [UInt8], _ b: [UInt8]) -> Bool {
     }
     return true
 }
+
+/// Compares a received slice with an ASCII literal without allocating.
+@inline(__always)
+public func asciiEquals(_ a: UnsafeBufferPointer<UInt8>, _ b: StaticString) -> Bool {
+    let n = b.utf8CodeUnitCount
+    if a.count != n { return false }
+    let p = b.utf8Start
+    var i = 0
+    while i < n {
+        if a[i] != p[i] { return false }
+        i &+= 1
+    }
+    return true
+}
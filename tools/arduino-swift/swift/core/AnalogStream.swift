@@ -0,0 +1,158 @@
+// AnalogStream.swift
+// Continuous multi-channel ADC sampling (Embedded Swift friendly).
+//
+// Features:
+// - The board samples in the background at a fixed frame rate (AdcStream.h):
+//   DMA / PDC where the board API has it, analogRead() in a timer ISR otherwise
+// - Samples land in fixed blocks of `framesPerBlock` frames, channels interleaved
+//   in pin order; each block carries the micros() stamp of its last frame
+// - Storage is one ring allocated at init; draining is allocation-free
+// - Ring full: new blocks are dropped and counted in `overruns`
+//
+// Usage:
+//   let adc = AnalogStream(pins: [54, 55, 56, 57], rateHz: 10_000)
+//   _ = adc.start()
+//   adc.onBlock = { block in
+//       let first = block.sample(frame: 0, channel: 0)
+//   }
+//   ArduinoRuntime.add(adc)
+
+public final class AnalogStream: ArduinoTickable {
+
+    public enum Mode {
+        case off
+        case dma
+        case timer
+    }
+
+    /// One block of interleaved samples. Borrowed: valid only inside the callback.
+    public struct Block {
+        public let samples: UnsafeBufferPointer<UInt16>
+        public let channels: Int
+        public let frames: Int
+
+        /// micros() when the last frame of the block was converted.
+        public let stampMicros: U32
+
+        @inline(__always)
+        public func sample(frame: Int, channel: Int) -> UInt16 {
+            samples[frame &* channels &+ channel]
+        }
+    }
+
+    public typealias Handler = (Block) -> Void
+
+    // MARK: - Public
+
+    public let pins: [U32]
+    public let rateHz: U32
+    public let framesPerBlock: Int
+    public let blocks: Int
+
+    public var onBlock: Handler?
+
+    /// Max blocks delivered per tick. Keeps a backlog from stalling other tickables.
+    public var maxBlocksPerTick: Int = 4
+
+    public private(set) var mode: Mode = .off
+
+    // MARK: - Storage
+
+    private let storage: UnsafeMutableRawPointer
+
+    // MARK: - Init
+
+    /// `blocks` is rounded up to a power of two (min 2); at most 8 pins.
+    public init(pins: [Int], rateHz: U32, framesPerBlock: Int = 32, blocks: Int = 8, onBlock: Handler? = nil) {
+        var list: [U32] = []
+        var i = 0
+        while i < pins.count && i < 8 {
+            list.append(U32(pins[i]))
+            i += 1
+        }
+
+        var n = 2
+        while n < blocks && n < 0x4000 { n <<= 1 }
+
+        self.pins = list
+        self.rateHz = rateHz
+        self.framesPerBlock = framesPerBlock > 0 ? framesPerBlock : 1
+        self.blocks = n
+        self.onBlock = onBlock
+
+        let bytes = arduino_adc_stream_bytes(U32(list.count), U32(self.framesPerBlock), U32(n))
+        self.storage = UnsafeMutableRawPointer.allocate(byteCount: Int(bytes), alignment: 32)
+    }
+
+    deinit {
+        stop()
+        storage.deallocate()
+    }
+
+    // MARK: - Control
+
+    /// Returns false when the board cannot stream these pins at this rate.
+    @discardableResult
+    public func start() -> Bool {
+        if pins.isEmpty { return false }
+
+        let raw = pins.withUnsafeBufferPointer { buf in
+            arduino_adc_stream_start(
+                buf.baseAddress!, U32(buf.count), rateHz,
+                U32(framesPerBlock), U32(blocks), storage
+            )
+        }
+
+        switch raw {
+        case 1:  mode = .dma
+        case 2:  mode = .timer
+        default: mode = .off
+        }
+        return mode != .off
+    }
+
+    public func stop() {
+        if mode == .off { return }
+        arduino_adc_stream_stop()
+        mode = .off
+    }
+
+    // MARK: - Consumer
+
+    /// Blocks waiting to be drained.
+    public var available: Int { Int(arduino_adc_stream_available()) }
+
+    /// Blocks dropped because the consumer fell behind.
+    public var overruns: U32 { arduino_adc_stream_overruns() }
+
+    /// Blocks produced since start (delivered + dropped).
+    public var produced: U32 { arduino_adc_stream_total() }
+
+    /// Hands up to `max` queued blocks to `body`, oldest first. Returns how many.
+    @discardableResult
+    public func drain(max: Int = Int.max, _ body: Handler) -> Int {
+        let channels = pins.count
+        let len = channels &* framesPerBlock
+
+        var n = 0
+        var stamp: U32 = 0
+        while n < max, let p = arduino_adc_stream_peek(&stamp) {
+            body(Block(
+                samples: UnsafeBufferPointer(start: p, count: len),
+                channels: channels,
+                frames: framesPerBlock,
+                stampMicros: stamp
+            ))
+            arduino_adc_stream_release()
+            n += 1
+        }
+        return n
+    }
+
+    // MARK: - ArduinoTickable
+
+    public func tick() {
+        guard mode != .off, let handler = onBlock else { return }
+        drain(max: maxBlocksPerTick, handler)
+    }
+}
@@ -19,6 +19,44 @@ public func arduino_digitalWrite(_ pin: U32, _ value: U32) -> Void
 @_silgen_name("arduino_digitalRead")
 public func arduino_digitalRead(_ pin: U32) -> U32
 
+// ----------------------
+// Fast IO (FastIO.h: handle = 8 words of register address / mask)
+// ----------------------
+/// Fills `out` (8 words). Returns 0 when the board has no direct-register path for `pin`.
+@_silgen_name("arduino_fastio_resolve")
+public func arduino_fastio_resolve(_ pin: U32, _ out: UnsafeMutablePointer<UInt>) -> U32
+
+@_silgen_name("arduino_fastio_set")
+public func arduino_fastio_set(_ h: UnsafePointer<UInt>) -> Void
+
+@_silgen_name("arduino_fastio_clear")
+public func arduino_fastio_clear(_ h: UnsafePointer<UInt>) -> Void
+
+@_silgen_name("arduino_fastio_write")
+public func arduino_fastio_write(_ h: UnsafePointer<UInt>, _ value: U32) -> Void
+
+@_silgen_name("arduino_fastio_toggle")
+public func arduino_fastio_toggle(_ h: UnsafePointer<UInt>) -> Void
+
+@_silgen_name("arduino_fastio_read")
+public func arduino_fastio_read(_ h: UnsafePointer<UInt>) -> U32
+
+// ----------------------
+// Pin groups (FastIO.h: storage = arduino_pingroup_words(count) words)
+// ----------------------
+@_silgen_name("arduino_pingroup_words")
+public func arduino_pingroup_words(_ count: U32) -> U32
+
+/// Returns 0 when any pin has no direct-register path (caller falls back to digitalWrite).
+@_silgen_name("arduino_pingroup_init")
+public func arduino_pingroup_init(_ g: UnsafeMutablePointer<UInt>, _ pins: UnsafePointer<U32>, _ count: U32) -> U32
+
+@_silgen_name("arduino_pingroup_write")
+public func arduino_pingroup_write(_ g: UnsafePointer<UInt>, _ value: U32) -> Void
+
+@_silgen_name("arduino_pingroup_read")
+public func arduino_pingroup_read(_ g: UnsafePointer<UInt>) -> U32
+
 // ----------------------
 // Timing
 // ----------------------
@@ -28,6 +66,29 @@ public func arduino_delay_ms(_ ms: U32) -> Void
 @_silgen_name("arduino_millis")
 public func arduino_millis() -> U32
 
+/// 64-bit monotonic microseconds (wrap of the core's 32-bit micros() handled in C).
+@_silgen_name("arduino_micros")
+public func arduino_micros() -> UInt64
+
+@_silgen_name("arduino_delay_us")
+public func arduino_delay_us(_ us: U32) -> Void
+
+// ----------------------
+// Cycle counter (CycleCounter.h: DWT CYCCNT)
+// ----------------------
+/// Returns 1 when CYCCNT is running.
+@_silgen_name("arduino_cycles_enable")
+public func arduino_cycles_enable() -> U32
+
+@_silgen_name("arduino_cycles_read")
+public func arduino_cycles_read() -> U32
+
+@_silgen_name("arduino_cycles_hz")
+public func arduino_cycles_hz() -> U32
+
+@_silgen_name("arduino_cycles_to_ns")
+public func arduino_cycles_to_ns(_ cycles: U32) -> UInt64
+
 // ----------------------
 // Analog
 // ----------------------
@@ -40,6 +101,118 @@ public func arduino_analogReadResolution(_ bits: U32) -> Void
 @_silgen_name("arduino_analogMaxValue")
 public func arduino_analogMaxValue() -> U32
 
+// ----------------------
+// ADC stream (AdcStream.h: block ring, caller-owned storage)
+// ----------------------
+/// Returns the mode (0 off, 1 DMA, 2 timer ISR). `storage` must be 32-byte aligned.
+@_silgen_name("arduino_adc_stream_start")
+public func arduino_adc_stream_start(
+    _ pins: UnsafePointer<U32>, _ channels: U32, _ rateHz: U32,
+    _ frames: U32, _ blocks: U32, _ storage: UnsafeMutableRawPointer
+) -> U32
+
+@_silgen_name("arduino_adc_stream_stop")
+public func arduino_adc_stream_stop() -> Void
+
+@_silgen_name("arduino_adc_stream_mode")
+public func arduino_adc_stream_mode() -> U32
+
+@_silgen_name("arduino_adc_stream_bytes")
+public func arduino_adc_stream_bytes(_ channels: U32, _ frames: U32, _ blocks: U32) -> U32
+
+@_silgen_name("arduino_adc_stream_available")
+public func arduino_adc_stream_available() -> U32
+
+/// Oldest queued block (nil when empty); valid until arduino_adc_stream_release().
+@_silgen_name("arduino_adc_stream_peek")
+public func arduino_adc_stream_peek(_ stampUs: UnsafeMutablePointer<U32>?) -> UnsafePointer<UInt16>?
+
+@_silgen_name("arduino_adc_stream_release")
+public func arduino_adc_stream_release() -> Void
+
+@_silgen_name("arduino_adc_stream_overruns")
+public func arduino_adc_stream_overruns() -> U32
+
+@_silgen_name("arduino_adc_stream_total")
+public func arduino_adc_stream_total() -> U32
+
+// ----------------------
+// Hardware timers (HwTimer.h: per-slot tick queues filled by the timer ISR)
+// ----------------------
+/// Returns the slot, or -1 when no timer is free / period_us < 10.
+@_silgen_name("arduino_hwtimer_open")
+public func arduino_hwtimer_open(_ periodUs: U32) -> I32
+
+@_silgen_name("arduino_hwtimer_close")
+public func arduino_hwtimer_close(_ slot: U32) -> Void
+
+@_silgen_name("arduino_hwtimer_set_toggle")
+public func arduino_hwtimer_set_toggle(_ slot: U32, _ pin: U32) -> U32
+
+/// 0 when the pin has no fast IO path.
+@_silgen_name("arduino_hwtimer_can_toggle")
+public func arduino_hwtimer_can_toggle(_ pin: U32) -> U32
+
+@_silgen_name("arduino_hwtimer_clear_actions")
+public func arduino_hwtimer_clear_actions(_ slot: U32) -> Void
+
+@_silgen_name("arduino_hwtimer_ticks")
+public func arduino_hwtimer_ticks(_ slot: U32) -> U32
+
+/// Returns 0 when the slot's queue is empty.
+@_silgen_name("arduino_hwtimer_pop")
+public func arduino_hwtimer_pop(_ slot: U32, _ stampUs: UnsafeMutablePointer<U32>?) -> U32
+
+@_silgen_name("arduino_hwtimer_dropped")
+public func arduino_hwtimer_dropped(_ slot: U32) -> U32
+
+// ----------------------
+// Core link (CoreLink.h: message rings between the two cores of a dual-core board)
+// ----------------------
+/// Main core: formats the shared window, returns 1. Aux core: 1 once the main core did.
+@_silgen_name("arduino_corelink_open")
+public func arduino_corelink_open() -> U32
+
+/// 0 = main core (Giga M7, or the only core), 1 = aux core (Giga M4).
+@_silgen_name("arduino_corelink_core")
+public func arduino_corelink_core() -> U32
+
+@_silgen_name("arduino_corelink_is_dual")
+public func arduino_corelink_is_dual() -> U32
+
+@_silgen_name("arduino_corelink_boot_aux")
+public func arduino_corelink_boot_aux() -> U32
+
+@_silgen_name("arduino_corelink_payload_max")
+public func arduino_corelink_payload_max() -> U32
+
+/// Returns 0 when the outgoing ring is full or len > payload max.
+@_silgen_name("arduino_corelink_send")
+public func arduino_corelink_send(_ data: UnsafePointer<U8>?, _ len: U32) -> U32
+
+/// Payload area of the next outgoing slot (nil when full); publish with arduino_corelink_commit().
+@_silgen_name("arduino_corelink_reserve")
+public func arduino_corelink_reserve() -> UnsafeMutablePointer<U8>?
+
+@_silgen_name("arduino_corelink_commit")
+public func arduino_corelink_commit(_ len: U32) -> Void
+
+/// Oldest incoming message (nil when empty); valid until arduino_corelink_release().
+@_silgen_name("arduino_corelink_peek")
+public func arduino_corelink_peek(_ len: UnsafeMutablePointer<U32>?) -> UnsafePointer<U8>?
+
+@_silgen_name("arduino_corelink_release")
+public func arduino_corelink_release() -> Void
+
+@_silgen_name("arduino_corelink_available")
+public func arduino_corelink_available() -> U32
+
+@_silgen_name("arduino_corelink_signals")
+public func arduino_corelink_signals() -> U32
+
+@_silgen_name("arduino_corelink_dropped")
+public func arduino_corelink_dropped() -> U32
+
 // ----------------------
 // Constants
 // ----------------------
@@ -88,6 +261,10 @@ public func arduino_irq_detach(_ slot: I32) -> Void
 @_silgen_name("arduino_irq_consume")
 public func arduino_irq_consume(_ slot: I32) -> U32
 
+/// Edges since the last call + micros() (low 32 bits) of the latest edge.
+@_silgen_name("arduino_irq_consume_edges")
+public func arduino_irq_consume_edges(_ slot: I32, _ lastUs: UnsafeMutablePointer<U32>?) -> U32
+
 @_silgen_name("arduino_digitalPinToInterrupt")
 public func arduino_digitalPinToInterrupt(_ pin: U32) -> I32
 
@@ -109,6 +286,58 @@ public func arduino_serial_print_u32(_ v: U32) -> Void
 @_silgen_name("arduino_serial_print_f64")
 public func arduino_serial_print_f64(_ v: Double) -> Void
 
+/// Digits print(Double) / print(Float) use without `digits:` (6; 2 on Due).
+@_silgen_name("arduino_serial_float_digits")
+public func arduino_serial_float_digits() -> U32
+
+/// Bytes already buffered by the core (never blocks).
+@_silgen_name("arduino_serial_available")
+public func arduino_serial_available() -> I32
+
+/// Drains up to `cap` buffered bytes into `out`. Returns bytes copied (never blocks).
+@_silgen_name("arduino_serial_read_buf")
+public func arduino_serial_read_buf(_ out: UnsafeMutablePointer<U8>?, _ cap: U32) -> U32
+
+// ----------------------
+// Memory (SwiftMemory.c: heap counters + stack high-water mark)
+// ----------------------
+/// 1 when the build keeps heap counters (config.json "heap": { "stats": "on" }, the default).
+@_silgen_name("arduino_mem_stats_enabled")
+public func arduino_mem_stats_enabled() -> U32
+
+@_silgen_name("arduino_mem_live_bytes")
+public func arduino_mem_live_bytes() -> U32
+
+@_silgen_name("arduino_mem_peak_bytes")
+public func arduino_mem_peak_bytes() -> U32
+
+@_silgen_name("arduino_mem_alloc_count")
+public func arduino_mem_alloc_count() -> U32
+
+@_silgen_name("arduino_mem_free_count")
+public func arduino_mem_free_count() -> U32
+
+@_silgen_name("arduino_mem_failed_count")
+public func arduino_mem_failed_count() -> U32
+
+@_silgen_name("arduino_mem_largest_free")
+public func arduino_mem_largest_free() -> U32
+
+@_silgen_name("arduino_mem_bucket_count")
+public func arduino_mem_bucket_count(_ i: U32) -> U32
+
+@_silgen_name("arduino_mem_bucket_limit")
+public func arduino_mem_bucket_limit(_ i: U32) -> U32
+
+@_silgen_name("arduino_mem_stack_used")
+public func arduino_mem_stack_used() -> U32
+
+@_silgen_name("arduino_mem_stack_size")
+public func arduino_mem_stack_size() -> U32
+
+@_silgen_name("arduino_mem_reset_peak")
+public func arduino_mem_reset_peak() -> Void
+
 // ----------------------
 // SPI (optional, for later)
 // ----------------------
@@ -28,6 +28,10 @@ public enum ArduinoRuntime {
 
     @inline(__always)
     public static func tickAll() {
+        // Keeps the 64-bit micros extension fed across the 32-bit wrap even
+        // when no tickable reads the clock.
+        _ = arduino_micros()
+
         for it in items {
             it.tick()
         }
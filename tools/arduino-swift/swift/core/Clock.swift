@@ -0,0 +1,153 @@
+// Clock.swift
+// Microsecond time base + DWT cycle counter (Embedded Swift friendly).
+//
+// Features:
+// - Clock.now(): 64-bit monotonic microseconds (arduino_micros, never wraps in practice)
+// - Clock.Instant / Clock.Duration: integer microseconds, wrap-free arithmetic
+// - Clock.sleep(for:): cooperative for >= 1 ms (runtime keeps ticking), busy-wait below
+// - Clock.Cycles: CYCCNT reads, cycles -> ns, measure { } for profiling
+//
+// The types are nested in `Clock` so they never collide with the stdlib
+// `Clock` / `Duration` names.
+//
+// Usage:
+//   let t0 = Clock.now()
+//   work()
+//   let dt = Clock.now() - t0            // Clock.Duration
+//   if dt > .millis(2) { println("slow") }
+//
+//   let cycles = Clock.Cycles.measure { work() }
+
+public enum Clock {
+
+    // MARK: - Duration
+
+    public struct Duration: Comparable {
+        public var micros: Int64
+
+        @inline(__always)
+        public init(micros: Int64) { self.micros = micros }
+
+        @inline(__always)
+        public static func micros(_ v: Int64) -> Duration { Duration(micros: v) }
+
+        @inline(__always)
+        public static func millis(_ v: Int64) -> Duration { Duration(micros: v &* 1_000) }
+
+        @inline(__always)
+        public static func seconds(_ v: Int64) -> Duration { Duration(micros: v &* 1_000_000) }
+
+        public static let zero = Duration(micros: 0)
+
+        /// Whole milliseconds (truncated toward zero).
+        public var millis: Int64 { micros / 1_000 }
+
+        @inline(__always)
+        public static func < (a: Duration, b: Duration) -> Bool { a.micros < b.micros }
+
+        @inline(__always)
+        public static func + (a: Duration, b: Duration) -> Duration { Duration(micros: a.micros &+ b.micros) }
+
+        @inline(__always)
+        public static func - (a: Duration, b: Duration) -> Duration { Duration(micros: a.micros &- b.micros) }
+
+        @inline(__always)
+        public static func * (a: Duration, n: Int64) -> Duration { Duration(micros: a.micros &* n) }
+    }
+
+    // MARK: - Instant
+
+    public struct Instant: Comparable {
+        /// Microseconds since boot.
+        public let micros: UInt64
+
+        @inline(__always)
+        public init(micros: UInt64) { self.micros = micros }
+
+        @inline(__always)
+        public func advanced(by d: Duration) -> Instant {
+            Instant(micros: UInt64(bitPattern: Int64(bitPattern: micros) &+ d.micros))
+        }
+
+        /// Time since this instant.
+        @inline(__always)
+        public var elapsed: Duration { Clock.now() - self }
+
+        /// True once `now` has reached this instant.
+        @inline(__always)
+        public var hasPassed: Bool { Clock.now().micros >= micros }
+
+        @inline(__always)
+        public static func < (a: Instant, b: Instant) -> Bool { a.micros < b.micros }
+
+        @inline(__always)
+        public static func - (a: Instant, b: Instant) -> Duration {
+            Duration(micros: Int64(bitPattern: a.micros &- b.micros))
+        }
+
+        @inline(__always)
+        public static func + (a: Instant, d: Duration) -> Instant { a.advanced(by: d) }
+    }
+
+    // MARK: - Now / sleep
+
+    @inline(__always)
+    public static func now() -> Instant {
+        Instant(micros: arduino_micros())
+    }
+
+    /// >= 1 ms: cooperative (ArduinoRuntime keeps ticking) then a precise tail;
+    /// below 1 ms: busy-wait.
+    public static func sleep(for d: Duration) {
+        if d.micros <= 0 { return }
+        sleep(until: now() + d)
+    }
+
+    public static func sleep(until deadline: Instant) {
+        while true {
+            let left = deadline.micros &- arduino_micros()
+            if Int64(bitPattern: left) <= 0 { return }
+
+            if left >= 2_000 {
+                if ArduinoRuntime.hasItems { ArduinoRuntime.tickAll() }
+                arduino_delay_ms(1)
+            } else {
+                arduino_delay_us(U32(left))
+                return
+            }
+        }
+    }
+
+    // MARK: - Cycles
+
+    public enum Cycles {
+
+        /// Starts CYCCNT. False on cores / hosts without a DWT cycle counter.
+        @discardableResult
+        public static func enable() -> Bool {
+            arduino_cycles_enable() != 0
+        }
+
+        /// Raw 32-bit counter (wraps; use wrapping differences).
+        @inline(__always)
+        public static func now() -> U32 {
+            arduino_cycles_read()
+        }
+
+        public static var hz: U32 { arduino_cycles_hz() }
+
+        @inline(__always)
+        public static func nanoseconds(_ cycles: U32) -> UInt64 {
+            arduino_cycles_to_ns(cycles)
+        }
+
+        /// Cycles spent in `body` (enables the counter on first use).
+        @inline(__always)
+        public static func measure(_ body: () -> Void) -> U32 {
+            enable()
+            let start = arduino_cycles_read()
+            body()
+            return arduino_cycles_read() &- start
+        }
+    }
+}
@@ -0,0 +1,135 @@
+// CoreLink.swift
+// Message link between the two cores of a dual-core board (Embedded Swift friendly).
+//
+// Features:
+// - One lock-free ring per direction in shared memory (CoreLink.h); messages are
+//   up to `payloadMax` bytes (60 by default), copied in / read in place
+// - The same class runs on both cores: on the Giga the M7 image (main.swift) is
+//   the main core, the M4 image (main_m4.swift) the aux core
+// - The sender raises a hardware-semaphore interrupt on the other core when the
+//   ring was empty; tick() drains every loop anyway
+// - Single-core boards: both directions share one ring, sends loop back
+//
+// Usage (M7, main.swift):
+//   let link = CoreLink { msg in handleSample(msg) }
+//   _ = CoreLink.bootAux()
+//   ArduinoRuntime.add(link)
+//
+// Usage (M4, main_m4.swift):
+//   let link = CoreLink()
+//   ArduinoRuntime.add(link)
+//   let v = arduino_analogRead(54)
+//   link.send { out in                  // fill the slot in place
+//       out[0] = U8(truncatingIfNeeded: v)
+//       out[1] = U8(truncatingIfNeeded: v >> 8)
+//       return 2
+//   }
+
+public final class CoreLink: ArduinoTickable {
+
+    /// Borrowed message: valid only inside the callback.
+    public typealias Handler = (UnsafeBufferPointer<U8>) -> Void
+
+    // MARK: - Cores
+
+    /// True on boards with a second core and a shared window.
+    public static var isDualCore: Bool { arduino_corelink_is_dual() != 0 }
+
+    /// True on the aux core (Giga M4).
+    public static var isAux: Bool { arduino_corelink_core() != 0 }
+
+    /// Main core only: formats the window and releases the aux core from reset.
+    @discardableResult
+    public static func bootAux() -> Bool {
+        arduino_corelink_boot_aux() != 0
+    }
+
+    // MARK: - Public
+
+    public var onMessage: Handler?
+
+    /// Max messages delivered per tick. Keeps a backlog from stalling other tickables.
+    public var maxMessagesPerTick: Int = 16
+
+    public var payloadMax: Int { Int(arduino_corelink_payload_max()) }
+
+    /// False on the aux core until the main core has formatted the window.
+    public private(set) var isOpen: Bool = false
+
+    /// Incoming messages waiting.
+    public var available: Int { Int(arduino_corelink_available()) }
+
+    /// Sends that found the outgoing ring full.
+    public var dropped: U32 { arduino_corelink_dropped() }
+
+    /// Notifications from the other core since the previous call. A hint only:
+    /// the ring is the source of truth and tick() polls it every loop.
+    public func signals() -> U32 {
+        arduino_corelink_signals()
+    }
+
+    // MARK: - Init
+
+    public init(onMessage: Handler? = nil) {
+        self.onMessage = onMessage
+        _ = open()
+    }
+
+    /// Retried from tick() until it succeeds.
+    @discardableResult
+    public func open() -> Bool {
+        if !isOpen { isOpen = arduino_corelink_open() != 0 }
+        return isOpen
+    }
+
+    // MARK: - Send
+
+    /// Copies `bytes` into the next slot. False when full, too long or not open yet.
+    @discardableResult
+    public func send(_ bytes: UnsafeBufferPointer<U8>) -> Bool {
+        guard open() else { return false }
+        return arduino_corelink_send(bytes.baseAddress, U32(bytes.count)) != 0
+    }
+
+    @discardableResult
+    public func send(_ bytes: [U8]) -> Bool {
+        bytes.withUnsafeBufferPointer { send($0) }
+    }
+
+    /// Zero-copy send: `fill` writes up to payloadMax bytes and returns the length.
+    @discardableResult
+    public func send(_ fill: (UnsafeMutableBufferPointer<U8>) -> Int) -> Bool {
+        guard open(), let p = arduino_corelink_reserve() else { return false }
+
+        let cap = payloadMax
+        var n = fill(UnsafeMutableBufferPointer(start: p, count: cap))
+        if n < 0 { n = 0 }
+        if n > cap { n = cap }
+        arduino_corelink_commit(U32(n))
+        return true
+    }
+
+    // MARK: - Receive
+
+    /// Hands up to `max` messages to `body`, oldest first. Returns how many.
+    @discardableResult
+    public func drain(max: Int = Int.max, _ body: Handler) -> Int {
+        guard open() else { return 0 }
+
+        var n = 0
+        var len: U32 = 0
+        while n < max, let p = arduino_corelink_peek(&len) {
+            body(UnsafeBufferPointer(start: p, count: Int(len)))
+            arduino_corelink_release()
+            n += 1
+        }
+        return n
+    }
+
+    // MARK: - ArduinoTickable
+
+    public func tick() {
+        guard let handler = onMessage else { return }
+        drain(max: maxMessagesPerTick, handler)
+    }
+}
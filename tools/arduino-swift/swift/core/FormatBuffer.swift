@@ -0,0 +1,417 @@
+// FormatBuffer.swift
+// Allocation-free text/number formatting (Embedded Swift friendly).
+//
+// Features:
+// - Fixed inline storage (no heap): lives on the stack or inside another value
+// - Decimal integers (8/16/32/64-bit) with optional width padding
+// - Hex integers with fixed or minimal width
+// - Fixed-point (scaled integers) and floats with fixed precision
+// - Table-driven digit generation: two digits per step from a "00".."99" table,
+//   divisions are by constants only (the compiler lowers them to multiplies)
+//
+// Usage:
+//   var f = FormatBuffer()
+//   f.append("t=")
+//   f.append(arduino_millis(), width: 8, pad: 0x30)
+//   f.append(" temp=")
+//   f.append(tempC, precision: 2)
+//   f.println()
+
+public struct FormatBuffer {
+
+    /// Max printable bytes (one extra byte is always kept for the C string terminator).
+    public static let capacity: Int = 47
+
+    // 48 bytes of inline storage.
+    @usableFromInline
+    var storage: (UInt64, UInt64, UInt64, UInt64, UInt64, UInt64) = (0, 0, 0, 0, 0, 0)
+
+    public private(set) var count: Int = 0
+
+    /// Set when an append did not fit. The buffer keeps what was written before.
+    public private(set) var truncated: Bool = false
+
+    @inline(__always)
+    public init() {}
+
+    @inline(__always)
+    public var isEmpty: Bool { count == 0 }
+
+    @inline(__always)
+    public mutating func removeAll() {
+        count = 0
+        truncated = false
+    }
+
+    // MARK: - Raw bytes / text
+
+    @inline(__always)
+    public mutating func append(byte b: UInt8) {
+        if count >= Self.capacity { truncated = true; return }
+        let i = count
+        withBytes { p in p[i] = b }
+        count = i &+ 1
+    }
+
+    public mutating func append(_ s: StaticString) {
+        let n = s.utf8CodeUnitCount
+        if !reserve(n) { return }
+        let src = s.utf8Start
+        let start = count
+        withBytes { p in
+            var i = 0
+            while i < n {
+                p[start &+ i] = src[i]
+                i &+= 1
+            }
+        }
+        count = start &+ n
+    }
+
+    public mutating func append(_ bytes: UnsafeBufferPointer<UInt8>) {
+        let n = bytes.count
+        if n == 0 || !reserve(n) { return }
+        let start = count
+        withBytes { p in
+            var i = 0
+            while i < n {
+                p[start &+ i] = bytes[i]
+                i &+= 1
+            }
+        }
+        count = start &+ n
+    }
+
+    // MARK: - Decimal
+
+    public mutating func append(_ v: UInt32, width: Int = 0, pad: UInt8 = 0x20) {
+        let n = _decimalDigits(v)
+        appendSignAndPadding(negative: false, digits: n, width: width, pad: pad)
+        writeDigits(v, count: n)
+    }
+
+    public mutating func append(_ v: Int32, width: Int = 0, pad: UInt8 = 0x20) {
+        let neg = v < 0
+        let mag = neg ? (0 &- UInt32(bitPattern: v)) : UInt32(bitPattern: v)
+        let n = _decimalDigits(mag)
+        appendSignAndPadding(negative: neg, digits: n, width: width, pad: pad)
+        writeDigits(mag, count: n)
+    }
+
+    @inline(__always)
+    public mutating func append(_ v: UInt8, width: Int = 0, pad: UInt8 = 0x20) {
+        append(UInt32(v), width: width, pad: pad)
+    }
+
+    @inline(__always)
+    public mutating func append(_ v: UInt16, width: Int = 0, pad: UInt8 = 0x20) {
+        append(UInt32(v), width: width, pad: pad)
+    }
+
+    public mutating func append(_ v: UInt64, width: Int = 0, pad: UInt8 = 0x20) {
+        appendDecimal64(v, negative: false, width: width, pad: pad)
+    }
+
+    public mutating func append(_ v: Int64, width: Int = 0, pad: UInt8 = 0x20) {
+        let neg = v < 0
+        let mag = neg ? (0 &- UInt64(bitPattern: v)) : UInt64(bitPattern: v)
+        appendDecimal64(mag, negative: neg, width: width, pad: pad)
+    }
+
+    @inline(__always)
+    public mutating func append(_ v: Int, width: Int = 0, pad: UInt8 = 0x20) {
+        append(Int64(v), width: width, pad: pad)
+    }
+
+    // MARK: - Hex
+
+    /// `width` = minimum digit count (zero-padded). 0 means "as few digits as needed".
+    public mutating func appendHex(_ v: UInt32, width: Int = 0, uppercase: Bool = true) {
+        var n = 1
+        var t = v >> 4
+        while t != 0 { n &+= 1; t >>= 4 }
+        if width > n { n = width > 8 ? 8 : width }
+        if !reserve(n) { return }
+
+        let alpha: UInt8 = uppercase ? 55 : 87 // 'A' - 10 / 'a' - 10
+        let start = count
+        withBytes { p in
+            var x = v
+            var i = start &+ n
+            while i > start {
+                i &-= 1
+                let d = UInt8(truncatingIfNeeded: x & 0xF)
+                p[i] = d < 10 ? (0x30 &+ d) : (alpha &+ d)
+                x >>= 4
+            }
+        }
+        count = start &+ n
+    }
+
+    /// Two hex digits: 00..FF
+    @inline(__always)
+    public mutating func appendHex(_ b: UInt8, uppercase: Bool = true) {
+        appendHex(UInt32(b), width: 2, uppercase: uppercase)
+    }
+
+    // MARK: - Fixed-point / floating point
+
+    /// Scaled integer: `append(fixed: 12345, decimals: 2)` -> "123.45"
+    public mutating func append(fixed raw: Int32, decimals: Int) {
+        let neg = raw < 0
+        let mag = neg ? (0 &- UInt32(bitPattern: raw)) : UInt32(bitPattern: raw)
+        let d = decimals < 0 ? 0 : (decimals > 9 ? 9 : decimals)
+        let scale = _pow10u32(d)
+
+        let ip = mag / scale
+        let fp = mag &- ip &* scale
+
+        let n = _decimalDigits(ip)
+        appendSignAndPadding(negative: neg, digits: n, width: 0, pad: 0x20)
+        writeDigits(ip, count: n)
+        if d > 0 {
+            append(byte: 0x2E)
+            writeDigits(fp, count: d)
+        }
+    }
+
+    /// Fixed precision (0...9 digits after the point), same digits as printf("%.*f"):
+    /// the exact binary value is rounded, ties to even ("-0.00" keeps its sign).
+    /// Prints "nan", "inf" / "-inf", and "ovf" when the value does not fit 64 bits once scaled.
+    public mutating func append(_ v: Double, precision: Int = 2) {
+        if v.isNaN { append("nan"); return }
+        if v.isInfinite { append(v < 0 ? "-inf" : "inf"); return }
+
+        let d = precision < 0 ? 0 : (precision > 9 ? 9 : precision)
+        let scale32 = _pow10u32(d)
+
+        let neg = v.sign == .minus
+        let mag = neg ? -v : v
+        guard let s64 = _roundScaled(mag, scale32) else { append("ovf"); return }
+
+        if s64 <= UInt64(UInt32.max) {
+            // Fast path: everything fits 32-bit arithmetic.
+            let s = UInt32(truncatingIfNeeded: s64)
+            let ip = s / scale32
+            let fp = s &- ip &* scale32
+            let n = _decimalDigits(ip)
+            appendSignAndPadding(negative: neg, digits: n, width: 0, pad: 0x20)
+            writeDigits(ip, count: n)
+            if d > 0 {
+                append(byte: 0x2E)
+                writeDigits(fp, count: d)
+            }
+            return
+        }
+
+        let scale64 = UInt64(scale32)
+        let ip = s64 / scale64
+        let fp = UInt32(truncatingIfNeeded: s64 &- ip &* scale64)
+        appendDecimal64(ip, negative: neg, width: 0, pad: 0x20)
+        if d > 0 {
+            append(byte: 0x2E)
+            writeDigits(fp, count: d)
+        }
+    }
+
+    @inline(__always)
+    public mutating func append(_ v: Float, precision: Int = 2) {
+        append(Double(v), precision: precision)
+    }
+
+    // MARK: - Output
+
+    /// Borrow the formatted bytes (no terminator).
+    @inline(__always)
+    public mutating func withUnsafeBytes<R>(_ body: (UnsafeBufferPointer<UInt8>) -> R) -> R {
+        let n = count
+        return withBytes { p in body(UnsafeBufferPointer(start: p, count: n)) }
+    }
+
+    /// Borrow the formatted text as a null-terminated C string.
+    @inline(__always)
+    public mutating func withCString<R>(_ body: (UnsafePointer<CChar>) -> R) -> R {
+        let n = count
+        return withBytes { p in
+            p[n] = 0
+            return p.withMemoryRebound(to: CChar.self, capacity: n &+ 1) { body($0) }
+        }
+    }
+
+    /// Allocates. Prefer print()/withCString on hot paths.
+    public mutating func toString() -> String {
+        withCString { String(cString: $0) }
+    }
+
+    @inline(__always)
+    public mutating func print() {
+        if !Serial.isInitialized() { Serial.begin(115200) }
+        withCString { arduino_serial_print_cstr($0) }
+    }
+
+    @inline(__always)
+    public mutating func println() {
+        append(byte: 0x0A)
+        print()
+    }
+
+    // MARK: - Internals
+
+    @inline(__always)
+    @usableFromInline
+    mutating func withBytes<R>(_ body: (UnsafeMutablePointer<UInt8>) -> R) -> R {
+        withUnsafeMutableBytes(of: &storage) { raw in
+            body(raw.baseAddress!.assumingMemoryBound(to: UInt8.self))
+        }
+    }
+
+    @inline(__always)
+    private mutating func reserve(_ n: Int) -> Bool {
+        if n > Self.capacity &- count {
+            truncated = true
+            return false
+        }
+        return true
+    }
+
+    private mutating func appendSignAndPadding(negative: Bool, digits: Int, width: Int, pad: UInt8) {
+        var fill = width &- digits &- (negative ? 1 : 0)
+        if fill < 0 { fill = 0 }
+
+        if negative && pad == 0x30 { append(byte: 0x2D) }
+        while fill > 0 {
+            append(byte: pad)
+            fill &-= 1
+        }
+        if negative && pad != 0x30 { append(byte: 0x2D) }
+    }
+
+    /// Writes exactly `n` digits of `value` (leading zeros included), two at a time.
+    private mutating func writeDigits(_ value: UInt32, count n: Int) {
+        if n <= 0 { return }
+        if !reserve(n) { return }
+
+        let start = count
+        let pairs = _digitPairs.utf8Start
+        withBytes { p in
+            var v = value
+            var i = start &+ n
+            while i &- start >= 2 {
+                let q = v / 100
+                let r = Int(v &- q &* 100) &* 2
+                v = q
+                i &-= 2
+                p[i] = pairs[r]
+                p[i &+ 1] = pairs[r &+ 1]
+            }
+            if i > start {
+                p[start] = 0x30 &+ UInt8(truncatingIfNeeded: v % 10)
+            }
+        }
+        count = start &+ n
+    }
+
+    private mutating func appendDecimal64(_ v: UInt64, negative: Bool, width: Int, pad: UInt8) {
+        if v <= UInt64(UInt32.max) {
+            let v32 = UInt32(truncatingIfNeeded: v)
+            let n = _decimalDigits(v32)
+            appendSignAndPadding(negative: negative, digits: n, width: width, pad: pad)
+            writeDigits(v32, count: n)
+            return
+        }
+
+        // Split into base-1e9 limbs so digit generation stays 32-bit.
+        let lo = UInt32(truncatingIfNeeded: v % 1_000_000_000)
+        let rest = v / 1_000_000_000
+        let mid = UInt32(truncatingIfNeeded: rest % 1_000_000_000)
+        let hi = UInt32(truncatingIfNeeded: rest / 1_000_000_000)
+
+        let n = hi != 0 ? (_decimalDigits(hi) &+ 18) : (_decimalDigits(mid) &+ 9)
+        appendSignAndPadding(negative: negative, digits: n, width: width, pad: pad)
+
+        if hi != 0 {
+            writeDigits(hi, count: _decimalDigits(hi))
+            writeDigits(mid, count: 9)
+        } else {
+            writeDigits(mid, count: _decimalDigits(mid))
+        }
+        writeDigits(lo, count: 9)
+    }
+}
+
+// MARK: - Digit tables
+
+private let _digitPairs: StaticString =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899"
+
+@inline(__always)
+private func _decimalDigits(_ v: UInt32) -> Int {
+    if v < 10 { return 1 }
+    if v < 100 { return 2 }
+    if v < 1_000 { return 3 }
+    if v < 10_000 { return 4 }
+    if v < 100_000 { return 5 }
+    if v < 1_000_000 { return 6 }
+    if v < 10_000_000 { return 7 }
+    if v < 100_000_000 { return 8 }
+    if v < 1_000_000_000 { return 9 }
+    return 10
+}
+
+/// mag * scale rounded to an integer on the exact binary value of `mag` (ties to
+/// even). nil when it does not fit 64 bits.
+private func _roundScaled(_ mag: Double, _ scale: UInt32) -> UInt64? {
+    let bits = mag.bitPattern
+    let exp = Int((bits >> 52) & 0x7FF)
+    let frac = bits & 0x000F_FFFF_FFFF_FFFF
+    if exp == 0 && frac == 0 { return 0 }
+
+    // mag = m * 2^e exactly; the 128-bit product m * scale is exact too.
+    let m = exp == 0 ? frac : (frac | (1 << 52))
+    let e = (exp == 0 ? 1 : exp) &- 1075
+    let (hi, lo) = m.multipliedFullWidth(by: UInt64(scale))
+
+    if e >= 0 {
+        if hi != 0 || e >= 64 { return nil }
+        if e > 0 && (lo >> UInt64(64 &- e)) != 0 { return nil }
+        return lo << UInt64(e)
+    }
+
+    let k = 0 &- e
+    if k >= 128 { return 0 }    // product < 2^83: below one half
+
+    var q: UInt64
+    var half: Bool
+    var sticky: Bool
+    if k < 64 {
+        if (hi >> UInt64(k)) != 0 { return nil }
+        q = (lo >> UInt64(k)) | (hi << UInt64(64 &- k))
+        half = (lo >> UInt64(k &- 1)) & 1 != 0
+        sticky = lo & ((1 << UInt64(k &- 1)) &- 1) != 0
+    } else if k == 64 {
+        q = hi
+        half = lo >> 63 != 0
+        sticky = lo & 0x7FFF_FFFF_FFFF_FFFF != 0
+    } else {
+        q = hi >> UInt64(k &- 64)
+        half = (hi >> UInt64(k &- 65)) & 1 != 0
+        sticky = lo != 0 || hi & ((1 << UInt64(k &- 65)) &- 1) != 0
+    }
+
+    if half && (sticky || q & 1 != 0) {
+        if q == UInt64.max { return nil }
+        q &+= 1
+    }
+    return q
+}
+
+@inline(__always)
+private func _pow10u32(_ d: Int) -> UInt32 {
+    var p: UInt32 = 1
+    var i = 0
+    while i < d {
+        p &*= 10
+        i &+= 1
+    }
+    return p
+}
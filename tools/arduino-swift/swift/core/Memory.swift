@@ -0,0 +1,122 @@
+// Memory.swift
+// Heap + stack usage numbers (Embedded Swift friendly).
+//
+// Features:
+// - Memory.stats() snapshots the counters kept by SwiftMemory.c
+// - live / peak heap bytes, alloc/free/failed counts, allocation size histogram
+//   (on by default; with config.json "heap": { "stats": "off" } they read 0 and
+//   Memory.heapStatsEnabled is false)
+// - largest free block (exact with the TLSF heap, sbrk headroom with newlib)
+// - stack high-water mark (stack is painted in Bridge.cpp setup())
+//
+// Usage:
+//   let m = Memory.stats()
+//   if m.failed > 0 { Serial.println("OOM!") }
+//   Memory.printStats()
+
+public enum Memory {
+
+    /// Allocation size histogram: bucket i holds requests <= bucketLimit(i) bytes.
+    public static let bucketCount: Int = 8
+
+    /// The build keeps heap counters. When false, the heap fields of Stats and
+    /// the histogram are 0 because nothing was measured, not because the heap is idle.
+    @inline(__always)
+    public static var heapStatsEnabled: Bool {
+        arduino_mem_stats_enabled() != 0
+    }
+
+    public struct Stats {
+        /// liveBytes ... failed are measured (see Memory.heapStatsEnabled).
+        public var heapStatsEnabled: Bool
+        public var liveBytes: U32
+        public var peakBytes: U32
+        public var allocations: U32
+        public var frees: U32
+        public var failed: U32
+        public var largestFree: U32
+
+        /// Deepest stack use since boot. 0 when the board cannot report its stack bounds.
+        public var stackUsed: U32
+        public var stackSize: U32
+
+        public var stackFree: U32 {
+            stackSize > stackUsed ? stackSize &- stackUsed : 0
+        }
+    }
+
+    @inline(__always)
+    public static func stats() -> Stats {
+        Stats(
+            heapStatsEnabled: heapStatsEnabled,
+            liveBytes: arduino_mem_live_bytes(),
+            peakBytes: arduino_mem_peak_bytes(),
+            allocations: arduino_mem_alloc_count(),
+            frees: arduino_mem_free_count(),
+            failed: arduino_mem_failed_count(),
+            largestFree: arduino_mem_largest_free(),
+            stackUsed: arduino_mem_stack_used(),
+            stackSize: arduino_mem_stack_size()
+        )
+    }
+
+    @inline(__always)
+    public static func bucket(_ i: Int) -> U32 {
+        (i >= 0 && i < bucketCount) ? arduino_mem_bucket_count(U32(i)) : 0
+    }
+
+    /// Upper size bound of bucket i (the last bucket is open-ended: U32.max).
+    @inline(__always)
+    public static func bucketLimit(_ i: Int) -> U32 {
+        (i >= 0 && i < bucketCount) ? arduino_mem_bucket_limit(U32(i)) : 0
+    }
+
+    /// Restarts peak tracking from the current live size.
+    @inline(__always)
+    public static func resetPeak() {
+        arduino_mem_reset_peak()
+    }
+
+    /// One-line summary + histogram on Serial (no heap use while printing).
+    public static func printStats() {
+        let s = stats()
+
+        var f = FormatBuffer()
+        if s.heapStatsEnabled {
+            f.append("heap live=")
+            f.append(s.liveBytes)
+            f.append(" peak=")
+            f.append(s.peakBytes)
+            f.append(" largest=")
+        } else {
+            f.append("heap stats off largest=")
+        }
+        f.append(s.largestFree)
+        if s.heapStatsEnabled {
+            f.append(" fail=")
+            f.append(s.failed)
+        }
+        Serial.print(&f)
+
+        f.removeAll()
+        f.append(" stack=")
+        f.append(s.stackUsed)
+        f.append("/")
+        f.append(s.stackSize)
+        Serial.print(&f)
+        Serial.println()
+        if !s.heapStatsEnabled { return }
+
+        var i = 0
+        while i < bucketCount {
+            f.removeAll()
+            f.append(" <=")
+            if i == bucketCount - 1 { f.append("inf") } else { f.append(bucketLimit(i)) }
+            f.append(":")
+            f.append(bucket(i))
+            Serial.print(&f)
+            i += 1
+        }
+        Serial.println()
+    }
+}
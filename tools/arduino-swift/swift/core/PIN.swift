@@ -1,5 +1,8 @@
 // PIN.swift
 // High-level digital pin wrapper for Embedded Swift + Arduino ABI.
+//
+// Writes, reads and toggles go straight to the port registers when the board API
+// resolves the pin (FastIO.h); otherwise they fall back to digitalWrite/digitalRead.
 
 public final class PIN {
 
@@ -8,18 +11,47 @@ public final class PIN {
     // Cache the last configured mode to avoid redundant pinMode calls.
     private var currentMode: Mode?
 
+    // Register handle (FastIO.h layout), nil when the board has no fast path for this pin.
+    private let fast: UnsafeMutablePointer<UInt>?
+
     // MARK: - Init
 
     public init(_ pin: Int) {
         self.number = U32(pin)
         self.currentMode = nil
+        self.fast = PIN.resolveFast(U32(pin))
+    }
+
+    /// Uses explicit registers instead of asking the board API (host tests: point them at RAM words).
+    public init(_ pin: Int, fastIO: FastIO) {
+        self.number = U32(pin)
+        self.currentMode = nil
+
+        let h = UnsafeMutablePointer<UInt>.allocate(capacity: FastIO.words)
+        fastIO.store(into: h)
+        self.fast = h
     }
 
     private init(resolved pin: U32) {
         self.number = pin
         self.currentMode = nil
+        self.fast = PIN.resolveFast(pin)
     }
 
+    deinit {
+        fast?.deallocate()
+    }
+
+    private static func resolveFast(_ pin: U32) -> UnsafeMutablePointer<UInt>? {
+        let h = UnsafeMutablePointer<UInt>.allocate(capacity: FastIO.words)
+        if arduino_fastio_resolve(pin, h) != 0 { return h }
+        h.deallocate()
+        return nil
+    }
+
+    /// True when writes/reads use direct port registers.
+    public var hasFastIO: Bool { fast != nil }
+
     // Built-in LED
     public static let builtin = PIN(resolved: arduino_builtin_led())
 
@@ -63,12 +95,20 @@ public final class PIN {
 
     public func on() {
         ensureMode(.output)
-        arduino_digitalWrite(number, arduino_high())
+        if let h = fast {
+            arduino_fastio_set(h)
+        } else {
+            arduino_digitalWrite(number, arduino_high())
+        }
     }
 
     public func off() {
         ensureMode(.output)
-        arduino_digitalWrite(number, arduino_low())
+        if let h = fast {
+            arduino_fastio_clear(h)
+        } else {
+            arduino_digitalWrite(number, arduino_low())
+        }
     }
 
     public func write(_ isOn: Bool) {
@@ -77,6 +117,11 @@ public final class PIN {
 
     public func toggle() {
         ensureMode(.output)
+        if let h = fast {
+            // Output latch read + one set/clear store.
+            arduino_fastio_toggle(h)
+            return
+        }
         if readRaw() == arduino_high() {
             arduino_digitalWrite(number, arduino_low())
         } else {
@@ -90,6 +135,9 @@ public final class PIN {
         if currentMode == nil {
             ensureMode(.input)
         }
+        if let h = fast {
+            return arduino_fastio_read(h) != 0 ? arduino_high() : arduino_low()
+        }
         return arduino_digitalRead(number)
     }
 
@@ -102,6 +150,52 @@ public final class PIN {
     }
 }
 
+// MARK: - Fast IO handle
+
+extension PIN {
+
+    /// Register addresses + masks for one pin (mirrors FastIO.h).
+    public struct FastIO {
+        public static let words: Int = 8
+
+        public var setRegister: UInt
+        public var setMask: UInt
+        public var clearRegister: UInt
+        public var clearMask: UInt
+        public var inputRegister: UInt
+        public var inputMask: UInt
+        public var outputRegister: UInt
+        public var outputMask: UInt
+
+        public init(
+            setRegister: UInt, setMask: UInt,
+            clearRegister: UInt, clearMask: UInt,
+            inputRegister: UInt, inputMask: UInt,
+            outputRegister: UInt, outputMask: UInt
+        ) {
+            self.setRegister = setRegister
+            self.setMask = setMask
+            self.clearRegister = clearRegister
+            self.clearMask = clearMask
+            self.inputRegister = inputRegister
+            self.inputMask = inputMask
+            self.outputRegister = outputRegister
+            self.outputMask = outputMask
+        }
+
+        fileprivate func store(into h: UnsafeMutablePointer<UInt>) {
+            h[0] = setRegister
+            h[1] = setMask
+            h[2] = clearRegister
+            h[3] = clearMask
+            h[4] = inputRegister
+            h[5] = inputMask
+            h[6] = outputRegister
+            h[7] = outputMask
+        }
+    }
+}
+
 // MARK: - Equatable support
 
 extension PIN.Mode: Equatable {
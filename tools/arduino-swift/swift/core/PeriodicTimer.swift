@@ -0,0 +1,148 @@
+// PeriodicTimer.swift
+// Hardware-timer periodic callbacks (Embedded Swift friendly).
+//
+// Features:
+// - A board hardware timer (HwTimer.h) fires every `periodMicros` (>= 10 us),
+//   independent of loop latency
+// - The ISR can toggle a pin (one register store), so the time-critical edge
+//   never waits for the Swift loop
+// - Each period is queued as a Tick { stamp }; the Swift side drains the queue
+//   from tick(). `missed` reports periods whose event did not fit the queue.
+// - No ADC in the ISR: a blocking conversion per period stretches the ISR and
+//   contends with AnalogStream for the ADC. Sample on a schedule with
+//   AnalogStream, which owns the ADC while it runs.
+//
+// Usage:
+//   let t = PeriodicTimer(periodMicros: 100) { tick in
+//       control.step(tick.stampMicros)
+//   }
+//   t.toggle(pin: 7)        // scope probe: square wave at half the timer rate
+//   _ = t.start()
+//   ArduinoRuntime.add(t)
+
+public final class PeriodicTimer: ArduinoTickable {
+
+    public struct Tick {
+        /// micros() in the ISR, after the optional pin toggle.
+        public let stampMicros: U32
+    }
+
+    public typealias Handler = (Tick) -> Void
+
+    // MARK: - Public
+
+    public private(set) var periodMicros: U32
+
+    public var onTick: Handler?
+
+    /// Max ticks delivered per tick(). Keeps a backlog from stalling other tickables.
+    public var maxTicksPerLoop: Int = 16
+
+    public var isRunning: Bool { slot >= 0 }
+
+    // MARK: - Storage
+
+    private var slot: I32 = -1
+    private var togglePin: U32?
+    private var droppedSeen: U32 = 0
+
+    // MARK: - Init
+
+    public init(periodMicros: U32, onTick: Handler? = nil) {
+        self.periodMicros = periodMicros
+        self.onTick = onTick
+    }
+
+    deinit {
+        stop()
+    }
+
+    // MARK: - ISR actions
+
+    /// Toggle `pin` from the ISR every period. Returns false (and sets nothing)
+    /// when the pin has no fast IO path.
+    @discardableResult
+    public func toggle(pin: Int) -> Bool {
+        guard pin >= 0, arduino_hwtimer_can_toggle(U32(pin)) != 0 else { return false }
+        togglePin = U32(pin)
+        if slot < 0 { return true }
+        return arduino_hwtimer_set_toggle(U32(slot), U32(pin)) != 0
+    }
+
+    public func clearActions() {
+        togglePin = nil
+        if slot >= 0 { arduino_hwtimer_clear_actions(U32(slot)) }
+    }
+
+    // MARK: - Control
+
+    /// Returns false when no hardware timer is free or the period is out of range.
+    @discardableResult
+    public func start() -> Bool {
+        stop()
+
+        let s = arduino_hwtimer_open(periodMicros)
+        if s < 0 { return false }
+        slot = s
+        droppedSeen = 0
+
+        if let p = togglePin { _ = arduino_hwtimer_set_toggle(U32(s), p) }
+        return true
+    }
+
+    public func stop() {
+        if slot < 0 { return }
+        arduino_hwtimer_close(U32(slot))
+        slot = -1
+    }
+
+    /// Restarts on a new period (queued ticks are discarded).
+    @discardableResult
+    public func setPeriod(micros: U32) -> Bool {
+        periodMicros = micros
+        return isRunning ? start() : true
+    }
+
+    // MARK: - Counters
+
+    /// Periods elapsed since start() (wraps).
+    public var ticks: U32 {
+        slot >= 0 ? arduino_hwtimer_ticks(U32(slot)) : 0
+    }
+
+    /// Periods whose event was dropped because the queue was full.
+    public var dropped: U32 {
+        slot >= 0 ? arduino_hwtimer_dropped(U32(slot)) : 0
+    }
+
+    /// Drops since the previous call (0 when the consumer keeps up).
+    public func missed() -> U32 {
+        let d = dropped
+        let n = d &- droppedSeen
+        droppedSeen = d
+        return n
+    }
+
+    // MARK: - Consumer
+
+    /// Hands up to `max` queued ticks to `body`, oldest first. Returns how many.
+    @discardableResult
+    public func drain(max: Int = Int.max, _ body: Handler) -> Int {
+        if slot < 0 { return 0 }
+
+        var n = 0
+        var stamp: U32 = 0
+        while n < max && arduino_hwtimer_pop(U32(slot), &stamp) != 0 {
+            body(Tick(stampMicros: stamp))
+            n += 1
+        }
+        return n
+    }
+
+    // MARK: - ArduinoTickable
+
+    public func tick() {
+        guard let handler = onTick else { return }
+        drain(max: maxTicksPerLoop, handler)
+    }
+}
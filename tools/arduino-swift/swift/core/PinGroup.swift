@@ -0,0 +1,106 @@
+// PinGroup.swift
+// Drive / sample up to 32 digital pins as one word (Embedded Swift friendly).
+//
+// Features:
+// - pins are merged by port ONCE at init (arduino_pingroup_init, FastIO.h)
+// - write(value): bit i drives pins[i]; one register store per port
+//   (two on SAM3X: SODR then CODR), so pins of the same port change together
+// - read(): one input register load per port
+// - falls back to sequential digitalWrite/digitalRead when any pin has no fast path
+//
+// Usage:
+//   let bus = PinGroup([2, 3, 4, 5, 6, 7, 8, 9])
+//   bus.output()
+//   bus.write(0xA5)
+
+public final class PinGroup {
+
+    public static let maxPins: Int = 32
+
+    public let pins: [U32]
+
+    // Port-merged register table, nil when the board cannot fast-path every pin.
+    private let table: UnsafeMutablePointer<UInt>?
+
+    // MARK: - Init
+
+    public init(_ pins: [Int]) {
+        var list: [U32] = []
+        var i = 0
+        while i < pins.count && i < PinGroup.maxPins {
+            list.append(U32(pins[i]))
+            i += 1
+        }
+        self.pins = list
+        self.table = PinGroup.resolve(list)
+    }
+
+    deinit {
+        table?.deallocate()
+    }
+
+    private static func resolve(_ pins: [U32]) -> UnsafeMutablePointer<UInt>? {
+        if pins.isEmpty { return nil }
+
+        let count = U32(pins.count)
+        let g = UnsafeMutablePointer<UInt>.allocate(capacity: Int(arduino_pingroup_words(count)))
+        let ok = pins.withUnsafeBufferPointer { buf in
+            arduino_pingroup_init(g, buf.baseAddress!, count)
+        }
+        if ok != 0 { return g }
+        g.deallocate()
+        return nil
+    }
+
+    /// True when write()/read() use port registers.
+    public var hasFastIO: Bool { table != nil }
+
+    public var count: Int { pins.count }
+
+    // MARK: - Mode
+
+    public func output() { setMode(arduino_mode_output()) }
+
+    public func input() { setMode(arduino_mode_input()) }
+
+    public func pullup() { setMode(arduino_mode_input_pullup()) }
+
+    private func setMode(_ mode: U32) {
+        for p in pins {
+            arduino_pinMode(p, mode)
+        }
+    }
+
+    // MARK: - IO
+
+    /// Bit i of `value` drives pins[i].
+    public func write(_ value: U32) {
+        if let g = table {
+            arduino_pingroup_write(g, value)
+            return
+        }
+
+        var v = value
+        for p in pins {
+            arduino_digitalWrite(p, (v & 1) != 0 ? arduino_high() : arduino_low())
+            v >>= 1
+        }
+    }
+
+    /// Bit i is the level of pins[i].
+    public func read() -> U32 {
+        if let g = table {
+            return arduino_pingroup_read(g)
+        }
+
+        var value: U32 = 0
+        var i: U32 = 0
+        for p in pins {
+            if arduino_digitalRead(p) == arduino_high() {
+                value |= (1 << i)
+            }
+            i += 1
+        }
+        return value
+    }
+}
@@ -52,6 +52,36 @@ public func print(_ v: Float) {
     Serial.print(v)
 }
 
+@inline(__always)
+public func print(_ v: Int64) {
+    _ensureSerial()
+    Serial.print(v)
+}
+
+@inline(__always)
+public func print(_ v: UInt64) {
+    _ensureSerial()
+    Serial.print(v)
+}
+
+@inline(__always)
+public func print(_ v: Double, digits: Int) {
+    _ensureSerial()
+    Serial.print(v, digits: digits)
+}
+
+@inline(__always)
+public func print(_ v: Float, digits: Int) {
+    _ensureSerial()
+    Serial.print(v, digits: digits)
+}
+
+@inline(__always)
+public func print(_ f: inout FormatBuffer) {
+    _ensureSerial()
+    Serial.print(&f)
+}
+
 // MARK: - println
 
 @inline(__always)
@@ -102,6 +132,36 @@ public func println(_ v: Float) {
     Serial.println(v)
 }
 
+@inline(__always)
+public func println(_ v: Int64) {
+    _ensureSerial()
+    Serial.println(v)
+}
+
+@inline(__always)
+public func println(_ v: UInt64) {
+    _ensureSerial()
+    Serial.println(v)
+}
+
+@inline(__always)
+public func println(_ v: Double, digits: Int) {
+    _ensureSerial()
+    Serial.println(v, digits: digits)
+}
+
+@inline(__always)
+public func println(_ v: Float, digits: Int) {
+    _ensureSerial()
+    Serial.println(v, digits: digits)
+}
+
+@inline(__always)
+public func println(_ f: inout FormatBuffer) {
+    _ensureSerial()
+    Serial.println(&f)
+}
+
 // MARK: - Raw byte
 
 @inline(__always)
@@ -42,4 +42,29 @@ extension Serial {
     public static func println(_ v: Float) {
         print(v); print("\n")
     }
+
+    @inline(__always)
+    public static func println(_ v: Int64) {
+        print(v); print("\n")
+    }
+
+    @inline(__always)
+    public static func println(_ v: UInt64) {
+        print(v); print("\n")
+    }
+
+    @inline(__always)
+    public static func println(_ v: Double, digits: Int) {
+        print(v, digits: digits); print("\n")
+    }
+
+    @inline(__always)
+    public static func println(_ v: Float, digits: Int) {
+        print(v, digits: digits); print("\n")
+    }
+
+    @inline(__always)
+    public static func println(_ f: inout FormatBuffer) {
+        print(&f); print("\n")
+    }
 }
@@ -3,6 +3,7 @@
 //
 // Features:
 // - print overloads for StaticString / String / numbers
+// - numbers are formatted in Swift via FormatBuffer (no heap, no per-digit C calls)
 // - printHex2 for byte dumps (00..FF)
 // - write(byte) for raw printable bytes
 
@@ -51,46 +52,91 @@ public enum Serial {
 
     @inline(__always)
     public static func print(_ s: String) {
-        // Embedded Swift: keep it simple -> UTF8 + null terminator.
-        var bytes = Array(s.utf8)
-        bytes.append(0)
-        bytes.withUnsafeBufferPointer { b in
-            b.baseAddress!.withMemoryRebound(to: CChar.self, capacity: b.count) { cstr in
-                arduino_serial_print_cstr(cstr)
-            }
+        // Native Swift strings are already contiguous + null-terminated: no copy.
+        s.withCString { cstr in
+            arduino_serial_print_cstr(cstr)
         }
     }
 
     @inline(__always)
     public static func print(_ v: Int) {
-        arduino_serial_print_i32(I32(v))
+        var f = FormatBuffer()
+        f.append(v)
+        print(&f)
     }
 
     @inline(__always)
     public static func print(_ v: Int32) {
-        arduino_serial_print_i32(v)
+        var f = FormatBuffer()
+        f.append(v)
+        print(&f)
     }
 
     @inline(__always)
     public static func print(_ v: UInt32) {
-        arduino_serial_print_u32(v)
+        var f = FormatBuffer()
+        f.append(v)
+        print(&f)
+    }
+
+    @inline(__always)
+    public static func print(_ v: Int64) {
+        var f = FormatBuffer()
+        f.append(v)
+        print(&f)
     }
 
+    @inline(__always)
+    public static func print(_ v: UInt64) {
+        var f = FormatBuffer()
+        f.append(v)
+        print(&f)
+    }
+
+    /// Formatted in Swift with the board's default digits (6; 2 on Due), the
+    /// same output the core's float printing gave.
     @inline(__always)
     public static func print(_ v: Double) {
-        arduino_serial_print_f64(v)
+        print(v, digits: Int(arduino_serial_float_digits()))
     }
 
     @inline(__always)
     public static func print(_ v: Float) {
-        arduino_serial_print_f64(Double(v))
+        print(Double(v), digits: Int(arduino_serial_float_digits()))
+    }
+
+    /// `digits` after the decimal point (0...9), formatted in Swift and rounded like printf("%.*f").
+    @inline(__always)
+    public static func print(_ v: Double, digits: Int) {
+        var f = FormatBuffer()
+        f.append(v, precision: digits)
+        print(&f)
+    }
+
+    @inline(__always)
+    public static func print(_ v: Float, digits: Int) {
+        print(Double(v), digits: digits)
+    }
+
+    /// Prints an already formatted buffer.
+    @inline(__always)
+    public static func print(_ f: inout FormatBuffer) {
+        f.withCString { cstr in
+            arduino_serial_print_cstr(cstr)
+        }
     }
 
     public static func printHexBytes(_ bytes: [UInt8]) {
+        var f = FormatBuffer()
         for b in bytes {
-            printHex2(b)
-            print(" ")
+            if f.count > FormatBuffer.capacity - 3 {
+                print(&f)
+                f.removeAll()
+            }
+            f.appendHex(b)
+            f.append(byte: 0x20)
         }
+        print(&f)
     }
 
     public static func printASCIIOrHex(_ bytes: [UInt8]) {
@@ -110,12 +156,9 @@ public enum Serial {
     /// Good for printable ASCII. For non-printable, use printHex2.
     @inline(__always)
     public static func write(_ b: UInt8) {
-        var s: [UInt8] = [b, 0]
-        s.withUnsafeBufferPointer { buf in
-            buf.baseAddress!.withMemoryRebound(to: CChar.self, capacity: 2) { cstr in
-                arduino_serial_print_cstr(cstr)
-            }
-        }
+        var f = FormatBuffer()
+        f.append(byte: b)
+        print(&f)
     }
 
     // MARK: - Hex helpers
@@ -123,20 +166,16 @@ public enum Serial {
     /// Prints a byte as two hex digits: 00..FF
     @inline(__always)
     public static func printHex2(_ b: UInt8) {
-        let hi = nibbleHex(b >> 4)
-        let lo = nibbleHex(b)
-        var s: [UInt8] = [hi, lo, 0]
-        s.withUnsafeBufferPointer { buf in
-            buf.baseAddress!.withMemoryRebound(to: CChar.self, capacity: 3) { cstr in
-                arduino_serial_print_cstr(cstr)
-            }
-        }
+        var f = FormatBuffer()
+        f.appendHex(b)
+        print(&f)
     }
 
+    /// Prints `v` in hex, zero-padded to at least `width` digits (no "0x" prefix).
     @inline(__always)
-    private static func nibbleHex(_ v: UInt8) -> UInt8 {
-        let x = v & 0x0F
-        // ASCII '0' = 48, 'A' = 65
-        return x < 10 ? (48 &+ x) : (65 &+ (x &- 10))
+    public static func printHex(_ v: UInt32, width: Int = 0) {
+        var f = FormatBuffer()
+        f.appendHex(v, width: width)
+        print(&f)
     }
 }
@@ -0,0 +1,226 @@
+// SerialReader.swift
+// Non-blocking Serial RX with frame assembly (Embedded Swift friendly).
+//
+// Features:
+// - Drains Serial in bulk (arduino_serial_read_buf) without ever waiting
+// - Assembles newline-terminated lines or length-prefixed binary frames
+// - Storage is one fixed ring allocated at init; no per-frame allocation
+// - Frames are delivered as borrowed slices (valid only inside the callback)
+//
+// Usage:
+//   let rx = SerialReader(framing: .line()) { line in
+//       if asciiEquals(line, "PING") { println("PONG") }
+//   }
+//   ArduinoRuntime.add(rx)
+
+public final class SerialReader: ArduinoTickable {
+
+    // MARK: - Framing
+
+    public enum Framing {
+        /// Frames end at `delimiter` (not included). Optionally strips a trailing '\r'.
+        case line(delimiter: UInt8 = 0x0A, stripCR: Bool = true)
+
+        /// Frames start with a 1..4 byte unsigned length header, followed by the payload.
+        case lengthPrefixed(headerBytes: Int = 2, bigEndian: Bool = false)
+    }
+
+    public typealias Handler = (UnsafeBufferPointer<UInt8>) -> Void
+
+    // MARK: - Public
+
+    public var enabled: Bool = true
+
+    /// Max bytes drained per tick. Keeps a flood of input from stalling other tickables.
+    public var maxBytesPerTick: Int = 256
+
+    /// Frames dropped because they did not fit in the ring (or carried an impossible length).
+    public private(set) var overflows: U32 = 0
+
+    /// Frames delivered to the callback since init.
+    public private(set) var frames: U32 = 0
+
+    // MARK: - Storage
+
+    private let framing: Framing
+    private var onFrameBlock: Handler?
+
+    private let capacity: U32
+    private let mask: U32
+    private let ring: UnsafeMutablePointer<UInt8>
+
+    // Used only when a frame wraps around the end of the ring.
+    private let scratch: UnsafeMutablePointer<UInt8>
+
+    // Free-running indices (masked on access). tail = start of the pending frame.
+    private var head: U32 = 0
+    private var tail: U32 = 0
+    private var scan: U32 = 0
+
+    // Line mode: currently dropping an oversized line until the next delimiter.
+    private var discarding: Bool = false
+
+    // MARK: - Init
+
+    /// `capacity` is rounded up to a power of two and bounds the largest frame.
+    public init(capacity: Int = 512, framing: Framing = .line(), onFrame: Handler? = nil) {
+        var cap: U32 = 16
+        while Int(cap) < capacity && cap < 0x8000_0000 { cap <<= 1 }
+
+        self.capacity = cap
+        self.mask = cap &- 1
+        self.framing = framing
+        self.onFrameBlock = onFrame
+
+        self.ring = UnsafeMutablePointer<UInt8>.allocate(capacity: Int(cap))
+        self.scratch = UnsafeMutablePointer<UInt8>.allocate(capacity: Int(cap))
+    }
+
+    deinit {
+        ring.deallocate()
+        scratch.deallocate()
+    }
+
+    @discardableResult
+    public func onFrame(_ handler: @escaping Handler) -> Self {
+        onFrameBlock = handler
+        return self
+    }
+
+    public func addToRuntime() {
+        ArduinoRuntime.add(self)
+    }
+
+    /// Drops any partially assembled frame.
+    public func reset() {
+        head = 0
+        tail = 0
+        scan = 0
+        discarding = false
+    }
+
+    // MARK: - Tick
+
+    public func tick() {
+        guard enabled else { return }
+
+        var budget = maxBytesPerTick
+        while budget > 0 {
+            let avail = Int(arduino_serial_available())
+            if avail <= 0 { break }
+
+            var used = head &- tail
+            if used == capacity {
+                dropPending()
+                used = 0
+            }
+
+            // Contiguous free span starting at head.
+            let at = head & mask
+            var span = Int(capacity &- used)
+            let toEnd = Int(capacity &- at)
+            if span > toEnd { span = toEnd }
+            if span > avail { span = avail }
+            if span > budget { span = budget }
+
+            let got = arduino_serial_read_buf(ring + Int(at), U32(span))
+            if got == 0 { break }
+
+            head = head &+ got
+            budget -= Int(got)
+
+            process()
+        }
+    }
+
+    // MARK: - Frame assembly
+
+    private func process() {
+        switch framing {
+        case .line(let delimiter, let stripCR):
+            processLines(delimiter: delimiter, stripCR: stripCR)
+        case .lengthPrefixed(let headerBytes, let bigEndian):
+            processPrefixed(headerBytes: headerBytes, bigEndian: bigEndian)
+        }
+    }
+
+    private func processLines(delimiter: UInt8, stripCR: Bool) {
+        while scan != head {
+            let b = ring[Int(scan & mask)]
+            scan = scan &+ 1
+
+            if b != delimiter { continue }
+
+            if discarding {
+                discarding = false
+                tail = scan
+                continue
+            }
+
+            var len = (scan &- 1) &- tail
+            if stripCR && len > 0 && ring[Int((tail &+ len &- 1) & mask)] == 0x0D {
+                len &-= 1
+            }
+
+            deliver(start: tail, count: len)
+            tail = scan
+        }
+    }
+
+    private func processPrefixed(headerBytes: Int, bigEndian: Bool) {
+        let hb = U32(headerBytes < 1 ? 1 : (headerBytes > 4 ? 4 : headerBytes))
+
+        while (head &- tail) >= hb {
+            var len: U32 = 0
+            var i: U32 = 0
+            while i < hb {
+                let b = U32(ring[Int((tail &+ i) & mask)])
+                if bigEndian {
+                    len = (len << 8) | b
+                } else {
+                    len |= b << (8 &* i)
+                }
+                i &+= 1
+            }
+
+            // A length that can never fit means we lost sync: flush and start over.
+            if len > capacity &- hb {
+                overflows &+= 1
+                tail = head
+                break
+            }
+
+            if (head &- tail) < hb &+ len { break }
+
+            deliver(start: tail &+ hb, count: len)
+            tail = tail &+ hb &+ len
+        }
+        scan = head
+    }
+
+    private func dropPending() {
+        if !discarding { overflows &+= 1 }
+        tail = head
+        scan = head
+        if case .line = framing { discarding = true }
+    }
+
+    private func deliver(start: U32, count: U32) {
+        frames &+= 1
+        guard let cb = onFrameBlock else { return }
+
+        let at = Int(start & mask)
+        let n = Int(count)
+        let toEnd = Int(capacity) - at
+
+        if n <= toEnd {
+            cb(UnsafeBufferPointer(start: ring + at, count: n))
+            return
+        }
+
+        // Wrapped frame: linearize into scratch.
+        scratch.update(from: ring + at, count: toEnd)
+        (scratch + toEnd).update(from: ring, count: n - toEnd)
+        cb(UnsafeBufferPointer(start: scratch, count: n))
+    }
+}
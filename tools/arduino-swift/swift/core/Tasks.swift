@@ -0,0 +1,209 @@
+// Tasks.swift
+// Stackless cooperative tasks (resumable state machines) for ArduinoRuntime.
+//
+// Features:
+// - A task is a closure resumed once per loop while it is runnable; it reads
+//   `t.step` to know where it left off and returns what to wait for next:
+//   .yield, .sleep(ms), .waitUntil { cond }, .waitUntilTimeout(ms) { cond }, .done
+// - After each resume `step` advances by one unless the body called t.goto(n)
+// - No stacks, no threads, no Foundation: state lives in `step` + captured vars
+// - Fixed-capacity scheduler: spawn() returns nil when every slot is busy
+// - Tasks.spawn uses a shared scheduler that registers itself with ArduinoRuntime
+//
+// Usage:
+//   Tasks.spawn { t in
+//       switch t.step {
+//       case 0: wifi.begin();  return .waitUntilTimeout(10_000) { wifi.isConnected }
+//       case 1: if t.timedOut { t.goto(0); return .sleep(1_000) }
+//               println("connected"); return .done
+//       default: return .done
+//       }
+//   }
+
+public enum TaskAction {
+    /// Resume on the next loop.
+    case yield
+    /// Resume after `ms` milliseconds (other tickables keep running).
+    case sleep(U32)
+    /// Resume once `condition` returns true (checked every loop).
+    case waitUntil(() -> Bool)
+    /// Like waitUntil, but resumes after the given ms anyway with `timedOut == true`.
+    case waitUntilTimeout(U32, () -> Bool)
+    /// Finished: the slot is freed.
+    case done
+}
+
+public final class ArduinoTask {
+
+    public typealias Body = (ArduinoTask) -> TaskAction
+
+    // MARK: - Public
+
+    /// Resume point: 0 on the first resume, +1 after each resume unless goto() was called.
+    public private(set) var step: Int = 0
+
+    /// True when the last wait ended by timeout rather than by its condition.
+    public private(set) var timedOut: Bool = false
+
+    public private(set) var isDone: Bool = false
+
+    /// Jump to `step` on the next resume (instead of step + 1).
+    public func goto(_ step: Int) {
+        nextStep = step
+    }
+
+    /// Stops the task; its slot is freed on the next scheduler tick.
+    public func cancel() {
+        isDone = true
+    }
+
+    // MARK: - State
+
+    private let body: Body
+    private var nextStep: Int? = nil
+
+    private enum Wait {
+        case none
+        case until(U32)                       // millis deadline
+        case condition(() -> Bool, U32?)      // condition + optional deadline
+    }
+
+    private var wait: Wait = .none
+
+    // MARK: - Init
+
+    public init(_ body: @escaping Body) {
+        self.body = body
+    }
+
+    // MARK: - Scheduler hooks
+
+    /// Returns true when the task is finished.
+    fileprivate func poll(now: U32) -> Bool {
+        if isDone { return true }
+
+        switch wait {
+        case .none:
+            break
+        case .until(let deadline):
+            if !reached(deadline, now) { return false }
+            timedOut = false
+        case .condition(let cond, let deadline):
+            if cond() {
+                timedOut = false
+            } else if let d = deadline, reached(d, now) {
+                timedOut = true
+            } else {
+                return false
+            }
+        }
+        wait = .none
+
+        let action = body(self)
+        if let n = nextStep {
+            step = n
+            nextStep = nil
+        } else {
+            step += 1
+        }
+
+        switch action {
+        case .yield:
+            break
+        case .sleep(let ms):
+            wait = .until(now &+ ms)
+        case .waitUntil(let cond):
+            wait = .condition(cond, nil)
+        case .waitUntilTimeout(let ms, let cond):
+            wait = .condition(cond, now &+ ms)
+        case .done:
+            isDone = true
+        }
+        return isDone
+    }
+
+    @inline(__always)
+    private func reached(_ deadline: U32, _ now: U32) -> Bool {
+        // Wrap-safe: deadlines are < 2^31 ms ahead.
+        Int32(bitPattern: now &- deadline) >= 0
+    }
+}
+
+// MARK: - Scheduler
+
+public final class TaskScheduler: ArduinoTickable {
+
+    public let capacity: Int
+
+    // Fixed slots, allocated once.
+    private var slots: [ArduinoTask?]
+    public private(set) var count: Int = 0
+
+    public init(capacity: Int = 8) {
+        self.capacity = capacity > 0 ? capacity : 1
+        self.slots = [ArduinoTask?](repeating: nil, count: self.capacity)
+    }
+
+    /// Starts `body` on the next tick. Returns nil when every slot is busy.
+    @discardableResult
+    public func spawn(_ body: @escaping ArduinoTask.Body) -> ArduinoTask? {
+        var i = 0
+        while i < capacity {
+            if slots[i] == nil {
+                let t = ArduinoTask(body)
+                slots[i] = t
+                count += 1
+                return t
+            }
+            i += 1
+        }
+        return nil
+    }
+
+    public func cancelAll() {
+        var i = 0
+        while i < capacity {
+            slots[i]?.cancel()
+            slots[i] = nil
+            i += 1
+        }
+        count = 0
+    }
+
+    public func tick() {
+        if count == 0 { return }
+        let now = arduino_millis()
+
+        var i = 0
+        while i < capacity {
+            if let t = slots[i], t.poll(now: now) {
+                slots[i] = nil
+                count -= 1
+            }
+            i += 1
+        }
+    }
+}
+
+// MARK: - Shared scheduler
+
+public enum Tasks {
+
+    /// Slots of the shared scheduler; set before the first spawn.
+    public static var capacity: Int = 8
+
+    private static var sharedScheduler: TaskScheduler?
+
+    public static var shared: TaskScheduler {
+        if let s = sharedScheduler { return s }
+        let s = TaskScheduler(capacity: capacity)
+        sharedScheduler = s
+        ArduinoRuntime.add(s)
+        return s
+    }
+
+    @discardableResult
+    public static func spawn(_ body: @escaping ArduinoTask.Body) -> ArduinoTask? {
+        shared.spawn(body)
+    }
+}
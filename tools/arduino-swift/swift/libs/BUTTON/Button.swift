@@ -1,6 +1,8 @@
 // Button.swift
 // Button built on PIN with press + release callbacks.
-// Uses polling (no interrupts) and integrates with ArduinoRuntime.
+// Polls by default; useInterrupt() switches to edge-driven mode (arduino_irq_attach
+// slot): tick() then does no pin read at all until the ISR reports an edge, and
+// the level is sampled once the line has been quiet for the debounce time.
 //
 // Usage:
 //   let button = Button(
@@ -8,7 +10,10 @@
 //       onPress: { ... },
 //       onRelease: { ... }
 //   )
+//   button.useInterrupt()   // optional
 //   ArduinoRuntime.add(button)
+//
+// Many buttons: ButtonGroup (one port read per scan). Matrix: Keypad.
 
 public final class Button: ArduinoTickable {
 
@@ -39,6 +44,11 @@ public final class Button: ArduinoTickable {
     private var debounceMs: U32 = 25
     private var lastEdgeMs: U32 = 0
 
+    // Interrupt mode: IRQ slot (-1 = polling) + pending edge awaiting the quiet period.
+    private var irqSlot: I32 = -1
+    private var edgePending = false
+    private var lastEdgeUs: U32 = 0
+
     // MARK: - Init
 
     public init(
@@ -85,6 +95,35 @@ public final class Button: ArduinoTickable {
         debounceMs = ms
     }
 
+    // MARK: - Interrupt mode
+
+    /// Attaches a CHANGE interrupt. Returns false (and keeps polling) when the pin
+    /// has no interrupt or all IRQ slots are taken.
+    @discardableResult
+    public func useInterrupt() -> Bool {
+        if irqSlot >= 0 { return true }
+        let slot = arduino_irq_attach(pin.number, arduino_irq_mode_change())
+        if slot < 0 { return false }
+        irqSlot = slot
+        edgePending = false
+        didInitState = false
+        return true
+    }
+
+    /// Back to polling; frees the IRQ slot.
+    public func usePolling() {
+        if irqSlot < 0 { return }
+        arduino_irq_detach(irqSlot)
+        irqSlot = -1
+        edgePending = false
+        didInitState = false
+    }
+
+    public var isInterruptDriven: Bool { irqSlot >= 0 }
+
+    /// micros() (low 32 bits) of the latest edge seen by the ISR.
+    public var lastEdgeMicros: U32 { lastEdgeUs }
+
     // MARK: - State query
 
     /// Returns true while button is physically pressed
@@ -103,6 +142,11 @@ public final class Button: ArduinoTickable {
     public func tick() {
         guard enabled else { return }
 
+        if irqSlot >= 0 {
+            tickInterrupt()
+            return
+        }
+
         let now = arduino_millis()
         let pressed = readPressed()
 
@@ -128,6 +172,37 @@ public final class Button: ArduinoTickable {
         lastPressed = pressed
     }
 
+    private func tickInterrupt() {
+        if !didInitState {
+            _ = arduino_irq_consume_edges(irqSlot, nil)
+            lastPressed = readPressed()
+            didInitState = true
+            return
+        }
+
+        var stamp: U32 = 0
+        if arduino_irq_consume_edges(irqSlot, &stamp) != 0 {
+            edgePending = true
+            lastEdgeUs = stamp
+        }
+        guard edgePending else { return }
+
+        // Debounce = the line stayed quiet for debounceMs after its last edge.
+        let quietUs = U32(truncatingIfNeeded: arduino_micros()) &- lastEdgeUs
+        if quietUs < debounceMs &* 1000 { return }
+        edgePending = false
+
+        let pressed = readPressed()
+        if pressed == lastPressed { return }   // bounced back: glitch, no event
+        lastPressed = pressed
+
+        if pressed {
+            onPressBlock?()
+        } else {
+            onReleaseBlock?()
+        }
+    }
+
     // MARK: - Internals
 
     private func configureHardware() {
@@ -0,0 +1,142 @@
+// ButtonGroup.swift
+// Up to 32 buttons debounced together from one PinGroup read per scan.
+//
+// - One scan = PinGroup.read() (one input register load per port) + a handful of
+//   bitwise ops for all buttons at once (2-bit vertical counters per bit).
+// - A button changes state after 4 consecutive scans agree, so the debounce time
+//   is 4 * scanMs (default 5 ms -> 20 ms). Between scans tick() only checks the clock.
+// - Callbacks receive the button index (position in `pins`).
+//
+// Usage:
+//   let panel = ButtonGroup(pins: [22, 23, 24, 25, 26, 27]) { i in
+//       print("pressed ")
+//       println(i)
+//   }
+//   ArduinoRuntime.add(panel)
+
+public final class ButtonGroup: ArduinoTickable {
+
+    public typealias Handler = (Int) -> Void
+
+    // MARK: - Public
+
+    public let pins: PinGroup
+
+    /// Time between scans. Debounce time is 4 scans.
+    public var scanMs: U32 = 5
+
+    public var enabled: Bool = true
+
+    public var onPress: Handler?
+    public var onRelease: Handler?
+
+    /// Debounced state, bit i = button i pressed.
+    public var pressedMask: U32 { debouncer.state }
+
+    // MARK: - State
+
+    private let activeLow: Bool
+    private var debouncer = BitDebouncer()
+    private var lastScanMs: U32 = 0
+    private var didInitState = false
+
+    // MARK: - Init
+
+    /// `pullup`: inputs use INPUT_PULLUP and a pressed button reads LOW.
+    public init(pins: [Int], pullup: Bool = true, onPress: Handler? = nil, onRelease: Handler? = nil) {
+        self.pins = PinGroup(pins)
+        self.activeLow = pullup
+        self.onPress = onPress
+        self.onRelease = onRelease
+
+        if pullup {
+            self.pins.pullup()
+        } else {
+            self.pins.input()
+        }
+    }
+
+    // MARK: - Query
+
+    public func isPressed(_ index: Int) -> Bool {
+        index >= 0 && index < 32 && (debouncer.state & (1 << U32(index))) != 0
+    }
+
+    // MARK: - Tick
+
+    public func tick() {
+        guard enabled else { return }
+
+        let now = arduino_millis()
+        if didInitState && (now &- lastScanMs) < scanMs { return }
+        lastScanMs = now
+
+        let sample = samplePressed()
+        if !didInitState {
+            debouncer.reset(to: sample)
+            didInitState = true
+            return
+        }
+
+        let changed = debouncer.update(sample)
+        if changed != 0 {
+            BitDebouncer.forEachBit(changed) { i in
+                if (debouncer.state & (1 << U32(i))) != 0 {
+                    onPress?(i)
+                } else {
+                    onRelease?(i)
+                }
+            }
+        }
+    }
+
+    // MARK: - Internals
+
+    private func samplePressed() -> U32 {
+        let raw = pins.read()
+        let used: U32 = pins.count >= 32 ? 0xFFFF_FFFF : ((1 << U32(pins.count)) &- 1)
+        return (activeLow ? ~raw : raw) & used
+    }
+}
+
+// MARK: - Vertical counter debouncer
+
+/// 32 independent 2-bit counters in two words: a bit flips in `state` only after
+/// the input disagreed with it on 4 consecutive updates.
+public struct BitDebouncer {
+
+    public private(set) var state: U32 = 0
+
+    private var ct0: U32 = 0xFFFF_FFFF
+    private var ct1: U32 = 0xFFFF_FFFF
+
+    public init() {}
+
+    public mutating func reset(to sample: U32) {
+        state = sample
+        ct0 = 0xFFFF_FFFF
+        ct1 = 0xFFFF_FFFF
+    }
+
+    /// Feeds one sample; returns the bits that changed state.
+    @inline(__always)
+    public mutating func update(_ sample: U32) -> U32 {
+        let delta = sample ^ state
+        ct0 = ~(ct0 & delta)
+        ct1 = ct0 ^ (ct1 & delta)
+        let toggled = delta & ct0 & ct1
+        state ^= toggled
+        return toggled
+    }
+
+    /// Calls `body` with the index of every set bit, lowest first.
+    @inline(__always)
+    public static func forEachBit(_ mask: U32, _ body: (Int) -> Void) {
+        var m = mask
+        while m != 0 {
+            let i = m.trailingZeroBitCount
+            body(i)
+            m &= m &- 1
+        }
+    }
+}
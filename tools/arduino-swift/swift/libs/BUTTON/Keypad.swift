@@ -0,0 +1,135 @@
+// Keypad.swift
+// Matrix keypad scanner (rows x cols <= 32 keys), debounced with BitDebouncer.
+//
+// - Rows idle as INPUT (high-Z); a scan drives one row LOW at a time and reads
+//   every column with one PinGroup read (columns use INPUT_PULLUP), so two keys
+//   pressed in one column never short two driven outputs.
+// - A full scan happens every scanMs; a key changes state after 4 agreeing scans.
+// - Key index = row * cols + col.
+//
+// Usage:
+//   let pad = Keypad(rows: [2, 3, 4, 5], cols: [6, 7, 8, 9]) { key in
+//       println(key)
+//   }
+//   ArduinoRuntime.add(pad)
+
+public final class Keypad: ArduinoTickable {
+
+    public typealias Handler = (Int) -> Void
+
+    // MARK: - Public
+
+    public let rowCount: Int
+    public let colCount: Int
+
+    /// Time between full scans. Debounce time is 4 scans.
+    public var scanMs: U32 = 5
+
+    /// Settle time after driving a row, before the columns are sampled.
+    public var settleMicros: U32 = 5
+
+    public var enabled: Bool = true
+
+    public var onPress: Handler?
+    public var onRelease: Handler?
+
+    /// Debounced state, bit (row * cols + col) = key pressed.
+    public var pressedMask: U32 { debouncer.state }
+
+    // MARK: - State
+
+    private let rows: [PIN]
+    private let cols: PinGroup
+    private var debouncer = BitDebouncer()
+    private var lastScanMs: U32 = 0
+    private var didInitState = false
+
+    // MARK: - Init
+
+    /// Extra rows / columns beyond 32 keys are ignored.
+    public init(rows: [Int], cols: [Int], onPress: Handler? = nil, onRelease: Handler? = nil) {
+        let c = cols.count < 32 ? cols.count : 32
+        let r = c > 0 ? min(rows.count, 32 / c) : 0
+
+        var rowPins: [PIN] = []
+        var i = 0
+        while i < r {
+            let p = PIN(rows[i])
+            p.input()
+            rowPins.append(p)
+            i += 1
+        }
+
+        var colPins: [Int] = []
+        i = 0
+        while i < c {
+            colPins.append(cols[i])
+            i += 1
+        }
+
+        self.rows = rowPins
+        self.rowCount = r
+        self.colCount = c
+        self.cols = PinGroup(colPins)
+        self.onPress = onPress
+        self.onRelease = onRelease
+
+        self.cols.pullup()
+    }
+
+    // MARK: - Query
+
+    public func isPressed(row: Int, col: Int) -> Bool {
+        if row < 0 || row >= rowCount || col < 0 || col >= colCount { return false }
+        return (debouncer.state & (1 << U32(row * colCount + col))) != 0
+    }
+
+    // MARK: - Tick
+
+    public func tick() {
+        guard enabled, rowCount > 0 else { return }
+
+        let now = arduino_millis()
+        if didInitState && (now &- lastScanMs) < scanMs { return }
+        lastScanMs = now
+
+        let sample = scan()
+        if !didInitState {
+            debouncer.reset(to: sample)
+            didInitState = true
+            return
+        }
+
+        let changed = debouncer.update(sample)
+        if changed != 0 {
+            BitDebouncer.forEachBit(changed) { k in
+                if (debouncer.state & (1 << U32(k))) != 0 {
+                    onPress?(k)
+                } else {
+                    onRelease?(k)
+                }
+            }
+        }
+    }
+
+    // MARK: - Internals
+
+    private func scan() -> U32 {
+        let colMask: U32 = (1 << U32(colCount)) &- 1
+        var keys: U32 = 0
+
+        var r = 0
+        while r < rowCount {
+            let row = rows[r]
+            row.off()                   // OUTPUT + LOW
+            if settleMicros > 0 { arduino_delay_us(settleMicros) }
+
+            let pressed = ~cols.read() & colMask
+            keys |= pressed << U32(r * colCount)
+
+            row.input()                 // back to high-Z
+            r += 1
+        }
+        return keys
+    }
+}
@@ -32,12 +32,88 @@ public func arduino_i2c_available() -> I32
 @_silgen_name("arduino_i2c_read")
 public func arduino_i2c_read() -> I32
 
+@_silgen_name("arduino_i2c_read_buf")
+public func arduino_i2c_read_buf(_ out: UnsafeMutablePointer<U8>?, _ cap: U32) -> U32
+
+@_silgen_name("arduino_i2c_transfer")
+public func arduino_i2c_transfer(
+    _ address: U8,
+    _ tx: UnsafePointer<U8>?, _ txLen: U32,
+    _ rx: UnsafeMutablePointer<U8>?, _ rxLen: U32,
+    _ flags: U32
+) -> I32
+
+// ----------------------
+// I2C (Wire) - Mux
+// ----------------------
+@_silgen_name("arduino_i2c_mux_select")
+public func arduino_i2c_mux_select(_ mux: U8, _ channel: U8) -> U8
+
+@_silgen_name("arduino_i2c_mux_invalidate")
+public func arduino_i2c_mux_invalidate() -> Void
+
+@_silgen_name("arduino_i2c_mux_stats")
+public func arduino_i2c_mux_stats(_ skipped: UnsafeMutablePointer<U32>?) -> U32
+
+@_silgen_name("arduino_i2c_mux_transfer")
+public func arduino_i2c_mux_transfer(
+    _ mux: U8, _ channel: U8, _ address: U8,
+    _ tx: UnsafePointer<U8>?, _ txLen: U32,
+    _ rx: UnsafeMutablePointer<U8>?, _ rxLen: U32,
+    _ flags: U32
+) -> I32
+
+// ----------------------
+// I2C master queue (I2CQueue.h)
+// ----------------------
+@_silgen_name("arduino_i2cq_submit")
+public func arduino_i2cq_submit(
+    _ address: U8,
+    _ tx: UnsafePointer<U8>?, _ txLen: U32,
+    _ rx: UnsafeMutablePointer<U8>?, _ rxLen: U32,
+    _ flags: U32
+) -> I32
+
+@_silgen_name("arduino_i2cq_pump")
+public func arduino_i2cq_pump() -> U32
+
+@_silgen_name("arduino_i2cq_peek_done")
+public func arduino_i2cq_peek_done(
+    _ id: UnsafeMutablePointer<U32>?,
+    _ result: UnsafeMutablePointer<I32>?,
+    _ rx: UnsafeMutablePointer<UnsafePointer<U8>?>?
+) -> U32
+
+@_silgen_name("arduino_i2cq_release_done")
+public func arduino_i2cq_release_done() -> Void
+
+@_silgen_name("arduino_i2cq_slots")
+public func arduino_i2cq_slots() -> U32
+
+@_silgen_name("arduino_i2cq_state")
+public func arduino_i2cq_state(_ id: U32) -> U32
+
+@_silgen_name("arduino_i2cq_pending")
+public func arduino_i2cq_pending() -> U32
+
+@_silgen_name("arduino_i2cq_is_async")
+public func arduino_i2cq_is_async() -> U32
+
 // ----------------------
 // I2C (Wire) - Slave
 // ----------------------
 @_silgen_name("arduino_i2c_slave_begin")
 public func arduino_i2c_slave_begin(_ address: U8) -> Void
 
+@_silgen_name("arduino_i2c_slave_rx_frames")
+public func arduino_i2c_slave_rx_frames() -> U32
+
+@_silgen_name("arduino_i2c_slave_rx_frame_peek")
+public func arduino_i2c_slave_rx_frame_peek(_ len: UnsafeMutablePointer<U32>?) -> UnsafePointer<U8>?
+
+@_silgen_name("arduino_i2c_slave_rx_frame_release")
+public func arduino_i2c_slave_rx_frame_release() -> Void
+
 @_silgen_name("arduino_i2c_slave_rx_available")
 public func arduino_i2c_slave_rx_available() -> U32
 
@@ -50,9 +126,24 @@ public func arduino_i2c_slave_rx_read_buf(_ out: UnsafeMutablePointer<U8>?, _ ma
 @_silgen_name("arduino_i2c_slave_rx_clear")
 public func arduino_i2c_slave_rx_clear() -> Void
 
+@_silgen_name("arduino_i2c_slave_rx_overflows")
+public func arduino_i2c_slave_rx_overflows() -> U32
+
+@_silgen_name("arduino_i2c_slave_tx_back")
+public func arduino_i2c_slave_tx_back(_ cap: UnsafeMutablePointer<U32>?) -> UnsafeMutablePointer<U8>?
+
+@_silgen_name("arduino_i2c_slave_tx_publish")
+public func arduino_i2c_slave_tx_publish(_ len: U32) -> Void
+
 @_silgen_name("arduino_i2c_slave_set_tx")
 public func arduino_i2c_slave_set_tx(_ data: UnsafePointer<U8>?, _ len: U32) -> Void
 
+@_silgen_name("arduino_i2c_slave_set_reg_tx")
+public func arduino_i2c_slave_set_reg_tx(_ reg: U8, _ data: UnsafePointer<U8>?, _ len: U32) -> U32
+
+@_silgen_name("arduino_i2c_slave_clear_reg_tx")
+public func arduino_i2c_slave_clear_reg_tx() -> Void
+
 @_silgen_name("arduino_i2c_slave_consume_onReceive")
 public func arduino_i2c_slave_consume_onReceive() -> U32
 
@@ -38,75 +38,277 @@ public enum I2C {
     // ------------------------------------------------------------
     // MARK: - Packet (typed views over bytes)
     // ------------------------------------------------------------
+    /// Up to `inlineCapacity` bytes live inside the Packet itself (no heap);
+    /// longer payloads spill to one array. Typed LE/BE readers and writers work
+    /// on whichever storage is active.
     public struct Packet: Sendable {
 
-        public var bytes: [UInt8]
+        /// Bytes stored inline. Resize `Inline` (8 bytes per field) to change it.
+        public static let inlineCapacity = MemoryLayout<Inline>.size
+
+        private typealias Inline = (UInt64, UInt64, UInt64, UInt64)
+
+        private var inline: Inline = (0, 0, 0, 0)
+        private var spill: [UInt8]?          // nil until count exceeds inlineCapacity
+        public private(set) var count: Int = 0
 
         @inline(__always)
+        public init() {}
+
+        public init(_ bytes: UnsafeBufferPointer<UInt8>) {
+            append(contentsOf: bytes)
+        }
+
         public init(_ bytes: [UInt8]) {
-            self.bytes = bytes
+            bytes.withUnsafeBufferPointer { append(contentsOf: $0) }
+        }
+
+        /// Zero-copy fill: `fill` writes up to `capacity` bytes and returns the length.
+        public init(capacity: Int, _ fill: (UnsafeMutableBufferPointer<UInt8>) -> Int) {
+            let cap = capacity > 0 ? capacity : 0
+            grow(to: cap)
+            var n = storage { fill(UnsafeMutableBufferPointer(rebasing: $0[0..<cap])) }
+            if n < 0 { n = 0 }
+            if n > cap { n = cap }
+            count = cap
+            removeLast(cap - n)
         }
 
         @inline(__always)
         public init(byte: UInt8) {
-            self.bytes = [byte]
+            append(byte: byte)
         }
 
         /// Little-endian Int32 payload (4 bytes)
         @inline(__always)
         public init(int32LE v: Int32) {
-            let u = UInt32(bitPattern: v)
-            self.bytes = [
-                UInt8(truncatingIfNeeded: u),
-                UInt8(truncatingIfNeeded: u >> 8),
-                UInt8(truncatingIfNeeded: u >> 16),
-                UInt8(truncatingIfNeeded: u >> 24),
-            ]
+            appendLE(v)
         }
 
         /// Little-endian UInt32 payload (4 bytes)
         @inline(__always)
         public init(uint32LE v: UInt32) {
-            self.bytes = [
-                UInt8(truncatingIfNeeded: v),
-                UInt8(truncatingIfNeeded: v >> 8),
-                UInt8(truncatingIfNeeded: v >> 16),
-                UInt8(truncatingIfNeeded: v >> 24),
-            ]
+            appendLE(v)
         }
 
         /// UTF-8 payload (no null terminator, raw bytes)
         public init(utf8 s: String) {
-            self.bytes = Array(s.utf8)
+            for b in s.utf8 { append(byte: b) }
         }
 
-        public var count: Int { bytes.count }
-        public var isEmpty: Bool { bytes.isEmpty }
+        /// Copy as an array (allocates; prefer withUnsafeBytes).
+        public var bytes: [UInt8] {
+            get { withUnsafeBytes { Array($0) } }
+            set {
+                removeAll()
+                newValue.withUnsafeBufferPointer { append(contentsOf: $0) }
+            }
+        }
+
+        public var isEmpty: Bool { count == 0 }
+
+        /// False once the payload has spilled to the heap.
+        public var isInline: Bool { spill == nil }
 
         public func byte(at i: Int) -> UInt8? {
-            if i < 0 || i >= bytes.count { return nil }
-            return bytes[i]
+            if i < 0 || i >= count { return nil }
+            return withUnsafeBytes { $0[i] }
+        }
+
+        // ----------------------
+        // Access
+        // ----------------------
+
+        public func withUnsafeBytes<R>(_ body: (UnsafeBufferPointer<UInt8>) -> R) -> R {
+            if let a = spill {
+                return a.withUnsafeBufferPointer { body($0) }
+            }
+            let n = count
+            return Swift.withUnsafeBytes(of: inline) { raw in
+                body(UnsafeBufferPointer(start: raw.baseAddress?.assumingMemoryBound(to: UInt8.self), count: n))
+            }
+        }
+
+        public mutating func withUnsafeMutableBytes<R>(_ body: (UnsafeMutableBufferPointer<UInt8>) -> R) -> R {
+            let n = count
+            return storage { body(UnsafeMutableBufferPointer(rebasing: $0[0..<n])) }
+        }
+
+        // ----------------------
+        // Writers
+        // ----------------------
+
+        public mutating func append(byte: UInt8) {
+            let at = count
+            grow(to: at + 1)
+            storage { $0[at] = byte }
+            count = at + 1
+        }
+
+        public mutating func append(contentsOf src: UnsafeBufferPointer<UInt8>) {
+            guard let base = src.baseAddress, !src.isEmpty else { return }
+            let at = count
+            grow(to: at + src.count)
+            storage { dst in
+                dst.baseAddress!.advanced(by: at).update(from: base, count: src.count)
+            }
+            count = at + src.count
+        }
+
+        /// Appends `v` little-endian (pass a typed value: a bare literal is an Int).
+        public mutating func appendLE<T: FixedWidthInteger>(_ v: T) {
+            put(v, at: count, bigEndian: false)
+        }
+
+        public mutating func appendBE<T: FixedWidthInteger>(_ v: T) {
+            put(v, at: count, bigEndian: true)
+        }
+
+        /// Overwrites (or extends past the end with) `v` at `offset`. False when offset > count.
+        @discardableResult
+        public mutating func writeLE<T: FixedWidthInteger>(_ v: T, at offset: Int) -> Bool {
+            if offset < 0 || offset > count { return false }
+            put(v, at: offset, bigEndian: false)
+            return true
+        }
+
+        @discardableResult
+        public mutating func writeBE<T: FixedWidthInteger>(_ v: T, at offset: Int) -> Bool {
+            if offset < 0 || offset > count { return false }
+            put(v, at: offset, bigEndian: true)
+            return true
+        }
+
+        public mutating func removeLast(_ k: Int) {
+            if k <= 0 { return }
+            let n = k < count ? count - k : 0
+            if spill != nil { spill!.removeLast(count - n) }
+            count = n
+        }
+
+        /// Back to inline storage: a spilled buffer is released, so a reused
+        /// Packet does not keep a long payload's heap block alive.
+        public mutating func removeAll() {
+            spill = nil
+            count = 0
+        }
+
+        // ----------------------
+        // Readers
+        // ----------------------
+
+        /// `T` read little-endian at `offset`; nil when it runs past the end.
+        public func readLE<T: FixedWidthInteger>(_ type: T.Type, at offset: Int = 0) -> T? {
+            get(type, at: offset, bigEndian: false)
+        }
+
+        public func readBE<T: FixedWidthInteger>(_ type: T.Type, at offset: Int = 0) -> T? {
+            get(type, at: offset, bigEndian: true)
         }
 
         /// Try decode bytes as UTF-8 String (returns nil if invalid UTF-8)
         public func asUTF8String() -> String? {
-            String(validating: bytes, as: UTF8.self)
+            withUnsafeBytes { String(validating: $0, as: UTF8.self) }
         }
 
         /// Interpret first 4 bytes as LE UInt32
         public func asUInt32LE() -> UInt32? {
-            if bytes.count < 4 { return nil }
-            let b0 = UInt32(bytes[0])
-            let b1 = UInt32(bytes[1]) << 8
-            let b2 = UInt32(bytes[2]) << 16
-            let b3 = UInt32(bytes[3]) << 24
-            return (b0 | b1 | b2 | b3)
+            readLE(UInt32.self)
         }
 
         /// Interpret first 4 bytes as LE Int32
         public func asInt32LE() -> Int32? {
-            guard let u = asUInt32LE() else { return nil }
-            return Int32(bitPattern: u)
+            readLE(Int32.self)
+        }
+
+        // ----------------------
+        // Storage
+        // ----------------------
+
+        /// Active storage: the inline bytes, or the whole spill array.
+        private mutating func storage<R>(_ body: (UnsafeMutableBufferPointer<UInt8>) -> R) -> R {
+            if spill != nil {
+                return spill!.withUnsafeMutableBufferPointer { body($0) }
+            }
+            return Swift.withUnsafeMutableBytes(of: &inline) { raw in
+                body(UnsafeMutableBufferPointer(
+                    start: raw.baseAddress?.assumingMemoryBound(to: UInt8.self),
+                    count: Self.inlineCapacity))
+            }
+        }
+
+        /// Makes `n` bytes addressable; the first spill moves the inline bytes to the heap.
+        private mutating func grow(to n: Int) {
+            if spill == nil {
+                if n <= Self.inlineCapacity { return }
+                var a = [UInt8]()
+                a.reserveCapacity(n)
+                withUnsafeBytes { a.append(contentsOf: $0) }
+                spill = a
+            }
+            let have = spill!.count
+            if have < n { spill!.append(contentsOf: repeatElement(UInt8(0), count: n - have)) }
+        }
+
+        private mutating func put<T: FixedWidthInteger>(_ v: T, at offset: Int, bigEndian: Bool) {
+            let size = MemoryLayout<T>.size
+            let end = offset + size
+            grow(to: end)
+            storage { b in
+                var i = 0
+                while i < size {
+                    let shift = (bigEndian ? size - 1 - i : i) * 8
+                    b[offset + i] = UInt8(truncatingIfNeeded: v >> shift)
+                    i += 1
+                }
+            }
+            if end > count { count = end }
+        }
+
+        private func get<T: FixedWidthInteger>(_ type: T.Type, at offset: Int, bigEndian: Bool) -> T? {
+            let size = MemoryLayout<T>.size
+            if offset < 0 || offset > count - size { return nil }
+            return withUnsafeBytes { b in
+                var v: T = 0
+                var i = 0
+                while i < size {
+                    v = (v << 8) | T(truncatingIfNeeded: b[offset + (bigEndian ? i : size - 1 - i)])
+                    i += 1
+                }
+                return v
+            }
+        }
+    }
+
+    // ------------------------------------------------------------
+    // MARK: - Target (device address, optionally behind a mux channel)
+    // ------------------------------------------------------------
+    /// A device on the bus, or behind channel `channel` of a TCA9548A-style mux.
+    /// The library caches each mux's selected channel and skips redundant selects.
+    public struct Target: Equatable, Sendable {
+        /// 0 = directly on the bus.
+        public let mux: UInt8
+        public let channel: UInt8
+        public let address: UInt8
+
+        public init(mux: UInt8, channel: UInt8, address: UInt8) {
+            self.mux = mux
+            self.channel = channel
+            self.address = address
+        }
+
+        public static func direct(_ address: UInt8) -> Target {
+            Target(mux: 0, channel: 0, address: address)
+        }
+
+        public var isMuxed: Bool { mux != 0 }
+
+        /// Scheduling order: everything behind one mux channel together.
+        @inline(__always)
+        func precedes(_ o: Target) -> Bool {
+            if mux != o.mux { return mux < o.mux }
+            if channel != o.channel { return channel < o.channel }
+            return address < o.address
         }
     }
 
@@ -121,6 +323,10 @@ public enum I2C {
         // One Wire instance on Arduino: keep single begin flag.
         static var didBegin: Bool = false
 
+        // arduino_i2c_transfer flags (I2C.h)
+        static let xferStopBetween: UInt32 = 0x01
+        static let xferNoStop: UInt32 = 0x02
+
         public init(clockHz: UInt32 = 100_000, defaultStop: Bool = true) {
             self.clockHz = clockHz
             self.defaultStop = defaultStop
@@ -146,21 +352,23 @@ public enum I2C {
         // ----------------------
 
         /// beginTransmission(addr) + write(bytes) + endTransmission(stop)
-        @inline(__always)
-        public mutating func write(to address: UInt8, bytes: [UInt8], sendStop: Bool? = nil) -> Status {
+        public mutating func write(to address: UInt8, bytes: UnsafeBufferPointer<UInt8>, sendStop: Bool? = nil) -> Status {
             beginIfNeeded()
 
             arduino_i2c_beginTransmission(address)
             if !bytes.isEmpty {
-                bytes.withUnsafeBufferPointer { buf in
-                    _ = arduino_i2c_write_buf(buf.baseAddress, UInt32(buf.count))
-                }
+                _ = arduino_i2c_write_buf(bytes.baseAddress, UInt32(bytes.count))
             }
 
             let stop = (sendStop ?? defaultStop) ? UInt8(1) : UInt8(0)
             return Status(rawValue: arduino_i2c_endTransmission(stop))
         }
 
+        @inline(__always)
+        public mutating func write(to address: UInt8, bytes: [UInt8], sendStop: Bool? = nil) -> Status {
+            bytes.withUnsafeBufferPointer { write(to: address, bytes: $0, sendStop: sendStop) }
+        }
+
         /// write one byte
         @inline(__always)
         public mutating func write(to address: UInt8, byte: UInt8, sendStop: Bool? = nil) -> Status {
@@ -176,35 +384,99 @@ public enum I2C {
         /// write Packet
         @inline(__always)
         public mutating func write(to address: UInt8, packet: Packet, sendStop: Bool? = nil) -> Status {
-            write(to: address, bytes: packet.bytes, sendStop: sendStop)
+            packet.withUnsafeBytes { write(to: address, bytes: $0, sendStop: sendStop) }
         }
 
         // ----------------------
         // Master read (Wire)
         // ----------------------
 
+        /// requestFrom(addr, buf.count, stop) straight into `buf`. Returns bytes read.
+        public mutating func read(from address: UInt8, into buf: UnsafeMutableBufferPointer<UInt8>, sendStop: Bool? = nil) -> Int {
+            if buf.isEmpty { return 0 }
+            beginIfNeeded()
+
+            let flags: UInt32 = (sendStop ?? defaultStop) ? 0 : Self.xferNoStop
+            let got = arduino_i2c_transfer(address, nil, 0, buf.baseAddress, UInt32(buf.count), flags)
+            return got > 0 ? Int(got) : 0
+        }
+
         /// requestFrom(addr,count,stop) then read available bytes (up to count).
         public mutating func read(from address: UInt8, count: Int, sendStop: Bool? = nil) -> Packet {
-            if count <= 0 { return Packet([]) }
-            beginIfNeeded()
+            if count <= 0 { return Packet() }
+            return Packet(capacity: count) { read(from: address, into: $0, sendStop: sendStop) }
+        }
 
-            let stop = (sendStop ?? defaultStop) ? UInt8(1) : UInt8(0)
-            let got = Int(arduino_i2c_requestFrom(address, UInt32(count), stop))
+        // ----------------------
+        // Master transaction (one C call)
+        // ----------------------
 
-            var out: [UInt8] = []
-            out.reserveCapacity(got > 0 ? got : count)
-            let target = (got > 0 && got <= count) ? got : count
+        /// Write `tx`, then read into `rx` after a repeated start (or STOP + START
+        /// when `repeatedStart` is false). Either side may be empty.
+        /// `count` is the number of bytes read (may be short of rx.count).
+        public mutating func transfer(
+            to address: UInt8,
+            tx: UnsafeBufferPointer<UInt8>,
+            rx: UnsafeMutableBufferPointer<UInt8>,
+            repeatedStart: Bool = true,
+            sendStop: Bool? = nil
+        ) -> (status: Status, count: Int) {
+            beginIfNeeded()
 
-            while out.count < target {
-                let avail = Int(arduino_i2c_available())
-                if avail <= 0 { break }
+            var flags: UInt32 = 0
+            if !repeatedStart { flags |= Self.xferStopBetween }
+            if !(sendStop ?? defaultStop) { flags |= Self.xferNoStop }
 
-                let v = arduino_i2c_read()
-                if v < 0 { break }
-                out.append(UInt8(truncatingIfNeeded: v))
+            let r = arduino_i2c_transfer(
+                address,
+                tx.baseAddress, UInt32(tx.count),
+                rx.baseAddress, UInt32(rx.count),
+                flags
+            )
+            if r < 0 { return (Status(rawValue: UInt8(truncatingIfNeeded: -r)), 0) }
+            return (.ok, Int(r))
+        }
+
+        /// Register-block read (IMUs, sensors): write `register`, repeated start, read rx.count bytes.
+        public mutating func readRegisters(
+            from address: UInt8,
+            register: UInt8,
+            into rx: UnsafeMutableBufferPointer<UInt8>
+        ) -> (status: Status, count: Int) {
+            var reg = register
+            return withUnsafePointer(to: &reg) { p in
+                transfer(to: address, tx: UnsafeBufferPointer(start: p, count: 1), rx: rx)
             }
+        }
+
+        /// transfer() to a Target: selects its mux channel first when needed.
+        public mutating func transfer(
+            to target: Target,
+            tx: UnsafeBufferPointer<UInt8>,
+            rx: UnsafeMutableBufferPointer<UInt8>
+        ) -> (status: Status, count: Int) {
+            if !target.isMuxed { return transfer(to: target.address, tx: tx, rx: rx) }
+            beginIfNeeded()
 
-            return Packet(out)
+            let r = arduino_i2c_mux_transfer(
+                target.mux, target.channel, target.address,
+                tx.baseAddress, UInt32(tx.count),
+                rx.baseAddress, UInt32(rx.count),
+                0
+            )
+            if r < 0 { return (Status(rawValue: UInt8(truncatingIfNeeded: -r)), 0) }
+            return (.ok, Int(r))
+        }
+
+        public mutating func readRegisters(
+            from target: Target,
+            register: UInt8,
+            into rx: UnsafeMutableBufferPointer<UInt8>
+        ) -> (status: Status, count: Int) {
+            var reg = register
+            return withUnsafePointer(to: &reg) { p in
+                transfer(to: target, tx: UnsafeBufferPointer(start: p, count: 1), rx: rx)
+            }
         }
 
         // ----------------------
@@ -231,19 +503,23 @@ public enum I2C {
             sendStopAfterWrite: Bool = false,
             sendStopAfterRead: Bool = true
         ) -> (status: Status, packet: Packet) {
-            let st = self.write(to: address, bytes: write, sendStop: sendStopAfterWrite)
-            if !st.isOK {
-                return (st, Packet([]))
+            var status = Status.ok
+            let pkt = write.withUnsafeBufferPointer { tx in
+                Packet(capacity: readCount) { rx in
+                    let r = transfer(to: address, tx: tx, rx: rx,
+                                     repeatedStart: !sendStopAfterWrite, sendStop: sendStopAfterRead)
+                    status = r.status
+                    return r.status.isOK ? r.count : 0
+                }
             }
-            let pkt = self.read(from: address, count: readCount, sendStop: sendStopAfterRead)
-            return (st, pkt)
+            return (status, pkt)
         }
     }
 
     // ------------------------------------------------------------
     // MARK: - Bus (high-level Master API with callbacks)
     // ------------------------------------------------------------
-    public final class Bus {
+    public final class Bus: SchedulerTransport {
 
         private var master: Master
 
@@ -306,12 +582,17 @@ public enum I2C {
         // ----------------------
 
         @discardableResult
-        public func send(to address: UInt8, _ bytes: [UInt8], stop: Bool? = nil) -> Status {
+        public func send(to address: UInt8, _ bytes: UnsafeBufferPointer<UInt8>, stop: Bool? = nil) -> Status {
             let st = master.write(to: address, bytes: bytes, sendStop: stop)
             if !st.isOK { emitError(address, st) }
             return st
         }
 
+        @discardableResult
+        public func send(to address: UInt8, _ bytes: [UInt8], stop: Bool? = nil) -> Status {
+            bytes.withUnsafeBufferPointer { send(to: address, $0, stop: stop) }
+        }
+
         @discardableResult
         public func send(to address: UInt8, _ byte: UInt8, stop: Bool? = nil) -> Status {
             let st = master.write(to: address, byte: byte, sendStop: stop)
@@ -321,7 +602,7 @@ public enum I2C {
 
         @discardableResult
         public func send(to address: UInt8, _ v: Int32, stop: Bool? = nil) -> Status {
-            send(to: address, Packet(int32LE: v).bytes, stop: stop)
+            send(to: address, Packet(int32LE: v), stop: stop)
         }
 
         @discardableResult
@@ -335,17 +616,17 @@ public enum I2C {
 
         @discardableResult
         public func send(to address: UInt8, _ v: UInt32, stop: Bool? = nil) -> Status {
-            send(to: address, Packet(uint32LE: v).bytes, stop: stop)
+            send(to: address, Packet(uint32LE: v), stop: stop)
         }
 
         @discardableResult
         public func send(to address: UInt8, _ text: String, stop: Bool? = nil) -> Status {
-            send(to: address, Packet(utf8: text).bytes, stop: stop)
+            send(to: address, Packet(utf8: text), stop: stop)
         }
 
         @discardableResult
         public func send(to address: UInt8, _ packet: Packet, stop: Bool? = nil) -> Status {
-            send(to: address, packet.bytes, stop: stop)
+            packet.withUnsafeBytes { send(to: address, $0, stop: stop) }
         }
 
         public func broadcast(to addresses: [UInt8], _ bytes: [UInt8], stop: Bool? = nil) {
@@ -372,6 +653,91 @@ public enum I2C {
             completion(pkt)
         }
 
+        /// Reads straight into a caller buffer (no Packet). Returns bytes read.
+        @discardableResult
+        public func request(from address: UInt8, into buf: UnsafeMutableBufferPointer<UInt8>, stop: Bool? = nil) -> Int {
+            master.read(from: address, into: buf, sendStop: stop)
+        }
+
+        /// One write-then-read transaction into caller buffers (no Packet).
+        @discardableResult
+        public func transfer(
+            to address: UInt8,
+            tx: UnsafeBufferPointer<UInt8>,
+            rx: UnsafeMutableBufferPointer<UInt8>,
+            repeatedStart: Bool = true
+        ) -> (status: Status, count: Int) {
+            let r = master.transfer(to: address, tx: tx, rx: rx, repeatedStart: repeatedStart)
+            if !r.status.isOK { emitError(address, r.status) }
+            return r
+        }
+
+        @discardableResult
+        public func readRegisters(
+            from address: UInt8,
+            register: UInt8,
+            into rx: UnsafeMutableBufferPointer<UInt8>
+        ) -> (status: Status, count: Int) {
+            let r = master.readRegisters(from: address, register: register, into: rx)
+            if !r.status.isOK { emitError(address, r.status) }
+            return r
+        }
+
+        // ----------------------
+        // Mux targets
+        // ----------------------
+
+        /// Selects the target's mux channel (no bus traffic when already selected).
+        @discardableResult
+        public func select(_ target: Target) -> Status {
+            guard target.isMuxed else { return .ok }
+            master.beginIfNeeded()
+            let st = Status(rawValue: arduino_i2c_mux_select(target.mux, target.channel))
+            if !st.isOK { emitError(target.mux, st) }
+            return st
+        }
+
+        @discardableResult
+        public func transfer(
+            to target: Target,
+            tx: UnsafeBufferPointer<UInt8>,
+            rx: UnsafeMutableBufferPointer<UInt8>
+        ) -> (status: Status, count: Int) {
+            let r = master.transfer(to: target, tx: tx, rx: rx)
+            if !r.status.isOK { emitError(target.address, r.status) }
+            return r
+        }
+
+        @discardableResult
+        public func send(to target: Target, _ bytes: [UInt8]) -> Status {
+            bytes.withUnsafeBufferPointer { tx in
+                transfer(to: target, tx: tx, rx: UnsafeMutableBufferPointer(start: nil, count: 0)).status
+            }
+        }
+
+        @discardableResult
+        public func readRegisters(
+            from target: Target,
+            register: UInt8,
+            into rx: UnsafeMutableBufferPointer<UInt8>
+        ) -> (status: Status, count: Int) {
+            let r = master.readRegisters(from: target, register: register, into: rx)
+            if !r.status.isOK { emitError(target.address, r.status) }
+            return r
+        }
+
+        /// Forget cached mux channels (after a mux reset / power cycle).
+        public func invalidateMuxes() {
+            arduino_i2c_mux_invalidate()
+        }
+
+        /// Select writes sent vs. answered from the channel cache.
+        public var muxSelects: (written: UInt32, skipped: UInt32) {
+            var skipped: UInt32 = 0
+            let written = arduino_i2c_mux_stats(&skipped)
+            return (written, skipped)
+        }
+
         public func writeRead(
             to address: UInt8,
             write: [UInt8],
@@ -411,13 +777,384 @@ public enum I2C {
             MasterTxRxDevice(bus: self, address: address, payload: payload, everyMs: everyMs, readCount: readCount)
         }
 
-        fileprivate func _sendRaw(to address: UInt8, bytes: [UInt8], stop: Bool?) -> Status {
+        fileprivate func _sendRaw(to address: UInt8, bytes: UnsafeBufferPointer<UInt8>, stop: Bool?) -> Status {
             master.write(to: address, bytes: bytes, sendStop: stop)
         }
 
         fileprivate func _requestRaw(from address: UInt8, count: Int, stop: Bool?) -> Packet {
             master.read(from: address, count: count, sendStop: stop)
         }
+
+        public func scheduler(slotMs: UInt32 = 2) -> Scheduler {
+            Scheduler(transport: self, slotMs: slotMs)
+        }
+
+        // ----------------------
+        // SchedulerTransport
+        // ----------------------
+
+        public func scheduledRead(
+            from target: Target,
+            register: UInt8,
+            into rx: UnsafeMutableBufferPointer<UInt8>
+        ) -> (status: Status, count: Int) {
+            master.readRegisters(from: target, register: register, into: rx)
+        }
+
+        public func scheduledError(_ address: UInt8, _ status: Status) {
+            emitError(address, status)
+        }
+
+        @inline(__always)
+        public func nowMs() -> UInt32 { arduino_millis() }
+
+        @inline(__always)
+        public func nowUs() -> UInt32 { UInt32(truncatingIfNeeded: arduino_micros()) }
+    }
+
+    // ------------------------------------------------------------
+    // MARK: - Scheduler (bus-level periodic reads + register shadow cache)
+    // ------------------------------------------------------------
+    /// What a Scheduler needs from the bus: one register-block read, an error
+    /// sink and the clocks it schedules and times bursts with.
+    public protocol SchedulerTransport: AnyObject {
+        func scheduledRead(
+            from target: Target,
+            register: UInt8,
+            into rx: UnsafeMutableBufferPointer<UInt8>
+        ) -> (status: Status, count: Int)
+        func scheduledError(_ address: UInt8, _ status: Status)
+        func nowMs() -> UInt32
+        func nowUs() -> UInt32
+    }
+
+    /// Owns the periodic register reads of every device on a bus:
+    /// - each read gets a phase in one of `phaseSlots` time slots (least loaded
+    ///   first), so reads with the same period do not all fire on the same tick
+    /// - reads of one device that are due together and adjacent (or within
+    ///   `coalesceGap` registers) go out as one register-block burst
+    /// - results land in a per-device register shadow; a read is stale once it
+    ///   has not been refreshed for `staleAfterMs` (default 2 x period)
+    /// - per-device latency / error statistics
+    /// - devices behind mux channels (Target) are read channel by channel, so a
+    ///   polling round selects each channel once (cached selects cost nothing)
+    /// At most `maxBurstsPerTick` transfers per tick.
+    ///
+    /// Ordering and coalescing only see a `SchedulerTransport`: `Bus` is the
+    /// real one, host tests drive the same code with a fake Wire and clock.
+    public final class Scheduler: ArduinoTickable {
+
+        public struct Stats: Sendable {
+            public var transfers: UInt32 = 0
+            public var errors: UInt32 = 0
+            public var lastStatus: Status = .ok
+            public var lastLatencyUs: UInt32 = 0
+            /// Moving average (1/8 weight per transfer).
+            public var avgLatencyUs: UInt32 = 0
+            public var maxLatencyUs: UInt32 = 0
+        }
+
+        public struct Read: Equatable, Sendable {
+            public let index: Int
+        }
+
+        /// Bytes per burst (Wire buffer size on the smallest supported core).
+        public static let maxBurst: Int = 32
+
+        public var enabled: Bool = true
+        public var maxBurstsPerTick: Int = 2
+
+        /// Registers of slack allowed between two reads merged into one burst.
+        public var coalesceGap: Int = 0
+
+        /// Called after every burst: (address, status, latency us).
+        public var onTransfer: ((UInt8, Status, UInt32) -> Void)?
+
+        public let slotMs: UInt32
+        public let phaseSlots: Int
+
+        // ----------------------
+        // State
+        // ----------------------
+
+        private struct Device {
+            let target: Target
+            var shadow: [UInt8]
+            var stats = Stats()
+        }
+
+        private struct Entry {
+            let device: Int
+            let start: Int
+            let count: Int
+            var everyMs: UInt32
+            var staleAfterMs: UInt32
+            var nextMs: UInt32
+            var lastMs: UInt32 = 0
+            var valid: Bool = false
+            var onUpdate: ((UnsafeBufferPointer<UInt8>) -> Void)?
+        }
+
+        private let transport: SchedulerTransport
+        private var devices: [Device] = []
+        private var entries: [Entry] = []
+        private var slotLoad: [Int]
+        private var due: [Int] = []        // scratch, reused every tick
+
+        public init(transport: SchedulerTransport, slotMs: UInt32 = 2, phaseSlots: Int = 16) {
+            self.transport = transport
+            self.slotMs = slotMs > 0 ? slotMs : 1
+            self.phaseSlots = phaseSlots > 0 ? phaseSlots : 1
+            self.slotLoad = [Int](repeating: 0, count: self.phaseSlots)
+        }
+
+        public convenience init(bus: Bus, slotMs: UInt32 = 2, phaseSlots: Int = 16) {
+            self.init(transport: bus, slotMs: slotMs, phaseSlots: phaseSlots)
+        }
+
+        // ----------------------
+        // Setup
+        // ----------------------
+
+        /// Reads `count` registers from `start` every `everyMs`. Nil when the
+        /// range does not fit one burst or runs past register 0xFF.
+        @discardableResult
+        public func add(
+            address: UInt8,
+            register start: UInt8,
+            count: Int,
+            everyMs: UInt32,
+            staleAfterMs: UInt32? = nil,
+            onUpdate: ((UnsafeBufferPointer<UInt8>) -> Void)? = nil
+        ) -> Read? {
+            add(target: .direct(address), register: start, count: count,
+                everyMs: everyMs, staleAfterMs: staleAfterMs, onUpdate: onUpdate)
+        }
+
+        @discardableResult
+        public func add(
+            target: Target,
+            register start: UInt8,
+            count: Int,
+            everyMs: UInt32,
+            staleAfterMs: UInt32? = nil,
+            onUpdate: ((UnsafeBufferPointer<UInt8>) -> Void)? = nil
+        ) -> Read? {
+            let first = Int(start)
+            if count <= 0 || count > Self.maxBurst || first + count > 256 { return nil }
+
+            let d = deviceIndex(target, needing: first + count)
+
+            // Least-loaded phase slot; reads keep that phase from then on.
+            var slot = 0
+            var i = 1
+            while i < phaseSlots {
+                if slotLoad[i] < slotLoad[slot] { slot = i }
+                i += 1
+            }
+            slotLoad[slot] += 1
+
+            let period = everyMs > 0 ? everyMs : 1
+            entries.append(Entry(
+                device: d,
+                start: first,
+                count: count,
+                everyMs: period,
+                staleAfterMs: staleAfterMs ?? (period &* 2),
+                nextMs: transport.nowMs() &+ UInt32(slot) &* slotMs,
+                onUpdate: onUpdate
+            ))
+            due.reserveCapacity(entries.count)
+            return Read(index: entries.count - 1)
+        }
+
+        public func setPeriod(_ r: Read, everyMs: UInt32) {
+            guard r.index >= 0 && r.index < entries.count else { return }
+            entries[r.index].everyMs = everyMs > 0 ? everyMs : 1
+        }
+
+        // ----------------------
+        // Cache
+        // ----------------------
+
+        /// True until the read has succeeded once, and again after `staleAfterMs` without a refresh.
+        public func isStale(_ r: Read) -> Bool {
+            guard r.index >= 0 && r.index < entries.count else { return true }
+            let e = entries[r.index]
+            return !e.valid || (transport.nowMs() &- e.lastMs) > e.staleAfterMs
+        }
+
+        /// Borrowed view of the cached registers of `r`; nil when stale.
+        public func withValue<T>(_ r: Read, _ body: (UnsafeBufferPointer<UInt8>) -> T) -> T? {
+            if isStale(r) { return nil }
+            let e = entries[r.index]
+            return devices[e.device].shadow.withUnsafeBufferPointer { all in
+                body(UnsafeBufferPointer(rebasing: all[e.start..<(e.start + e.count)]))
+            }
+        }
+
+        /// One cached register; nil unless a fresh read covers it.
+        public func value(address: UInt8, register: UInt8) -> UInt8? {
+            value(target: .direct(address), register: register)
+        }
+
+        public func value(target: Target, register: UInt8) -> UInt8? {
+            let reg = Int(register)
+            let now = transport.nowMs()
+            var i = 0
+            while i < entries.count {
+                let e = entries[i]
+                if devices[e.device].target == target,
+                   reg >= e.start, reg < e.start + e.count,
+                   e.valid, (now &- e.lastMs) <= e.staleAfterMs {
+                    return devices[e.device].shadow[reg]
+                }
+                i += 1
+            }
+            return nil
+        }
+
+        public func stats(for address: UInt8) -> Stats? {
+            stats(for: .direct(address))
+        }
+
+        public func stats(for target: Target) -> Stats? {
+            var i = 0
+            while i < devices.count {
+                if devices[i].target == target { return devices[i].stats }
+                i += 1
+            }
+            return nil
+        }
+
+        // ----------------------
+        // ArduinoTickable
+        // ----------------------
+
+        public func tick() {
+            guard enabled, !entries.isEmpty else { return }
+            let now = transport.nowMs()
+
+            // Due reads, sorted by (mux, channel, device, start register):
+            // insertion sort, no allocation.
+            due.removeAll(keepingCapacity: true)
+            var i = 0
+            while i < entries.count {
+                if reached(entries[i].nextMs, now) {
+                    let e = entries[i]
+                    var j = due.count
+                    due.append(i)
+                    while j > 0 {
+                        let p = entries[due[j - 1]]
+                        if p.device == e.device {
+                            if p.start <= e.start { break }
+                        } else if devices[p.device].target.precedes(devices[e.device].target) {
+                            break
+                        }
+                        due[j] = due[j - 1]
+                        j -= 1
+                    }
+                    due[j] = i
+                }
+                i += 1
+            }
+
+            // Merge runs of adjacent ranges on the same device into bursts.
+            var bursts = 0
+            var k = 0
+            while k < due.count && bursts < maxBurstsPerTick {
+                let first = entries[due[k]]
+                let lo = first.start
+                var hi = first.start + first.count
+                var end = k + 1
+                while end < due.count {
+                    let n = entries[due[end]]
+                    if n.device != first.device || n.start > hi + coalesceGap { break }
+                    let nh = Swift.max(hi, n.start + n.count)
+                    if nh - lo > Self.maxBurst { break }
+                    hi = nh
+                    end += 1
+                }
+
+                burst(device: first.device, lo: lo, hi: hi, members: k..<end, now: now)
+                bursts += 1
+                k = end
+            }
+        }
+
+        // ----------------------
+        // Internals
+        // ----------------------
+
+        private func burst(device d: Int, lo: Int, hi: Int, members: Range<Int>, now: UInt32) {
+            let target = devices[d].target
+            let address = target.address
+
+            let t0 = transport.nowUs()
+            let r = devices[d].shadow.withUnsafeMutableBufferPointer { all in
+                transport.scheduledRead(
+                    from: target,
+                    register: UInt8(truncatingIfNeeded: lo),
+                    into: UnsafeMutableBufferPointer(rebasing: all[lo..<hi])
+                )
+            }
+            let us = UInt32(truncatingIfNeeded: transport.nowUs() &- t0)
+            let ok = r.status.isOK && r.count == hi - lo
+
+            var st = devices[d].stats
+            st.transfers &+= 1
+            st.lastStatus = ok ? .ok : (r.status.isOK ? .otherError : r.status)
+            st.lastLatencyUs = us
+            st.avgLatencyUs = st.transfers == 1 ? us : st.avgLatencyUs &- (st.avgLatencyUs >> 3) &+ (us >> 3)
+            if us > st.maxLatencyUs { st.maxLatencyUs = us }
+            if !ok { st.errors &+= 1 }
+            devices[d].stats = st
+
+            onTransfer?(address, st.lastStatus, us)
+            if !ok { transport.scheduledError(address, st.lastStatus) }
+
+            var m = members.lowerBound
+            while m < members.upperBound {
+                let idx = due[m]
+                // Keep the phase; skip periods missed while the loop was busy.
+                var next = entries[idx].nextMs &+ entries[idx].everyMs
+                if reached(next, now) { next = now &+ entries[idx].everyMs }
+                entries[idx].nextMs = next
+
+                if ok {
+                    entries[idx].lastMs = now
+                    entries[idx].valid = true
+                    if let cb = entries[idx].onUpdate {
+                        let e = entries[idx]
+                        devices[d].shadow.withUnsafeBufferPointer { all in
+                            cb(UnsafeBufferPointer(rebasing: all[e.start..<(e.start + e.count)]))
+                        }
+                    }
+                }
+                m += 1
+            }
+        }
+
+        private func deviceIndex(_ target: Target, needing size: Int) -> Int {
+            var i = 0
+            while i < devices.count {
+                if devices[i].target == target {
+                    if devices[i].shadow.count < size {
+                        devices[i].shadow.append(contentsOf: [UInt8](repeating: 0, count: size - devices[i].shadow.count))
+                    }
+                    return i
+                }
+                i += 1
+            }
+            devices.append(Device(target: target, shadow: [UInt8](repeating: 0, count: size)))
+            return devices.count - 1
+        }
+
+        @inline(__always)
+        private func reached(_ deadline: UInt32, _ now: UInt32) -> Bool {
+            // Wrap-safe: deadlines are < 2^31 ms ahead.
+            Int32(bitPattern: now &- deadline) >= 0
+        }
     }
 
     // ------------------------------------------------------------
@@ -495,10 +1232,10 @@ public enum I2C {
             if (now &- lastMs) < everyMs { return }
             lastMs = now
 
-            let st = bus._sendRaw(to: address, bytes: payload.bytes, stop: stopAfterWrite)
+            let st = payload.withUnsafeBytes { bus._sendRaw(to: address, bytes: $0, stop: stopAfterWrite) }
             if !st.isOK { bus.emitError(address, st) }
 
-            var pkt = Packet([])
+            var pkt = Packet()
             if readCount > 0, st.isOK {
                 pkt = bus._requestRaw(from: address, count: readCount, stop: stopAfterRead)
                 bus.emitReceive(address, pkt)
@@ -508,6 +1245,188 @@ public enum I2C {
         }
     }
 
+    // ------------------------------------------------------------
+    // MARK: - Queue (non-blocking master transactions, ArduinoTickable)
+    // ------------------------------------------------------------
+    /// Fixed-size FIFO of master transactions run by the board's interrupt /
+    /// DMA backend (I2CQueue.h), or one per tick on blocking Wire where the
+    /// board has none. Results come back through a completion closure, or can
+    /// be polled with state(of:) / result(of:).
+    /// Do not mix with blocking Master / Bus calls while transactions are pending.
+    public final class Queue: ArduinoTickable {
+
+        /// `rx` is borrowed: valid only inside the closure.
+        public typealias Completion = (Status, UnsafeBufferPointer<UInt8>) -> Void
+
+        public struct Handle: Equatable, Sendable {
+            public let id: UInt32
+        }
+
+        public enum State {
+            case queued, running, done, unknown
+        }
+
+        /// True when the board runs transactions without blocking the loop.
+        public static var isAsync: Bool { arduino_i2cq_is_async() != 0 }
+
+        /// Bytes a transaction can read without a caller buffer (I2CQueue.h).
+        public static let inlineCapacity: Int = 32
+
+        public var onError: ((UInt8, Status) -> Void)?
+
+        /// Max completions handed out per tick.
+        public var maxCompletionsPerTick: Int = 8
+
+        public var pending: Int { Int(arduino_i2cq_pending()) }
+
+        private let slots: Int
+        private var completions: [Completion?]
+        private var addresses: [UInt8]
+        private var results: [(id: UInt32, status: Status, count: Int)]
+
+        public init(clockHz: UInt32 = 100_000) {
+            var m = Master(clockHz: clockHz)
+            m.beginIfNeeded()
+
+            slots = Int(arduino_i2cq_slots())
+            completions = [Completion?](repeating: nil, count: slots)
+            addresses = [UInt8](repeating: 0, count: slots)
+            results = [(id: UInt32, status: Status, count: Int)](
+                repeating: (UInt32.max, .otherError, 0), count: slots)
+        }
+
+        // ----------------------
+        // Submit
+        // ----------------------
+
+        /// Write `write` (copied if <= inlineCapacity, else borrowed until
+        /// completion), then read `readCount` (<= inlineCapacity) bytes after a
+        /// repeated start. Nil when the queue is full.
+        @discardableResult
+        public func submit(
+            to address: UInt8,
+            write: UnsafeBufferPointer<UInt8>,
+            readCount: Int = 0,
+            completion: Completion? = nil
+        ) -> Handle? {
+            let n = readCount > 0 ? readCount : 0
+            if n > Self.inlineCapacity { return nil }
+            let id = arduino_i2cq_submit(address, write.baseAddress, UInt32(write.count), nil, UInt32(n), 0)
+            return accept(id, address, completion)
+        }
+
+        /// Short writes only (copied); for longer ones keep the buffer alive and use the pointer form.
+        @discardableResult
+        public func submit(
+            to address: UInt8,
+            write: [UInt8],
+            readCount: Int = 0,
+            completion: Completion? = nil
+        ) -> Handle? {
+            if write.count > Self.inlineCapacity { return nil }
+            return write.withUnsafeBufferPointer { submit(to: address, write: $0, readCount: readCount, completion: completion) }
+        }
+
+        /// Caller-owned buffers (e.g. a display frame, a large register block):
+        /// both must stay valid until the completion runs.
+        @discardableResult
+        public func submit(
+            to address: UInt8,
+            write: UnsafeBufferPointer<UInt8>,
+            into rx: UnsafeMutableBufferPointer<UInt8>,
+            repeatedStart: Bool = true,
+            completion: Completion? = nil
+        ) -> Handle? {
+            let flags: UInt32 = repeatedStart ? 0 : Master.xferStopBetween
+            let id = arduino_i2cq_submit(
+                address,
+                write.baseAddress, UInt32(write.count),
+                rx.baseAddress, UInt32(rx.count),
+                flags
+            )
+            return accept(id, address, completion)
+        }
+
+        /// Register-block read: write `register`, repeated start, read `count` (<= inlineCapacity).
+        @discardableResult
+        public func readRegisters(
+            from address: UInt8,
+            register: UInt8,
+            count: Int,
+            completion: @escaping Completion
+        ) -> Handle? {
+            var reg = register
+            return withUnsafePointer(to: &reg) { p in
+                submit(to: address, write: UnsafeBufferPointer(start: p, count: 1),
+                       readCount: count, completion: completion)
+            }
+        }
+
+        // ----------------------
+        // Polled status
+        // ----------------------
+
+        public func state(of h: Handle) -> State {
+            switch arduino_i2cq_state(h.id) {
+            case 1: return .queued
+            case 2: return .running
+            case 3: return .done
+            default: return .unknown
+            }
+        }
+
+        /// Status and bytes read of a finished transaction, until its slot is reused.
+        public func result(of h: Handle) -> (status: Status, count: Int)? {
+            let r = results[slot(h.id)]
+            return r.id == h.id ? (r.status, r.count) : nil
+        }
+
+        // ----------------------
+        // ArduinoTickable
+        // ----------------------
+
+        public func tick() {
+            _ = arduino_i2cq_pump()
+
+            var n = 0
+            var id: UInt32 = 0
+            var raw: Int32 = 0
+            var rx: UnsafePointer<UInt8>? = nil
+            while n < maxCompletionsPerTick, arduino_i2cq_peek_done(&id, &raw, &rx) != 0 {
+                let i = slot(id)
+                let status = raw < 0 ? Status(rawValue: UInt8(truncatingIfNeeded: -raw)) : Status.ok
+                let count = raw > 0 ? Int(raw) : 0
+
+                results[i] = (id, status, count)
+                if !status.isOK { onError?(addresses[i], status) }
+
+                if let done = completions[i] {
+                    completions[i] = nil
+                    done(status, UnsafeBufferPointer(start: rx, count: rx == nil ? 0 : count))
+                }
+                arduino_i2cq_release_done()
+                n += 1
+            }
+        }
+
+        // ----------------------
+        // Internals
+        // ----------------------
+
+        @inline(__always)
+        private func slot(_ id: UInt32) -> Int {
+            Int(id & UInt32(slots - 1))
+        }
+
+        private func accept(_ id: Int32, _ address: UInt8, _ completion: Completion?) -> Handle? {
+            if id < 0 { return nil }
+            let i = slot(UInt32(id))
+            completions[i] = completion
+            addresses[i] = address
+            return Handle(id: UInt32(id))
+        }
+    }
+
     // ------------------------------------------------------------
     // MARK: - Slave (low-level, driven by shim flags)
     // ------------------------------------------------------------
@@ -517,18 +1436,22 @@ public enum I2C {
 
         private var didBegin: Bool = false
 
-        // Scratch buffer for draining RX ring from shim
-        private var rxScratch: [UInt8] = Array(repeating: 0, count: 64)
-
-        // TX payload storage must stay alive until shim snapshots it in ISR
-        private var txPayload: [UInt8] = []
+        /// Called once per master write with a borrowed view of its bytes
+        /// (valid only inside the callback, no copy). Takes precedence over onReceive.
+        public var onFrame: ((UnsafeBufferPointer<UInt8>) -> Void)?
 
-        /// Called when master writes to this slave.
+        /// Called once per master write with a copy of its bytes.
         public var onReceive: ((Packet) -> Void)?
 
-        /// Called when master requests data. Return payload to send.
+        /// Max frames delivered per tick; the rest wait for the next one.
+        public var maxFramesPerTick: Int = 16
+
+        /// Called after the master read; the returned payload answers the next request.
         public var onRequest: (() -> Packet)?
 
+        /// Bytes the shim dropped because its RX ring was full.
+        public var rxOverflows: UInt32 { arduino_i2c_slave_rx_overflows() }
+
         public init(address: UInt8) {
             self.address = address
         }
@@ -542,8 +1465,14 @@ public enum I2C {
         public func tick() {
             if !didBegin { begin() }
 
-            if arduino_i2c_slave_consume_onReceive() != 0 {
-                drainReceiveAndCallback()
+            // Frames are the source of truth; the flag only needs clearing.
+            _ = arduino_i2c_slave_consume_onReceive()
+            if let handler = onFrame {
+                drainFrames(max: maxFramesPerTick, handler)
+            } else if let handler = onReceive {
+                drainFrames(max: maxFramesPerTick) { frame in
+                    handler(Packet(frame))
+                }
             }
 
             if arduino_i2c_slave_consume_onRequest() != 0 {
@@ -551,49 +1480,61 @@ public enum I2C {
             }
         }
 
-        private func drainReceiveAndCallback() {
-            let avail = Int(arduino_i2c_slave_rx_available())
-            if avail <= 0 {
-                onReceive?(Packet([]))
-                return
+        /// Hands up to `max` received frames to `body`, oldest first, each
+        /// released once `body` returns. Returns how many.
+        @discardableResult
+        public func drainFrames(max: Int = Int.max, _ body: (UnsafeBufferPointer<UInt8>) -> Void) -> Int {
+            var n = 0
+            var len: UInt32 = 0
+            while n < max, let p = arduino_i2c_slave_rx_frame_peek(&len) {
+                body(UnsafeBufferPointer(start: p, count: Int(len)))
+                arduino_i2c_slave_rx_frame_release()
+                n += 1
             }
+            return n
+        }
 
-            var all: [UInt8] = []
-            all.reserveCapacity(avail)
+        // ----------------------
+        // TX (double-buffered: the ISR sends the front buffer, these fill the back one)
+        // ----------------------
 
-            while true {
-                let a = Int(arduino_i2c_slave_rx_available())
-                if a <= 0 { break }
+        /// Copies `bytes` into the back buffer and swaps it to the front.
+        public func setResponse(_ bytes: UnsafeBufferPointer<UInt8>) {
+            arduino_i2c_slave_set_tx(bytes.baseAddress, UInt32(bytes.count))
+        }
 
-                let chunk = min(a, rxScratch.count)
-                let got: UInt32 = rxScratch.withUnsafeMutableBufferPointer { buf in
-                    arduino_i2c_slave_rx_read_buf(buf.baseAddress, UInt32(chunk))
-                }
-                if got == 0 { break }
+        public func setResponse(_ bytes: [UInt8]) {
+            bytes.withUnsafeBufferPointer { setResponse($0) }
+        }
 
-                all.append(contentsOf: rxScratch[0..<Int(got)])
-            }
+        /// Zero-copy: `fill` writes the back buffer in place and returns the length.
+        public func updateResponse(_ fill: (UnsafeMutableBufferPointer<UInt8>) -> Int) {
+            var cap: UInt32 = 0
+            guard let p = arduino_i2c_slave_tx_back(&cap) else { return }
 
-            onReceive?(Packet(all))
+            var n = fill(UnsafeMutableBufferPointer(start: p, count: Int(cap)))
+            if n < 0 { n = 0 }
+            if n > Int(cap) { n = Int(cap) }
+            arduino_i2c_slave_tx_publish(UInt32(n))
         }
 
-        private func prepareTxFromCallback() {
-            guard let mk = onRequest else {
-                arduino_i2c_slave_set_tx(nil, 0)
-                return
+        /// Register-style reads answered in the ISR: a request right after a
+        /// write starting with `register` returns `bytes` (up to 16 by default).
+        /// Empty `bytes` removes it. False when the table is full or too long.
+        @discardableResult
+        public func setRegister(_ register: UInt8, _ bytes: [UInt8]) -> Bool {
+            bytes.withUnsafeBufferPointer { buf in
+                arduino_i2c_slave_set_reg_tx(register, buf.baseAddress, UInt32(buf.count)) != 0
             }
+        }
 
-            let packet = mk()
-            txPayload = packet.bytes
-
-            if txPayload.isEmpty {
-                arduino_i2c_slave_set_tx(nil, 0)
-                return
-            }
+        public func clearRegisters() {
+            arduino_i2c_slave_clear_reg_tx()
+        }
 
-            txPayload.withUnsafeBufferPointer { buf in
-                arduino_i2c_slave_set_tx(buf.baseAddress, UInt32(buf.count))
-            }
+        private func prepareTxFromCallback() {
+            guard let mk = onRequest else { return }
+            mk().withUnsafeBytes { setResponse($0) }
         }
     }
 
@@ -611,6 +1552,11 @@ public enum I2C {
             set { slave.onReceive = newValue }
         }
 
+        public var onFrame: ((UnsafeBufferPointer<UInt8>) -> Void)? {
+            get { slave.onFrame }
+            set { slave.onFrame = newValue }
+        }
+
         public var onRequest: (() -> Packet)? {
             get { slave.onRequest }
             set { slave.onRequest = newValue }
@@ -623,6 +1569,13 @@ public enum I2C {
         public func begin() { slave.begin() }
         public func tick() { slave.tick() }
 
+        public func setResponse(_ bytes: [UInt8]) { slave.setResponse(bytes) }
+
+        @discardableResult
+        public func setRegister(_ register: UInt8, _ bytes: [UInt8]) -> Bool {
+            slave.setRegister(register, bytes)
+        }
+
         // Typed helpers for responding to master requests
         public func respondBytes(_ bytes: [UInt8]) {
             slave.onRequest = { Packet(bytes) }
@@ -664,5 +1617,5 @@ public enum I2C {
 /// Build an I2C.Packet from ASCII bytes using Packet's unlabeled initializer.
 @inline(__always)
 public func asciiPacket(_ s: StaticString) -> I2C.Packet {
-    I2C.Packet(asciiBytes(s))
+    s.withUTF8Buffer { I2C.Packet($0) }
 }
@@ -0,0 +1,281 @@
+// HTTPParser.swift
+// Incremental, zero-copy HTTP/1.x request-head parser (Embedded Swift friendly).
+//
+// Rules:
+// - Works in place on the connection's receive buffer: results are index ranges
+//   (method, path, query, header names / values) into that buffer, never copies.
+// - Incremental: parse() resumes at the first byte it has not looked at yet, so a
+//   head arriving in pieces is scanned once in total.
+// - Header spans live in an array reserved once (`maxHeaders`); after that a
+//   request allocates nothing. Headers past `maxHeaders` are still checked for
+//   Content-Length / Connection, just not recorded.
+// - CRLF or bare LF line endings; blank lines before the request line are skipped.
+// - Content-Length headers that disagree make the head invalid. Transfer-Encoding
+//   is only recorded (`transferEncoding`): the server reads no chunked bodies and
+//   must not treat the chunk bytes as a pipelined request.
+//
+// Usage (one receive buffer per connection):
+//   var p = HTTPParser()
+//   // after each read:
+//   switch buf.withUnsafeBufferPointer({ p.parse(UnsafeBufferPointer(rebasing: $0[0..<len])) }) {
+//   case .needMore: break                 // read more
+//   case .invalid:  close()
+//   case .complete: // body = buf[p.headerEnd ..< p.headerEnd + p.contentLength]
+//   }
+//   p.reset()                              // before the next (pipelined) request
+
+public struct HTTPHeaderSpan: Sendable {
+    public let name: Range<Int>
+    public let value: Range<Int>
+}
+
+public struct HTTPParser {
+
+    public enum Status: Sendable {
+        case needMore       // head not complete yet
+        case complete       // head parsed (the body may still be arriving)
+        case invalid
+    }
+
+    public let maxHeaders: Int
+
+    public private(set) var status: Status = .needMore
+
+    /// Nil for a method the server does not handle (methodRange still holds it).
+    public private(set) var method: HTTPMethod? = nil
+    public private(set) var methodRange: Range<Int> = 0..<0
+
+    /// Request target up to '?', and what follows it.
+    public private(set) var path: Range<Int> = 0..<0
+    public private(set) var query: Range<Int>? = nil
+
+    public private(set) var headers: [HTTPHeaderSpan] = []
+
+    /// Index just past the blank line: where the body starts.
+    public private(set) var headerEnd: Int = 0
+    public private(set) var contentLength: Int = 0
+
+    /// A Transfer-Encoding header was present (any value).
+    public private(set) var transferEncoding: Bool = false
+
+    /// HTTP/1.1 unless "Connection: close"; HTTP/1.0 only with "Connection: keep-alive".
+    public private(set) var keepAlive: Bool = false
+
+    /// False for HTTP/1.0 (no chunked responses).
+    public private(set) var isHTTP11: Bool = false
+
+    private var scan: Int = 0
+    private var lineStart: Int = 0
+    private var sawRequestLine: Bool = false
+    private var sawContentLength: Bool = false
+
+    public init(maxHeaders: Int = 16) {
+        self.maxHeaders = maxHeaders
+        headers.reserveCapacity(maxHeaders)
+    }
+
+    public mutating func reset() {
+        status = .needMore
+        method = nil
+        methodRange = 0..<0
+        path = 0..<0
+        query = nil
+        headers.removeAll(keepingCapacity: true)
+        headerEnd = 0
+        contentLength = 0
+        transferEncoding = false
+        keepAlive = false
+        isHTTP11 = false
+        scan = 0
+        lineStart = 0
+        sawRequestLine = false
+        sawContentLength = false
+    }
+
+    /// `buf` is everything received for this request so far (the same buffer,
+    /// only ever longer, between resets).
+    @discardableResult
+    public mutating func parse(_ buf: UnsafeBufferPointer<U8>) -> Status {
+        if status != .needMore { return status }
+
+        var i = scan
+        while i < buf.count {
+            if buf[i] != 0x0A {
+                i += 1
+                continue
+            }
+
+            let start = lineStart
+            var end = i
+            if end > start && buf[end - 1] == 0x0D { end -= 1 }
+            i += 1
+            lineStart = i
+
+            if !sawRequestLine {
+                if end == start { continue }
+                if !requestLine(buf, start, end) {
+                    status = .invalid
+                    break
+                }
+                sawRequestLine = true
+            } else if end == start {
+                headerEnd = i
+                status = .complete
+                break
+            } else if !headerLine(buf, start, end) {
+                status = .invalid
+                break
+            }
+        }
+
+        scan = i
+        return status
+    }
+
+    // ----------------------
+    // Lines
+    // ----------------------
+
+    private mutating func requestLine(_ b: UnsafeBufferPointer<U8>, _ start: Int, _ end: Int) -> Bool {
+        guard let sp1 = httpFind(b, 0x20, start, end), sp1 > start else { return false }
+        let target = sp1 + 1
+        guard let sp2 = httpFind(b, 0x20, target, end), sp2 > target else { return false }
+
+        methodRange = start..<sp1
+        method = httpMethod(b, methodRange)
+
+        if let q = httpFind(b, 0x3F, target, sp2) {
+            path = target..<q
+            query = (q + 1)..<sp2
+        } else {
+            path = target..<sp2
+        }
+
+        let version = (sp2 + 1)..<end
+        if httpEqual(b, version, "HTTP/1.1") {
+            keepAlive = true
+            isHTTP11 = true
+        } else if httpEqual(b, version, "HTTP/1.0") {
+            keepAlive = false
+        } else {
+            return false
+        }
+        return true
+    }
+
+    private mutating func headerLine(_ b: UnsafeBufferPointer<U8>, _ start: Int, _ end: Int) -> Bool {
+        // Lines without a colon are ignored, like before.
+        guard let colon = httpFind(b, 0x3A, start, end) else { return true }
+
+        var nameEnd = colon
+        while nameEnd > start && httpIsSpace(b[nameEnd - 1]) { nameEnd -= 1 }
+        var valueStart = colon + 1
+        while valueStart < end && httpIsSpace(b[valueStart]) { valueStart += 1 }
+        var valueEnd = end
+        while valueEnd > valueStart && httpIsSpace(b[valueEnd - 1]) { valueEnd -= 1 }
+
+        let name = start..<nameEnd
+        let value = valueStart..<valueEnd
+
+        if httpEqualIgnoringCase(b, name, "Content-Length") {
+            guard let n = httpParseDecimal(b, value) else { return false }
+            if sawContentLength && n != contentLength { return false }
+            contentLength = n
+            sawContentLength = true
+        } else if httpEqualIgnoringCase(b, name, "Transfer-Encoding") {
+            transferEncoding = true
+        } else if httpEqualIgnoringCase(b, name, "Connection") {
+            if httpEqualIgnoringCase(b, value, "close") { keepAlive = false }
+            else if httpEqualIgnoringCase(b, value, "keep-alive") { keepAlive = true }
+        }
+
+        if headers.count < maxHeaders {
+            headers.append(HTTPHeaderSpan(name: name, value: value))
+        }
+        return true
+    }
+}
+
+// ============================================================
+// Byte-range helpers (shared with http_server.swift)
+// ============================================================
+
+@inline(__always)
+func httpMethod(_ b: UnsafeBufferPointer<U8>, _ r: Range<Int>) -> HTTPMethod? {
+    switch r.count {
+    case 3:
+        if httpEqual(b, r, "GET") { return .get }
+        if httpEqual(b, r, "PUT") { return .put }
+    case 4:
+        if httpEqual(b, r, "POST") { return .post }
+        if httpEqual(b, r, "HEAD") { return .head }
+    case 5:
+        if httpEqual(b, r, "PATCH") { return .patch }
+    case 6:
+        if httpEqual(b, r, "DELETE") { return .delete }
+    case 7:
+        if httpEqual(b, r, "OPTIONS") { return .options }
+    default:
+        break
+    }
+    return nil
+}
+
+@inline(__always)
+func httpIsSpace(_ c: U8) -> Bool {
+    c == 0x20 || c == 0x09
+}
+
+@inline(__always)
+func httpFind(_ b: UnsafeBufferPointer<U8>, _ c: U8, _ start: Int, _ end: Int) -> Int? {
+    var i = start
+    while i < end {
+        if b[i] == c { return i }
+        i += 1
+    }
+    return nil
+}
+
+@inline(__always)
+func httpEqual(_ b: UnsafeBufferPointer<U8>, _ r: Range<Int>, _ s: StaticString) -> Bool {
+    if r.count != s.utf8CodeUnitCount { return false }
+    let p = s.utf8Start
+    var i = 0
+    while i < r.count {
+        if b[r.lowerBound + i] != p[i] { return false }
+        i += 1
+    }
+    return true
+}
+
+@inline(__always)
+func httpEqualIgnoringCase(_ b: UnsafeBufferPointer<U8>, _ r: Range<Int>, _ s: StaticString) -> Bool {
+    if r.count != s.utf8CodeUnitCount { return false }
+    let p = s.utf8Start
+    var i = 0
+    while i < r.count {
+        if httpLower(b[r.lowerBound + i]) != httpLower(p[i]) { return false }
+        i += 1
+    }
+    return true
+}
+
+@inline(__always)
+func httpLower(_ c: U8) -> U8 {
+    (c >= 0x41 && c <= 0x5A) ? c &+ 0x20 : c
+}
+
+/// Digits only; saturates at Int32.max so an absurd length just reads as "too large".
+@inline(__always)
+func httpParseDecimal(_ b: UnsafeBufferPointer<U8>, _ r: Range<Int>) -> Int? {
+    if r.isEmpty { return nil }
+    var v = 0
+    var i = r.lowerBound
+    while i < r.upperBound {
+        let c = b[i]
+        if c < 0x30 || c > 0x39 { return nil }
+        v = v > 214_748_363 ? Int(Int32.max) : v * 10 + Int(c - 0x30)
+        i += 1
+    }
+    return v
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+// HTTPResponseWriter.swift
+// Buffered response writer over one connection slot (Embedded Swift friendly).
+//
+// Rules:
+// - One fixed TX buffer (allocated once by HTTPServer.start()). Status line,
+//   headers and body all go through it, so a response that fits is sent with a
+//   single slot write; larger ones go out in full-buffer writes (each one a
+//   single transaction to the WiFi co-processor).
+// - Chunked mode (Transfer-Encoding: chunked): every flushed buffer is one
+//   chunk. Six bytes are reserved in front of the chunk data for its hex size
+//   and two behind it for the CRLF, so framing never costs an extra copy or write.
+// - Fixed-length bodies: a write that finds the buffer empty sends whole
+//   buffers straight from the caller's bytes (flash assets are never copied).
+// - Producers (HTTPResponse.stream) get the writer and write as much as they
+//   like; a short slot write marks the writer `failed` and later writes are dropped.
+//
+// Usage (producer):
+//   .stream(contentType: "text/csv") { w in
+//       var f = FormatBuffer()
+//       f.append(row); f.append(",")
+//       f.append(readSensor(row)); f.append("\n")
+//       w.write(f)
+//       row += 1
+//       return row < rows                  // true = call me again
+//   }
+
+public final class HTTPResponseWriter {
+
+    /// Max chunk size that fits the 4 reserved hex digits.
+    private static let maxCapacity = 0xFFFF
+
+    public let capacity: Int
+
+    /// A slot write came up short (client gone); writes are dropped from then on.
+    public private(set) var failed: Bool = false
+
+    /// Bytes handed to the slot since begin().
+    public private(set) var sent: Int = 0
+
+    private var buf: [U8]
+    private var len: Int = 0
+    private var slot: U32 = 0
+    private var chunked: Bool = false
+    private var chunkStart: Int = -1     // reserved size field of the open chunk
+
+    init(capacity: Int) {
+        let cap = capacity < 64 ? 64 : (capacity > Self.maxCapacity ? Self.maxCapacity : capacity)
+        self.capacity = cap
+        self.buf = [U8](repeating: 0, count: cap)
+    }
+
+    /// Bytes that can be written before the next flush.
+    public var available: Int {
+        capacity - len - (chunkStart >= 0 ? 2 : 0)
+    }
+
+    // ----------------------
+    // Write
+    // ----------------------
+
+    public func write(_ bytes: UnsafeBufferPointer<U8>) {
+        guard let base = bytes.baseAddress else { return }
+        var off = 0
+        while off < bytes.count && !failed {
+            var room = available
+            if room <= 0 {
+                flush()
+                room = available
+                if room <= 0 { return }
+            }
+            // Nothing buffered and a whole buffer to go: send it from the
+            // caller's memory (e.g. a flash asset) instead of copying it in.
+            if len == 0 && !chunked && bytes.count - off >= capacity {
+                send(base + off, capacity)
+                off += capacity
+                continue
+            }
+            let n = min(room, bytes.count - off)
+            let at = len
+            buf.withUnsafeMutableBufferPointer { p in
+                (p.baseAddress! + at).update(from: base + off, count: n)
+            }
+            len += n
+            off += n
+        }
+    }
+
+    public func write(_ bytes: [U8]) {
+        bytes.withUnsafeBufferPointer { write($0) }
+    }
+
+    public func write(_ text: StaticString) {
+        write(UnsafeBufferPointer(start: text.utf8Start, count: text.utf8CodeUnitCount))
+    }
+
+    public func write(_ text: String) {
+        var t = text
+        t.withUTF8 { write($0) }
+    }
+
+    public func write(_ f: FormatBuffer) {
+        f.withUnsafeBytes { write($0) }
+    }
+
+    public func write(byte: U8) {
+        if available <= 0 { flush() }
+        if failed || available <= 0 { return }
+        buf[len] = byte
+        len += 1
+    }
+
+    /// Sends what is buffered now (in chunked mode, as one chunk).
+    public func flush() {
+        let reopen = chunkStart >= 0
+        closeChunk()
+        send()
+        if reopen { openChunk() }
+    }
+
+    // ----------------------
+    // Server side
+    // ----------------------
+
+    /// Starts writing to `slot`. `body` true resumes a chunked body (stream turns after the first).
+    func begin(slot: U32, chunked: Bool, body: Bool) {
+        self.slot = slot
+        self.chunked = chunked
+        len = 0
+        sent = 0
+        failed = false
+        chunkStart = -1
+        if body && chunked { openChunk() }
+    }
+
+    /// Status line + headers. `length` nil = chunked body (or no framing for HTTP/1.0).
+    func head(
+        status: I32,
+        contentType: [U8],
+        headers: [HTTPHeader],
+        keepAlive: Bool,
+        length: Int?
+    ) {
+        var f = FormatBuffer()
+        f.append("HTTP/1.1 ")
+        f.append(status)
+        f.append(" ")
+        write(f)
+        write(httpStatusReason(status))
+        write("\r\n")
+
+        if !contentType.isEmpty {
+            write("Content-Type: ")
+            write(contentType)
+            write("\r\n")
+        }
+
+        for h in headers {
+            write(h.name)
+            write(": ")
+            write(h.value)
+            write("\r\n")
+        }
+
+        write(keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n")
+
+        if let n = length {
+            f.removeAll()
+            f.append("Content-Length: ")
+            f.append(n)
+            f.append("\r\n")
+            write(f)
+        } else if chunked {
+            write("Transfer-Encoding: chunked\r\n")
+        }
+        write("\r\n")
+
+        if chunked { openChunk() }
+    }
+
+    /// Ends the response: last chunk + terminator in chunked mode, then sends the rest.
+    func end() {
+        if chunked {
+            closeChunk()
+            if capacity - len < 5 { send() }
+            write("0\r\n\r\n")
+            chunked = false
+        }
+        send()
+    }
+
+    // ----------------------
+    // Internals
+    // ----------------------
+
+    private func openChunk() {
+        if capacity - len < 6 + 2 + 1 { send() }
+        chunkStart = len
+        len += 6
+    }
+
+    /// Writes the size field and trailing CRLF of the open chunk (drops it when empty).
+    private func closeChunk() {
+        guard chunkStart >= 0 else { return }
+        let at = chunkStart
+        let n = len - at - 6
+        chunkStart = -1
+
+        if n <= 0 {
+            len = at
+            return
+        }
+
+        var shift = 12
+        var i = 0
+        while i < 4 {
+            let d = U8(truncatingIfNeeded: (n >> shift) & 0xF)
+            buf[at + i] = d < 10 ? 0x30 + d : 0x41 + d - 10
+            shift -= 4
+            i += 1
+        }
+        buf[at + 4] = 0x0D
+        buf[at + 5] = 0x0A
+        buf[len] = 0x0D
+        buf[len + 1] = 0x0A
+        len += 2
+    }
+
+    private func send() {
+        if len == 0 { return }
+        let n = len
+        buf.withUnsafeBufferPointer { p in send(p.baseAddress!, n) }
+        len = 0
+    }
+
+    private func send(_ p: UnsafePointer<U8>, _ n: Int) {
+        if failed { return }
+        let w = arduino_http_server_slot_write(slot, p, U32(n))
+        if Int(w) < n { failed = true }
+        sent += n
+    }
+}
\ No newline at end of file
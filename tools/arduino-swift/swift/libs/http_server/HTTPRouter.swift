@@ -0,0 +1,266 @@
+// HTTPRouter.swift
+// Route table compiled into a segment trie (Embedded Swift friendly).
+//
+// Rules:
+// - Patterns are '/'-separated segments: literal, `:name` (one segment, captured)
+//   or `*` (the rest of the path, captured as "*"; only as the last segment).
+// - compile() runs once (HTTPServer.start(), or the first request after a route
+//   was added); lookup() walks the trie one segment at a time and allocates
+//   nothing: literal children are found by FNV-1a hash (binary search) + byte
+//   compare, captures are index ranges into the request buffer.
+// - Precedence per segment: literal, then `:param`, then `*` (with backtracking).
+//   lookup() takes the method: a pattern that matches the path but lacks the
+//   method is skipped for the next candidate, so GET /users/me and
+//   DELETE /users/:id both answer "/users/me". HEAD falls back to GET.
+// - Empty segments are ignored ("/a//b/" matches "/a/b"). Two `:params` at the
+//   same place share the name registered first. The first route registered for
+//   a (pattern, method) wins.
+
+/// A captured path parameter: `name` indexes the router's name pool, `value`
+/// the request buffer.
+public struct HTTPParamSpan: Sendable {
+    public let name: Range<Int>
+    public let value: Range<Int>
+}
+
+struct HTTPRouter {
+
+    enum Match {
+        case route(Int)
+        /// Patterns match the path, none for the method. `methods`: all of
+        /// theirs (bit = 1 << rawValue); `explicit`: one is not a `*` catch-all.
+        case methodMissing(methods: U32, explicit: Bool)
+        case notFound
+    }
+
+    /// What the candidates rejected by method had registered.
+    private struct Seen {
+        var methods: U32 = 0
+        var explicit: Bool = false
+    }
+
+    private struct Edge {
+        let hash: U32
+        let segment: [U8]
+        let node: Int
+    }
+
+    private struct Endpoint {
+        let method: HTTPMethod
+        let route: Int
+    }
+
+    private struct Node {
+        var edges: [Edge] = []          // literal children, sorted by hash
+        var param: Int = -1             // child for `:name`
+        var wildcard: Int = -1          // child for `*`
+        var name: Range<Int> = 0..<0    // capture name (param / wildcard nodes)
+        var endpoints: [Endpoint] = []
+    }
+
+    private var nodes: [Node] = []
+
+    /// Capture names, referenced by HTTPParamSpan.name.
+    private(set) var names: [U8] = []
+
+    var isCompiled: Bool { !nodes.isEmpty }
+
+    mutating func invalidate() {
+        nodes.removeAll()
+        names.removeAll()
+    }
+
+    mutating func compile(_ routes: [HTTPServer.Route]) {
+        nodes = [Node()]
+        names = []
+
+        var ri = 0
+        while ri < routes.count {
+            let p = routes[ri].path
+            var n = 0
+            var i = 0
+            while i < p.count {
+                if p[i] == 0x2F {
+                    i += 1
+                    continue
+                }
+                var j = i
+                while j < p.count && p[j] != 0x2F { j += 1 }
+
+                if p[i] == 0x3A {
+                    if nodes[n].param < 0 {
+                        nodes[n].param = newNode(name: p, i + 1, j)
+                    }
+                    n = nodes[n].param
+                } else if p[i] == 0x2A && j == i + 1 {
+                    if nodes[n].wildcard < 0 {
+                        nodes[n].wildcard = newNode(name: p, i, j)
+                    }
+                    n = nodes[n].wildcard
+                    break
+                } else {
+                    n = literalChild(n, p, i, j)
+                }
+                i = j
+            }
+
+            let m = routes[ri].method
+            var k = 0
+            while k < nodes[n].endpoints.count && nodes[n].endpoints[k].method != m { k += 1 }
+            if k == nodes[n].endpoints.count {
+                nodes[n].endpoints.append(Endpoint(method: m, route: ri))
+            }
+            ri += 1
+        }
+    }
+
+    // ----------------------
+    // Lookup
+    // ----------------------
+
+    /// Route for `method` at `raw[path]`. Captures (ranges into `raw`) are
+    /// appended to `params` (up to its capacity), only for a `.route`.
+    func lookup(_ raw: UnsafeBufferPointer<U8>, _ path: Range<Int>, _ method: HTTPMethod, _ params: inout [HTTPParamSpan]) -> Match {
+        if nodes.isEmpty { return .notFound }
+        var seen = Seen()
+        if let r = match(0, raw, path.lowerBound, path.upperBound, method, &params, &seen) { return .route(r) }
+        return seen.methods == 0 ? .notFound : .methodMissing(methods: seen.methods, explicit: seen.explicit)
+    }
+
+    private func match(
+        _ n: Int, _ path: UnsafeBufferPointer<U8>, _ from: Int, _ end: Int, _ method: HTTPMethod,
+        _ params: inout [HTTPParamSpan], _ seen: inout Seen
+    ) -> Int? {
+        var i = from
+        while i < end && path[i] == 0x2F { i += 1 }
+
+        let w = nodes[n].wildcard
+
+        if i >= end {
+            if let r = endpoint(n, method, wildcard: false, &seen) { return r }
+            if w >= 0, let r = endpoint(w, method, wildcard: true, &seen) {
+                capture(&params, nodes[w].name, i..<i)
+                return r
+            }
+            return nil
+        }
+
+        var j = i
+        while j < end && path[j] != 0x2F { j += 1 }
+
+        if let e = findEdge(n, path, i, j), let r = match(e, path, j, end, method, &params, &seen) {
+            return r
+        }
+
+        let p = nodes[n].param
+        if p >= 0 {
+            let mark = params.count
+            capture(&params, nodes[p].name, i..<j)
+            if let r = match(p, path, j, end, method, &params, &seen) { return r }
+            params.removeLast(params.count - mark)
+        }
+
+        if w >= 0, let r = endpoint(w, method, wildcard: true, &seen) {
+            capture(&params, nodes[w].name, i..<end)
+            return r
+        }
+        return nil
+    }
+
+    /// Route registered at `node` for `method` (HEAD: else GET); otherwise
+    /// the node's methods go into `seen` and the caller backtracks.
+    private func endpoint(_ node: Int, _ method: HTTPMethod, wildcard: Bool, _ seen: inout Seen) -> Int? {
+        let endpoints = nodes[node].endpoints
+        if endpoints.isEmpty { return nil }
+
+        var get: Int? = nil
+        var mask: U32 = 0
+        for e in endpoints {
+            if e.method == method { return e.route }
+            if e.method == .get { get = e.route }
+            mask |= 1 << U32(e.method.rawValue)
+        }
+        if method == .head, let g = get { return g }
+
+        seen.methods |= mask
+        if !wildcard { seen.explicit = true }
+        return nil
+    }
+
+    @inline(__always)
+    private func capture(_ params: inout [HTTPParamSpan], _ name: Range<Int>, _ value: Range<Int>) {
+        if params.count < params.capacity {
+            params.append(HTTPParamSpan(name: name, value: value))
+        }
+    }
+
+    private func findEdge(_ n: Int, _ b: UnsafeBufferPointer<U8>, _ start: Int, _ end: Int) -> Int? {
+        let h = fnv1a(b, start, end)
+        let edges = nodes[n].edges
+
+        var lo = 0
+        var hi = edges.count
+        while lo < hi {
+            let mid = (lo + hi) / 2
+            if edges[mid].hash < h { lo = mid + 1 } else { hi = mid }
+        }
+        while lo < edges.count && edges[lo].hash == h {
+            if sameBytes(edges[lo].segment, b, start, end) { return edges[lo].node }
+            lo += 1
+        }
+        return nil
+    }
+
+    // ----------------------
+    // Compile helpers
+    // ----------------------
+
+    private mutating func newNode(name p: [U8], _ start: Int, _ end: Int) -> Int {
+        let at = names.count
+        names.append(contentsOf: p[start..<end])
+        var node = Node()
+        node.name = at..<names.count
+        nodes.append(node)
+        return nodes.count - 1
+    }
+
+    private mutating func literalChild(_ n: Int, _ p: [U8], _ start: Int, _ end: Int) -> Int {
+        let h = p.withUnsafeBufferPointer { fnv1a($0, start, end) }
+        let segment = Array(p[start..<end])
+
+        var k = 0
+        while k < nodes[n].edges.count && nodes[n].edges[k].hash < h { k += 1 }
+        var s = k
+        while s < nodes[n].edges.count && nodes[n].edges[s].hash == h {
+            if nodes[n].edges[s].segment == segment { return nodes[n].edges[s].node }
+            s += 1
+        }
+
+        nodes.append(Node())
+        let child = nodes.count - 1
+        nodes[n].edges.insert(Edge(hash: h, segment: segment, node: child), at: k)
+        return child
+    }
+}
+
+@inline(__always)
+private func fnv1a(_ b: UnsafeBufferPointer<U8>, _ start: Int, _ end: Int) -> U32 {
+    var h: U32 = 2166136261
+    var i = start
+    while i < end {
+        h = (h ^ U32(b[i])) &* 16777619
+        i += 1
+    }
+    return h
+}
+
+@inline(__always)
+private func sameBytes(_ a: [U8], _ b: UnsafeBufferPointer<U8>, _ start: Int, _ end: Int) -> Bool {
+    if a.count != end - start { return false }
+    var i = 0
+    while i < a.count {
+        if a[i] != b[start + i] { return false }
+        i += 1
+    }
+    return true
+}
\ No newline at end of file
@@ -6,20 +6,44 @@ public func arduino_http_server_begin(_ port: UInt16) -> I32
 @_silgen_name("arduino_http_server_end")
 public func arduino_http_server_end() -> Void
 
-@_silgen_name("arduino_http_server_client_available")
-public func arduino_http_server_client_available() -> I32
+@_silgen_name("arduino_http_server_slots")
+public func arduino_http_server_slots() -> U32
 
-@_silgen_name("arduino_http_server_client_connected")
-public func arduino_http_server_client_connected() -> I32
+@_silgen_name("arduino_http_server_accept")
+public func arduino_http_server_accept() -> I32
 
-@_silgen_name("arduino_http_server_client_available_bytes")
-public func arduino_http_server_client_available_bytes() -> I32
+@_silgen_name("arduino_http_server_slot_connected")
+public func arduino_http_server_slot_connected(_ slot: U32) -> I32
 
-@_silgen_name("arduino_http_server_client_read")
-public func arduino_http_server_client_read(_ out: UnsafeMutablePointer<U8>?, _ cap: U32) -> I32
+@_silgen_name("arduino_http_server_slot_available_bytes")
+public func arduino_http_server_slot_available_bytes(_ slot: U32) -> I32
 
-@_silgen_name("arduino_http_server_client_write")
-public func arduino_http_server_client_write(_ data: UnsafePointer<U8>?, _ len: U32) -> I32
+@_silgen_name("arduino_http_server_slot_read")
+public func arduino_http_server_slot_read(_ slot: U32, _ out: UnsafeMutablePointer<U8>?, _ cap: U32) -> I32
 
-@_silgen_name("arduino_http_server_client_stop")
-public func arduino_http_server_client_stop() -> Void
\ No newline at end of file
+@_silgen_name("arduino_http_server_slot_write")
+public func arduino_http_server_slot_write(_ slot: U32, _ data: UnsafePointer<U8>?, _ len: U32) -> I32
+
+@_silgen_name("arduino_http_server_slot_set_idle")
+public func arduino_http_server_slot_set_idle(_ slot: U32, _ idle: U32) -> Void
+
+@_silgen_name("arduino_http_server_slot_stop")
+public func arduino_http_server_slot_stop(_ slot: U32) -> Void
+
+@_silgen_name("arduino_http_asset_count")
+public func arduino_http_asset_count() -> U32
+
+@_silgen_name("arduino_http_asset_find")
+public func arduino_http_asset_find(_ path: UnsafePointer<U8>?, _ len: U32) -> I32
+
+@_silgen_name("arduino_http_asset_data")
+public func arduino_http_asset_data(_ i: U32, _ len: UnsafeMutablePointer<U32>?) -> UnsafePointer<U8>?
+
+@_silgen_name("arduino_http_asset_content_type")
+public func arduino_http_asset_content_type(_ i: U32) -> UnsafePointer<CChar>?
+
+@_silgen_name("arduino_http_asset_etag")
+public func arduino_http_asset_etag(_ i: U32) -> UnsafePointer<CChar>?
+
+@_silgen_name("arduino_http_asset_gzip")
+public func arduino_http_asset_gzip(_ i: U32) -> U32
\ No newline at end of file
@@ -10,53 +10,150 @@
 //  - No Foundation dependency (no CharacterSet, split, trimming, JSONSerialization, etc.)
 //  - Avoid Unicode normalization-heavy APIs to keep the embedded link clean
 //  - Parse HTTP requests using raw bytes (ASCII/UTF-8) with small fixed limits
-//  - Support basic routing for GET and POST
+//  - Routing for every method, with `:param` / `*` segments (HTTPRouter.swift)
 //  - Provide a small JSON encoder without Dictionaries (ordered tuples instead)
 //
 //  How it works:
 //  - The C++ side exposes a small C-ABI for an underlying WiFi server/client.
-//  - This Swift layer polls for an available client and reads bytes into a buffer.
-//  - It detects the end of headers (\r\n\r\n), parses the request line + headers,
-//    optionally reads Content-Length bytes, routes the request, writes a response,
-//    and closes the connection.
+//  - Up to ARDUINO_HTTP_SERVER_CLIENTS connections are held in slots, each with
+//    its own receive buffer and parse state.
+//  - Every tick accepts new connections, then visits the slots round-robin: read
+//    up to `readBudget` bytes, answer at most `maxRequestsPerTurn` requests.
+//  - Bytes are read straight into a fixed receive buffer per connection; HTTPParser
+//    (HTTPParser.swift) parses the head in place and incrementally, as index ranges.
+//    Once Content-Length bytes are in, the request is routed and answered.
+//  - Responses go through one fixed TX buffer (HTTPResponseWriter.swift): header and
+//    body leave in a single write when they fit, larger ones in full-buffer writes.
+//    Streamed responses (HTTPResponse.stream) are produced a turn at a time, chunked
+//    unless their length is known. Borrowed bodies (flash assets) go out a turn at
+//    a time too, from an offset kept with the connection.
+//  - HTTP/1.1 keep-alive: the connection stays open (pipelined bytes stay buffered)
+//    unless the client asks for close, and is dropped after `idleTimeoutMs`.
+//    When all slots are busy, the longest-idle connection makes room for a new one.
+//  - Throughput: `requestsServed` counts every answered request, `requestsPerSecond`
+//    is that count over the last full second (e.g. print it while `wrk` or `ab -k`
+//    loads the board from a PC).
 //
 //  Limitations:
-//  - One request per connection, Connection: close
-//  - Body is read only via Content-Length (no chunked transfer encoding)
+//  - Body is read only via Content-Length: a request with Transfer-Encoding gets
+//    501 and the connection is closed (its body would otherwise be read as the
+//    next pipelined request)
 //  - Minimal parsing, intended for LAN/dev usage on microcontrollers
 //
 
 public enum HTTPMethod: U8, Sendable {
-    case get  = 1
-    case post = 2
+    case get     = 1
+    case post    = 2
+    case head    = 3
+    case put     = 4
+    case delete  = 5
+    case options = 6
+    case patch   = 7
+
+    public var name: StaticString {
+        switch self {
+        case .get:     return "GET"
+        case .post:    return "POST"
+        case .head:    return "HEAD"
+        case .put:     return "PUT"
+        case .delete:  return "DELETE"
+        case .options: return "OPTIONS"
+        case .patch:   return "PATCH"
+        }
+    }
 }
 
 public struct HTTPHeader: Sendable {
     public let name: [U8]
     public let value: [U8]
+
+    public init(name: [U8], value: [U8]) {
+        self.name = name
+        self.value = value
+    }
+
+    public init(_ name: String, _ value: String) {
+        self.init(name: Array(name.utf8), value: Array(value.utf8))
+    }
 }
 
-public struct HTTPRequest: Sendable {
+/// A parsed request, borrowed from the connection's receive buffer: valid only
+/// inside the handler. The *View accessors are zero-copy; `path`, `body`,
+/// `headers` and `header(_:)` copy.
+public struct HTTPRequest {
     public let method: HTTPMethod
-    public let path: [U8]
-    public let headers: [HTTPHeader]
-    public let body: [U8]
 
-    public func pathString() -> String { asciiString(path) }
+    /// HTTP/1.1 without "Connection: close", or HTTP/1.0 with "Connection: keep-alive".
+    public let keepAlive: Bool
+
+    /// Request head + body as received.
+    public let raw: UnsafeBufferPointer<U8>
+    public let pathRange: Range<Int>
+    public let queryRange: Range<Int>?
+    public let bodyRange: Range<Int>
+    let headerSpans: UnsafeBufferPointer<HTTPHeaderSpan>
+    let paramSpans: UnsafeBufferPointer<HTTPParamSpan>
+    let paramNames: UnsafeBufferPointer<U8>
+
+    public var pathView: UnsafeBufferPointer<U8> { view(pathRange) }
+    public var bodyView: UnsafeBufferPointer<U8> { view(bodyRange) }
+
+    /// After '?', nil when the target has none.
+    public var queryView: UnsafeBufferPointer<U8>? {
+        guard let r = queryRange else { return nil }
+        return view(r)
+    }
 
-    public func header(_ name: StaticString) -> [U8]? {
-        let n = staticUTF8(name)
-        for h in headers {
-            if asciiCaseInsensitiveEqual(h.name, n) { return h.value }
+    public var headerCount: Int { headerSpans.count }
+    public func headerName(at i: Int) -> UnsafeBufferPointer<U8> { view(headerSpans[i].name) }
+    public func headerValue(at i: Int) -> UnsafeBufferPointer<U8> { view(headerSpans[i].value) }
+
+    /// First header named `name` (case-insensitive).
+    public func headerView(_ name: StaticString) -> UnsafeBufferPointer<U8>? {
+        for h in headerSpans {
+            if httpEqualIgnoringCase(raw, h.name, name) { return view(h.value) }
+        }
+        return nil
+    }
+
+    /// Path parameters captured by the route (`:name`, and "*" for a wildcard).
+    public var paramCount: Int { paramSpans.count }
+    public func paramName(at i: Int) -> UnsafeBufferPointer<U8> {
+        UnsafeBufferPointer(rebasing: paramNames[paramSpans[i].name])
+    }
+    public func paramValue(at i: Int) -> UnsafeBufferPointer<U8> { view(paramSpans[i].value) }
+
+    public func param(_ name: StaticString) -> UnsafeBufferPointer<U8>? {
+        for p in paramSpans {
+            if httpEqual(paramNames, p.name, name) { return view(p.value) }
         }
         return nil
     }
 
-    public func contentLength() -> Int {
-        if let v = header("Content-Length") {
-            return asciiParseInt(v) ?? 0
+    public var path: [U8] { Array(pathView) }
+    public var body: [U8] { Array(bodyView) }
+
+    public var headers: [HTTPHeader] {
+        var out: [HTTPHeader] = []
+        out.reserveCapacity(headerSpans.count)
+        for h in headerSpans {
+            out.append(HTTPHeader(name: Array(view(h.name)), value: Array(view(h.value))))
         }
-        return 0
+        return out
+    }
+
+    public func pathString() -> String { asciiString(path) }
+
+    public func header(_ name: StaticString) -> [U8]? {
+        guard let v = headerView(name) else { return nil }
+        return Array(v)
+    }
+
+    public func contentLength() -> Int { bodyRange.count }
+
+    @inline(__always)
+    private func view(_ r: Range<Int>) -> UnsafeBufferPointer<U8> {
+        UnsafeBufferPointer(rebasing: raw[r])
     }
 }
 
@@ -65,6 +162,34 @@ public struct HTTPResponse: Sendable {
     public let contentType: [U8]
     public let body: [U8]
 
+    /// Extra header lines (after Content-Type).
+    public var headers: [HTTPHeader] = []
+
+    /// Streamed body: called with the writer until it returns false.
+    public typealias Producer = (HTTPResponseWriter) -> Bool
+
+    public var producer: Producer? = nil
+
+    /// Content-Length of a streamed body; nil = Transfer-Encoding: chunked.
+    public var streamLength: Int? = nil
+
+    /// Body in memory that outlives the response (e.g. flash): sent a turn at a
+    /// time like a stream, never copied. Takes the place of `body`.
+    public var borrowedBody: UnsafeBufferPointer<U8>? = nil
+
+    /// Body generated while it is sent (see HTTPResponseWriter): never held in RAM.
+    public static func stream(
+        status: I32 = 200,
+        contentType: String = "application/octet-stream",
+        length: Int? = nil,
+        _ producer: @escaping Producer
+    ) -> HTTPResponse {
+        var r = HTTPResponse(status: status, contentType: Array(contentType.utf8), body: [])
+        r.producer = producer
+        r.streamLength = length
+        return r
+    }
+
     public static func response(
         _ text: String,
         status: I32 = 200,
@@ -192,23 +317,119 @@ public final class HTTPServer: ArduinoTickable {
         public init(_ message: String) { self.message = message }
     }
 
+    /// Requests answered per connection per tick; pipelined ones wait for the
+    /// next round so one busy client cannot starve the others.
+    public var maxRequestsPerTurn: Int = 1
+
+    /// Bytes read per connection per tick.
+    public var readBudget: Int = 512
+
+    /// A connection with no request in progress is closed after this long.
+    public var idleTimeoutMs: U32 = 5000
+
+    /// Requests per connection; the last one is answered with Connection: close.
+    public var maxRequestsPerConnection: Int = 100
+
+    /// Receive buffer per connection, allocated once by the first start(). A
+    /// request head + body must fit (larger heads are dropped, bodies get 413).
+    public var bufferBytes: Int = 2048
+
+    /// TX buffer shared by all connections, allocated once by the first start().
+    /// Responses leave in writes of this size (1460 = one TCP segment).
+    public var txBufferBytes: Int = 1460
+
+    /// Streamed bytes per connection per tick before the next connection's turn.
+    public var streamBytesPerTurn: Int = 8 * 1460
+
+    /// Path parameters captured per request (more are matched but not recorded).
+    public let maxParams: Int = 8
+
+    /// Connections that can be open at once (ARDUINO_HTTP_SERVER_CLIENTS).
+    public var slots: Int { Int(arduino_http_server_slots()) }
+
+    /// Requests answered since start() (wraps).
+    public private(set) var requestsServed: U32 = 0
+
+    /// Requests answered over the last measured second; 0 until one has passed.
+    public private(set) var requestsPerSecond: U32 = 0
+
+    /// Per-slot receive buffer and parse state.
+    private final class Conn {
+        let slot: U32
+        var active: Bool = false
+        var buf: [U8]
+        var len: Int = 0
+        var parser = HTTPParser()
+        var bodyWaitStart: U32 = 0
+        var lastActivity: U32 = 0
+        var served: Int = 0
+
+        // Streamed response in progress: a producer, or a borrowed body and
+        // how much of it is sent.
+        var stream: HTTPResponse.Producer? = nil
+        var streamData: UnsafeBufferPointer<U8>? = nil
+        var streamOffset: Int = 0
+        var streamChunked: Bool = false
+        var streamKeepAlive: Bool = false
+
+        var streaming: Bool { stream != nil || streamData != nil }
+
+        init(slot: U32, capacity: Int) {
+            self.slot = slot
+            self.buf = [U8](repeating: 0, count: capacity)
+        }
+
+        func resetRequest() {
+            parser.reset()
+            bodyWaitStart = 0
+        }
+
+        func reset(active: Bool, now: U32) {
+            self.active = active
+            len = 0
+            stream = nil
+            streamData = nil
+            resetRequest()
+            lastActivity = now
+            served = 0
+        }
+
+        /// Drops a finished request; pipelined bytes after it move to the front.
+        func consume(_ n: Int) {
+            let rest = len - n
+            if rest > 0 {
+                buf.withUnsafeMutableBufferPointer { p in
+                    p.baseAddress!.update(from: p.baseAddress! + n, count: rest)
+                }
+            }
+            len = rest > 0 ? rest : 0
+        }
+    }
+
     private var routes: [Route] = []
+    private var router = HTTPRouter()
+    private var params: [HTTPParamSpan] = []
+    private var tx: HTTPResponseWriter?
     private var failure: FailureHandler?
 
     private var port: UInt16 = 80
     private var running: Bool = false
 
-    private var rx: [U8] = []
-    private var headerEndIndex: Int = -1
-    private var expectedBodyLen: Int = 0
+    private var conns: [Conn] = []
+    private var nextConn: Int = 0
 
-    private let headerMaxBytes: Int = 2048
-    private let bodyMaxBytes: Int = 2048
     private let bodyWaitMs: U32 = 8000
     private let pollMs: U32 = 5
 
     private var nextPollAt: U32 = 0
-    private var bodyWaitStart: U32 = 0
+
+    // requestsPerSecond window.
+    private var rateWindowStart: U32 = 0
+    private var rateWindowCount: U32 = 0
+
+    // arduino_http_server_accept() results below zero (http_server.h).
+    private static let acceptNone: I32 = -1
+    private static let acceptSkipped: I32 = -2
 
     public init() {}
 
@@ -216,12 +437,54 @@ public final class HTTPServer: ArduinoTickable {
         self.failure = cb
     }
 
+    /// `path` segments may be `:name` (captured, see HTTPRequest.param) or a final `*`.
+    /// HEAD falls back to the GET handler (body not sent). When no pattern
+    /// matching the path has the method: OPTIONS gets 204 with Allow, others
+    /// 405 with Allow, or 404 if only `*` catch-alls matched.
+    public func handle(_ method: HTTPMethod, _ path: String, _ handler: @escaping Handler) {
+        routes.append(.init(method: method, path: Array(path.utf8), handler: handler))
+        router.invalidate()
+    }
+
     public func get(_ path: String, _ handler: @escaping Handler) {
-        routes.append(.init(method: .get, path: Array(path.utf8), handler: handler))
+        handle(.get, path, handler)
     }
 
     public func post(_ path: String, _ handler: @escaping Handler) {
-        routes.append(.init(method: .post, path: Array(path.utf8), handler: handler))
+        handle(.post, path, handler)
+    }
+
+    public func put(_ path: String, _ handler: @escaping Handler) {
+        handle(.put, path, handler)
+    }
+
+    public func delete(_ path: String, _ handler: @escaping Handler) {
+        handle(.delete, path, handler)
+    }
+
+    public func patch(_ path: String, _ handler: @escaping Handler) {
+        handle(.patch, path, handler)
+    }
+
+    public func options(_ path: String, _ handler: @escaping Handler) {
+        handle(.options, path, handler)
+    }
+
+    public func head(_ path: String, _ handler: @escaping Handler) {
+        handle(.head, path, handler)
+    }
+
+    /// Serves the project's assets/ directory, embedded in flash by the build:
+    /// `prefix` + "app.js" answers assets/app.js, a path ending in "/" its
+    /// index.html. Bodies are sent straight from flash; a matching
+    /// If-None-Match gets 304. Text assets may be stored gzip'd only: they
+    /// go out with Content-Encoding: gzip and Vary: Accept-Encoding unless the
+    /// request's Accept-Encoding rules gzip out, which gets 406. Other methods
+    /// on a path only this catch-all matches get 404, not 405.
+    public func serveStatic(_ prefix: String = "/") {
+        var pattern = prefix
+        if pattern.utf8.last != 0x2F { pattern += "/" }
+        get(pattern + "*") { req in staticAsset(req) }
     }
 
     @discardableResult
@@ -234,14 +497,33 @@ public final class HTTPServer: ArduinoTickable {
             return false
         }
         running = true
-        resetRx()
+        router.compile(routes)
+        params.reserveCapacity(maxParams)
+        if tx == nil { tx = HTTPResponseWriter(capacity: txBufferBytes) }
+
+        if conns.isEmpty {
+            let n = slots
+            conns.reserveCapacity(n)
+            var i = 0
+            while i < n {
+                conns.append(Conn(slot: U32(i), capacity: bufferBytes))
+                i += 1
+            }
+        }
+        let now = arduino_millis()
+        for c in conns { c.reset(active: false, now: now) }
+        requestsServed = 0
+        requestsPerSecond = 0
+        rateWindowStart = now
+        rateWindowCount = 0
         return true
     }
 
     public func stop() {
         arduino_http_server_end()
         running = false
-        resetRx()
+        let now = arduino_millis()
+        for c in conns { c.reset(active: false, now: now) }
     }
 
     public func addToRuntime() { ArduinoRuntime.add(self) }
@@ -250,130 +532,312 @@ public final class HTTPServer: ArduinoTickable {
         if !running { return }
 
         let now = arduino_millis()
-        if now < nextPollAt { return }
+        if Int32(bitPattern: now &- nextPollAt) < 0 { return }
         nextPollAt = now &+ pollMs
 
-        if arduino_http_server_client_available() != 1 {
-            return
-        }
+        updateRate(now)
+        acceptNew(now)
 
-        readAvailableIntoRx()
+        // Round-robin, starting one connection later every tick.
+        let n = conns.count
+        if n == 0 { return }
+        var k = 0
+        while k < n {
+            serve(conns[(nextConn + k) % n], now)
+            k += 1
+        }
+        nextConn = (nextConn + 1) % n
+    }
 
-        if headerEndIndex < 0 {
-            headerEndIndex = findHeaderEnd(rx)
-            if headerEndIndex >= 0 {
-                expectedBodyLen = parseContentLength(rx, headerEndIndex: headerEndIndex) ?? 0
-                if expectedBodyLen > bodyMaxBytes { expectedBodyLen = bodyMaxBytes }
-                bodyWaitStart = arduino_millis()
-            } else {
-                if rx.count > headerMaxBytes {
-                    failAndClose("Header too large")
-                }
-                return
-            }
+    /// Accepts until nothing is waiting. A skipped socket (already in a slot,
+    /// or refused) does not end the loop: a new client may be queued behind it.
+    /// WiFiS3 can hand out the same busy socket again, so attempts are bounded.
+    private func acceptNew(_ now: U32) {
+        var attempts = 2 * conns.count + 1
+        while attempts > 0 {
+            attempts -= 1
+            let slot = arduino_http_server_accept()
+            if slot == HTTPServer.acceptNone { return }
+            if slot < 0 || Int(slot) >= conns.count { continue }
+            conns[Int(slot)].reset(active: true, now: now)
         }
+    }
+
+    private func updateRate(_ now: U32) {
+        let elapsed = now &- rateWindowStart
+        if elapsed < 1000 { return }
+        let n = requestsServed &- rateWindowCount
+        requestsPerSecond = U32(truncatingIfNeeded: UInt64(n) * 1000 / UInt64(elapsed))
+        rateWindowStart = now
+        rateWindowCount = requestsServed
+    }
 
-        let headerEnd = headerEndIndex
-        let haveBodyBytes = rx.count - headerEnd
+    private func serve(_ c: Conn, _ now: U32) {
+        if !c.active { return }
 
-        if expectedBodyLen > 0 && haveBodyBytes < expectedBodyLen {
-            if (arduino_millis() &- bodyWaitStart) > bodyWaitMs {
-                failAndClose("Body timeout (need \(expectedBodyLen), have \(haveBodyBytes))")
-            }
+        if arduino_http_server_slot_connected(c.slot) != 1 {
+            close(c)
             return
         }
 
-        guard let req = parseRequest(rx, headerEndIndex: headerEndIndex, bodyLen: expectedBodyLen) else {
-            failAndClose("Bad request")
+        if readAvailable(into: c) > 0 { c.lastActivity = now }
+
+        // Requests behind a streamed response wait until it is done.
+        if c.streaming {
+            pumpStream(c, now, resume: true)
             return
         }
 
-        let resp = route(req) ?? .response("Not Found\n", status: 404, contentType: "text/plain; charset=utf-8")
-        writeResponse(resp)
-        arduino_http_server_client_stop()
-        resetRx()
-    }
+        var served = 0
+        while served < maxRequestsPerTurn && c.active {
+            if !handleRequest(c, now) { break }
+            served += 1
+        }
 
-    private func resetRx() {
-        rx.removeAll(keepingCapacity: true)
-        headerEndIndex = -1
-        expectedBodyLen = 0
-        bodyWaitStart = 0
+        if c.active && c.parser.status == .needMore && (now &- c.lastActivity) > idleTimeoutMs {
+            close(c)
+        }
     }
 
-    private func failAndClose(_ msg: String) {
-        failure?(.init(msg))
-        arduino_http_server_client_stop()
-        resetRx()
-    }
+    /// Answers one buffered request. False when none is complete yet (or the connection closed).
+    private func handleRequest(_ c: Conn, _ now: U32) -> Bool {
+        if c.parser.status == .needMore {
+            let len = c.len
+            let st = c.buf.withUnsafeBufferPointer { c.parser.parse(UnsafeBufferPointer(rebasing: $0[0..<len])) }
+            switch st {
+            case .needMore:
+                if c.len >= c.buf.count {
+                    failAndClose(c, "Header too large")
+                }
+                return false
+            case .invalid:
+                writeResponse(.response("Bad Request\n", status: 400), to: c, keepAlive: false)
+                failAndClose(c, "Bad request")
+                return false
+            case .complete:
+                if c.parser.transferEncoding {
+                    writeResponse(.response("Not Implemented\n", status: 501), to: c, keepAlive: false)
+                    failAndClose(c, "Transfer-Encoding not supported")
+                    return false
+                }
+                if c.parser.headerEnd + c.parser.contentLength > c.buf.count {
+                    writeResponse(.response("Payload Too Large\n", status: 413), to: c, keepAlive: false)
+                    failAndClose(c, "Body too large")
+                    return false
+                }
+                c.bodyWaitStart = now
+            }
+        }
 
-    private func route(_ req: HTTPRequest) -> HTTPResponse? {
-        for r in routes {
-            if r.method == req.method && r.path == req.path {
-                return r.handler(req)
+        let headerEnd = c.parser.headerEnd
+        let end = headerEnd + c.parser.contentLength
+
+        if c.len < end {
+            if (now &- c.bodyWaitStart) > bodyWaitMs {
+                let need = c.parser.contentLength
+                let have = c.len - headerEnd
+                failAndClose(c, {
+                    var f = FormatBuffer()
+                    f.append("Body timeout (need ")
+                    f.append(need)
+                    f.append(", have ")
+                    f.append(have)
+                    f.append(")")
+                    return f.toString()
+                }())
             }
+            return false
         }
-        return nil
+
+        c.served += 1
+        requestsServed &+= 1
+        let keepAlive = c.parser.keepAlive && c.served < maxRequestsPerConnection
+
+        guard let method = c.parser.method else {
+            let ka = writeResponse(.response("Not Implemented\n", status: 501), to: c, keepAlive: keepAlive)
+            return finish(c, end, ka, now)
+        }
+
+        let resp: HTTPResponse = c.buf.withUnsafeBufferPointer { raw in
+            dispatch(method, c, UnsafeBufferPointer(rebasing: raw[0..<end]), headerEnd)
+        }
+        let ka = writeResponse(resp, to: c, keepAlive: keepAlive, sendBody: method != .head)
+        return finish(c, end, ka, now)
     }
 
-    private func readAvailableIntoRx() {
-        var safety = 0
-        while safety < 16 {
-            safety += 1
+    /// Done with the request ending at `end`: close, or keep pipelined bytes for the next one.
+    private func finish(_ c: Conn, _ end: Int, _ keepAlive: Bool, _ now: U32) -> Bool {
+        if !c.streaming && (!keepAlive || tx?.failed == true) {
+            close(c)
+            return false
+        }
 
-            let av = arduino_http_server_client_available_bytes()
-            if av <= 0 { break }
+        // Pipelined bytes after this request stay buffered for the next one.
+        c.consume(end)
+        c.resetRequest()
+        c.lastActivity = now
 
-            let maxRead = min(Int(av), 256)
+        if c.streaming {
+            c.streamKeepAlive = keepAlive
+            pumpStream(c, now, resume: false)
+            return false
+        }
 
-            var tmp = [U8](repeating: 0, count: maxRead)
-            let cap = U32(maxRead)
+        if c.len == 0 { arduino_http_server_slot_set_idle(c.slot, 1) }
+        return true
+    }
 
-            let n: I32 = tmp.withUnsafeMutableBufferPointer { p in
-                arduino_http_server_client_read(p.baseAddress, cap)
+    /// Runs the connection's producer (or sends its borrowed body) for up to
+    /// `streamBytesPerTurn` bytes. `resume` false right after the head (still
+    /// buffered in the writer).
+    private func pumpStream(_ c: Conn, _ now: U32, resume: Bool) {
+        guard c.streaming, let w = tx else { return }
+        if resume { w.begin(slot: c.slot, chunked: c.streamChunked, body: true) }
+
+        var more = true
+        while more && !w.failed && w.sent < streamBytesPerTurn {
+            if let producer = c.stream {
+                more = producer(w)
+            } else {
+                more = sendBorrowed(c, w)
             }
+        }
+        c.lastActivity = now
 
-            if n <= 0 { break }
-            let nn = Int(n)
-            if nn > 0 {
-                rx.append(contentsOf: tmp[0..<nn])
-            }
+        if more && !w.failed {
+            w.flush()
+            if !w.failed { return }
+        }
 
-            if rx.count > (headerMaxBytes + bodyMaxBytes) {
-                break
-            }
+        c.stream = nil
+        c.streamData = nil
+        if !w.failed { w.end() }
+        if w.failed || !c.streamKeepAlive {
+            close(c)
+            return
         }
+        if c.len == 0 { arduino_http_server_slot_set_idle(c.slot, 1) }
     }
 
-    private func writeResponse(_ resp: HTTPResponse) {
-        var out: [U8] = []
-        out.reserveCapacity(128 + resp.body.count)
+    /// Next piece of a borrowed body: tops up what is buffered (the head), then
+    /// whole buffers, which the writer sends straight from the body's memory.
+    private func sendBorrowed(_ c: Conn, _ w: HTTPResponseWriter) -> Bool {
+        guard let data = c.streamData else { return false }
+        let room = w.available
+        let n = min(data.count - c.streamOffset, room > 0 && room < w.capacity ? room : w.capacity)
+        w.write(UnsafeBufferPointer(rebasing: data[c.streamOffset..<(c.streamOffset + n)]))
+        c.streamOffset += n
+        return c.streamOffset < data.count
+    }
+
+    private func close(_ c: Conn) {
+        arduino_http_server_slot_stop(c.slot)
+        c.reset(active: false, now: c.lastActivity)
+    }
+
+    // The message is only built when someone listens for failures.
+    private func failAndClose(_ c: Conn, _ msg: @autoclosure () -> String) {
+        if let failure { failure(.init(msg())) }
+        close(c)
+    }
+
+    private func dispatch(_ method: HTTPMethod, _ c: Conn, _ raw: UnsafeBufferPointer<U8>, _ headerEnd: Int) -> HTTPResponse {
+        if !router.isCompiled { router.compile(routes) }
+
+        params.removeAll(keepingCapacity: true)
+        let ri: Int
+        switch router.lookup(raw, c.parser.path, method, &params) {
+        case .route(let r):
+            ri = r
+        case .methodMissing(let methods, let explicit) where method == .options || explicit:
+            var resp: HTTPResponse = method == .options
+                ? .response([], status: 204, contentType: "text/plain")
+                : .response("Method Not Allowed\n", status: 405, contentType: "text/plain; charset=utf-8")
+            resp.headers.append(HTTPHeader(name: Array("Allow".utf8), value: allowValue(methods)))
+            return resp
+        case .methodMissing, .notFound:
+            return .response("Not Found\n", status: 404, contentType: "text/plain; charset=utf-8")
+        }
 
-        out += Array("HTTP/1.1 ".utf8)
-        out += asciiInt(resp.status)
-        out.append(0x20)
-        out += statusReason(resp.status)
-        out += Array("\r\n".utf8)
+        return c.parser.headers.withUnsafeBufferPointer { spans in
+            params.withUnsafeBufferPointer { ps in
+                router.names.withUnsafeBufferPointer { names in
+                    routes[ri].handler(HTTPRequest(
+                        method: method,
+                        keepAlive: c.parser.keepAlive,
+                        raw: raw,
+                        pathRange: c.parser.path,
+                        queryRange: c.parser.query,
+                        bodyRange: headerEnd..<raw.count,
+                        headerSpans: spans,
+                        paramSpans: ps,
+                        paramNames: names
+                    ))
+                }
+            }
+        }
+    }
 
-        out += Array("Content-Type: ".utf8)
-        out += resp.contentType
-        out += Array("\r\n".utf8)
+    /// Reads up to `readBudget` bytes straight into the connection buffer. Returns bytes read.
+    private func readAvailable(into c: Conn) -> Int {
+        var total = 0
+        while total < readBudget && c.len < c.buf.count {
+            let av = arduino_http_server_slot_available_bytes(c.slot)
+            if av <= 0 { break }
 
-        out += Array("Connection: close\r\n".utf8)
+            let at = c.len
+            let cap = U32(min(Int(av), c.buf.count - at, readBudget - total))
 
-        out += Array("Content-Length: ".utf8)
-        out += asciiInt(I32(resp.body.count))
-        out += Array("\r\n\r\n".utf8)
+            let n: I32 = c.buf.withUnsafeMutableBufferPointer { p in
+                arduino_http_server_slot_read(c.slot, p.baseAddress! + at, cap)
+            }
 
-        out.withUnsafeBufferPointer { p in
-            _ = arduino_http_server_client_write(p.baseAddress, U32(out.count))
+            if n <= 0 { break }
+            c.len += Int(n)
+            total += Int(n)
         }
+        return total
+    }
 
-        if !resp.body.isEmpty {
-            resp.body.withUnsafeBufferPointer { p in
-                _ = arduino_http_server_client_write(p.baseAddress, U32(resp.body.count))
+    /// Writes the head and a buffered body, or the head only and arms the
+    /// connection's stream. `sendBody` false for HEAD: same headers, no body.
+    /// Returns the keep-alive actually announced (an unframed HTTP/1.0 stream closes).
+    @discardableResult
+    private func writeResponse(_ resp: HTTPResponse, to c: Conn, keepAlive: Bool, sendBody: Bool = true) -> Bool {
+        guard let w = tx else { return false }
+
+        // 204 / 304 carry no body and no Content-Length.
+        let hasBody = resp.status != 204 && resp.status != 304
+        var ka = keepAlive
+        var length: Int? = hasBody ? resp.body.count : nil
+        var chunked = false
+
+        if hasBody, let producer = resp.producer {
+            length = resp.streamLength
+            if length == nil {
+                if c.parser.isHTTP11 { chunked = sendBody } else { ka = false }
+            }
+            if sendBody {
+                c.stream = producer
+                c.streamChunked = chunked
+            }
+        } else if hasBody, let data = resp.borrowedBody {
+            length = data.count
+            if sendBody {
+                c.streamData = data
+                c.streamOffset = 0
+                c.streamChunked = false
             }
         }
+
+        w.begin(slot: c.slot, chunked: chunked, body: false)
+        w.head(status: resp.status, contentType: resp.contentType, headers: resp.headers, keepAlive: ka, length: length)
+
+        if !c.streaming {
+            if sendBody && hasBody { w.write(resp.body) }
+            w.end()
+        }
+        return ka
     }
 }
 
@@ -382,228 +846,186 @@ public final class HTTPServer: ArduinoTickable {
 // ============================================================
 
 @inline(__always)
-private func statusReason(_ status: I32) -> [U8] {
+func httpStatusReason(_ status: I32) -> StaticString {
     switch status {
-    case 200: return Array("OK".utf8)
-    case 201: return Array("Created".utf8)
-    case 204: return Array("No Content".utf8)
-    case 400: return Array("Bad Request".utf8)
-    case 401: return Array("Unauthorized".utf8)
-    case 403: return Array("Forbidden".utf8)
-    case 404: return Array("Not Found".utf8)
-    case 405: return Array("Method Not Allowed".utf8)
-    case 413: return Array("Payload Too Large".utf8)
-    case 500: return Array("Internal Server Error".utf8)
-    default:  return Array("OK".utf8)
-    }
-}
-
-@inline(__always)
-private func findHeaderEnd(_ bytes: [U8]) -> Int {
-    if bytes.count < 4 { return -1 }
-    var i = 3
-    while i < bytes.count {
-        if bytes[i-3] == 13 && bytes[i-2] == 10 && bytes[i-1] == 13 && bytes[i] == 10 {
-            return i + 1
-        }
-        i += 1
+    case 200: return "OK"
+    case 201: return "Created"
+    case 204: return "No Content"
+    case 304: return "Not Modified"
+    case 400: return "Bad Request"
+    case 401: return "Unauthorized"
+    case 403: return "Forbidden"
+    case 404: return "Not Found"
+    case 405: return "Method Not Allowed"
+    case 406: return "Not Acceptable"
+    case 413: return "Payload Too Large"
+    case 500: return "Internal Server Error"
+    case 501: return "Not Implemented"
+    default:  return "OK"
     }
-    return -1
 }
 
-private func parseRequest(_ bytes: [U8], headerEndIndex: Int, bodyLen: Int) -> HTTPRequest? {
-    let header = Array(bytes[0..<headerEndIndex])
-
-    guard let lineEnd = findCRLF(header, start: 0) else { return nil }
-    let reqLine = Array(header[0..<lineEnd])
-
-    var p = 0
-    let mEnd = findByte(reqLine, byte: 0x20, start: p) ?? -1
-    if mEnd < 0 { return nil }
-    let methodBytes = Array(reqLine[p..<mEnd])
-    p = mEnd + 1
-
-    let pathEnd = findByte(reqLine, byte: 0x20, start: p) ?? -1
-    if pathEnd < 0 { return nil }
-    let pathBytes = Array(reqLine[p..<pathEnd])
-
-    let method: HTTPMethod
-    if asciiEqual(methodBytes, Array("GET".utf8)) {
-        method = .get
-    } else if asciiEqual(methodBytes, Array("POST".utf8)) {
-        method = .post
-    } else {
-        return nil
+/// The asset at "/" + the request's `*` capture (the byte before it is the '/').
+private func staticAsset(_ req: HTTPRequest) -> HTTPResponse {
+    var key: Range<Int>? = nil
+    for p in req.paramSpans where httpEqual(req.paramNames, p.name, "*") {
+        let lo = p.value.lowerBound
+        if lo > req.pathRange.lowerBound && req.raw[lo - 1] == 0x2F { key = (lo - 1)..<p.value.upperBound }
     }
 
-    var headers: [HTTPHeader] = []
-    headers.reserveCapacity(8)
-
-    var cur = lineEnd + 2
-    while cur + 2 <= header.count {
-        if cur + 1 < header.count, header[cur] == 13, header[cur+1] == 10 { break }
-
-        guard let hEnd = findCRLF(header, start: cur) else { break }
-        let line = Array(header[cur..<hEnd])
-        cur = hEnd + 2
-
-        guard let colon = findByte(line, byte: 0x3A, start: 0) else { continue }
-        let name = rtrimSpaces(Array(line[0..<colon]))
-        let value = ltrimSpaces(Array(line[(colon+1)..<line.count]))
-        headers.append(.init(name: name, value: value))
+    guard let r = key else { return .response("Not Found\n", status: 404) }
+    let i = arduino_http_asset_find(req.raw.baseAddress! + r.lowerBound, U32(r.count))
+    guard i >= 0 else { return .response("Not Found\n", status: 404) }
+    let a = U32(i)
+
+    // Only gzip'd assets vary by Accept-Encoding: flash holds no identity copy.
+    let gzip = arduino_http_asset_gzip(a) != 0
+    let vary = HTTPHeader(name: Array("Vary".utf8), value: Array("Accept-Encoding".utf8))
+    if gzip && !acceptsGzip(req.headerView("Accept-Encoding")) {
+        var resp: HTTPResponse = .response("Not Acceptable (stored gzip only)\n", status: 406)
+        resp.headers = [vary]
+        return resp
     }
 
-    var body: [U8] = []
-    if bodyLen > 0 {
-        let start = headerEndIndex
-        let end = min(bytes.count, start + bodyLen)
-        if end > start {
-            body = Array(bytes[start..<end])
-        }
+    let etag = cStringBytes(arduino_http_asset_etag(a))
+    var headers: [HTTPHeader] = [
+        HTTPHeader(name: Array("ETag".utf8), value: Array(etag)),
+        HTTPHeader(name: Array("Cache-Control".utf8), value: Array("no-cache".utf8)),
+    ]
+    if gzip { headers.append(vary) }
+
+    if let inm = req.headerView("If-None-Match"), etagListMatches(inm, etag) {
+        var resp: HTTPResponse = .response([], status: 304, contentType: "")
+        resp.headers = headers
+        return resp
     }
 
-    return .init(method: method, path: pathBytes, headers: headers, body: body)
-}
-
-private func parseContentLength(_ bytes: [U8], headerEndIndex: Int) -> Int? {
-    let header = Array(bytes[0..<headerEndIndex])
-
-    guard let firstCRLF = findCRLF(header, start: 0) else { return nil }
-    var cur = firstCRLF + 2
-
-    let target = Array("Content-Length".utf8)
-
-    while cur + 2 <= header.count {
-        if cur + 1 < header.count, header[cur] == 13, header[cur+1] == 10 { break }
+    if gzip { headers.append(HTTPHeader(name: Array("Content-Encoding".utf8), value: Array("gzip".utf8))) }
 
-        guard let hEnd = findCRLF(header, start: cur) else { break }
-        let line = Array(header[cur..<hEnd])
-        cur = hEnd + 2
+    var len: U32 = 0
+    guard let data = arduino_http_asset_data(a, &len) else { return .response("Not Found\n", status: 404) }
 
-        guard let colon = findByte(line, byte: 0x3A, start: 0) else { continue }
-
-        let name = rtrimSpaces(Array(line[0..<colon]))
-        if !asciiCaseInsensitiveEqual(name, target) { continue }
-
-        let value = ltrimSpaces(Array(line[(colon+1)..<line.count]))
-        return asciiParseInt(value)
-    }
-
-    return nil
+    var resp = HTTPResponse(
+        status: 200,
+        contentType: Array(cStringBytes(arduino_http_asset_content_type(a))),
+        body: []
+    )
+    resp.headers = headers
+    resp.borrowedBody = UnsafeBufferPointer(start: data, count: Int(len))
+    return resp
 }
 
-@inline(__always)
-private func findCRLF(_ bytes: [U8], start: Int) -> Int? {
-    var i = start + 1
-    while i < bytes.count {
-        if bytes[i-1] == 13 && bytes[i] == 10 { return i - 1 }
-        i += 1
+/// Accept-Encoding allows gzip: a "gzip" / "x-gzip" entry, else "*", with a
+/// q other than 0. No header: any coding is acceptable (RFC 9110 12.5.3); an
+/// empty one: identity only.
+private func acceptsGzip(_ v: UnsafeBufferPointer<U8>?) -> Bool {
+    guard let v else { return true }
+    var gzip: Bool? = nil
+    var any: Bool? = nil
+    var i = 0
+    while i < v.count {
+        while i < v.count && (v[i] == 0x2C || httpIsSpace(v[i])) { i += 1 }
+        var j = i
+        while j < v.count && v[j] != 0x2C { j += 1 }
+        var e = i
+        while e < j && v[e] != 0x3B { e += 1 }
+        var te = e
+        while te > i && httpIsSpace(v[te - 1]) { te -= 1 }
+
+        let ok = !qualityIsZero(v, e, j)
+        if httpEqualIgnoringCase(v, i..<te, "gzip") || httpEqualIgnoringCase(v, i..<te, "x-gzip") {
+            gzip = (gzip ?? false) || ok
+        } else if httpEqualIgnoringCase(v, i..<te, "*") {
+            any = ok
+        }
+        i = j
     }
-    return nil
+    return gzip ?? any ?? false
 }
 
-@inline(__always)
-private func findByte(_ bytes: [U8], byte: U8, start: Int) -> Int? {
+/// A "q=0" (0.0, 0.000, ...) among the ";"-separated parameters in v[start..<end].
+private func qualityIsZero(_ v: UnsafeBufferPointer<U8>, _ start: Int, _ end: Int) -> Bool {
     var i = start
-    while i < bytes.count {
-        if bytes[i] == byte { return i }
-        i += 1
+    while i < end {
+        i += 1    // ';'
+        while i < end && httpIsSpace(v[i]) { i += 1 }
+        var j = i
+        while j < end && v[j] != 0x3B { j += 1 }
+
+        var k = i + 1
+        if k < j && httpLower(v[i]) == 0x71 {
+            while k < j && httpIsSpace(v[k]) { k += 1 }
+            if k < j && v[k] == 0x3D {
+                k += 1
+                while k < j && httpIsSpace(v[k]) { k += 1 }
+                var zero = k < j
+                while k < j && !httpIsSpace(v[k]) {
+                    if v[k] != 0x30 && v[k] != 0x2E { zero = false }
+                    k += 1
+                }
+                return zero
+            }
+        }
+        i = j
     }
-    return nil
-}
-
-@inline(__always)
-private func ltrimSpaces(_ bytes: [U8]) -> [U8] {
-    var i = 0
-    while i < bytes.count && (bytes[i] == 0x20 || bytes[i] == 0x09) { i += 1 }
-    if i == 0 { return bytes }
-    return Array(bytes[i..<bytes.count])
-}
-
-@inline(__always)
-private func rtrimSpaces(_ bytes: [U8]) -> [U8] {
-    if bytes.isEmpty { return bytes }
-    var j = bytes.count - 1
-    while true {
-        let b = bytes[j]
-        if b != 0x20 && b != 0x09 { break }
-        if j == 0 { return [] }
-        j -= 1
-    }
-    return Array(bytes[0...j])
+    return false
 }
 
-@inline(__always)
-private func asciiEqual(_ a: [U8], _ b: [U8]) -> Bool {
-    if a.count != b.count { return false }
+/// If-None-Match: "*" or a comma-separated list of entity tags (weak comparison).
+private func etagListMatches(_ v: UnsafeBufferPointer<U8>, _ etag: UnsafeBufferPointer<U8>) -> Bool {
     var i = 0
-    while i < a.count {
-        if a[i] != b[i] { return false }
-        i += 1
-    }
-    return true
-}
-
-@inline(__always)
-private func asciiCaseInsensitiveEqual(_ a: [U8], _ b: [U8]) -> Bool {
-    if a.count != b.count { return false }
-    var i = 0
-    while i < a.count {
-        if asciiLower(a[i]) != asciiLower(b[i]) { return false }
-        i += 1
+    while i < v.count {
+        while i < v.count && (v[i] == 0x2C || httpIsSpace(v[i])) { i += 1 }
+        var j = i
+        while j < v.count && v[j] != 0x2C { j += 1 }
+        var e = j
+        while e > i && httpIsSpace(v[e - 1]) { e -= 1 }
+
+        var s = i
+        if e - s == 1 && v[s] == 0x2A { return true }
+        if e - s > 2 && v[s] == 0x57 && v[s + 1] == 0x2F { s += 2 }    // W/
+        if e - s == etag.count {
+            var k = 0
+            while k < etag.count && v[s + k] == etag[k] { k += 1 }
+            if k == etag.count { return true }
+        }
+        i = j
     }
-    return true
+    return false
 }
 
 @inline(__always)
-private func asciiLower(_ b: U8) -> U8 {
-    if b >= 0x41 && b <= 0x5A { return b &+ 0x20 }
-    return b
+private func cStringBytes(_ p: UnsafePointer<CChar>?) -> UnsafeBufferPointer<U8> {
+    guard let p else { return UnsafeBufferPointer(start: nil, count: 0) }
+    var n = 0
+    while p[n] != 0 { n += 1 }
+    return UnsafeBufferPointer(start: UnsafeRawPointer(p).assumingMemoryBound(to: U8.self), count: n)
 }
 
-@inline(__always)
-private func asciiParseInt(_ bytes: [U8]) -> Int? {
-    var i = 0
-    while i < bytes.count && (bytes[i] == 0x20 || bytes[i] == 0x09) { i += 1 }
-    if i >= bytes.count { return nil }
-
-    var sign = 1
-    if bytes[i] == 0x2D { sign = -1; i += 1 }
+/// "GET, HEAD, POST, OPTIONS" style list for `mask` (bit = 1 << rawValue).
+/// GET implies HEAD; OPTIONS is always answered.
+private func allowValue(_ mask: U32) -> [U8] {
+    var m = mask | (1 << U32(HTTPMethod.options.rawValue))
+    if m & (1 << U32(HTTPMethod.get.rawValue)) != 0 { m |= 1 << U32(HTTPMethod.head.rawValue) }
 
-    var val = 0
-    var any = false
-    while i < bytes.count {
-        let b = bytes[i]
-        if b < 0x30 || b > 0x39 { break }
-        any = true
-        val = val * 10 + Int(b - 0x30)
-        i += 1
+    var out: [U8] = []
+    var raw: U8 = 1
+    while raw <= 7 {
+        if m & (1 << U32(raw)) != 0, let method = HTTPMethod(rawValue: raw) {
+            if !out.isEmpty { out += Array(", ".utf8) }
+            let name = method.name
+            out.append(contentsOf: UnsafeBufferPointer(start: name.utf8Start, count: name.utf8CodeUnitCount))
+        }
+        raw += 1
     }
-    return any ? (val * sign) : nil
+    return out
 }
 
 @inline(__always)
 private func asciiInt(_ v: I32) -> [U8] {
-    var n = v
-    if n == 0 { return [0x30] }
-
-    var out: [U8] = []
-    if n < 0 { out.append(0x2D); n = -n }
-
-    var tmp: [U8] = []
-    while n > 0 {
-        let d = U8(n % 10)
-        tmp.append(0x30 &+ d)
-        n /= 10
-    }
-
-    var i = tmp.count
-    while i > 0 {
-        i -= 1
-        out.append(tmp[i])
-    }
-
-    return out
+    var f = FormatBuffer()
+    f.append(v)
+    return f.withUnsafeBytes { Array($0) }
 }
 
 @inline(__always)
@@ -615,18 +1037,4 @@ private func asciiString(_ bytes: [U8]) -> String {
         i += 1
     }
     return String(cString: buf)
-}
-
-@inline(__always)
-private func staticUTF8(_ s: StaticString) -> [U8] {
-    let utf8 = s.utf8Start
-    let len = s.utf8CodeUnitCount
-    var out: [U8] = []
-    out.reserveCapacity(len)
-    var i = 0
-    while i < len {
-        out.append(U8(utf8[i]))
-        i += 1
-    }
-    return out
 }
\ No newline at end of file
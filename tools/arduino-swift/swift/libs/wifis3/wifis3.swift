@@ -24,7 +24,26 @@ public struct WiFiS3IP: Sendable {
         )
     }
 
-    public func toString() -> String { "\(a).\(b).\(c).\(d)" }
+    public func toString() -> String {
+        var f = FormatBuffer()
+        format(into: &f)
+        return f.toString()
+    }
+
+    /// Dotted quad into a caller buffer (no allocation).
+    public func format(into f: inout FormatBuffer) {
+        f.append(a); f.append(byte: 0x2E)
+        f.append(b); f.append(byte: 0x2E)
+        f.append(c); f.append(byte: 0x2E)
+        f.append(d)
+    }
+
+    public func print() {
+        var f = FormatBuffer()
+        format(into: &f)
+        f.print()
+    }
+
     public var isZero: Bool { a == 0 && b == 0 && c == 0 && d == 0 }
 }
 
@@ -0,0 +1,198 @@
+// adc_ring_test.c
+// AdcStream.c block ring on the host: layout, reserve/commit order, the
+// scratch-block overrun path, push() framing, and a two-thread stress where a
+// pthread producer plays the ISR / DMA side against the consumer loop.
+
+#include "AdcStream.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int g_failures;
+
+#define CHECK(cond, ...)                            \
+  do {                                              \
+    if (!(cond)) {                                  \
+      if (g_failures++ < 20) {                      \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__);                        \
+        printf("\n");                               \
+      }                                             \
+    }                                               \
+  } while (0)
+
+static uint8_t g_storage[64 * 1024] __attribute__((aligned(32)));
+
+static void test_init(void) {
+  arduino_adc_ring_t r;
+  CHECK(!arduino_adc_ring_init(&r, g_storage, 8, 3), "non power of two accepted");
+  CHECK(!arduino_adc_ring_init(&r, g_storage, 8, 1), "one block accepted");
+  CHECK(!arduino_adc_ring_init(&r, g_storage, 0, 4), "empty blocks accepted");
+  CHECK(!arduino_adc_ring_init(&r, NULL, 8, 4), "NULL storage accepted");
+
+  CHECK(arduino_adc_ring_init(&r, g_storage, 10, 4), "init");
+  CHECK(r.stride == 16, "stride %u, expected 16", r.stride);
+  CHECK(((uintptr_t)r.samples & 31u) == 0, "samples not 32-byte aligned");
+
+  // Every block (and the scratch block) starts on a 32-byte boundary inside the storage.
+  const uint32_t bytes = arduino_adc_ring_bytes(10, 4);
+  const uint8_t* end = (const uint8_t*)(r.samples + 5u * r.stride);
+  CHECK(end <= g_storage + bytes, "scratch block past arduino_adc_ring_bytes()");
+  CHECK((const uint8_t*)r.samples >= (const uint8_t*)(r.stamps + 4), "stamps overlap samples");
+
+  CHECK(arduino_adc_stream_prepare(g_storage + 2, 2, 8, 4) == 0, "unaligned storage accepted");
+  CHECK(arduino_adc_stream_prepare(g_storage, ARDUINO_ADC_STREAM_MAX_CHANNELS + 1u, 8, 4) == 0,
+        "too many channels accepted");
+  CHECK(arduino_adc_stream_prepare(g_storage, 2, 8, 4) == 1, "prepare");
+  CHECK(g_adc_stream.block_len == 16, "stream block_len %u", g_adc_stream.block_len);
+}
+
+static void test_reserve_commit(void) {
+  arduino_adc_ring_t r;
+  arduino_adc_ring_init(&r, g_storage, 4, 4);
+
+  // DMA double buffering: two blocks in flight, committed in order.
+  uint16_t* a = arduino_adc_ring_reserve(&r);
+  uint16_t* b = arduino_adc_ring_reserve(&r);
+  CHECK(a != b, "two reservations share a block");
+  CHECK(arduino_adc_ring_available(&r) == 0, "reserved blocks visible to the consumer");
+
+  for (int i = 0; i < 4; i++) a[i] = (uint16_t)(100 + i);
+  arduino_adc_ring_commit(&r, a, 1000);
+  CHECK(arduino_adc_ring_available(&r) == 1, "available %u after one commit", arduino_adc_ring_available(&r));
+
+  uint32_t stamp = 0;
+  const uint16_t* got = arduino_adc_ring_peek(&r, &stamp);
+  CHECK(got == a && stamp == 1000 && got[3] == 103, "peek returned the wrong block");
+  arduino_adc_ring_release(&r);
+  CHECK(arduino_adc_ring_peek(&r, NULL) == NULL, "peek on an empty ring");
+  arduino_adc_ring_release(&r);  // no-op when empty
+  CHECK(r.tail == 1, "release on an empty ring moved tail");
+
+  // Fill the ring: b + 3 more reservations = 4 slots, the 5th is scratch.
+  uint16_t* c = arduino_adc_ring_reserve(&r);
+  uint16_t* d = arduino_adc_ring_reserve(&r);
+  uint16_t* e = arduino_adc_ring_reserve(&r);
+  uint16_t* s = arduino_adc_ring_reserve(&r);
+  CHECK(c && d && e, "reserve failed with free slots");
+  CHECK(s == r.samples + 4u * r.stride, "full ring did not hand out the scratch block");
+
+  arduino_adc_ring_commit(&r, b, 2000);
+  arduino_adc_ring_commit(&r, c, 3000);
+  arduino_adc_ring_commit(&r, d, 4000);
+  arduino_adc_ring_commit(&r, e, 5000);
+  arduino_adc_ring_commit(&r, s, 6000);
+  CHECK(r.overruns == 1 && r.total == 6, "overruns %u total %u", r.overruns, r.total);
+  CHECK(arduino_adc_ring_available(&r) == 4, "available %u, expected 4", arduino_adc_ring_available(&r));
+
+  // Queued blocks are never overwritten: the stamps come out in commit order.
+  const uint32_t want[] = { 2000, 3000, 4000, 5000 };
+  for (int i = 0; i < 4; i++) {
+    arduino_adc_ring_peek(&r, &stamp);
+    CHECK(stamp == want[i], "block %d stamp %u, expected %u", i, stamp, want[i]);
+    arduino_adc_ring_release(&r);
+  }
+}
+
+static void test_push(void) {
+  arduino_adc_ring_t r;
+  arduino_adc_ring_init(&r, g_storage, 3, 2);
+
+  // 3 samples per block; 4 blocks pushed into a 2-block ring with no consumer.
+  for (uint32_t i = 0; i < 12; i++) arduino_adc_ring_push(&r, (uint16_t)i, 10u * i);
+
+  CHECK(r.total == 4 && r.overruns == 2, "total %u overruns %u", r.total, r.overruns);
+  uint32_t stamp = 0;
+  const uint16_t* b = arduino_adc_ring_peek(&r, &stamp);
+  CHECK(b && b[0] == 0 && b[2] == 2 && stamp == 20, "first block %u..%u stamp %u",
+        b ? b[0] : 0, b ? b[2] : 0, stamp);
+  arduino_adc_ring_release(&r);
+  b = arduino_adc_ring_peek(&r, &stamp);
+  CHECK(b && b[0] == 3 && stamp == 50, "second block starts at %u stamp %u", b ? b[0] : 0, stamp);
+  arduino_adc_ring_release(&r);
+  CHECK(arduino_adc_ring_available(&r) == 0, "ring not empty");
+
+  // A partly filled block is not visible.
+  arduino_adc_ring_push(&r, 7, 0);
+  CHECK(arduino_adc_ring_available(&r) == 0, "partial block visible");
+}
+
+// ----------------------
+// Two-thread stress
+// ----------------------
+
+#define STRESS_BLOCKS   (1u << 20)
+#define STRESS_LEN      24u
+
+static arduino_adc_ring_t g_ring;
+static volatile int       g_done;
+
+// Block n carries samples n*STRESS_LEN + i (mod 2^16) and stamp n. A full
+// ring yields the CPU (a fixed-rate DMA would simply keep dropping), so the
+// consumer also runs on single-core hosts.
+static void* producer(void* arg) {
+  (void)arg;
+  for (uint32_t n = 0; n < STRESS_BLOCKS; n++) {
+    uint16_t* blk = arduino_adc_ring_reserve(&g_ring);
+    const int dropped = blk == g_ring.samples + (g_ring.mask + 1u) * g_ring.stride;
+    for (uint32_t i = 0; i < STRESS_LEN; i++) blk[i] = (uint16_t)(n * STRESS_LEN + i);
+    arduino_adc_ring_commit(&g_ring, blk, n);
+    if (dropped) sched_yield();
+  }
+  __atomic_store_n(&g_done, 1, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+static void test_threads(void) {
+  static uint8_t storage[64 * 1024] __attribute__((aligned(32)));
+  CHECK(arduino_adc_ring_bytes(STRESS_LEN, 16) <= sizeof(storage), "stress storage too small");
+  arduino_adc_ring_init(&g_ring, storage, STRESS_LEN, 16);
+
+  pthread_t th;
+  pthread_create(&th, NULL, producer, NULL);
+
+  uint32_t received = 0, last = 0, bad = 0;
+  int first = 1;
+  for (;;) {
+    uint32_t stamp = 0;
+    const uint16_t* b = arduino_adc_ring_peek(&g_ring, &stamp);
+    if (!b) {
+      if (__atomic_load_n(&g_done, __ATOMIC_ACQUIRE) && arduino_adc_ring_available(&g_ring) == 0) break;
+      sched_yield();
+      continue;
+    }
+
+    for (uint32_t i = 0; i < STRESS_LEN; i++) {
+      if (b[i] != (uint16_t)(stamp * STRESS_LEN + i)) {
+        bad++;
+        break;
+      }
+    }
+    if (!first && stamp <= last) bad++;
+    first = 0;
+    last = stamp;
+    received++;
+    arduino_adc_ring_release(&g_ring);
+  }
+  pthread_join(th, NULL);
+
+  CHECK(bad == 0, "%u torn or out-of-order blocks", bad);
+  CHECK(received + g_ring.overruns == STRESS_BLOCKS, "received %u + overruns %u != %u",
+        received, g_ring.overruns, STRESS_BLOCKS);
+  CHECK(g_ring.total == STRESS_BLOCKS, "total %u", g_ring.total);
+  printf("adc ring stress: %u blocks, %u delivered, %u overruns\n",
+         STRESS_BLOCKS, received, g_ring.overruns);
+}
+
+int main(void) {
+  test_init();
+  test_reserve_commit();
+  test_push();
+  test_threads();
+  printf("adc ring: %d failures\n", g_failures);
+  return g_failures == 0 ? 0 : 1;
+}
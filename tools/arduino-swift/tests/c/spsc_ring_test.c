@@ -0,0 +1,281 @@
+// spsc_ring_test.c
+// SpscRing.h on the host: single-thread edge cases (wrap, overflow counting,
+// bulk copies and spans across the wrap), a two-thread stress mixing every
+// producer and consumer entry point, and HwTimer.c's per-slot event queue driven
+// by a pthread standing in for the timer ISR.
+
+#include "SpscRing.h"
+#include "HwTimer.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int g_failures;
+
+#define CHECK(cond, ...)                            \
+  do {                                              \
+    if (!(cond)) {                                  \
+      if (g_failures++ < 20) {                      \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__);                        \
+        printf("\n");                               \
+      }                                             \
+    }                                               \
+  } while (0)
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint32_t rnd(void) {
+  g_rng ^= g_rng >> 12;
+  g_rng ^= g_rng << 25;
+  g_rng ^= g_rng >> 27;
+  return (uint32_t)((g_rng * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+// Three words derived from one sequence number: a torn copy breaks the relation.
+typedef struct {
+  uint32_t seq;
+  uint32_t inv;
+  uint32_t mix;
+} elem_t;
+
+static elem_t make_elem(uint32_t seq) {
+  elem_t e = { seq, ~seq, seq * 0x9E3779B1u };
+  return e;
+}
+
+static int elem_ok(const elem_t* e, uint32_t want) {
+  return e->seq == want && e->inv == ~want && e->mix == want * 0x9E3779B1u;
+}
+
+// ----------------------
+// Single thread
+// ----------------------
+
+static void test_basic(void) {
+  static elem_t storage[8];
+  arduino_spsc_t r;
+  CHECK(!arduino_spsc_init(&r, storage, sizeof(elem_t), 6), "non power of two accepted");
+  CHECK(!arduino_spsc_init(&r, storage, 0, 8), "zero element size accepted");
+  CHECK(!arduino_spsc_init(&r, NULL, sizeof(elem_t), 8), "NULL storage accepted");
+  CHECK(arduino_spsc_init(&r, storage, sizeof(elem_t), 8), "init");
+  CHECK(arduino_spsc_capacity(&r) == 8 && arduino_spsc_free(&r) == 8, "fresh ring not empty");
+
+  // Push past capacity: the extra elements are counted, never written.
+  for (uint32_t i = 0; i < 10; i++) {
+    const elem_t e = make_elem(i);
+    CHECK(arduino_spsc_push(&r, &e) == (i < 8), "push %u", i);
+  }
+  CHECK(arduino_spsc_count(&r) == 8 && arduino_spsc_overflows(&r) == 2,
+        "count %u overflows %u", arduino_spsc_count(&r), arduino_spsc_overflows(&r));
+
+  elem_t e;
+  for (uint32_t i = 0; i < 5; i++) {
+    CHECK(arduino_spsc_pop(&r, &e) && elem_ok(&e, i), "pop %u", i);
+  }
+
+  // head = 8, tail = 5: 5 of the 6 bulk elements fit; the bulk pop then wraps.
+  elem_t in[6], out[8];
+  for (uint32_t i = 0; i < 6; i++) in[i] = make_elem(100 + i);
+  CHECK(arduino_spsc_push_bulk(&r, in, 6) == 5, "bulk push over free space");
+  CHECK(arduino_spsc_overflows(&r) == 3, "overflows %u, expected 3", arduino_spsc_overflows(&r));
+
+  CHECK(arduino_spsc_pop_bulk(&r, out, 8) == 8, "bulk pop");
+  for (uint32_t i = 0; i < 3; i++) CHECK(elem_ok(&out[i], 5 + i), "out[%u]", i);
+  for (uint32_t i = 0; i < 5; i++) CHECK(elem_ok(&out[3 + i], 100 + i), "out[%u]", 3 + i);
+  CHECK(arduino_spsc_pop(&r, &e) == 0, "pop on an empty ring");
+
+  // Spans stop at the wrap: head and tail are both 13 (slot 5).
+  uint32_t n = 0;
+  elem_t* w = (elem_t*)arduino_spsc_write_span(&r, &n);
+  CHECK(w && n == 3, "write span %u, expected 3 up to the wrap", n);
+  for (uint32_t i = 0; i < n; i++) w[i] = make_elem(200 + i);
+  arduino_spsc_write_commit(&r, n);
+  w = (elem_t*)arduino_spsc_write_span(&r, &n);
+  CHECK(w == storage && n == 5, "second write span %u", n);
+  for (uint32_t i = 0; i < n; i++) w[i] = make_elem(203 + i);
+  arduino_spsc_write_commit(&r, n);
+  CHECK(arduino_spsc_write_span(&r, &n) == NULL && n == 0, "write span on a full ring");
+
+  const elem_t* s = (const elem_t*)arduino_spsc_read_span(&r, &n);
+  CHECK(s && n == 3 && elem_ok(&s[2], 202), "read span %u", n);
+  arduino_spsc_read_release(&r, n);
+  s = (const elem_t*)arduino_spsc_read_span(&r, &n);
+  CHECK(s == storage && n == 5 && elem_ok(&s[4], 207), "second read span %u", n);
+
+  arduino_spsc_clear(&r);
+  CHECK(arduino_spsc_count(&r) == 0 && arduino_spsc_read_span(&r, &n) == NULL, "clear");
+}
+
+// ----------------------
+// Two-thread stress
+// ----------------------
+
+#define STRESS_ELEMS  (1u << 21)
+#define STRESS_CAP    64u
+#define STRESS_BATCH  19u   // not a divisor of the capacity: bulk copies wrap
+
+static elem_t         g_storage[STRESS_CAP];
+static arduino_spsc_t g_ring;
+
+// Lossless: a full ring yields and retries, so every sequence number must
+// arrive exactly once and in order. The three producer paths are mixed at
+// random; overflows only count the retried attempts.
+static void* producer(void* arg) {
+  (void)arg;
+  uint64_t rng = 0xD1B54A32D192ED03ull;
+  uint32_t seq = 0;
+  while (seq < STRESS_ELEMS) {
+    rng ^= rng >> 12; rng ^= rng << 25; rng ^= rng >> 27;
+    const uint32_t mode = (uint32_t)(rng >> 60) % 3u;
+    uint32_t done = 0;
+
+    if (mode == 0) {
+      const elem_t e = make_elem(seq);
+      done = arduino_spsc_push(&g_ring, &e);
+    } else if (mode == 1) {
+      elem_t batch[STRESS_BATCH];
+      uint32_t k = STRESS_ELEMS - seq < STRESS_BATCH ? STRESS_ELEMS - seq : STRESS_BATCH;
+      if (k > arduino_spsc_free(&g_ring)) k = arduino_spsc_free(&g_ring);
+      for (uint32_t i = 0; i < k; i++) batch[i] = make_elem(seq + i);
+      done = k ? arduino_spsc_push_bulk(&g_ring, batch, k) : 0;
+    } else {
+      uint32_t n = 0;
+      elem_t* w = (elem_t*)arduino_spsc_write_span(&g_ring, &n);
+      if (w) {
+        if (n > STRESS_ELEMS - seq) n = STRESS_ELEMS - seq;
+        for (uint32_t i = 0; i < n; i++) w[i] = make_elem(seq + i);
+        arduino_spsc_write_commit(&g_ring, n);
+        done = n;
+      }
+    }
+
+    seq += done;
+    if (!done) sched_yield();
+  }
+  return NULL;
+}
+
+static void test_threads(void) {
+  arduino_spsc_init(&g_ring, g_storage, sizeof(elem_t), STRESS_CAP);
+
+  pthread_t th;
+  pthread_create(&th, NULL, producer, NULL);
+
+  // A bad element is counted, not fatal: stopping early would leave the
+  // producer waiting on a full ring.
+  uint32_t next = 0, bad = 0;
+  while (next < STRESS_ELEMS) {
+    const uint32_t mode = rnd() % 3u;
+    uint32_t got = 0;
+
+    if (mode == 0) {
+      elem_t e;
+      if (arduino_spsc_pop(&g_ring, &e)) {
+        if (!elem_ok(&e, next)) bad++;
+        got = 1;
+      }
+    } else if (mode == 1) {
+      elem_t out[STRESS_BATCH];
+      got = arduino_spsc_pop_bulk(&g_ring, out, 1u + rnd() % STRESS_BATCH);
+      for (uint32_t i = 0; i < got; i++) if (!elem_ok(&out[i], next + i)) bad++;
+    } else {
+      const elem_t* s = (const elem_t*)arduino_spsc_read_span(&g_ring, &got);
+      for (uint32_t i = 0; i < got; i++) if (!elem_ok(&s[i], next + i)) bad++;
+      if (got) arduino_spsc_read_release(&g_ring, got);
+    }
+
+    next += got;
+    if (!got) sched_yield();
+  }
+  pthread_join(th, NULL);
+
+  CHECK(bad == 0, "%u torn, lost or reordered elements", bad);
+  CHECK(arduino_spsc_count(&g_ring) == 0, "%u elements left over", arduino_spsc_count(&g_ring));
+  printf("spsc stress: %u elements through %u slots, %u full-ring retries\n",
+         next, STRESS_CAP, arduino_spsc_overflows(&g_ring));
+}
+
+// ----------------------
+// HwTimer queue (board hooks stubbed: one slot, a counting clock)
+// ----------------------
+
+static uint32_t g_clock;
+
+uint32_t arduino_hwtimer_hw_slots(void) { return 1; }
+uint32_t arduino_hwtimer_hw_open(uint32_t slot, uint32_t period_us) { (void)slot; (void)period_us; return 1; }
+void     arduino_hwtimer_hw_close(uint32_t slot) { (void)slot; }
+uint32_t arduino_hwtimer_now_us(void) { return ++g_clock; }
+
+uint32_t arduino_fastio_resolve(uint32_t pin, uintptr_t* out) { (void)pin; (void)out; return 0; }
+void     arduino_fastio_toggle(const uintptr_t* h) { (void)h; }
+
+#define TIMER_TICKS (1u << 20)
+
+static volatile int g_timer_done;
+
+static void* timer_isr(void* arg) {
+  const uint32_t slot = (uint32_t)(uintptr_t)arg;
+  for (uint32_t i = 0; i < TIMER_TICKS; i++) {
+    arduino_hwtimer_isr(slot);
+    if ((i & 7u) == 0) sched_yield();
+  }
+  __atomic_store_n(&g_timer_done, 1, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+static void test_hwtimer(void) {
+  const int32_t slot = arduino_hwtimer_open(100);
+  CHECK(slot == 0, "open returned %d", slot);
+  if (slot < 0) return;
+
+  // No consumer: the queue keeps the oldest events, the rest are counted.
+  for (uint32_t i = 0; i < ARDUINO_HWTIMER_QUEUE + 5u; i++) arduino_hwtimer_isr((uint32_t)slot);
+  CHECK(arduino_hwtimer_dropped((uint32_t)slot) == 5, "dropped %u", arduino_hwtimer_dropped((uint32_t)slot));
+  uint32_t stamp = 0;
+  CHECK(arduino_hwtimer_pop((uint32_t)slot, &stamp) && stamp == 1, "oldest event stamp %u", stamp);
+
+  // Reopening starts a fresh queue.
+  arduino_hwtimer_close((uint32_t)slot);
+  CHECK(arduino_hwtimer_open(100) == slot, "reopen");
+  CHECK(arduino_hwtimer_pop((uint32_t)slot, NULL) == 0, "queue survived close / open");
+  CHECK(arduino_hwtimer_dropped((uint32_t)slot) == 0, "dropped survived close / open");
+
+  pthread_t th;
+  pthread_create(&th, NULL, timer_isr, (void*)(uintptr_t)slot);
+
+  uint32_t popped = 0, bad = 0, last = 0;
+  for (;;) {
+    if (!arduino_hwtimer_pop((uint32_t)slot, &stamp)) {
+      // Done is published after the last push: one more pop drains it.
+      if (__atomic_load_n(&g_timer_done, __ATOMIC_ACQUIRE)) {
+        if (!arduino_hwtimer_pop((uint32_t)slot, &stamp)) break;
+      } else {
+        sched_yield();
+        continue;
+      }
+    }
+    if (stamp <= last) bad++;
+    last = stamp;
+    popped++;
+  }
+  pthread_join(th, NULL);
+  arduino_hwtimer_close((uint32_t)slot);
+
+  const uint32_t dropped = arduino_hwtimer_dropped((uint32_t)slot);
+  CHECK(bad == 0, "%u out-of-order timer events", bad);
+  CHECK(popped + dropped == TIMER_TICKS, "popped %u + dropped %u != %u", popped, dropped, TIMER_TICKS);
+  printf("hwtimer stress: %u ticks, %u popped, %u dropped\n", TIMER_TICKS, popped, dropped);
+}
+
+int main(void) {
+  test_basic();
+  test_threads();
+  test_hwtimer();
+  printf("spsc ring: %d failures\n", g_failures);
+  return g_failures == 0 ? 0 : 1;
+}
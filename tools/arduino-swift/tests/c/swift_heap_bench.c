@@ -0,0 +1,272 @@
+// swift_heap_bench.c
+// SwiftHeap (TLSF) on the host: randomized stress with content/overlap checks,
+// then a fragmentation and timing benchmark against the host malloc.
+//
+// Checks (exit 1 on failure):
+// - alignment, ownership and usable size of every block
+// - no two live blocks overlap (each block carries its own fill pattern)
+// - after freeing everything the arena is one free block again
+//
+// Benchmark (printed):
+// - utilization at the first failed allocation under a Swift-like size mix
+// - fragmentation (1 - largest free / free bytes) over a long churn
+// - mean and worst-case ns per alloc and per free (worst case on a desktop OS
+//   includes preemption; compare the means with the host malloc line)
+
+#include "SwiftHeap.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_LIVE 2048
+
+typedef struct {
+  uint8_t* p;
+  size_t   size;
+  uint8_t  fill;
+} live_t;
+
+static live_t   g_live[MAX_LIVE];
+static int      g_live_count;
+static int      g_failures;
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint32_t rnd(void) {
+  g_rng ^= g_rng >> 12;
+  g_rng ^= g_rng << 25;
+  g_rng ^= g_rng >> 27;
+  return (uint32_t)((g_rng * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+static uint64_t now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Cost of one now_ns() pair, subtracted from every timed operation.
+static uint64_t g_clock_cost;
+
+static void calibrate_clock(void) {
+  uint64_t best = UINT64_MAX;
+  for (int i = 0; i < 10000; i++) {
+    const uint64_t t0 = now_ns();
+    const uint64_t d = now_ns() - t0;
+    if (d < best) best = d;
+  }
+  g_clock_cost = best;
+}
+
+static uint64_t elapsed_since(uint64_t t0) {
+  const uint64_t d = now_ns() - t0;
+  return d > g_clock_cost ? d - g_clock_cost : 0;
+}
+
+#define CHECK(cond, ...)                          \
+  do {                                            \
+    if (!(cond)) {                                \
+      if (g_failures++ < 20) {                    \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__);                      \
+        printf("\n");                             \
+      }                                           \
+    }                                             \
+  } while (0)
+
+// Swift-like mix: mostly small objects (class instances, boxes), some arrays.
+static size_t pick_size(void) {
+  uint32_t r = rnd() % 100;
+  if (r < 60) return 8 + rnd() % 56;       // 8..63
+  if (r < 85) return 64 + rnd() % 192;     // 64..255
+  if (r < 97) return 256 + rnd() % 768;    // 256..1023
+  return 1024 + rnd() % 3072;              // 1 KiB..4 KiB
+}
+
+static size_t pick_align(void) {
+  static const size_t aligns[] = { 0, 0, 0, 8, 16, 32, 64 };
+  return aligns[rnd() % (sizeof(aligns) / sizeof(aligns[0]))];
+}
+
+static int overlaps_live(const uint8_t* p, size_t size) {
+  for (int i = 0; i < g_live_count; i++) {
+    const uint8_t* q = g_live[i].p;
+    if (p < q + g_live[i].size && q < p + size) return 1;
+  }
+  return 0;
+}
+
+static void verify_and_free(int i) {
+  live_t* l = &g_live[i];
+  for (size_t k = 0; k < l->size; k++) {
+    if (l->p[k] != l->fill) {
+      CHECK(0, "block %p (%zu bytes) overwritten at +%zu", (void*)l->p, l->size, k);
+      break;
+    }
+  }
+  swift_heap_free(l->p);
+  g_live[i] = g_live[--g_live_count];
+}
+
+static void free_all(void) {
+  while (g_live_count > 0) verify_and_free(g_live_count - 1);
+}
+
+// ----------------------
+// Stress
+// ----------------------
+
+static void stress(uint8_t* arena, size_t bytes, int rounds) {
+  CHECK(swift_heap_init(arena, bytes), "init %zu", bytes);
+  const size_t empty = swift_heap_free_bytes();
+  CHECK(swift_heap_largest_free() == empty, "fresh heap is not one block");
+
+  for (int r = 0; r < rounds; r++) {
+    if (g_live_count > 0 && (g_live_count >= MAX_LIVE || rnd() % 100 < 45)) {
+      verify_and_free((int)(rnd() % (uint32_t)g_live_count));
+      continue;
+    }
+
+    const size_t size = pick_size();
+    const size_t align = pick_align();
+    uint8_t* p = (uint8_t*)swift_heap_alloc(size, align);
+    if (!p) {
+      // Full: drop a third of the live set and keep going.
+      for (int k = g_live_count / 3; k > 0; k--) verify_and_free((int)(rnd() % (uint32_t)g_live_count));
+      continue;
+    }
+
+    CHECK(((uintptr_t)p & ((align ? align : 8) - 1)) == 0, "%p not aligned to %zu", (void*)p, align);
+    CHECK(swift_heap_owns(p), "%p not owned", (void*)p);
+    CHECK(swift_heap_block_size(p) >= size, "block_size %zu < %zu", swift_heap_block_size(p), size);
+    CHECK(p >= arena && p + size <= arena + bytes, "%p outside the arena", (void*)p);
+    CHECK(!overlaps_live(p, size), "%p (%zu bytes) overlaps a live block", (void*)p, size);
+
+    live_t* l = &g_live[g_live_count++];
+    l->p = p;
+    l->size = size;
+    l->fill = (uint8_t)rnd();
+    memset(p, l->fill, size);
+  }
+
+  free_all();
+  CHECK(swift_heap_free_bytes() == empty, "free bytes %zu after freeing all, expected %zu",
+        swift_heap_free_bytes(), empty);
+  CHECK(swift_heap_largest_free() == empty, "arena did not coalesce back (largest %zu of %zu)",
+        swift_heap_largest_free(), empty);
+}
+
+// ----------------------
+// Benchmark
+// ----------------------
+
+typedef void* (*alloc_fn)(size_t size);
+typedef void  (*free_fn)(void* p);
+
+static void* tlsf_alloc(size_t size) { return swift_heap_alloc(size, 0); }
+static void  tlsf_free(void* p)      { swift_heap_free(p); }
+
+typedef struct {
+  double   alloc_mean, free_mean;
+  uint64_t alloc_max, free_max;
+} timing_t;
+
+static timing_t churn(alloc_fn af, free_fn ff, int rounds, int target_live, double* frag_peak, double* frag_mean) {
+  static void* slots[MAX_LIVE];
+  int live = 0;
+  uint64_t at = 0, ft = 0;
+  timing_t t = { 0, 0, 0, 0 };
+  int na = 0, nf = 0, nfrag = 0;
+  double fsum = 0;
+
+  if (frag_peak) *frag_peak = 0;
+
+  for (int r = 0; r < rounds; r++) {
+    if (live > 0 && (live >= target_live || rnd() % 100 < 48)) {
+      const int i = (int)(rnd() % (uint32_t)live);
+      const uint64_t t0 = now_ns();
+      ff(slots[i]);
+      const uint64_t d = elapsed_since(t0);
+      ft += d;
+      if (d > t.free_max) t.free_max = d;
+      nf++;
+      slots[i] = slots[--live];
+    } else {
+      const size_t size = pick_size();
+      const uint64_t t0 = now_ns();
+      void* p = af(size);
+      const uint64_t d = elapsed_since(t0);
+      if (!p) continue;
+      at += d;
+      if (d > t.alloc_max) t.alloc_max = d;
+      na++;
+      slots[live++] = p;
+    }
+
+    if (frag_peak && (r & 255) == 0 && swift_heap_free_bytes() > 0) {
+      const double f = 1.0 - (double)swift_heap_largest_free() / (double)swift_heap_free_bytes();
+      if (f > *frag_peak) *frag_peak = f;
+      fsum += f;
+      nfrag++;
+    }
+  }
+
+  while (live > 0) ff(slots[--live]);
+
+  if (frag_mean) *frag_mean = nfrag ? fsum / nfrag : 0;
+  t.alloc_mean = na ? (double)at / na : 0;
+  t.free_mean = nf ? (double)ft / nf : 0;
+  return t;
+}
+
+// Allocates the size mix until the first failure: how much of the arena was usable.
+static double fill_utilization(uint8_t* arena, size_t bytes) {
+  swift_heap_init(arena, bytes);
+  size_t used = 0;
+  for (;;) {
+    const size_t size = pick_size();
+    if (!swift_heap_alloc(size, 0)) break;
+    used += size;
+  }
+  return (double)used / (double)bytes;
+}
+
+int main(void) {
+  static uint8_t arena[256 * 1024] __attribute__((aligned(8)));
+  static const size_t sizes[] = { 16 * 1024, 32 * 1024, 256 * 1024 };
+
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    stress(arena, sizes[i], 200000);
+  }
+  printf("swift_heap stress: 3 arenas x 200000 ops, %d failures\n", g_failures);
+
+  calibrate_clock();
+  printf("\n%-10s %8s %10s %10s %12s %12s %12s %12s\n",
+         "arena", "fill%", "frag mean", "frag peak", "alloc ns", "alloc max", "free ns", "free max");
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    const size_t bytes = sizes[i];
+    const double util = fill_utilization(arena, bytes);
+
+    swift_heap_init(arena, bytes);
+    // Keep roughly half the arena live: ~150 bytes per object on this mix.
+    int target = (int)(bytes / 2 / 150);
+    if (target > MAX_LIVE) target = MAX_LIVE;
+    double fpeak = 0, fmean = 0;
+    const timing_t t = churn(tlsf_alloc, tlsf_free, 500000, target, &fpeak, &fmean);
+
+    printf("%-10zu %7.1f%% %9.1f%% %9.1f%% %12.1f %12llu %12.1f %12llu\n",
+           bytes, util * 100.0, fmean * 100.0, fpeak * 100.0,
+           t.alloc_mean, (unsigned long long)t.alloc_max,
+           t.free_mean, (unsigned long long)t.free_max);
+  }
+
+  const timing_t m = churn(malloc, free, 500000, 600, NULL, NULL);
+  printf("%-10s %8s %10s %10s %12.1f %12llu %12.1f %12llu\n",
+         "host malloc", "-", "-", "-",
+         m.alloc_mean, (unsigned long long)m.alloc_max,
+         m.free_mean, (unsigned long long)m.free_max);
+
+  return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,17 @@
+// HostBoard.swift
+// What FormatBuffer.print() needs from the board, on the host.
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#endif
+
+enum Serial {
+    static func isInitialized() -> Bool { true }
+    static func begin(_ baud: U32) {}
+}
+
+func arduino_serial_print_cstr(_ s: UnsafePointer<CChar>) {
+    fputs(s, stdout)
+}
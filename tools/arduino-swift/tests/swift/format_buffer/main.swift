@@ -0,0 +1,86 @@
+// main.swift
+// FormatBuffer against the C library: append(Double, precision:) vs
+// printf("%.*f"), integers vs printf("%lld" / "%llu" / "%0*lld").
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#endif
+
+func reference(_ format: String, _ args: [CVarArg]) -> String {
+    var buf = [CChar](repeating: 0, count: 512)
+    _ = withVaList(args) { va in vsnprintf(&buf, 512, format, va) }
+    return String(cString: buf)
+}
+
+func expect(_ got: String, _ want: String, _ what: String) {
+    expect(got == want, "\(what): got \(got) want \(want)")
+}
+
+func checkDouble(_ v: Double, _ digits: Int) {
+    var f = FormatBuffer()
+    f.append(v, precision: digits)
+    let got = f.toString()
+    // Past 64 bits once scaled FormatBuffer stops ("ovf"); printf keeps going.
+    if f.truncated || got == "ovf" { return }
+    expect(got, reference("%.*f", [Int32(digits), v]), "\(v) precision \(digits)")
+}
+
+// xorshift64*: same sequence on every run and platform.
+var seed: UInt64 = 0x9E37_79B9_7F4A_7C15
+func next() -> UInt64 {
+    seed ^= seed >> 12
+    seed ^= seed << 25
+    seed ^= seed >> 27
+    return seed &* 0x2545_F491_4F6C_DD1D
+}
+
+// Ties and classic half-up traps.
+let edges: [Double] = [
+    0, -0.0, 0.5, 1.5, 2.5, 0.125, 0.375, -0.001, 0.005, 1.005, 0.045, 2.675,
+    1e-300, 5e-324, 123456789.987654321, 4294967295.5, 4294967296.5,
+    9007199254740993, 1.8e19, -1.8e19, 0.1, 0.2, 0.3, 1.0 / 3.0, 2.0 / 3.0,
+]
+for v in edges {
+    for d in 0...9 { checkDouble(v, d) }
+}
+
+// Random bit patterns, small dyadic fractions (exact ties) and scaled integers.
+for i in 0..<300_000 {
+    let d = i % 10
+    var v: Double
+    switch i % 3 {
+    case 0:  v = Double(bitPattern: next())
+    case 1:  v = Double(Int(next() % 200_000)) / Double(1 << Int(next() % 20))
+    default: v = Double(Int32(truncatingIfNeeded: next())) * pow(2.0, Double(Int(next() % 80) - 60))
+    }
+    if v.isNaN || v.isInfinite { continue }
+    checkDouble(v, d)
+}
+
+for v in [Double.nan, .infinity, -.infinity] {
+    var f = FormatBuffer()
+    f.append(v, precision: 2)
+    expect(f.toString(), v.isNaN ? "nan" : (v < 0 ? "-inf" : "inf"), "\(v)")
+}
+
+// Integers.
+for i in 0..<100_000 {
+    let r = next()
+    let s = Int64(bitPattern: r) >> Int64(i % 64)
+    var f = FormatBuffer()
+    f.append(s)
+    expect(f.toString(), reference("%lld", [s]), "Int64 \(s)")
+
+    f.removeAll()
+    f.append(r >> UInt64(i % 64))
+    expect(f.toString(), reference("%llu", [r >> UInt64(i % 64)]), "UInt64 \(r)")
+
+    let w = i % 24
+    f.removeAll()
+    f.append(Int32(truncatingIfNeeded: r) >> Int32(i % 32), width: w, pad: 0x30)
+    expect(f.toString(), reference("%0*d", [Int32(w), Int32(truncatingIfNeeded: r) >> Int32(i % 32)]), "Int32 width \(w)")
+}
+
+finish(suite: "format_buffer")
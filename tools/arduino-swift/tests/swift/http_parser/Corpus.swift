@@ -0,0 +1,76 @@
+// Corpus.swift
+// Seed requests for the HTTPParser fuzz run: well-formed heads from real
+// clients, the edge cases the parser has rules for, and known-bad input.
+// main.swift checks the listed outcome of each seed, then mutates them.
+
+struct Seed {
+    let text: String
+    let status: HTTPParser.Status
+    let path: String
+    let contentLength: Int
+    let keepAlive: Bool
+    let transferEncoding: Bool
+
+    init(_ text: String, _ status: HTTPParser.Status, path: String = "", contentLength: Int = 0,
+         keepAlive: Bool = false, transferEncoding: Bool = false) {
+        self.text = text
+        self.status = status
+        self.path = path
+        self.contentLength = contentLength
+        self.keepAlive = keepAlive
+        self.transferEncoding = transferEncoding
+    }
+}
+
+let corpus: [Seed] = [
+    // Clients.
+    Seed("GET / HTTP/1.1\r\nHost: 192.168.1.40\r\n\r\n", .complete, path: "/", keepAlive: true),
+    Seed("GET /app.js?v=3 HTTP/1.1\r\nHost: uno.local\r\nUser-Agent: Mozilla/5.0 (X11; Linux x86_64) "
+         + "AppleWebKit/537.36 (KHTML, like Gecko) Chrome/126.0 Safari/537.36\r\nAccept: */*\r\n"
+         + "Accept-Encoding: gzip, deflate, br\r\nAccept-Language: en-US,en;q=0.9\r\n"
+         + "If-None-Match: W/\"5f3a\", \"9b1c\"\r\nReferer: http://uno.local/\r\nConnection: keep-alive\r\n\r\n",
+         .complete, path: "/app.js", keepAlive: true),
+    Seed("POST /api/led HTTP/1.1\r\nHost: uno\r\nContent-Type: application/json\r\nContent-Length: 13\r\n\r\n{\"on\": true}\n",
+         .complete, path: "/api/led", contentLength: 13, keepAlive: true),
+    Seed("GET /metrics HTTP/1.0\r\n\r\n", .complete, path: "/metrics"),
+    Seed("GET /metrics HTTP/1.0\r\nConnection: keep-alive\r\n\r\n", .complete, path: "/metrics", keepAlive: true),
+    Seed("HEAD /index.html HTTP/1.1\r\nConnection: close\r\n\r\n", .complete, path: "/index.html"),
+    Seed("OPTIONS * HTTP/1.1\r\nHost: uno\r\n\r\n", .complete, path: "*", keepAlive: true),
+    Seed("DELETE /users/42 HTTP/1.1\r\nHost: uno\r\ncontent-length:0\r\n\r\n", .complete, path: "/users/42", keepAlive: true),
+
+    // Parser rules.
+    Seed("GET /lf HTTP/1.1\nHost: uno\n\n", .complete, path: "/lf", keepAlive: true),
+    Seed("\r\n\r\nGET /after-blank HTTP/1.1\r\n\r\n", .complete, path: "/after-blank", keepAlive: true),
+    Seed("GET /ws HTTP/1.1\r\nContent-Length :\t 7 \t\r\nCONNECTION:   Close\r\n\r\n", .complete,
+         path: "/ws", contentLength: 7),
+    Seed("GET /nocolon HTTP/1.1\r\nthis line has no colon\r\n\r\n", .complete, path: "/nocolon", keepAlive: true),
+    Seed("BREW /pot HTTP/1.1\r\n\r\n", .complete, path: "/pot", keepAlive: true),
+    Seed("GET /huge HTTP/1.1\r\nContent-Length: 99999999999999999999\r\n\r\n", .complete,
+         path: "/huge", contentLength: Int(Int32.max), keepAlive: true),
+    Seed("GET /many HTTP/1.1\r\n" + String(repeating: "X-Pad: 1\r\n", count: 20) + "Connection: close\r\n\r\n",
+         .complete, path: "/many"),
+    Seed("GET /q?a=1&b=%20?c HTTP/1.1\r\n\r\n", .complete, path: "/q", keepAlive: true),
+    Seed("POST /same HTTP/1.1\r\nContent-Length: 5\r\nContent-Length: 5\r\n\r\nhello", .complete,
+         path: "/same", contentLength: 5, keepAlive: true),
+
+    // Transfer-Encoding: recorded, the server answers 501 and closes.
+    Seed("POST /up HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n0\r\n\r\n", .complete,
+         path: "/up", keepAlive: true, transferEncoding: true),
+    Seed("POST /up HTTP/1.1\r\nContent-Length: 4\r\ntransfer-encoding: gzip, chunked\r\n\r\n", .complete,
+         path: "/up", contentLength: 4, keepAlive: true, transferEncoding: true),
+
+    // Incomplete.
+    Seed("GET / HTTP/1.1\r\nHost: uno\r\n", .needMore),
+    Seed("GET / HT", .needMore),
+    Seed("", .needMore),
+
+    // Invalid.
+    Seed("GET / HTTP/2.0\r\n\r\n", .invalid),
+    Seed("GET /\r\n\r\n", .invalid),
+    Seed(" / HTTP/1.1\r\n\r\n", .invalid),
+    Seed("GET  HTTP/1.1\r\n\r\n", .invalid),
+    Seed("POST /x HTTP/1.1\r\nContent-Length: 12a\r\n\r\n", .invalid),
+    Seed("POST /x HTTP/1.1\r\nContent-Length:\r\n\r\n", .invalid),
+    Seed("POST /x HTTP/1.1\r\nContent-Length: 5\r\nContent-Length: 50\r\n\r\n", .invalid),
+    Seed("POST /x HTTP/1.1\r\ncontent-length: 0\r\nContent-Length:  7\r\n\r\n", .invalid),
+]
@@ -0,0 +1,232 @@
+// main.swift
+// HTTPParser fuzz run on the host. Every seed in Corpus.swift must give its
+// listed outcome; then mutated seeds (byte flips, inserted CR / LF / ':' / ' ',
+// deletions, duplicated and truncated spans) must never trap and must keep
+// the parser's invariants:
+// - fed in random pieces, the result equals a one-shot parse of the same bytes
+// - parse() after .complete / .invalid returns that status again
+// - after reset() the same buffer parses to the same result
+// - every recorded range lies inside the head; headers stay within maxHeaders;
+//   Content-Length is never negative
+// and a reused parser allocates nothing (AllocCount.c). Over HTTPHostBoard, a
+// request smuggled behind Transfer-Encoding or conflicting Content-Lengths
+// is never answered.
+
+// xorshift64*: same sequence on every run and platform.
+var seed: UInt64 = 0x9E37_79B9_7F4A_7C15
+func next() -> UInt64 {
+    seed ^= seed >> 12
+    seed ^= seed << 25
+    seed ^= seed >> 27
+    return seed &* 0x2545_F491_4F6C_DD1D
+}
+
+func below(_ n: Int) -> Int { Int(next() % UInt64(n)) }
+
+/// What a parse produced, comparable across feeding strategies.
+struct Parsed: Equatable {
+    var status: HTTPParser.Status
+    var method: HTTPMethod?
+    var methodRange: Range<Int>
+    var path: Range<Int>
+    var query: Range<Int>?
+    var headers: [Range<Int>]
+    var headerEnd: Int
+    var contentLength: Int
+    var transferEncoding: Bool
+    var keepAlive: Bool
+    var isHTTP11: Bool
+
+    init(_ p: HTTPParser) {
+        status = p.status
+        method = p.method
+        methodRange = p.methodRange
+        path = p.path
+        query = p.query
+        headers = p.headers.flatMap { [$0.name, $0.value] }
+        headerEnd = p.headerEnd
+        contentLength = p.contentLength
+        transferEncoding = p.transferEncoding
+        keepAlive = p.keepAlive
+        isHTTP11 = p.isHTTP11
+    }
+}
+
+func oneShot(_ p: inout HTTPParser, _ b: [U8]) -> Parsed {
+    b.withUnsafeBufferPointer { _ = p.parse($0) }
+    return Parsed(p)
+}
+
+/// Grows the visible prefix piece by piece, as reads arrive on a connection.
+func pieces(_ p: inout HTTPParser, _ b: [U8], maxPiece: Int) -> Parsed {
+    b.withUnsafeBufferPointer { all in
+        var n = 0
+        while n < all.count && p.status == .needMore {
+            n = min(all.count, n + 1 + below(maxPiece))
+            p.parse(UnsafeBufferPointer(rebasing: all[0..<n]))
+        }
+        if n < all.count { p.parse(all) }
+    }
+    return Parsed(p)
+}
+
+func checkInvariants(_ r: Parsed, _ b: [U8], _ maxHeaders: Int, _ what: @autoclosure () -> String) {
+    expect(r.contentLength >= 0 && r.contentLength <= Int(Int32.max), "\(what()): contentLength \(r.contentLength)")
+    guard r.status == .complete else { return }
+    let head = 0..<r.headerEnd
+    func inside(_ x: Range<Int>) -> Bool { x.lowerBound >= head.lowerBound && x.upperBound <= head.upperBound }
+    expect(r.headerEnd > 0 && r.headerEnd <= b.count, "\(what()): headerEnd \(r.headerEnd) of \(b.count)")
+    if r.headerEnd <= 0 { return }
+    expect(!r.methodRange.isEmpty && inside(r.methodRange), "\(what()): methodRange \(r.methodRange)")
+    expect(!r.path.isEmpty && inside(r.path), "\(what()): path \(r.path)")
+    expect(r.path.lowerBound > r.methodRange.upperBound, "\(what()): path overlaps the method")
+    if let q = r.query { expect(inside(q) && q.lowerBound == r.path.upperBound + 1, "\(what()): query \(q)") }
+    expect(r.headers.count <= 2 * maxHeaders, "\(what()): \(r.headers.count / 2) headers recorded")
+    expect(r.headers.allSatisfy(inside), "\(what()): header range outside the head")
+    expect(r.headerEnd <= b.count && b[r.headerEnd - 1] == 0x0A, "\(what()): headerEnd not after a LF")
+}
+
+func text(_ b: [U8]) -> String {
+    var s = ""
+    for c in b.prefix(80) {
+        switch c {
+        case 0x0D: s += "\\r"
+        case 0x0A: s += "\\n"
+        case 0x20...0x7E: s += String(UnicodeScalar(c))
+        default: s += "\\x" + String(c, radix: 16)
+        }
+    }
+    return b.count > 80 ? s + "..." : s
+}
+
+/// Runs every check on one input; returns its one-shot result.
+@discardableResult
+func fuzzOne(_ b: [U8]) -> Parsed {
+    var p = HTTPParser()
+    let whole = oneShot(&p, b)
+    checkInvariants(whole, b, p.maxHeaders, "\"\(text(b))\"")
+
+    let again = b.withUnsafeBufferPointer { p.parse($0) }
+    expect(again == whole.status, "\"\(text(b))\": status changed on a repeated parse")
+
+    p.reset()
+    expect(oneShot(&p, b) == whole, "\"\(text(b))\": reset parser disagrees")
+
+    p.reset()
+    let byByte = pieces(&p, b, maxPiece: 1)
+    expect(byByte == whole, "\"\(text(b))\": byte-by-byte \(byByte.status) vs one-shot \(whole.status)")
+
+    p.reset()
+    let chunks = pieces(&p, b, maxPiece: 64)
+    expect(chunks == whole, "\"\(text(b))\": random pieces \(chunks.status) vs one-shot \(whole.status)")
+    return whole
+}
+
+// ----------------------
+// Seeds
+// ----------------------
+
+for s in corpus {
+    let b = Array(s.text.utf8)
+    let r = fuzzOne(b)
+    expect(r.status == s.status, "seed \"\(text(b))\": \(r.status), want \(s.status)")
+    if s.status != .complete || r.status != .complete { continue }
+    expect(Array(b[r.path]) == Array(s.path.utf8), "seed \"\(text(b))\": path \"\(text(Array(b[r.path])))\"")
+    expect(r.contentLength == s.contentLength, "seed \"\(text(b))\": contentLength \(r.contentLength)")
+    expect(r.keepAlive == s.keepAlive, "seed \"\(text(b))\": keepAlive \(r.keepAlive)")
+    expect(r.transferEncoding == s.transferEncoding, "seed \"\(text(b))\": transferEncoding \(r.transferEncoding)")
+}
+
+// ----------------------
+// Server: no smuggling through a body the parser does not frame
+// ----------------------
+
+do {
+    var smuggled = 0
+    let server = HTTPServer()
+    server.post("/up") { _ in .response("up") }
+    server.get("/admin") { _ in smuggled += 1; return .response("admin") }
+    server.start()
+
+    let chunked = roundTrip(server, "POST /up HTTP/1.1\r\nHost: uno\r\nTransfer-Encoding: chunked\r\n\r\n"
+                                    + "20\r\nGET /admin HTTP/1.1\r\nHost: x\r\n\r\n\r\n0\r\n\r\n").response
+    expect(status(chunked) == 501 && header(chunked, "Connection") == "close",
+           "chunked request: \(status(chunked)) Connection \(header(chunked, "Connection") ?? "-")")
+
+    let dup = roundTrip(server, "POST /up HTTP/1.1\r\nHost: uno\r\nContent-Length: 0\r\nContent-Length: 32\r\n\r\n"
+                                + "GET /admin HTTP/1.1\r\nHost: x\r\n\r\n").response
+    expect(status(dup) == 400 && header(dup, "Connection") == "close",
+           "conflicting Content-Length: \(status(dup)) Connection \(header(dup, "Connection") ?? "-")")
+    expect(smuggled == 0, "a request hidden in a body was answered \(smuggled) times")
+    server.stop()
+}
+
+// ----------------------
+// Heap
+// ----------------------
+
+// init() reserves the header spans; parsing allocates nothing after that,
+// not even past maxHeaders.
+var reused = HTTPParser()
+let heads = corpus.map { Array($0.text.utf8) }
+func parseCorpus() {
+    for b in heads {
+        reused.reset()
+        b.withUnsafeBufferPointer { _ = reused.parse($0) }
+    }
+}
+parseCorpus()
+if let heap = heapCalls(parseCorpus) {
+    expect(heap.allocs == 0, "parsing the corpus made \(heap.allocs) allocations")
+} else {
+    print("http_parser: no allocation counter on this host, heap check skipped")
+}
+
+// ----------------------
+// Mutations
+// ----------------------
+
+let interesting: [U8] = [0x0D, 0x0A, 0x3A, 0x20, 0x09, 0x3F, 0x30, 0x39, 0x00, 0xFF, 0x2F, 0x2C]
+
+func mutate(_ input: [U8]) -> [U8] {
+    var b = input
+    var k = 1 + below(4)
+    while k > 0 {
+        k -= 1
+        let at = b.isEmpty ? 0 : below(b.count + 1)
+        switch below(6) {
+        case 0:
+            if at < b.count { b[at] ^= U8(truncatingIfNeeded: 1 << below(8)) }
+        case 1:
+            b.insert(interesting[below(interesting.count)], at: at)
+        case 2:
+            b.insert(U8(truncatingIfNeeded: next()), at: at)
+        case 3:
+            if at < b.count { b.removeSubrange(at..<min(b.count, at + 1 + below(8))) }
+        case 4:
+            if at < b.count {
+                let span = Array(b[at..<min(b.count, at + 1 + below(24))])
+                b.insert(contentsOf: span, at: below(b.count + 1))
+            }
+        default:
+            b.removeSubrange(at..<b.count)
+        }
+    }
+    return b
+}
+
+let rounds = 40_000
+var outcomes = [0, 0, 0]
+var i = 0
+while i < rounds {
+    let b = mutate(Array(corpus[below(corpus.count)].text.utf8))
+    switch fuzzOne(b).status {
+    case .complete: outcomes[0] += 1
+    case .needMore: outcomes[1] += 1
+    case .invalid:  outcomes[2] += 1
+    }
+    i += 1
+}
+print("http_parser fuzz: \(rounds) mutations, \(outcomes[0]) complete, \(outcomes[1]) need more, \(outcomes[2]) invalid")
+
+finish(suite: "http_parser")
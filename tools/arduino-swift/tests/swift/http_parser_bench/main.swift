@@ -0,0 +1,83 @@
+// main.swift
+// HTTPParser throughput on the host: ns per request head and MB/s for a
+// browser GET, an API POST and a bare curl GET, parsed in one shot and fed
+// in 64-byte reads (incremental: the head is still scanned once). The host
+// numbers only compare parser versions; on the board the WiFi link dominates.
+// Fails a check if a head does not parse.
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#endif
+
+var sink = 0
+
+func nowNs() -> UInt64 {
+    var ts = timespec()
+    clock_gettime(CLOCK_MONOTONIC, &ts)
+    return UInt64(ts.tv_sec) &* 1_000_000_000 &+ UInt64(ts.tv_nsec)
+}
+
+let heads: [(String, String)] = [
+    ("browser GET",
+     "GET /app.js?v=3 HTTP/1.1\r\nHost: uno.local\r\nUser-Agent: Mozilla/5.0 (X11; Linux x86_64) "
+     + "AppleWebKit/537.36 (KHTML, like Gecko) Chrome/126.0 Safari/537.36\r\nAccept: */*\r\n"
+     + "Accept-Encoding: gzip, deflate, br\r\nAccept-Language: en-US,en;q=0.9\r\n"
+     + "If-None-Match: W/\"5f3a\"\r\nReferer: http://uno.local/\r\nCache-Control: no-cache\r\n"
+     + "Connection: keep-alive\r\n\r\n"),
+    ("API POST",
+     "POST /api/led HTTP/1.1\r\nHost: uno\r\nContent-Type: application/json\r\nContent-Length: 13\r\n\r\n"),
+    ("curl GET",
+     "GET /metrics HTTP/1.1\r\nHost: uno\r\nUser-Agent: curl/8.5.0\r\nAccept: */*\r\n\r\n"),
+]
+
+/// Parses `head` `iterations` times, feeding at most `piece` new bytes per call.
+func run(_ head: [U8], piece: Int, iterations: Int) -> UInt64 {
+    var p = HTTPParser()
+    var bad = 0
+    let ns: UInt64 = head.withUnsafeBufferPointer { all in
+        let start = nowNs()
+        var i = 0
+        while i < iterations {
+            p.reset()
+            var n = 0
+            while n < all.count && p.status == .needMore {
+                n = min(all.count, n + piece)
+                p.parse(UnsafeBufferPointer(rebasing: all[0..<n]))
+            }
+            if p.status != .complete { bad += 1 }
+            sink &+= p.headerEnd &+ p.headers.count
+            i += 1
+        }
+        return nowNs() &- start
+    }
+    expect(bad == 0, "\(bad) of \(iterations) heads did not parse (\(piece)-byte reads)")
+    return ns
+}
+
+func pad(_ s: String, _ width: Int) -> String {
+    s.count >= width ? s : s + String(repeating: " ", count: width - s.count)
+}
+
+func fixed(_ v: Double, _ digits: Int) -> String {
+    var f = FormatBuffer()
+    f.append(v, precision: digits)
+    return f.toString()
+}
+
+let iterations = 200_000
+print("\(pad("head", 12)) \(pad("bytes", 6)) \(pad("read", 8)) \(pad("ns/head", 10)) \(pad("MB/s", 8))")
+for (name, text) in heads {
+    let head = Array(text.utf8)
+    for piece in [head.count, 64] {
+        _ = run(head, piece: piece, iterations: iterations / 10)
+        let ns = run(head, piece: piece, iterations: iterations)
+        let perHead = Double(ns) / Double(iterations)
+        let mbs = Double(head.count) * Double(iterations) / (Double(ns) / 1e9) / 1e6
+        print("\(pad(name, 12)) \(pad(String(head.count), 6)) \(pad(piece == head.count ? "whole" : "64 B", 8)) "
+              + "\(pad(fixed(perHead, 1), 10)) \(pad(fixed(mbs, 1), 8))")
+    }
+}
+
+finish(suite: "http_parser_bench", detail: "(sink \(sink & 1))")
@@ -0,0 +1,90 @@
+// main.swift
+// HTTPServer routing end to end over HTTPHostBoard: which handler answers,
+// what it captured, and when a request gets 404 / 405 / 204 + Allow. Covers
+// backtracking by method (GET /users/me next to DELETE /users/:id) and a
+// serveStatic catch-all next to explicit routes.
+
+/// "name=value,..." for every captured parameter.
+func captures(_ req: HTTPRequest) -> String {
+    var s = ""
+    var i = 0
+    while i < req.paramCount {
+        if i > 0 { s += "," }
+        s += String(decoding: req.paramName(at: i), as: UTF8.self) + "="
+        s += String(decoding: req.paramValue(at: i), as: UTF8.self)
+        i += 1
+    }
+    return s
+}
+
+func exchange(_ server: HTTPServer, _ method: String, _ path: String, body: String = "") -> String {
+    var head = method + " " + path + " HTTP/1.1\r\nHost: uno\r\nConnection: close\r\n"
+    if !body.isEmpty { head += "Content-Length: \(body.utf8.count)\r\n" }
+    return roundTrip(server, head + "\r\n" + body).response
+}
+
+func expectAnswer(_ server: HTTPServer, _ method: String, _ path: String,
+                  _ wantStatus: Int, _ wantBody: String? = nil, allow: String? = nil) {
+    let resp = exchange(server, method, path)
+    let what = "\(method) \(path)"
+    expect(status(resp) == wantStatus, "\(what): status \(status(resp)), want \(wantStatus)")
+    if let b = wantBody { expect(body(resp) == b, "\(what): body \"\(body(resp))\", want \"\(b)\"") }
+    if let a = allow { expect(header(resp, "Allow") == a, "\(what): Allow \(header(resp, "Allow") ?? "-"), want \(a)") }
+}
+
+// A method missing on the best match backtracks to the next candidate.
+do {
+    let s = HTTPServer()
+    s.get("/users/me") { _ in .response("me") }
+    s.delete("/users/:id") { req in .response("delete " + captures(req)) }
+    s.put("/k/:a/z") { req in .response("put z " + captures(req)) }
+    s.post("/k/:b/:c") { req in .response("post " + captures(req)) }
+    s.start()
+
+    expectAnswer(s, "GET", "/users/me", 200, "me")
+    expectAnswer(s, "DELETE", "/users/me", 200, "delete id=me")
+    expectAnswer(s, "DELETE", "/users/42", 200, "delete id=42")
+    expectAnswer(s, "HEAD", "/users/me", 200, "")
+    expectAnswer(s, "POST", "/users/me", 405, allow: "GET, HEAD, DELETE, OPTIONS")
+    expectAnswer(s, "GET", "/users/42", 405, allow: "DELETE, OPTIONS")
+    expectAnswer(s, "OPTIONS", "/users/me", 204, allow: "GET, HEAD, DELETE, OPTIONS")
+
+    // Captures of the rejected candidate do not leak into the chosen one.
+    expectAnswer(s, "PUT", "/k/v/z", 200, "put z a=v")
+    expectAnswer(s, "POST", "/k/v/z", 200, "post a=v,c=z")
+    expectAnswer(s, "PATCH", "/k/v/z", 405, allow: "POST, PUT, OPTIONS")
+    expectAnswer(s, "GET", "/nothing/here", 404)
+    s.stop()
+}
+
+// serveStatic("/") catches every GET; other methods only 405 on explicit routes.
+do {
+    hostAddAsset("/app.js", Array("let x = 1\n".utf8), contentType: "text/javascript", etag: "\"a1\"")
+    let s = HTTPServer()
+    s.post("/api/led") { req in .response("led " + String(decoding: req.bodyView, as: UTF8.self)) }
+    s.serveStatic("/")
+    s.start()
+
+    expectAnswer(s, "GET", "/app.js", 200, "let x = 1\n")
+    expectAnswer(s, "GET", "/missing.js", 404)
+    expectAnswer(s, "POST", "/missing.js", 404)
+    expectAnswer(s, "POST", "/app.js", 404)
+    expectAnswer(s, "DELETE", "/", 404)
+    expectAnswer(s, "OPTIONS", "/app.js", 204, allow: "GET, HEAD, OPTIONS")
+    expectAnswer(s, "PUT", "/api/led", 405, allow: "GET, POST, HEAD, OPTIONS")
+
+    let resp = exchange(s, "POST", "/api/led", body: "on")
+    expect(status(resp) == 200 && body(resp) == "led on", "POST /api/led: \(resp)")
+    s.stop()
+}
+
+// No routes at all.
+do {
+    let s = HTTPServer()
+    s.start()
+    expectAnswer(s, "GET", "/", 404)
+    expectAnswer(s, "OPTIONS", "/", 404)
+    s.stop()
+}
+
+finish(suite: "http_router")
@@ -0,0 +1,123 @@
+// main.swift
+// serveStatic over HTTPHostBoard: gzip'd assets go to clients that send no
+// Accept-Encoding or one allowing gzip (one ruling it out gets 406),
+// Vary: Accept-Encoding only on responses for gzip'd assets, 304 keeps Vary,
+// and borrowed flash bodies resume at the right offset across ticks and
+// pipelined requests.
+
+func pattern(_ n: Int, _ salt: Int) -> [U8] {
+    var out: [U8] = []
+    out.reserveCapacity(n)
+    var i = 0
+    while i < n {
+        out.append(U8(truncatingIfNeeded: i &* 31 &+ salt &+ (i >> 8)))
+        i += 1
+    }
+    return out
+}
+
+let plain = Array("hello\n".utf8)
+let appGz: [U8] = [0x1F, 0x8B, 0x08, 0x00] + pattern(300, 7)
+let bigGz: [U8] = [0x1F, 0x8B, 0x08, 0x00] + pattern(5000, 3)
+
+hostAddAsset("/plain.txt", plain, contentType: "text/plain", etag: "\"p1\"")
+hostAddAsset("/app.js", appGz, contentType: "text/javascript", etag: "\"g1\"", gzip: true)
+hostAddAsset("/big.css", bigGz, contentType: "text/css", etag: "\"g2\"", gzip: true)
+
+let server = HTTPServer()
+server.serveStatic("/")
+server.start()
+
+func get(_ path: String, _ headers: String = "", method: String = "GET") -> HostClient {
+    roundTrip(server, method + " " + path + " HTTP/1.1\r\nHost: uno\r\n" + headers + "Connection: close\r\n\r\n")
+}
+
+// Identity assets: served to everyone, no Vary.
+for ae in ["", "Accept-Encoding: gzip\r\n", "Accept-Encoding: identity\r\n"] {
+    let r = get("/plain.txt", ae).response
+    expect(status(r) == 200 && body(r) == "hello\n", "plain.txt with \"\(ae)\": \(status(r))")
+    expect(header(r, "Vary") == nil && header(r, "Content-Encoding") == nil, "plain.txt with \"\(ae)\" has Vary / Content-Encoding")
+}
+
+// gzip'd asset: Accept-Encoding decides. No header means any coding is
+// acceptable; an empty one means identity only.
+let acceptance: [(String?, Bool)] = [
+    (nil, true),
+    ("gzip", true),
+    ("x-gzip", true),
+    ("*", true),
+    ("gzip, deflate, br", true),
+    ("deflate,gzip", true),
+    ("GZIP;Q=0.8", true),
+    ("gzip;q=0.001", true),
+    ("deflate, *;q=0.5", true),
+    ("x-gzip;q=0, gzip", true),
+    ("", false),
+    ("br", false),
+    ("identity", false),
+    ("gzipx", false),
+    ("gzip;q=0", false),
+    ("gzip ; q = 0.000", false),
+    ("gzip;level=1;q=0", false),
+    ("*;q=0", false),
+    ("gzip;q=0, *", false),
+]
+for (ae, ok) in acceptance {
+    let c = get("/app.js", ae.map { "Accept-Encoding: " + $0 + "\r\n" } ?? "")
+    let r = c.response
+    let what = "app.js with Accept-Encoding \(ae ?? "(none)")"
+    expect(header(r, "Vary") == "Accept-Encoding", "\(what): Vary \(header(r, "Vary") ?? "-")")
+    if ok {
+        expect(status(r) == 200, "\(what): status \(status(r)), want 200")
+        expect(header(r, "Content-Encoding") == "gzip", "\(what): no Content-Encoding: gzip")
+        expect(body(c.outbound) == appGz, "\(what): body differs")
+    } else {
+        expect(status(r) == 406, "\(what): status \(status(r)), want 406")
+        expect(header(r, "Content-Encoding") == nil, "\(what): 406 with Content-Encoding")
+    }
+}
+
+// 304 carries Vary when the 200 would, never Content-Encoding.
+do {
+    let g = get("/app.js", "Accept-Encoding: gzip\r\nIf-None-Match: W/\"g1\"\r\n").response
+    expect(status(g) == 304 && header(g, "Vary") == "Accept-Encoding" && header(g, "ETag") == "\"g1\"",
+           "app.js 304: \(status(g)) Vary \(header(g, "Vary") ?? "-")")
+    expect(header(g, "Content-Encoding") == nil && body(g).isEmpty, "app.js 304 with Content-Encoding or a body")
+
+    let p = get("/plain.txt", "If-None-Match: \"p1\"\r\n").response
+    expect(status(p) == 304 && header(p, "Vary") == nil, "plain.txt 304: \(status(p)) Vary \(header(p, "Vary") ?? "-")")
+}
+
+// HEAD: the GET headers, no body.
+do {
+    let r = get("/app.js", "Accept-Encoding: gzip\r\n", method: "HEAD").response
+    expect(status(r) == 200 && header(r, "Content-Encoding") == "gzip", "HEAD app.js: \(status(r))")
+    expect(header(r, "Content-Length") == "\(appGz.count)" && body(r).isEmpty, "HEAD app.js length / body")
+}
+
+// A body larger than one turn resumes where the last turn stopped.
+do {
+    server.streamBytesPerTurn = 1460
+    let c = get("/big.css", "Accept-Encoding: gzip\r\n")
+    expect(status(c.response) == 200 && header(c.response, "Content-Length") == "\(bigGz.count)",
+           "big.css: \(status(c.response)) length \(header(c.response, "Content-Length") ?? "-")")
+    expect(body(c.outbound) == bigGz, "big.css body differs (\(body(c.outbound).count) bytes)")
+}
+
+// Pipelined on one keep-alive connection: each response starts from offset 0.
+do {
+    let c = roundTrip(server,
+                      "GET /big.css HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n"
+                      + "GET /app.js HTTP/1.1\r\nAccept-Encoding: gzip\r\nConnection: close\r\n\r\n")
+    let all = body(c.outbound)
+    expect(all.count > bigGz.count && Array(all[0..<bigGz.count]) == bigGz, "pipelined big.css body differs")
+    if all.count > bigGz.count {
+        let second = Array(all[bigGz.count...])
+        let r = String(decoding: second, as: UTF8.self)
+        expect(status(r) == 200 && body(second) == appGz, "pipelined app.js: \(status(r)), \(body(second).count) bytes")
+    }
+    server.streamBytesPerTurn = 8 * 1460
+}
+
+server.stop()
+finish(suite: "http_static")
@@ -0,0 +1,120 @@
+// main.swift
+// I2C.Packet heap traffic, counted by AllocCount.c: payloads up to
+// Packet.inlineCapacity and the Bus send / request paths never allocate, a
+// longer payload spills to the heap, and removeAll() releases the spill.
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#endif
+
+var sink = 0
+
+guard let empty = heapCalls({}) else {
+    print("i2c_packet: no allocation counter on this host, skipped")
+    exit(0)
+}
+expect(empty.allocs == 0 && empty.frees == 0, "an empty block counted \(empty)")
+
+/// `body` runs once untimed first: one-off runtime metadata allocations do not count.
+func expectNoHeap(_ what: String, _ body: () -> Void) {
+    body()
+    let c = heapCalls(body)!
+    expect(c.allocs == 0 && c.frees == 0, "\(what): \(c.allocs) allocations, \(c.frees) frees")
+}
+
+// Building, editing and reading inline payloads.
+expectNoHeap("inline payloads") {
+    var i = 0
+    while i < 1000 {
+        var p = I2C.Packet()
+        p.appendLE(UInt32(truncatingIfNeeded: i))
+        p.appendBE(UInt16(7))
+        p.append(byte: 1)
+        var k = 0
+        while p.count < I2C.Packet.inlineCapacity {
+            p.append(byte: UInt8(truncatingIfNeeded: k))
+            k += 1
+        }
+        p.writeLE(UInt64(truncatingIfNeeded: i), at: 8)
+        sink &+= Int(p.readLE(UInt32.self) ?? 0) &+ Int(p.readBE(UInt16.self, at: 4) ?? 0)
+        p.withUnsafeBytes { sink &+= Int($0[I2C.Packet.inlineCapacity - 1]) }
+        p.withUnsafeMutableBytes { $0[0] = 0xAA }
+        p.removeLast(10)
+        sink &+= p.count
+
+        let q = I2C.Packet(int32LE: Int32(truncatingIfNeeded: i))
+        let r = I2C.Packet(capacity: I2C.Packet.inlineCapacity) { buf in
+            buf[0] = 1
+            return 1
+        }
+        sink &+= Int(q.asInt32LE() ?? 0) &+ Int(r.byte(at: 0) ?? 0)
+        expect(p.isInline && q.isInline && r.isInline, "inline payload spilled")
+        i += 1
+    }
+}
+
+// Bus paths that hand Packets to the (fake) Wire and back.
+let bus = I2C.Bus()
+expectNoHeap("Bus send / request") {
+    var i = 0
+    while i < 1000 {
+        _ = bus.send(to: 0x40, Int32(truncatingIfNeeded: i))
+        _ = bus.send(to: 0x40, UInt32(truncatingIfNeeded: i))
+        let got = bus.request(from: 0x40, count: 16)
+        sink &+= got.count &+ Int(got.byte(at: 15) ?? 0)
+        _ = bus.send(to: 0x41, got)
+        i += 1
+    }
+}
+
+// Spill, then removeAll() back to inline storage.
+var big = I2C.Packet()
+let spill = heapCalls {
+    var k = 0
+    while k < I2C.Packet.inlineCapacity + 8 {
+        big.append(byte: UInt8(truncatingIfNeeded: k))
+        k += 1
+    }
+}!
+expect(!big.isInline && big.count == I2C.Packet.inlineCapacity + 8, "payload did not spill")
+expect(spill.allocs > 0, "spilling counted no allocation")
+expect(big.readLE(UInt32.self, at: I2C.Packet.inlineCapacity) == 0x2322_2120, "spilled payload lost bytes")
+
+let cleared = heapCalls { big.removeAll() }!
+expect(big.isInline && big.count == 0, "removeAll kept the spilled buffer")
+expect(cleared.frees > 0, "removeAll freed nothing")
+
+expectNoHeap("inline again after removeAll") {
+    big.removeAll()
+    var k = 0
+    while k < I2C.Packet.inlineCapacity {
+        big.append(byte: UInt8(truncatingIfNeeded: k))
+        k += 1
+    }
+    sink &+= Int(big.readLE(UInt64.self, at: 8) ?? 0)
+}
+
+// A reused Packet that spills now and then holds no heap block between uses.
+var reused = I2C.Packet()
+func reuseRound(_ rounds: Int) {
+    var i = 0
+    while i < rounds {
+        let n = i % 4 == 0 ? I2C.Packet.inlineCapacity * 2 : 8
+        var k = 0
+        while k < n {
+            reused.append(byte: UInt8(truncatingIfNeeded: k))
+            k += 1
+        }
+        sink &+= reused.count
+        reused.removeAll()
+        i += 1
+    }
+}
+reuseRound(1)
+let churn = heapCalls { reuseRound(1000) }!
+expect(reused.isInline, "reused packet still spilled")
+expect(churn.allocs == churn.frees, "reuse left \(churn.allocs) allocations for \(churn.frees) frees")
+
+finish(suite: "i2c_packet", detail: "(sink \(sink & 1))")
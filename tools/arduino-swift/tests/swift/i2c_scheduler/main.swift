@@ -0,0 +1,220 @@
+// main.swift
+// I2C.Scheduler against a fake Wire: which bursts go out on each tick, in what
+// order, how reads are coalesced and phased, and what the shadow cache and
+// stats report. The transport records every burst and owns the clock.
+
+struct Burst: Equatable, CustomStringConvertible {
+    let target: I2C.Target
+    let register: Int
+    let count: Int
+
+    init(_ address: UInt8, _ register: Int, _ count: Int) {
+        target = .direct(address)
+        self.register = register
+        self.count = count
+    }
+
+    init(target: I2C.Target, register: Int, count: Int) {
+        self.target = target
+        self.register = register
+        self.count = count
+    }
+
+    var description: String {
+        "\(target.mux).\(target.channel).0x\(String(target.address, radix: 16))[\(register)+\(count)]"
+    }
+}
+
+/// Register r of device a reads as a * 7 + r; `failing` devices NACK.
+final class FakeWire: I2C.SchedulerTransport {
+    var ms: UInt32 = 1000
+    var us: UInt32 = 0
+    var usPerByte: UInt32 = 90
+    var failing: Set<UInt8> = []
+    var log: [Burst] = []
+    var errors: [(UInt8, I2C.Status)] = []
+
+    func scheduledRead(
+        from target: I2C.Target,
+        register: UInt8,
+        into rx: UnsafeMutableBufferPointer<UInt8>
+    ) -> (status: I2C.Status, count: Int) {
+        log.append(Burst(target: target, register: Int(register), count: rx.count))
+        us &+= usPerByte &* UInt32(rx.count)
+        if failing.contains(target.address) { return (.nackAddress, 0) }
+        for i in 0..<rx.count {
+            rx[i] = UInt8(truncatingIfNeeded: Int(target.address) &* 7 &+ Int(register) &+ i)
+        }
+        return (.ok, rx.count)
+    }
+
+    func scheduledError(_ address: UInt8, _ status: I2C.Status) {
+        errors.append((address, status))
+    }
+
+    func nowMs() -> UInt32 { ms }
+    func nowUs() -> UInt32 { us }
+
+    /// Bursts sent by one tick at `at` ms.
+    func tick(_ s: I2C.Scheduler, at: UInt32) -> [Burst] {
+        ms = at
+        log.removeAll()
+        s.tick()
+        return log
+    }
+}
+
+func expectBursts(_ got: [Burst], _ want: [Burst], _ what: String) {
+    expect(got == want, "\(what): got \(got) want \(want)")
+}
+
+// Same phase for every read: ordering and coalescing only.
+do {
+    let w = FakeWire()
+    let s = I2C.Scheduler(transport: w, slotMs: 2, phaseSlots: 1)
+    s.maxBurstsPerTick = 8
+    s.add(address: 0x40, register: 6, count: 2, everyMs: 10)
+    s.add(address: 0x40, register: 0, count: 2, everyMs: 10)
+    s.add(address: 0x20, register: 0x10, count: 4, everyMs: 10)
+    s.add(address: 0x40, register: 2, count: 2, everyMs: 10)
+
+    expectBursts(w.tick(s, at: 999), [], "nothing due before the first period")
+    expectBursts(w.tick(s, at: 1000), [Burst(0x20, 0x10, 4), Burst(0x40, 0, 4), Burst(0x40, 6, 2)],
+                 "sorted by device and register, adjacent ranges merged")
+    expectBursts(w.tick(s, at: 1005), [], "nothing due mid-period")
+
+    s.coalesceGap = 2
+    expectBursts(w.tick(s, at: 1010), [Burst(0x20, 0x10, 4), Burst(0x40, 0, 8)],
+                 "coalesceGap bridges the 2-register hole")
+
+    s.coalesceGap = 1
+    expectBursts(w.tick(s, at: 1020), [Burst(0x20, 0x10, 4), Burst(0x40, 0, 4), Burst(0x40, 6, 2)],
+                 "a gap wider than coalesceGap splits the burst")
+}
+
+// Bursts never exceed maxBurst bytes; overlapping ranges merge.
+do {
+    let w = FakeWire()
+    let s = I2C.Scheduler(transport: w, slotMs: 2, phaseSlots: 1)
+    s.maxBurstsPerTick = 8
+    s.add(address: 0x50, register: 0, count: 20, everyMs: 10)
+    s.add(address: 0x50, register: 20, count: 20, everyMs: 10)
+    s.add(address: 0x51, register: 0, count: 8, everyMs: 10)
+    s.add(address: 0x51, register: 4, count: 8, everyMs: 10)
+
+    expectBursts(w.tick(s, at: 1000), [Burst(0x50, 0, 20), Burst(0x50, 20, 20), Burst(0x51, 0, 12)],
+                 "40 adjacent bytes split at maxBurst, overlapping ranges merged")
+    expect(s.add(address: 0x52, register: 0, count: I2C.Scheduler.maxBurst + 1, everyMs: 10) == nil,
+           "a read larger than one burst is refused")
+    expect(s.add(address: 0x52, register: 0xF0, count: 0x20, everyMs: 10) == nil,
+           "a read past register 0xFF is refused")
+}
+
+// maxBurstsPerTick: the rest stays due and goes out first on the next tick.
+do {
+    let w = FakeWire()
+    let s = I2C.Scheduler(transport: w, slotMs: 2, phaseSlots: 1)
+    s.maxBurstsPerTick = 1
+    s.add(address: 0x30, register: 0, count: 1, everyMs: 10)
+    s.add(address: 0x31, register: 0, count: 1, everyMs: 10)
+    s.add(address: 0x32, register: 0, count: 1, everyMs: 10)
+
+    expectBursts(w.tick(s, at: 1000), [Burst(0x30, 0, 1)], "tick 1")
+    expectBursts(w.tick(s, at: 1001), [Burst(0x31, 0, 1)], "tick 2")
+    expectBursts(w.tick(s, at: 1002), [Burst(0x32, 0, 1)], "tick 3")
+    expectBursts(w.tick(s, at: 1003), [], "all served")
+}
+
+// Mux targets: direct devices first, then channel by channel.
+do {
+    let w = FakeWire()
+    let s = I2C.Scheduler(transport: w, slotMs: 2, phaseSlots: 1)
+    s.maxBurstsPerTick = 8
+    let a = I2C.Target(mux: 0x70, channel: 1, address: 0x40)
+    let b = I2C.Target(mux: 0x70, channel: 0, address: 0x41)
+    let c = I2C.Target(mux: 0x70, channel: 0, address: 0x40)
+    s.add(target: a, register: 0, count: 2, everyMs: 10)
+    s.add(target: b, register: 0, count: 2, everyMs: 10)
+    s.add(address: 0x40, register: 0, count: 2, everyMs: 10)
+    s.add(target: c, register: 2, count: 2, everyMs: 10)
+    s.add(target: c, register: 0, count: 2, everyMs: 10)
+
+    expectBursts(w.tick(s, at: 1000),
+                 [Burst(0x40, 0, 2), Burst(target: c, register: 0, count: 4),
+                  Burst(target: b, register: 0, count: 2), Burst(target: a, register: 0, count: 2)],
+                 "mux channels grouped, same address on two channels kept apart")
+}
+
+// Phases: same-period reads land in the least-loaded slots, one per tick.
+do {
+    let w = FakeWire()
+    let s = I2C.Scheduler(transport: w, slotMs: 2, phaseSlots: 4)
+    s.maxBurstsPerTick = 8
+    for a in UInt8(0x10)...UInt8(0x14) {
+        s.add(address: a, register: 0, count: 1, everyMs: 8)
+    }
+
+    var seen: [[Burst]] = []
+    var t: UInt32 = 1000
+    while t < 1008 {
+        seen.append(w.tick(s, at: t))
+        t += 2
+    }
+    expectBursts(seen[0], [Burst(0x10, 0, 1), Burst(0x14, 0, 1)], "slot 0 holds the 1st and 5th read")
+    expectBursts(seen[1], [Burst(0x11, 0, 1)], "slot 1")
+    expectBursts(seen[2], [Burst(0x12, 0, 1)], "slot 2")
+    expectBursts(seen[3], [Burst(0x13, 0, 1)], "slot 3")
+    expectBursts(w.tick(s, at: 1008), [Burst(0x10, 0, 1), Burst(0x14, 0, 1)], "phase kept on the next period")
+    expectBursts(w.tick(s, at: 1010), [Burst(0x11, 0, 1)], "slot 1, next period")
+
+    // A stalled loop does not replay missed periods.
+    expectBursts(w.tick(s, at: 1100), [Burst(0x10, 0, 1), Burst(0x11, 0, 1), Burst(0x12, 0, 1),
+                                       Burst(0x13, 0, 1), Burst(0x14, 0, 1)], "everything overdue once")
+    expectBursts(w.tick(s, at: 1101), [], "no catch-up bursts")
+    expectBursts(w.tick(s, at: 1108), [Burst(0x10, 0, 1), Burst(0x11, 0, 1), Burst(0x12, 0, 1),
+                                       Burst(0x13, 0, 1), Burst(0x14, 0, 1)], "rescheduled from the stall")
+}
+
+// Shadow cache, staleness, stats and errors.
+do {
+    let w = FakeWire()
+    let s = I2C.Scheduler(transport: w, slotMs: 2, phaseSlots: 1)
+    s.maxBurstsPerTick = 8
+    var updates = 0
+    let r = s.add(address: 0x40, register: 4, count: 3, everyMs: 10) { bytes in
+        if bytes.count == 3 && bytes[0] == UInt8(truncatingIfNeeded: 0x40 * 7 + 4) { updates += 1 }
+    }!
+    let bad = s.add(address: 0x41, register: 0, count: 1, everyMs: 10)!
+    w.failing = [0x41]
+
+    expect(s.isStale(r), "stale before the first read")
+    expect(s.value(address: 0x40, register: 5) == nil, "no value before the first read")
+
+    _ = w.tick(s, at: 1000)
+    expect(!s.isStale(r) && updates == 1, "fresh after one read (\(updates) updates)")
+    expect(s.value(address: 0x40, register: 5) == UInt8(truncatingIfNeeded: 0x40 * 7 + 5), "shadow value")
+    expect(s.value(address: 0x40, register: 7) == nil, "register outside every read")
+    expect(s.withValue(r) { Array($0) } == [0x40 * 7 + 4, 0x40 * 7 + 5, 0x40 * 7 + 6].map { UInt8(truncatingIfNeeded: $0) },
+           "withValue borrows the read's range")
+
+    w.failing = [0x40, 0x41]
+    _ = w.tick(s, at: 1010)
+    _ = w.tick(s, at: 1020)
+    expect(!s.isStale(r), "still fresh within 2 x period")
+    _ = w.tick(s, at: 1021)
+    expect(s.isStale(r) && s.value(address: 0x40, register: 5) == nil, "stale after 2 x period without a refresh")
+    expect(s.isStale(bad), "a read that never succeeded stays stale")
+
+    let st = s.stats(for: 0x40)
+    expect(st?.transfers == 3 && st?.errors == 2 && st?.lastStatus == I2C.Status.nackAddress,
+           "stats \(String(describing: st))")
+    expect(st?.lastLatencyUs == 3 * w.usPerByte, "latency is measured around the transfer")
+    expect(w.errors.count == 5 && w.errors.allSatisfy { $0.1 == .nackAddress }, "errors reported to the bus")
+    expect(updates == 1, "onUpdate only on success")
+
+    w.failing = []
+    _ = w.tick(s, at: 1030)
+    expect(!s.isStale(r) && updates == 2, "fresh again after a successful read")
+}
+
+finish(suite: "i2c_scheduler")
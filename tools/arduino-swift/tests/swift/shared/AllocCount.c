@@ -0,0 +1,64 @@
+// AllocCount.c
+// Heap allocation / free counters for host Swift suites (HostAlloc.swift reads them).
+//
+// glibc: malloc / calloc / realloc / free are replaced by counting forwarders
+// to the __libc_* entry points. The executable's definitions win over libc's
+// for the whole process, including the Swift runtime. Elsewhere the counters
+// are unavailable and both return UINT64_MAX.
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(__GLIBC__)
+
+extern void* __libc_malloc(size_t n);
+extern void* __libc_calloc(size_t n, size_t size);
+extern void* __libc_realloc(void* p, size_t n);
+extern void  __libc_free(void* p);
+
+static uint64_t g_allocs;
+static uint64_t g_frees;
+
+static inline void note_alloc(void) {
+  __atomic_add_fetch(&g_allocs, 1, __ATOMIC_RELAXED);
+}
+
+void* malloc(size_t n) {
+  note_alloc();
+  return __libc_malloc(n);
+}
+
+void* calloc(size_t n, size_t size) {
+  note_alloc();
+  return __libc_calloc(n, size);
+}
+
+void* realloc(void* p, size_t n) {
+  note_alloc();
+  return __libc_realloc(p, n);
+}
+
+void free(void* p) {
+  if (p) __atomic_add_fetch(&g_frees, 1, __ATOMIC_RELAXED);
+  __libc_free(p);
+}
+
+uint64_t host_alloc_count(void) {
+  return __atomic_load_n(&g_allocs, __ATOMIC_RELAXED);
+}
+
+uint64_t host_free_count(void) {
+  return __atomic_load_n(&g_frees, __ATOMIC_RELAXED);
+}
+
+#else
+
+uint64_t host_alloc_count(void) {
+  return UINT64_MAX;
+}
+
+uint64_t host_free_count(void) {
+  return UINT64_MAX;
+}
+
+#endif
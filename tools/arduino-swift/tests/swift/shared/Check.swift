@@ -0,0 +1,26 @@
+// Check.swift
+// The check harness every Swift suite shares: expect() counts a check and
+// prints the first 20 failures, finish(suite:) prints the totals line and
+// exits non-zero when any check failed.
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#endif
+
+var checked = 0
+var failures = 0
+
+func expect(_ ok: Bool, _ what: @autoclosure () -> String) {
+    checked += 1
+    if ok { return }
+    failures += 1
+    if failures <= 20 { print("FAIL \(what())") }
+}
+
+/// "<suite>: N checks, M failures" plus `detail`, then exit. The last line of main.swift.
+func finish(suite: String, detail: String = "") -> Never {
+    print("\(suite): \(checked) checks, \(failures) failures" + (detail.isEmpty ? "" : " " + detail))
+    exit(failures == 0 ? 0 : 1)
+}
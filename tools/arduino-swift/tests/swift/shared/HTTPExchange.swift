@@ -0,0 +1,52 @@
+// HTTPExchange.swift
+// Request / response helpers for suites that drive HTTPServer over
+// HTTPHostBoard: send raw request bytes on a new connection, tick until the
+// server closes it, and pick the status, headers and body out of the reply.
+
+/// Ticks (10 ms apart) until the server closes the connection; returns it.
+@discardableResult
+func roundTrip(_ server: HTTPServer, _ request: String, maxTicks: Int = 100) -> HostClient {
+    let c = hostConnect(request)
+    var k = 0
+    while k < maxTicks && !c.stopped {
+        hostMillis &+= 10
+        server.tick()
+        k += 1
+    }
+    return c
+}
+
+let crlf = Character("\r\n")
+
+func status(_ response: String) -> Int {
+    let line = response.split(separator: crlf, maxSplits: 1).first ?? ""
+    let parts = line.split(separator: " ")
+    return parts.count > 1 ? Int(parts[1]) ?? 0 : 0
+}
+
+/// First header `name` (case-insensitive) of the first response in `response`.
+func header(_ response: String, _ name: String) -> String? {
+    for line in response.split(separator: crlf, omittingEmptySubsequences: false) {
+        if line.isEmpty { break }
+        if line.lowercased().hasPrefix(name.lowercased() + ": ") {
+            return String(line.dropFirst(name.utf8.count + 2))
+        }
+    }
+    return nil
+}
+
+/// Bytes after the first blank line.
+func body(_ response: [U8]) -> [U8] {
+    var i = 0
+    while i + 3 < response.count {
+        if response[i] == 0x0D && response[i + 1] == 0x0A && response[i + 2] == 0x0D && response[i + 3] == 0x0A {
+            return Array(response[(i + 4)...])
+        }
+        i += 1
+    }
+    return []
+}
+
+func body(_ response: String) -> String {
+    String(decoding: body(Array(response.utf8)), as: UTF8.self)
+}
@@ -0,0 +1,178 @@
+// HTTPHostBoard.swift
+// Host stand-ins for the HTTP server C ABI (HTTPServer+ArduinoABI.swift), the
+// clock and FormatBuffer's Serial hooks, so swift/libs/http_server builds into
+// a host suite. Each slot holds a fake client: a test queues one with
+// hostConnect(), feeds it request bytes and reads back what the server wrote.
+// Accept follows http_server.cpp: -1 nothing waiting, -2 refused (no idle slot).
+
+var hostMillis: UInt32 = 0
+var hostMicros: UInt64 = 0
+
+func arduino_millis() -> U32 { hostMillis }
+func arduino_micros() -> UInt64 { hostMicros }
+func arduino_delay_ms(_ ms: U32) { hostMillis &+= ms; hostMicros &+= UInt64(ms) &* 1000 }
+
+enum Serial {
+    static func isInitialized() -> Bool { true }
+    static func begin(_ baud: U32) {}
+}
+
+func arduino_serial_print_cstr(_ s: UnsafePointer<CChar>) {}
+
+// ----------------------
+// Fake clients
+// ----------------------
+
+final class HostClient {
+    var inbound: [U8] = []
+    var readAt: Int = 0
+    var outbound: [U8] = []
+    var connected: Bool = true
+    var stopped: Bool = false
+
+    func send(_ text: String) { inbound += Array(text.utf8) }
+
+    /// Everything written so far, as text (assumes ASCII / UTF-8).
+    var response: String { String(decoding: outbound, as: UTF8.self) }
+}
+
+let hostSlotCount = 4
+var hostSlots: [HostClient?] = Array(repeating: nil, count: hostSlotCount)
+var hostWaiting: [HostClient] = []
+var hostListening: Bool = false
+
+/// A client waiting to be accepted.
+@discardableResult
+func hostConnect(_ request: String = "") -> HostClient {
+    let c = HostClient()
+    c.send(request)
+    hostWaiting.append(c)
+    return c
+}
+
+func hostReset() {
+    hostSlots = Array(repeating: nil, count: hostSlotCount)
+    hostWaiting.removeAll()
+}
+
+func arduino_http_server_begin(_ port: UInt16) -> I32 { hostListening = true; return 1 }
+func arduino_http_server_end() -> Void { hostListening = false; hostReset() }
+func arduino_http_server_slots() -> U32 { U32(hostSlotCount) }
+
+func arduino_http_server_accept() -> I32 {
+    if !hostListening || hostWaiting.isEmpty { return -1 }
+    let c = hostWaiting.removeFirst()
+    var i = 0
+    while i < hostSlotCount {
+        if hostSlots[i] == nil || hostSlots[i]!.stopped {
+            hostSlots[i] = c
+            return I32(i)
+        }
+        i += 1
+    }
+    c.stopped = true
+    return -2
+}
+
+private func hostClient(_ slot: U32) -> HostClient? {
+    guard Int(slot) < hostSlotCount, let c = hostSlots[Int(slot)], !c.stopped else { return nil }
+    return c
+}
+
+func arduino_http_server_slot_connected(_ slot: U32) -> I32 {
+    hostClient(slot)?.connected == true ? 1 : 0
+}
+
+func arduino_http_server_slot_available_bytes(_ slot: U32) -> I32 {
+    guard let c = hostClient(slot) else { return 0 }
+    return I32(c.inbound.count - c.readAt)
+}
+
+func arduino_http_server_slot_read(_ slot: U32, _ out: UnsafeMutablePointer<U8>?, _ cap: U32) -> I32 {
+    guard let c = hostClient(slot), let out = out else { return -1 }
+    let n = min(Int(cap), c.inbound.count - c.readAt)
+    var i = 0
+    while i < n {
+        out[i] = c.inbound[c.readAt + i]
+        i += 1
+    }
+    c.readAt += n
+    return I32(n)
+}
+
+func arduino_http_server_slot_write(_ slot: U32, _ data: UnsafePointer<U8>?, _ len: U32) -> I32 {
+    guard let c = hostClient(slot), c.connected, let data = data else { return 0 }
+    c.outbound.append(contentsOf: UnsafeBufferPointer(start: data, count: Int(len)))
+    return I32(len)
+}
+
+func arduino_http_server_slot_set_idle(_ slot: U32, _ idle: U32) -> Void {}
+
+func arduino_http_server_slot_stop(_ slot: U32) -> Void {
+    hostClient(slot)?.stopped = true
+}
+
+// ----------------------
+// Embedded assets (assets/ in a real build)
+// ----------------------
+
+struct HostAsset {
+    let path: [U8]
+    let data: UnsafeMutableBufferPointer<U8>
+    let contentType: UnsafeMutablePointer<CChar>
+    let etag: UnsafeMutablePointer<CChar>
+    let gzip: Bool
+}
+
+var hostAssets: [HostAsset] = []
+
+/// Copies live for the whole run, like flash.
+func hostAddAsset(_ path: String, _ body: [U8], contentType: String, etag: String, gzip: Bool = false) {
+    let data = UnsafeMutableBufferPointer<U8>.allocate(capacity: body.count)
+    _ = data.initialize(from: body)
+    hostAssets.append(HostAsset(path: Array(path.utf8), data: data,
+                                contentType: hostCString(contentType), etag: hostCString(etag), gzip: gzip))
+}
+
+private func hostCString(_ s: String) -> UnsafeMutablePointer<CChar> {
+    let bytes = Array(s.utf8)
+    let p = UnsafeMutablePointer<CChar>.allocate(capacity: bytes.count + 1)
+    var i = 0
+    while i < bytes.count {
+        p[i] = CChar(bitPattern: bytes[i])
+        i += 1
+    }
+    p[bytes.count] = 0
+    return p
+}
+
+func arduino_http_asset_count() -> U32 { U32(hostAssets.count) }
+
+func arduino_http_asset_find(_ path: UnsafePointer<U8>?, _ len: U32) -> I32 {
+    guard let path = path else { return -1 }
+    let key = Array(UnsafeBufferPointer(start: path, count: Int(len)))
+    var i = 0
+    while i < hostAssets.count {
+        if hostAssets[i].path == key { return I32(i) }
+        i += 1
+    }
+    return -1
+}
+
+func arduino_http_asset_data(_ i: U32, _ len: UnsafeMutablePointer<U32>?) -> UnsafePointer<U8>? {
+    guard Int(i) < hostAssets.count else { return nil }
+    len?.pointee = U32(hostAssets[Int(i)].data.count)
+    return UnsafePointer(hostAssets[Int(i)].data.baseAddress)
+}
+
+func arduino_http_asset_content_type(_ i: U32) -> UnsafePointer<CChar>? {
+    Int(i) < hostAssets.count ? UnsafePointer(hostAssets[Int(i)].contentType) : nil
+}
+
+func arduino_http_asset_etag(_ i: U32) -> UnsafePointer<CChar>? {
+    Int(i) < hostAssets.count ? UnsafePointer(hostAssets[Int(i)].etag) : nil
+}
+
+func arduino_http_asset_gzip(_ i: U32) -> U32 {
+    Int(i) < hostAssets.count && hostAssets[Int(i)].gzip ? 1 : 0
+}
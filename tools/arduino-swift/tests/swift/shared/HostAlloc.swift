@@ -0,0 +1,17 @@
+// HostAlloc.swift
+// Swift side of AllocCount.c: heap traffic of a block of code.
+
+@_silgen_name("host_alloc_count")
+func host_alloc_count() -> UInt64
+
+@_silgen_name("host_free_count")
+func host_free_count() -> UInt64
+
+/// Allocations and frees while `body` runs; nil where the host cannot count them.
+func heapCalls(_ body: () -> Void) -> (allocs: UInt64, frees: UInt64)? {
+    let a = host_alloc_count()
+    if a == UInt64.max { return nil }
+    let f = host_free_count()
+    body()
+    return (host_alloc_count() &- a, host_free_count() &- f)
+}
@@ -0,0 +1,97 @@
+// I2CHostBoard.swift
+// Host stand-ins for the I2C C ABI (I2C+ArduinoABI.swift), the clock and the
+// Serial hex helpers, so swift/libs/I2C/I2C.swift builds into a host suite.
+// Wire calls succeed; reads answer rxLen bytes 0, 1, 2, ...
+
+enum Serial {
+    static func printHex2(_ b: UInt8) {}
+    static func printHexBytes(_ bytes: [UInt8]) {}
+}
+
+var hostMillis: UInt32 = 0
+var hostMicros: UInt64 = 0
+
+func arduino_millis() -> U32 { hostMillis }
+func arduino_micros() -> UInt64 { hostMicros }
+func arduino_delay_ms(_ ms: U32) { hostMillis &+= ms; hostMicros &+= UInt64(ms) &* 1000 }
+
+func fakeRead(_ rx: UnsafeMutablePointer<U8>?, _ rxLen: U32) -> I32 {
+    guard let rx = rx else { return 0 }
+    var i = 0
+    while i < Int(rxLen) {
+        rx[i] = U8(truncatingIfNeeded: i)
+        i += 1
+    }
+    return I32(rxLen)
+}
+
+// ----------------------
+// I2C (Wire) - Master
+// ----------------------
+func arduino_i2c_begin() -> Void {}
+func arduino_i2c_setClock(_ hz: U32) -> Void {}
+func arduino_i2c_beginTransmission(_ address: U8) -> Void {}
+func arduino_i2c_write_byte(_ b: U8) -> U32 { 0 }
+func arduino_i2c_write_buf(_ data: UnsafePointer<U8>?, _ len: U32) -> U32 { 0 }
+func arduino_i2c_endTransmission(_ sendStop: U8) -> U8 { 0 }
+func arduino_i2c_requestFrom(_ address: U8, _ quantity: U32, _ sendStop: U8) -> U32 { 0 }
+func arduino_i2c_available() -> I32 { 0 }
+func arduino_i2c_read() -> I32 { 0 }
+func arduino_i2c_read_buf(_ out: UnsafeMutablePointer<U8>?, _ cap: U32) -> U32 { 0 }
+func arduino_i2c_transfer(
+    _ address: U8,
+    _ tx: UnsafePointer<U8>?, _ txLen: U32,
+    _ rx: UnsafeMutablePointer<U8>?, _ rxLen: U32,
+    _ flags: U32
+) -> I32 { fakeRead(rx, rxLen) }
+// ----------------------
+// I2C (Wire) - Mux
+// ----------------------
+func arduino_i2c_mux_select(_ mux: U8, _ channel: U8) -> U8 { 0 }
+func arduino_i2c_mux_invalidate() -> Void {}
+func arduino_i2c_mux_stats(_ skipped: UnsafeMutablePointer<U32>?) -> U32 { 0 }
+func arduino_i2c_mux_transfer(
+    _ mux: U8, _ channel: U8, _ address: U8,
+    _ tx: UnsafePointer<U8>?, _ txLen: U32,
+    _ rx: UnsafeMutablePointer<U8>?, _ rxLen: U32,
+    _ flags: U32
+) -> I32 { fakeRead(rx, rxLen) }
+// ----------------------
+// I2C master queue (I2CQueue.h)
+// ----------------------
+func arduino_i2cq_submit(
+    _ address: U8,
+    _ tx: UnsafePointer<U8>?, _ txLen: U32,
+    _ rx: UnsafeMutablePointer<U8>?, _ rxLen: U32,
+    _ flags: U32
+) -> I32 { -1 }
+func arduino_i2cq_pump() -> U32 { 0 }
+func arduino_i2cq_peek_done(
+    _ id: UnsafeMutablePointer<U32>?,
+    _ result: UnsafeMutablePointer<I32>?,
+    _ rx: UnsafeMutablePointer<UnsafePointer<U8>?>?
+) -> U32 { 0 }
+func arduino_i2cq_release_done() -> Void {}
+func arduino_i2cq_slots() -> U32 { 0 }
+func arduino_i2cq_state(_ id: U32) -> U32 { 0 }
+func arduino_i2cq_pending() -> U32 { 0 }
+func arduino_i2cq_is_async() -> U32 { 0 }
+// ----------------------
+// I2C (Wire) - Slave
+// ----------------------
+func arduino_i2c_slave_begin(_ address: U8) -> Void {}
+func arduino_i2c_slave_rx_frames() -> U32 { 0 }
+func arduino_i2c_slave_rx_frame_peek(_ len: UnsafeMutablePointer<U32>?) -> UnsafePointer<U8>? { nil }
+func arduino_i2c_slave_rx_frame_release() -> Void {}
+func arduino_i2c_slave_rx_available() -> U32 { 0 }
+func arduino_i2c_slave_rx_read() -> I32 { 0 }
+func arduino_i2c_slave_rx_read_buf(_ out: UnsafeMutablePointer<U8>?, _ maxLen: U32) -> U32 { 0 }
+func arduino_i2c_slave_rx_clear() -> Void {}
+func arduino_i2c_slave_rx_overflows() -> U32 { 0 }
+func arduino_i2c_slave_tx_back(_ cap: UnsafeMutablePointer<U32>?) -> UnsafeMutablePointer<U8>? { nil }
+func arduino_i2c_slave_tx_publish(_ len: U32) -> Void {}
+func arduino_i2c_slave_set_tx(_ data: UnsafePointer<U8>?, _ len: U32) -> Void {}
+func arduino_i2c_slave_set_reg_tx(_ reg: U8, _ data: UnsafePointer<U8>?, _ len: U32) -> U32 { 0 }
+func arduino_i2c_slave_clear_reg_tx() -> Void {}
+func arduino_i2c_slave_consume_onReceive() -> U32 { 0 }
+func arduino_i2c_slave_consume_onRequest() -> U32 { 0 }
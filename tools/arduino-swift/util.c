@@ -9,6 +9,8 @@
 #include <unistd.h>
 #include <limits.h>
 #include <sys/wait.h>
+#include <time.h>
+#include <errno.h>
 
 #if defined(__APPLE__)
   #include <mach-o/dyld.h>
@@ -98,6 +100,11 @@ int file_exists(const char* path) {
   return (stat(path, &st) == 0) && S_ISREG(st.st_mode);
 }
 
+int path_exists(const char* path) {
+  struct stat st;
+  return stat(path, &st) == 0;
+}
+
 int dir_exists(const char* path) {
   struct stat st;
   return (stat(path, &st) == 0) && S_ISDIR(st.st_mode);
@@ -169,6 +176,11 @@ int run_cmd_capture(const char* cmd, char* out, size_t out_cap) {
   return 127;
 }
 
+void sleep_ms(unsigned ms) {
+  struct timespec ts = { (time_t)(ms / 1000u), (long)(ms % 1000u) * 1000000L };
+  while (nanosleep(&ts, &ts) == -1 && errno == EINTR) {}
+}
+
 int prompt_yes_no(const char* q, int def_yes) {
   if (!isatty(STDIN_FILENO)) return def_yes;
 
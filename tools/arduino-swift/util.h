@@ -16,6 +16,7 @@ const char* cwd_dir(char* out, size_t cap);
 int path_join(char* out, size_t cap, const char* a, const char* b);
 
 int file_exists(const char* path);
+int path_exists(const char* path);     // any type (device nodes included)
 int dir_exists(const char* path);
 int ensure_dir(const char* path);
 
@@ -25,6 +26,8 @@ int write_file(const char* path, const char* s);
 int run_cmd(const char* cmd);           // prints cmd, returns exit code
 int run_cmd_capture(const char* cmd, char* out, size_t out_cap); // popen
 
+void sleep_ms(unsigned ms);            // nanosleep, restarts on EINTR
+
 int prompt_yes_no(const char* q, int def_yes);
 
 void die(const char* fmt, ...);